@@ -101,6 +101,7 @@
 #include "omnetpp/cscheduler.h"
 #include "omnetpp/csimplemodule.h"
 #include "omnetpp/csimulation.h"
+#include "omnetpp/cstatesaving.h"
 #include "omnetpp/cstatistic.h"
 #include "omnetpp/cstatisticbuilder.h"
 #include "omnetpp/cstddev.h"
@@ -108,6 +109,7 @@
 #include "omnetpp/cstringparimpl.h"
 #include "omnetpp/cstringtokenizer.h"
 #include "omnetpp/ctimestampedvalue.h"
+#include "omnetpp/ctimingwheel.h"
 #include "omnetpp/ctopology.h"
 #include "omnetpp/cvalue.h"
 #include "omnetpp/cvaluearray.h"
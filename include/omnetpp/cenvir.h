@@ -111,6 +111,14 @@ class SIM_API cEnvir
      * Configures the environment instance.
      */
     virtual void configure(cConfiguration *cfg) = 0;
+
+    /**
+     * Makes the environment continue with the run described by the given
+     * configuration, whose network has already been set up using the current
+     * configuration. Result recording is re-targeted to the new run. Called
+     * from cSimulation::switchRun(). The default implementation throws an error.
+     */
+    virtual void switchRun(cConfiguration *cfg);
     //@}
 
     /** @name Methods to be called by the simulation kernel to notify the environment about events. */
@@ -685,6 +693,13 @@ class SIM_API cEnvir
      * actually recorded, and false if it was not recorded (because of filtering, etc.)
      */
     virtual bool recordInOutputVector(void *vechandle, simtime_t t, double value) = 0;
+
+    /**
+     * Writes several values into the output vector; called by cOutVector::recordMany().
+     * Returns the number of values actually recorded. This default implementation
+     * calls recordInOutputVector() for each value.
+     */
+    virtual int recordManyInOutputVector(void *vechandle, const simtime_t *times, const double *values, int n);
     //@}
 
     /** @name Scalar statistics.
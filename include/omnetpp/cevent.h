@@ -47,11 +47,12 @@ class SIM_API cEvent : public cOwnedObject
 {
     friend class cMessage;     // getArrivalTime()
     friend class cEventHeap;   // heapIndex
+    friend class cTimingWheel; // heapIndex
 
   private:
     simtime_t arrivalTime;  // time of delivery -- set internally
     short priority = 0;     // priority -- used for scheduling events with equal arrival times
-    int heapIndex = -1;     // used by cEventHeap (-1 if not on heap; all other values, including negative ones, means "on the heap")
+    int heapIndex = -1;     // used by the FES (-1 if not on heap; all other values, including negative ones, means "on the heap")
     eventnumber_t insertOrder = -1; // used by the FES to keep order of events with equal time and priority
     eventnumber_t previousEventNumber = -1; // most recent event number when envir was notified about this event object (e.g. creating/cloning/sending/scheduling/deleting of this event object)
 
@@ -132,6 +132,11 @@ class SIM_API cGate : public cObject, noncopyable
     cGate *prevGate = nullptr;   // previous and next gate in the path
     cGate *nextGate = nullptr;
 
+    // internal: flattened connection path used by deliver(); built lazily,
+    // invalidated whenever the path downstream of this gate changes
+    struct DeliveryPlan;
+    DeliveryPlan *deliveryPlan = nullptr;
+
     static OPP_THREAD_LOCAL int lastConnectionId;
 
   protected:
@@ -150,6 +155,12 @@ class SIM_API cGate : public cObject, noncopyable
     // internal
     void checkChannels() const;
 
+    // internal
+    void buildDeliveryPlan();
+
+    // internal: invalidates cached delivery plans of this gate and all gates upstream
+    void invalidateDeliveryPlans();
+
 #ifdef SIMFRONTEND_SUPPORT
     // internal
     virtual bool hasChangedSince(int64_t lastRefreshSerial);
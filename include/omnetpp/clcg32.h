@@ -59,6 +59,12 @@ class SIM_API cLCG32 : public cRNG
                             int parsimProcId, int parsimNumPartitions,
                             cConfiguration *cfg) override;
 
+    /** Creates an exact copy of this RNG, including its internal state */
+    virtual cLCG32 *dup() const override;
+
+    /** Restores the internal state from another cLCG32 */
+    virtual void restoreState(const cRNG *other) override;
+
     /** Tests correctness of the RNG */
     virtual void selfTest() override;
 
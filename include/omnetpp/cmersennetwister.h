@@ -52,6 +52,12 @@ class SIM_API cMersenneTwister : public cRNG
                             int parsimProcId, int parsimNumPartitions,
                             cConfiguration *cfg) override;
 
+    /** Creates an exact copy of this RNG, including its internal state */
+    virtual cMersenneTwister *dup() const override;
+
+    /** Restores the internal state from another cMersenneTwister */
+    virtual void restoreState(const cRNG *other) override;
+
     /** Tests correctness of the RNG */
     virtual void selfTest() override;
 
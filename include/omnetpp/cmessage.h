@@ -142,6 +142,10 @@ class SIM_API cMessage : public cEvent
     // internal: used by the parallel simulation kernel.
     void setSrcProcId(int procId) {srcProcId = (short)procId;}
 
+    // internal: returns the id the next message created will get; used by the
+    // parallel simulation kernel.
+    static msgid_t getNextMessageId() {return nextMessageId;}
+
     // internal: used by the parallel simulation kernel.
     virtual int getSrcProcId() const override {return srcProcId;}
 
@@ -186,6 +186,18 @@ class SIM_API cOutVector : public cNoncopyableOwnedObject
      */
     virtual bool recordWithTimestamp(simtime_t t, SimTime value) {return recordWithTimestamp(t, value.dbl());}
 
+    /**
+     * Records n values with the given timestamps in one call. This is
+     * equivalent to calling recordWithTimestamp() for each (times[i], values[i])
+     * pair, but it is considerably cheaper for high-rate vectors, because the
+     * values are passed down to the output vector manager as a block.
+     * Timestamps must be in increasing order, and not less than the timestamp
+     * of the last recorded value.
+     *
+     * Returns the number of values actually recorded.
+     */
+    virtual int recordMany(const simtime_t *times, const double *values, int n);
+
     /**
      * Enables recording data via this object. (It is enabled by default.)
      */
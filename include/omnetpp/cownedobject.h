@@ -32,6 +32,7 @@ class cSimulation;
 class cSoftOwner;
 class cMessage;
 class cPacket;
+class cIOwnedObjectObserver;
 
 namespace internal { class Void; }
 
@@ -123,6 +124,9 @@ class SIM_API cOwnedObject : public cNamedObject
     static OPP_THREAD_LOCAL long totalObjectCount;
     static OPP_THREAD_LOCAL long liveObjectCount;
 
+    // notified about object creation and deletion; normally nullptr
+    static OPP_THREAD_LOCAL cIOwnedObjectObserver *observer;
+
   private:
     cOwnedObject(const char *name, bool namepooling, internal::Void *dummy);
     void copy(const cOwnedObject& obj);
@@ -134,6 +138,13 @@ class SIM_API cOwnedObject : public cNamedObject
     // internal
     static void setOwningContext(cSoftOwner *list);
 
+    // internal: installs an observer that is notified about the creation and
+    // deletion of every cOwnedObject (nullptr removes it); returns the previous one
+    static cIOwnedObjectObserver *setObserver(cIOwnedObjectObserver *observer);
+
+    // internal
+    static cIOwnedObjectObserver *getObserver() {return observer;}
+
   public:
     /** @name Constructors, destructor, assignment. */
     //@{
@@ -233,6 +244,29 @@ class SIM_API cOwnedObject : public cNamedObject
 };
 
 
+/**
+ * @brief Receives notifications about the creation and deletion of
+ * cOwnedObject instances, see cOwnedObject::setObserver(). This allows
+ * user interfaces to keep track of live objects without walking the object
+ * tree. There is one observer slot per simulation thread; an observer that
+ * replaces another one must forward the notifications to it, and put it back
+ * when it uninstalls itself.
+ *
+ * The notifications are sent from the cOwnedObject constructor and destructor,
+ * i.e. while the object is not fully constructed, or has been partially
+ * destroyed. Observers should only store the pointer, and inspect the object
+ * (type, name, owner) later.
+ *
+ * @ingroup Internals
+ */
+class SIM_API cIOwnedObjectObserver
+{
+  public:
+    virtual ~cIOwnedObjectObserver() {}
+    virtual void objectCreated(cOwnedObject *obj) = 0;
+    virtual void objectDeleted(cOwnedObject *obj) = 0;
+};
+
 /**
  * @brief Base class for cOwnedObject-based classes that do not wish to support
  * assignment and duplication.
@@ -276,6 +276,16 @@ class SIM_API cPacket : public cMessage
      */
     virtual cPacket *getEncapsulatedPacket() const;
 
+    /**
+     * Returns a read-only pointer to the encapsulated packet, or nullptr if
+     * there is no encapsulated packet. Unlike getEncapsulatedPacket(), this
+     * method does not unshare a shared encapsulated packet (see note at
+     * encapsulate()), so it is cheap for packets received via
+     * cSimpleModule::sendDirectMulticast(). Note that the owner of the
+     * returned object is undefined while it is shared.
+     */
+    const cPacket *peekEncapsulatedPacket() const {return encapsulatedPacket;}
+
     /**
      * Returns true if the packet contains an encapsulated packet, and false
      * otherwise. This method is potentially more efficient than
@@ -59,6 +59,7 @@ class SIM_API cParImpl : public cNamedObject
   private:
     // unit (s, mW, GHz, baud, etc); optional
     opp_staticpooledstring unit = nullptr;
+    short unitId = 0; // ID of the unit, for fast conversions; see UnitConversion::getUnitId()
 
     // base directory for interpreting relative path names in the expression (e.g. xmldoc())
     opp_staticpooledstring baseDirectory = nullptr;
@@ -201,7 +202,13 @@ class SIM_API cParImpl : public cNamedObject
     /**
      * Initialize the parameter's unit (normally from the @unit property).
      */
-    virtual void setUnit(const char *s) {unit = s;}
+    virtual void setUnit(const char *s);
+
+    /**
+     * Returns the ID of the parameter's unit, as returned by
+     * UnitConversion::getUnitId(). Internal.
+     */
+    int getUnitId() const {return unitId;}
 
     /**
      * Returns the base directory for interpreting relative path names
@@ -28,7 +28,13 @@ namespace omnetpp {
  * using insert(), and remove them at the front using pop().
  *
  * cQueue may be set up to act as a priority queue. This requires the user to
- * supply a comparison function.
+ * supply a comparison function. Elements are kept sorted, and ones that
+ * compare equal are kept in insertion order.
+ *
+ * Elements are stored in a contiguous circular buffer, so inserting at the
+ * back, pop() and get() are constant-time operations. Priority insertion
+ * uses binary search, unless the order has been altered with insertBefore()
+ * or insertAfter().
  *
  * Ownership of cOwnedObjects may be controlled by invoking setTakeOwnership()
  * prior to inserting objects. Objects that cannot track their ownership
@@ -41,14 +47,6 @@ namespace omnetpp {
  */
 class SIM_API cQueue : public cOwnedObject
 {
-  private:
-    struct QElem
-    {
-        cObject *obj; // the contained object
-        QElem *prev;  // element towards the front of the queue
-        QElem *next;  // element towards the back of the queue
-    };
-
   public:
     /**
      * @brief Base class for object comparators, used by cQueue for
@@ -77,11 +75,21 @@ class SIM_API cQueue : public cOwnedObject
 
     /**
      * @brief Walks along a cQueue.
+     *
+     * The iterator stores a position (index) in the queue, not a reference
+     * to the current element. Inserting or removing elements while iterating
+     * shifts the elements under the iterator. During forward iteration, an
+     * insertion before the current position makes the iterator visit the
+     * current element again, and a removal before it makes the iterator skip
+     * an element. Removing the current element makes the iterator point to
+     * the element that followed it. To modify the queue during iteration,
+     * collect the elements first, or iterate with get() and adjust the index.
      */
     class SIM_API Iterator
     {
       private:
-        QElem *p;
+        const cQueue *q;
+        int pos;
 
       public:
         /**
@@ -94,64 +102,71 @@ class SIM_API cQueue : public cOwnedObject
         /**
          * Reinitializes the iterator object.
          */
-        void init(const cQueue& q, bool reverse=false) {p = reverse ? q.backp : q.frontp;}
+        void init(const cQueue& q, bool reverse=false) {this->q = &q; pos = reverse ? q.len-1 : 0;}
 
         /**
          * Returns the current object.
          */
-        cObject *operator*() const {return p ? p->obj : nullptr;}
+        cObject *operator*() const {return end() ? nullptr : q->at(pos);}
 
         /**
          * Returns true if the iterator has reached either end of the queue.
          */
-        bool end() const {return p == nullptr;}
+        bool end() const {return pos < 0 || pos >= q->len;}
 
         /**
          * Prefix increment operator (++it). Moves the iterator to the next object
          * in the queue. It has no effect if the iterator has reached either
          * end of the queue.
          */
-        Iterator& operator++() {if (!end()) p = p->next; return *this;}
+        Iterator& operator++() {if (!end()) pos++; return *this;}
 
         /**
          * Postfix increment operator (it++). Moves the iterator to the next object
          * in the queue, and returns the iterator's previous state. It has
          * no effect if the iterator has reached either end of the queue.
          */
-        Iterator operator++(int) {Iterator tmp(*this); if (!end()) p = p->next; return tmp;}
+        Iterator operator++(int) {Iterator tmp(*this); if (!end()) pos++; return tmp;}
 
         /**
          * Prefix decrement operator (--it). Moves the iterator to the previous object
          * in the queue. It has no effect if the iterator has reached either
          * end of the queue.
          */
-        Iterator& operator--() {if (!end()) p = p->prev; return *this;}
+        Iterator& operator--() {if (!end()) pos--; return *this;}
 
         /**
          * Postfix decrement operator (it--). Moves the iterator to the previous object
          * in the queue, and returns the iterator's previous state. It has
          * no effect if the iterator has reached either end of the queue.
          */
-        Iterator operator--(int) {Iterator tmp(*this); if (!end()) p = p->prev; return tmp;}
+        Iterator operator--(int) {Iterator tmp(*this); if (!end()) pos--; return tmp;}
     };
 
     friend class Iterator;
 
   private:
     bool takeOwnership = true;
-    QElem *frontp = nullptr, *backp = nullptr;  // front and back pointers
+    cObject **elems = nullptr;  // circular buffer
+    int capacity = 0;  // size of the buffer; zero or a power of two
+    int head = 0;  // index of the front element in the buffer
     int len = 0;  // number of items in the queue
     Comparator *comparator = nullptr; // comparison functor; nullptr for FIFO
+    bool unsorted = false; // set if insertBefore()/insertAfter() or setup() broke the ordering; insert() falls back to linear search then
 
   private:
     void copy(const cQueue& other);
+    cObject *& at(int pos) const {return elems[(head + pos) & (capacity - 1)];}
+    void grow();
+    bool isSorted() const;
 
   protected:
-    // internal functions
-    QElem *find_qelem(cObject *obj) const;
-    void insbefore_qelem(QElem *p, cObject *obj);
-    void insafter_qelem(QElem *p, cObject *obj);
-    cObject *remove_qelem(QElem *p);
+    // internal functions; positions are counted from the front of the queue
+    int find_pos(cObject *obj) const;
+    int find_insertion_pos(cObject *obj) const;
+    void insert_at(int pos, cObject *obj);
+    void insert_explicit(int pos, cObject *obj);
+    cObject *remove_at(int pos);
 
   public:
     /** @name Constructors, destructor, assignment. */
@@ -261,7 +276,8 @@ class SIM_API cQueue : public cOwnedObject
 
     /**
      * Unlinks and returns the object given. If the object is not in the
-     * queue, nullptr is returned.
+     * queue, nullptr is returned. Removing the front or back element is a
+     * constant-time operation, otherwise the queue is searched linearly.
      */
     virtual cObject *remove(cObject *obj);
 
@@ -316,8 +332,7 @@ class SIM_API cQueue : public cOwnedObject
 
     /**
      * Returns the ith element in the queue, or nullptr if i is out of range.
-     * get(0) returns the front element. This method performs linear
-     * search.
+     * get(0) returns the front element.
      */
     virtual cObject *get(int i) const;
 
@@ -18,6 +18,7 @@
 
 #include "simkerneldefs.h"
 #include "cobject.h"
+#include "cexception.h"
 
 namespace omnetpp {
 
@@ -76,6 +77,21 @@ class SIM_API cRNG : public cObject
      */
     virtual uint64_t getNumbersDrawn() const  {return numDrawn;}
 
+    /**
+     * Creates an exact copy of this RNG, including its internal state. This
+     * is not supported by default; see restoreState().
+     */
+    virtual cRNG *dup() const override {return static_cast<cRNG *>(cObject::dup());}
+
+    /**
+     * Sets the internal state of this RNG (including the count of numbers
+     * drawn) to that of the given RNG, typically a copy created earlier with
+     * dup(). It is used for rolling back random number streams under
+     * optimistic parallel simulation. RNGs that support it should redefine
+     * both this method and dup(); the default implementation throws an error.
+     */
+    virtual void restoreState(const cRNG *other) {throw cRuntimeError(this, "restoreState(): Saving and restoring the RNG state is not supported by this class");}
+
     /**
      * Random integer in the range [0,intRandMax()]
      */
@@ -51,6 +51,16 @@ class SIM_API cIRngManager : public cNoncopyableOwnedObject
      */
     virtual void configure(cSimulation *simulation, cConfiguration *cfg, int parsimProcId, int parsimNumPartitions) = 0;
 
+    /**
+     * Re-seeds the existing RNGs according to the given configuration, which
+     * must only differ from the current one in the seeds (e.g. seed-set).
+     * RNGs are re-initialized in place, so the RNG mapping of components that
+     * have already been set up remains valid. This is used for continuing an
+     * already set up simulation as another repetition. The default
+     * implementation throws an error.
+     */
+    virtual void reseed(cConfiguration *cfg);
+
     /**
      * Sets up RNGs for the given component.
      */
@@ -84,6 +94,8 @@ class SIM_API cRngManager : public cIRngManager
 {
   private:
     cConfiguration *cfg = nullptr;
+    int parsimProcId = 0;
+    int parsimNumPartitions = 0;
     int numRNGs = 0;
     cRNG **rngs = nullptr;
 
@@ -97,6 +109,7 @@ class SIM_API cRngManager : public cIRngManager
     /** @name Redefined cIRngManager methods. */
     //@{
     virtual void configure(cSimulation *simulation, cConfiguration *cfg, int parsimProcId, int parsimNumPartitions) override;
+    virtual void reseed(cConfiguration *cfg) override;
     virtual void configureRNGs(cComponent *component) override;
     virtual int getNumRNGs(const cComponent *component) const override;
     virtual cRNG *getRNG(const cComponent *component, int k) override;
@@ -163,6 +163,17 @@ struct SIM_API SendOptions {
     std::string str() const;
 };
 
+/**
+ * @brief One destination of a cSimpleModule::sendDirectMulticast() call.
+ *
+ * @see cSimpleModule::sendDirectMulticast()
+ */
+struct SIM_API SendDirectTarget {
+    cGate *gate = nullptr;               ///< The destination gate
+    simtime_t propagationDelay = SIMTIME_ZERO; ///< Propagation delay to this destination
+    simtime_t duration = SIMTIME_ZERO;   ///< Transmission duration as seen by this destination; zero means unspecified
+};
+
 /**
  * @brief Base class for all simple module classes.
  *
@@ -502,6 +513,26 @@ class SIM_API cSimpleModule : public cModule //implies noncopyable
      * Utility function, roughly equivalent to sendDirect(msg, SendOptions().propagationDelay(delay).duration(duration), inputGate).
      */
     virtual void sendDirect(cMessage *msg, simtime_t propagationDelay, simtime_t duration, cGate *inputGate) {sendDirect(msg, resolveSendDirectOptions(propagationDelay, duration), inputGate);}
+
+    /**
+     * Sends the packet directly to several modules, with a per-destination
+     * propagation delay and duration. This is useful for modeling broadcast
+     * media (wireless channels, buses), where the same frame needs to be
+     * delivered to a large number of receivers.
+     *
+     * Every destination receives its own packet object, but only the outermost
+     * packet is copied: the encapsulated packets are shared among the copies
+     * via reference counting (see cPacket::encapsulate()), and each receiver
+     * only gets a private copy of an encapsulated packet when it accesses it
+     * for modification (getEncapsulatedPacket(), decapsulate()). Read-only
+     * access is possible with cPacket::peekEncapsulatedPacket() without
+     * triggering a copy. The last destination receives the original object.
+     *
+     * Each send is equivalent to sendDirect(copy, SendOptions().propagationDelay(delay).duration(duration), gate),
+     * so the rules of sendDirect() apply to every target gate. If the target
+     * list is empty, the packet is deleted.
+     */
+    virtual void sendDirectMulticast(cPacket *pkt, const std::vector<SendDirectTarget>& targets);
     //@}
 
     /** @name Self-messages. */
@@ -55,6 +55,7 @@ class cIEventLoopRunner;
 
 namespace internal {
 class Stopwatch;
+class HardwareCounters;
 }
 
 SIM_API extern OPP_THREAD_LOCAL cSoftOwner globalOwningContext; // also in globals.h
@@ -152,6 +153,7 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
     simtime_t simTimeLimit = 0;         // simulation time limit (0 -> no limit)
     cEvent *endSimulationEvent = nullptr; // only present if simulation time limit is set
     internal::Stopwatch *stopwatch;        // elapsed time, CPU usage time, and related time limits
+    internal::HardwareCounters *hardwareCounters = nullptr; // per-event hardware performance counters; only if enabled
 
     State state = SIM_NONETWORK;        // simulation state
     Stage stage = STAGE_NONE;           // what the simulation is currently doing
@@ -164,6 +166,7 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
     bool trapOnNextEvent = false;  // when set, next handleMessage or activity() will execute debugger interrupt
 
     bool parameterMutabilityCheck = true;  // when disabled, module parameters can be set without them being declared @mutable
+    bool resultRecorderFusion = true;      // whether cStatisticBuilder may feed groups of built-in recorders from one listener
 
     cFingerprintCalculator *fingerprint = nullptr; // used for fingerprint calculation
 
@@ -221,6 +224,8 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
     static void setEnvirFactoryFunction(EnvirFactoryFunction f);
     void setParameterMutabilityCheck(bool b) {parameterMutabilityCheck = b;}
     bool getParameterMutabilityCheck() const {return parameterMutabilityCheck;}
+    void setResultRecorderFusion(bool b) {resultRecorderFusion = b;}
+    bool getResultRecorderFusion() const {return resultRecorderFusion;}
     void setUniqueNumberRange(uint64_t start, uint64_t end) {nextUniqueNumber = start; uniqueNumbersEnd = end;}
     void printUnusedConfigEntriesIfAny(std::ostream& out);
 
@@ -511,6 +516,14 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
      */
     cFingerprintCalculator *getFingerprintCalculator() {return fingerprint;}  // note: intentionally non-virtual
 
+    /**
+     * Returns the object that collects per-event hardware performance counter
+     * data (`hardware-counters=true`), or nullptr if it is not enabled. The
+     * returned object is internal; it is used by the user interfaces for
+     * printing a report.
+     */
+    internal::HardwareCounters *getHardwareCounters() const {return hardwareCounters;}
+
     /**
      * Sets the simulation stop time be scheduling an appropriate
      * "end-simulation" event. Supply zero to clear an existing simulation
@@ -553,6 +566,19 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
      */
     virtual void callInitialize();
 
+    /**
+     * Makes the network currently set up continue as the run described by
+     * the given configuration. It is meant for sharing network setup (and
+     * possibly initialization and a warm-up period) among the repetitions
+     * of a configuration, e.g. by forking the process. The new configuration
+     * may only differ from the current one in run identification and seeds
+     * (repetition, seed-set, run ID, result file names); the RNGs are re-seeded,
+     * result recording is re-targeted to the new run, and hardware counters
+     * (if enabled) are restarted, but other settings are not re-read.
+     * Not supported with parallel simulation and with fingerprint checking.
+     */
+    virtual void switchRun(cConfiguration *cfg);
+
     /**
      * Recursively calls finish() on the modules of the network.
      * This method simply invokes callFinish() on the system module.
@@ -0,0 +1,128 @@
+//==========================================================================
+//  CSTATESAVING.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_CSTATESAVING_H
+#define __OMNETPP_CSTATESAVING_H
+
+#include <deque>
+#include <functional>
+#include "simkerneldefs.h"
+
+namespace omnetpp {
+
+/**
+ * @brief Incremental state saving for models that are run under an optimistic
+ * parallel simulation protocol (see cOptimisticProtocol).
+ *
+ * An optimistic protocol executes events speculatively, and when it turns out
+ * that an event was executed too early, it rolls back the state of the
+ * partition to before that event. The simulation kernel takes care of the
+ * future events, the messages being delivered and the random number
+ * generators, but the state of the modules is only known to the modules
+ * themselves. Modules need to announce the changes they make to their state
+ * during event processing, by calling saveState() before assigning to a
+ * state variable, or by registering an arbitrary undo action with
+ * addUndoAction():
+ *
+ * <pre>
+ * void Queue::handleMessage(cMessage *msg)
+ * {
+ *     cStateSaving::saveState(numJobs);
+ *     numJobs++;
+ *     queue.insert(msg);
+ *     cStateSaving::addUndoAction([this,msg]() {queue.remove(msg);});
+ *     ...
+ * }
+ * </pre>
+ *
+ * Undo actions are run in reverse order, in the context of the module
+ * that recorded them (so e.g. objects removed from a container go back to
+ * the module). They should restore the module state but must not send,
+ * schedule or cancel messages: the simulation kernel restores the future
+ * event set, including the self-messages cancelled by the rolled back
+ * events. The message delivered in a rolled back event should be back in
+ * the possession of the module after its undo actions have run; otherwise
+ * the kernel puts a copy of it (made at the time of delivery) back into the
+ * future event set instead.
+ *
+ * When the simulation is not run under an optimistic protocol (which is
+ * always the case in sequential simulation), no undo log is installed,
+ * and the above calls return immediately.
+ *
+ * @ingroup SimSupport
+ */
+class SIM_API cStateSaving
+{
+  public:
+    /**
+     * An undo action: restores a piece of state to its earlier value.
+     */
+    typedef std::function<void()> UndoAction;
+
+    /**
+     * The log of undo actions, maintained by the optimistic parallel
+     * simulation protocol.
+     */
+    typedef std::deque<UndoAction> UndoLog;
+
+  private:
+    static OPP_THREAD_LOCAL UndoLog *undoLog;
+
+  public:
+    /**
+     * Returns true if state changes are currently being recorded, i.e. the
+     * simulation is run under an optimistic parallel simulation protocol.
+     */
+    static bool isRecording() {return undoLog != nullptr;}
+
+    /**
+     * Records the current value of the given variable, so that it can be
+     * restored if the event being processed is rolled back. Call it before
+     * modifying the variable. The type must be copy-assignable.
+     */
+    template <typename T>
+    static void saveState(T& var) {
+        if (undoLog)
+            undoLog->push_back([&var, saved = var]() {var = saved;});
+    }
+
+    /**
+     * Registers an action to be run if the event being processed is rolled
+     * back, e.g. removing an object from a container it has been inserted into.
+     */
+    static void addUndoAction(UndoAction action) {
+        if (undoLog)
+            undoLog->push_back(std::move(action));
+    }
+
+    /** @name Internal methods, used by the parallel simulation kernel. */
+    //@{
+    /**
+     * Installs the undo log where the above methods record into. nullptr
+     * turns off recording. Returns the previously installed log.
+     */
+    static UndoLog *setUndoLog(UndoLog *log);
+
+    /**
+     * Returns the installed undo log, or nullptr if there is none.
+     */
+    static UndoLog *getUndoLog() {return undoLog;}
+    //@}
+};
+
+}  // namespace omnetpp
+
+
+#endif
@@ -28,6 +28,7 @@ extern const char *PROPKEY_STATISTIC_CHECKSIGNALS;
 class cConfiguration;
 class cComponent;
 class cResultListener;
+class cResultRecorder;
 
 struct SignalSource;
 
@@ -79,6 +80,8 @@ class SIM_API cStatisticBuilder
         std::vector<std::string> extractRecorderList(const char *modesOption, cProperty *statisticProperty);
         SignalSource doStatisticSource(cComponent *component, cProperty *statisticProperty, const char *statisticName, const char *sourceSpec, TristateBool checkSignalDecl, bool needWarmupFilter);
         void doResultRecorder(const SignalSource& source, const char *mode, cComponent *component, const char *statisticName, cProperty *attrsProperty);
+        cResultRecorder *createFusibleRecorder(const char *mode, cComponent *component, const char *statisticName, cProperty *attrsProperty);
+        void doFusedRecorders(const SignalSource& source, std::vector<cResultRecorder *>& recorders, cComponent *component, cProperty *attrsProperty);
         TristateBool parseTristateBool(const char *s, const char *what);
 
         static void dumpResultRecorderChain(std::ostream& out, cResultListener *listener, int depth);
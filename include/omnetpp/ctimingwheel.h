@@ -0,0 +1,229 @@
+//==========================================================================
+//  CTIMINGWHEEL.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_CTIMINGWHEEL_H
+#define __OMNETPP_CTIMINGWHEEL_H
+
+#include <vector>
+#include "cfutureeventset.h"
+
+namespace omnetpp {
+
+/**
+ * @brief Future event set implementation based on a hierarchical timing wheel,
+ * for models that schedule and cancel large numbers of near-future timers.
+ *
+ * Simulation time is divided into ticks of a configurable resolution
+ * (`timingwheel-resolution`). Events that fall within the horizon of the wheel
+ * (`timingwheel-horizon`, rounded up to a power of 256 ticks) are stored in
+ * the buckets of a multi-level wheel, where both insertion and cancellation
+ * are O(1). Buckets of the upper levels are redistributed into the lower
+ * levels as simulation time reaches them. Events beyond the horizon are stored
+ * in a binary heap, and moved into the wheel when the wheel runs empty.
+ *
+ * The events of the current tick are kept in a small binary heap, so the
+ * order of event execution is exactly the same as with cEventHeap: by arrival
+ * time, then by scheduling priority, then by insertion order.
+ *
+ * To use it, add `futureeventset-class = omnetpp::cTimingWheel` to the
+ * configuration.
+ *
+ * @ingroup SimCore
+ */
+class SIM_API cTimingWheel : public cFutureEventSet
+{
+  private:
+    struct Heap {
+        cEvent **items = nullptr;  // heap array (items[0] always empty)
+        int length = 0;            // number of elements on the heap
+        int capacity = 0;          // allocated size of the items[] array
+    };
+
+    // parameters
+    double resolution;             // tick length in seconds
+    double horizon;                // span of the wheel in seconds
+    int64_t tickSize = 0;          // tick length in raw simtime units; 0 if not yet computed
+    int numLevels = 0;             // number of levels in the wheel
+
+    // data structure
+    int64_t curTick = 0;           // front contains events up to and including this tick, wheel and far contain later ones
+    Heap front;                    // events at or before the current tick
+    Heap far;                      // events beyond the horizon of the wheel
+    std::vector<std::vector<cEvent*>> buckets; // numLevels*256 buckets of the wheel
+    std::vector<uint64_t> occupancy; // bitmap of non-empty buckets, 4 words per level
+    int wheelLength = 0;           // number of events in the wheel
+    std::vector<cEvent*> cascadeBuffer;
+    eventnumber_t insertCount = 0; // counts insertions, to keep insertion order for events with equal time and priority
+
+    // cache for get(k)
+    int cachedBucket = -1;
+    int cachedBase = 0;
+
+  private:
+    void copy(const cTimingWheel& other);
+    void setupWheel();
+    int64_t tickOf(const cEvent *event) const;
+    void place(cEvent *event);
+    void advance();
+    int findOccupiedSlot(int level, int from) const;
+
+    void heapInsert(Heap& heap, int tag, cEvent *event);
+    cEvent *heapRemove(Heap& heap, int tag, int pos);
+    void heapSort(Heap& heap, int tag);
+    void wheelInsert(int level, int slot, cEvent *event);
+    void wheelRemove(cEvent *event);
+    cEvent *wheelGet(int k);
+
+  public:
+    /** @name Constructors, destructor, assignment */
+    //@{
+
+    /**
+     * Copy constructor.
+     */
+    cTimingWheel(const cTimingWheel& other);
+
+    /**
+     * Constructor. Resolution and horizon are in seconds.
+     */
+    cTimingWheel(const char *name=nullptr, double resolution=1e-6, double horizon=1);
+
+    /**
+     * Destructor.
+     */
+    virtual ~cTimingWheel();
+
+    /**
+     * Assignment operator. The name member is not copied;
+     * see cOwnedObject's operator=() for more details.
+     */
+    cTimingWheel& operator=(const cTimingWheel& other);
+    //@}
+
+    /** @name Redefined cObject member functions. */
+    //@{
+
+    /**
+     * Creates and returns an exact copy of this object.
+     * See cObject for more details.
+     */
+    virtual cTimingWheel *dup() const override  {return new cTimingWheel(*this);}
+
+    /**
+     * Produces a one-line description of the object's contents.
+     * See cObject for more details.
+     */
+    virtual std::string str() const override;
+
+    /**
+     * Calls v->visit(this) for each contained object.
+     * See cObject for more details.
+     */
+    virtual void forEachChild(cVisitor *v) override;
+    //@}
+
+    /** @name Configuration. */
+    //@{
+    /**
+     * Reads the resolution and the horizon of the wheel from the configuration.
+     */
+    virtual void configure(cSimulation *simulation, cConfiguration *cfg) override;
+
+    /**
+     * Sets the tick length and the span of the wheel, in seconds. This may
+     * only be called while the FES is empty.
+     */
+    void setParameters(double resolution, double horizon);
+
+    /**
+     * Returns the tick length in seconds.
+     */
+    double getResolution() const {return resolution;}
+
+    /**
+     * Returns the configured horizon in seconds.
+     */
+    double getHorizon() const {return horizon;}
+    //@}
+
+    /** @name Simulation-related operations. */
+    //@{
+    /**
+     * Insert an event into the FES.
+     */
+    virtual void insert(cEvent *event) override;
+
+    /**
+     * Peek the first event in the FES (the one with the smallest timestamp.)
+     * If the FES is empty, it returns nullptr.
+     */
+    virtual cEvent *peekFirst() const override;
+
+    /**
+     * Removes and return the first event in the FES (the one with the
+     * smallest timestamp.) If the FES is empty, it returns nullptr.
+     */
+    virtual cEvent *removeFirst() override;
+
+    /**
+     * Undo for removeFirst(): it puts back an event to the front of the FES.
+     */
+    virtual void putBackFirst(cEvent *event) override;
+
+    /**
+     * Removes and returns the given event in the FES. If the event is
+     * not in the FES, returns nullptr.
+     */
+    virtual cEvent *remove(cEvent *event) override;
+
+    /**
+     * Returns true if the FES is empty.
+     */
+    virtual bool isEmpty() const override {return front.length == 0 && wheelLength == 0 && far.length == 0;}
+
+    /**
+     * Deletes all events in the FES.
+     */
+    virtual void clear() override;
+    //@}
+
+    /** @name Random access. */
+    //@{
+
+    /**
+     * Returns the number of events in the FES.
+     */
+    virtual int getLength() const override {return front.length + wheelLength + far.length;}
+
+    /**
+     * Returns the kth event in the FES if 0 <= k < getLength(), and nullptr
+     * otherwise. Events are returned in increasing timestamp order if sort()
+     * was called after the last mutating operation.
+     */
+    virtual cEvent *get(int k) override;
+
+    /**
+     * Sorts the contents of the FES. This is only necessary if one wants
+     * to iterate through in the FES in strict timestamp order.
+     */
+    virtual void sort() override;
+    //@}
+};
+
+}  // namespace omnetpp
+
+
+#endif
+
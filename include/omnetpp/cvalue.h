@@ -16,6 +16,7 @@
 #ifndef __OMNETPP_CVALUE_H
 #define __OMNETPP_CVALUE_H
 
+#include <new>
 #include <string>
 #include "simkerneldefs.h"
 #include "cexception.h"
@@ -41,6 +42,16 @@ class cDynamicExpression;
  * on top of that. If the pointer points to an object, the object's ownership
  * is unaffected, and the object is never deleted or cloned by cValue.
  *
+ * <b>Storage</b>
+ *
+ * cValue is kept compact (24 bytes on 64-bit platforms) because large numbers
+ * of them are created and copied during expression evaluation and in
+ * cValueArray/cValueMap. Payloads of the different types share storage.
+ * Measurement units are stored as pointers into the static string pool.
+ * String values are immutable and reference counted, so copying a STRING
+ * value does not copy the characters, and the empty string does not
+ * allocate at all.
+ *
  * @see cDynamicExpression, cNedFunction, Define_NED_Function()
  * @ingroup Expressions
  */
@@ -64,32 +75,54 @@ class SIM_API cValue
         DBL OPP_DEPRECATED_ENUMERATOR("renamed to DOUBLE") = DOUBLE,
         STR OPP_DEPRECATED_ENUMERATOR("renamed to STRING") = STRING
     };
-    Type type;
+    Type type = UNDEF;
 
   private:
-    bool bl;
-    intval_t intv;
-    double dbl;
-    opp_staticpooledstring unit = nullptr; // for INT/DOUBLE; may be nullptr
-    std::string s;
-    any_ptr ptr;
+    // unit ID of num.unit (see UnitConversion::getUnitId()), resolved on first
+    // use; occupies padding after 'type', so it does not increase the size
+    static const short UNITID_UNRESOLVED = -2;
+    mutable short unitId = UNITID_UNRESOLVED;
+
+    struct StringData; // immutable, reference counted; defined in cvalue.cc
+    struct Number {
+        union {
+            intval_t intv;
+            double dbl;
+        };
+        const char *unit; // pooled (see opp_staticpooledstring); may be nullptr
+    };
+    union {
+        bool bl;
+        Number num;     // INT, DOUBLE
+        StringData *sd; // STRING; nullptr means the empty string
+        any_ptr ptr;
+    };
     static const char *OVERFLOW_MSG;
 
   private:
+    void destroy() {if (type==STRING) releaseString();}
+    void releaseString();
+    void copyFrom(const cValue& other);
+    void moveFrom(cValue& other) noexcept;
+    static const char *poolUnit(const char *unit) {return unit ? opp_staticpooledstring::get(unit) : nullptr;}
 #ifdef NDEBUG
     void assertType(Type) const {}
 #else
     void assertType(Type t) const {if (type!=t) cannotCastError(t);}
 #endif
     [[noreturn]] void cannotCastError(Type t) const;
+    int getUnitId() const;
   public:
     // internal, for inspectors only:
     static cObject *getContainedObject(const cValue *p);
 
+    // internal: like doubleValueInUnit(), but with the ID of the target unit (see UnitConversion::getUnitId()) already known
+    double doubleValueInUnit(const char *targetUnit, int targetUnitId) const;
+
   public:
     /** @name Constructors */
     //@{
-    cValue()  {type=UNDEF;}
+    cValue()  {}
     cValue(bool b)  {set(b);}
     cValue(int l)  {set((intval_t)l);}
     cValue(int l, const char *unit)  {set((intval_t)l, unit);}
@@ -103,7 +136,9 @@ class SIM_API cValue
     cValue(any_ptr ptr)  {set(ptr);}
     cValue(cObject *obj)  {set(obj);}
     cValue(const void *) = delete; // prevent non-cObject pointers from silently being converted to bool
-    cValue(const cValue&) = default;
+    cValue(const cValue& other)  {copyFrom(other);}
+    cValue(cValue&& other) noexcept  {moveFrom(other);}
+    ~cValue()  {destroy();}
     //@}
 
     /**
@@ -111,6 +146,12 @@ class SIM_API cValue
      */
     void operator=(const cValue& other);
 
+    /**
+     * Move assignment. String contents are transferred without copying,
+     * and the other object is left in the UNDEF state.
+     */
+    void operator=(cValue&& other) noexcept;
+
     /** @name Type, unit conversion and misc. */
     //@{
     /**
@@ -184,14 +225,14 @@ class SIM_API cValue
     /**
      * Sets the value to the given bool value.
      */
-    void set(bool b) {type=BOOL; bl=b;}
+    void set(bool b) {destroy(); type=BOOL; bl=b;}
 
     /**
      * Sets the value to the given integer value and measurement unit (optional).
      * The unit string pointer is expected to stay valid during the entire
      * duration of the simulation (see related class comment).
      */
-    void set(intval_t l, const char *unit=nullptr) {type=INT; intv=l; this->unit=unit;}
+    void set(intval_t l, const char *unit=nullptr) {destroy(); type=INT; num.intv=l; num.unit=poolUnit(unit); unitId=UNITID_UNRESOLVED;}
 
     /**
      * Sets the value to the given integer value and measurement unit (optional).
@@ -206,19 +247,19 @@ class SIM_API cValue
      * The unit string pointer is expected to stay valid during the entire
      * duration of the simulation (see related class comment).
      */
-    void set(double d, const char *unit=nullptr) {type=DOUBLE; dbl=d; this->unit=unit;}
+    void set(double d, const char *unit=nullptr) {destroy(); type=DOUBLE; num.dbl=d; num.unit=poolUnit(unit); unitId=UNITID_UNRESOLVED;}
 
     /**
      * Sets the value to the given integer value, preserving the current
      * measurement unit. The object must already have the INT type.
      */
-    void setPreservingUnit(intval_t l) {assertType(INT); intv=l;}
+    void setPreservingUnit(intval_t l) {assertType(INT); num.intv=l;}
 
     /**
      * Sets the value to the given double value, preserving the current
      * measurement unit. The object must already have the DOUBLE type.
      */
-    void setPreservingUnit(double d) {assertType(DOUBLE); dbl=d;}
+    void setPreservingUnit(double d) {assertType(DOUBLE); num.dbl=d;}
 
     /**
      * Sets the measurement unit to the given value, leaving the numeric part
@@ -249,24 +290,24 @@ class SIM_API cValue
      * Sets the value to the given string value. The string itself will be
      * copied. nullptr is also accepted and treated as an empty string.
      */
-    void set(const char *s) {type=STRING; this->s=s?s:"";}
+    void set(const char *s);
 
     /**
      * Sets the value to the given string value.
      */
-    void set(const std::string& s) {type=STRING; this->s=s;}
+    void set(const std::string& s);
 
     /**
      * Sets the value to the given string value.
      */
-    void set(const opp_string& s) {type=STRING; this->s=s.c_str();}
+    void set(const opp_string& s) {set(s.c_str());}
 
     /**
      * Sets the value to the given pointer. The pointer is treated by
      * as an opaque value: If it points to an object, the object's ownership
      * is unaffected, and cValue will never delete or clone the object.
      */
-    void set(any_ptr ptr) {type=POINTER; this->ptr=ptr;}
+    void set(any_ptr ptr) {destroy(); type=POINTER; new (&this->ptr) any_ptr(ptr);}
 
     /**
      * Sets the value to the given object, via set(any_ptr). Note that
@@ -336,17 +377,17 @@ class SIM_API cValue
      * Returns the unit ("s", "mW", "Hz", "bps", etc), or nullptr if there was no
      * unit was specified. Unit is only valid for the DOUBLE and INT types.
      */
-    const char *getUnit() const {return (type==DOUBLE || type==INT) ? unit.c_str() : nullptr;}
+    const char *getUnit() const {return (type==DOUBLE || type==INT) ? num.unit : nullptr;}
 
     /**
      * Returns value as const char *. The type must be STRING.
      */
-    const char *stringValue() const {assertType(STRING); return s.c_str();}
+    const char *stringValue() const {assertType(STRING); return stdstringValue().c_str();}
 
     /**
      * Returns value as std::string. The type must be STRING.
      */
-    const std::string& stdstringValue() const {assertType(STRING); return s;}
+    const std::string& stdstringValue() const;
 
     /**
      * Returns value as any_ptr. The type must be POINTER.
@@ -29,6 +29,8 @@ namespace omnetpp {
 class cXMLElement;
 class cModule;
 
+namespace internal { class XMLElementIndex; class MiniXPath; }
+
 /**
  * @brief A list of XML elements. Used with cXMLElement.
  */
@@ -75,6 +77,7 @@ typedef std::map<std::string,std::string> cXMLAttributeMap;
 class SIM_API cXMLElement : public cOwnedObject
 {
     friend class cXMLElementDescriptor; // getAttr(i), getChild(i), etc.
+    friend class internal::MiniXPath; // getIndex()
 
   public:
     /**
@@ -103,9 +106,12 @@ class SIM_API cXMLElement : public cOwnedObject
     cXMLElement *prevSibling = nullptr;
     cXMLElement *nextSibling = nullptr;
     FileLine loc;
+    mutable internal::XMLElementIndex *index = nullptr; // only in the top element of the tree; built on demand
 
   private:
      void doGetElementsByTagName(const char *tagname, cXMLElementList& list) const;
+     internal::XMLElementIndex *getIndex() const;
+     void invalidateIndex();
 
   public:
     // internal: constructor
@@ -127,6 +133,9 @@ class SIM_API cXMLElement : public cOwnedObject
 
     virtual void setTagName(const char *tagName) {setName(tagName);}
 
+    // internal: sets the tag name
+    virtual void setName(const char *name) override;
+
     // internal: sets source location
     virtual void setSourceLocation(const char *fname, int line);
 
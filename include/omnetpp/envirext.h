@@ -103,6 +103,15 @@ class SIM_API cIOutputVectorManager : public cObject, public cISimulationLifecyc
      * Closes collecting. Called at the end of a simulation run.
      */
     virtual void endRun() = 0;
+
+    /**
+     * Makes the object record the results of the run described by the given
+     * configuration instead of the one it was configured with. The new
+     * configuration may only differ from the old one in run identification
+     * (repetition, seed-set, run ID, result file names). This is only allowed
+     * before any output vector data has been written. The default implementation throws an error.
+     */
+    virtual void switchRun(cConfiguration *cfg);
     //@}
 
     /** @name Output vectors. */
@@ -138,6 +147,16 @@ class SIM_API cIOutputVectorManager : public cObject, public cISimulationLifecyc
      */
     virtual bool record(void *vechandle, simtime_t t, double value) = 0;
 
+    /**
+     * Write several values into the output vector. Timestamps are in increasing
+     * order. Returns the number of values actually recorded. This default
+     * implementation calls record() for each value; output vector managers
+     * that buffer data may override it to store the values as a block.
+     *
+     * Calling recordMany() is only allowed between startRun() and endRun().
+     */
+    virtual int recordMany(void *vechandle, const simtime_t *times, const double *values, int n);
+
     /**
      * Returns the output vector file name. Returns nullptr if this object is not
      * producing file output.
@@ -218,6 +237,15 @@ class SIM_API cIOutputScalarManager : public cObject, public cISimulationLifecyc
      * Closes collecting. Called at the end of a simulation run.
      */
     virtual void endRun() = 0;
+
+    /**
+     * Makes the object record the results of the run described by the given
+     * configuration instead of the one it was configured with. The new
+     * configuration may only differ from the old one in run identification
+     * (repetition, seed-set, run ID, result file names). This is only allowed
+     * before any scalar has been written. The default implementation throws an error.
+     */
+    virtual void switchRun(cConfiguration *cfg);
     //@}
 
     /** @name Scalar statistics. */
@@ -328,6 +356,15 @@ class SIM_API cISnapshotManager : public cObject, public cISimulationLifecycleLi
      * Called at the end of a simulation run.
      */
     virtual void endRun() = 0;
+
+    /**
+     * Makes the object record the results of the run described by the given
+     * configuration instead of the one it was configured with. The new
+     * configuration may only differ from the old one in run identification
+     * (repetition, seed-set, run ID, result file names). This is only allowed
+     * before any snapshot has been written. The default implementation throws an error.
+     */
+    virtual void switchRun(cConfiguration *cfg);
     //@}
 
     /** @name Snapshot management */
@@ -55,6 +55,9 @@ void AbstractQueue::initialize()
 
 void AbstractQueue::handleMessage(cMessage *msg)
 {
+    // record state changes, for optimistic parallel simulation (no-op otherwise)
+    cStateSaving::saveState(msgServiced);
+
     if (msg == endServiceMsg) {
         endService(msgServiced);
         if (queue.isEmpty()) {
@@ -62,6 +65,13 @@ void AbstractQueue::handleMessage(cMessage *msg)
         }
         else {
             msgServiced = (cMessage *)queue.pop();
+            cMessage *job = msgServiced;
+            cStateSaving::addUndoAction([this,job]() {
+                if (queue.isEmpty())
+                    queue.insert(job);
+                else
+                    queue.insertBefore(queue.front(), job);
+            });
             queueLength.record(queue.getLength());
             simtime_t serviceTime = startService(msgServiced);
             endServiceMsg->setSchedulingPriority(priority);
@@ -78,6 +88,7 @@ void AbstractQueue::handleMessage(cMessage *msg)
     else {
         arrival(msg);
         queue.insert(msg);
+        cStateSaving::addUndoAction([this,msg]() {queue.remove(msg);});
         queueLength.record(queue.getLength());
     }
 }
@@ -94,8 +105,12 @@ void AbstractQueue::refreshDisplay() const
  */
 class Queue : public AbstractQueue
 {
+  protected:
+    long numJobsServed = 0;
+
   public:
     virtual void initialize() override;
+    virtual void finish() override;
 
     virtual simtime_t startService(cMessage *msg) override;
     virtual void endService(cMessage *msg) override;
@@ -122,6 +137,11 @@ void Queue::initialize()
     }
 }
 
+void Queue::finish()
+{
+    recordScalar("jobs served", numJobsServed);
+}
+
 simtime_t Queue::startService(cMessage *msg)
 {
     EV << "Starting service of " << msg->getName() << endl;
@@ -131,6 +151,8 @@ simtime_t Queue::startService(cMessage *msg)
 void Queue::endService(cMessage *msg)
 {
     EV << "Completed service of " << msg->getName() << endl;
+    cStateSaving::saveState(numJobsServed);
+    numJobsServed++;
     msg->setSchedulingPriority(priority);
     send(msg, "out");
 }
@@ -17,6 +17,7 @@
 #include "cmdenvnarrator.h"
 #include "omnetpp/checkandcast.h"
 #include "omnetpp/ccomponenttype.h"
+#include "sim/hwcounters.h"
 
 namespace omnetpp {
 namespace cmdenv {
@@ -34,6 +35,22 @@ void CmdenvNarrator::usingThreads(int numThreads)
         out << "Running simulations on " << numThreads << " threads\n";
 }
 
+void CmdenvNarrator::usingProcesses(int numProcesses)
+{
+    if (verbose)
+        out << "Running repetitions in at most " << numProcesses << " worker processes at a time\n";
+}
+
+void CmdenvNarrator::forking(const char *configName, const std::vector<int>& runNumbers)
+{
+    if (verbose) {
+        out << "\nForking worker processes for configuration " << configName << ", runs";
+        for (int runNumber : runNumbers)
+            out << " #" << runNumber;
+        out << "..." << endl;
+    }
+}
+
 void CmdenvNarrator::preparing(const char *configName, int runNumber)
 {
     if (verbose)
@@ -104,6 +121,7 @@ void CmdenvNarrator::simulationLifecycleEvent(cSimulation *simulation, std::ofst
             case LF_PRE_NETWORK_INITIALIZE: simout << "Initializing..." << endl; break;
             case LF_ON_SIMULATION_START: simout << "\nRunning simulation..." << endl; break;
             case LF_PRE_NETWORK_FINISH: simout << "\nCalling finish() at end of Run #" << simulation->getConfig()->getVariable(CFGVAR_RUNNUMBER) << "..." << endl; break;
+            case LF_POST_NETWORK_FINISH: if (simulation->getHardwareCounters()) simulation->getHardwareCounters()->printReport(simout); break;
             case LF_ON_SIMULATION_SUCCESS: simout << "\n<!> " << check_and_cast<cException*>(details)->getFormattedMessage() << endl; break;
             case LF_ON_SIMULATION_ERROR: simout << "\n<!> " << check_and_cast<cException*>(details)->getFormattedMessage() << endl; break;
             default: break;
@@ -23,6 +23,13 @@
 #include <sstream>
 #include <thread>
 
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
 #include "cmddefs.h"
 #include "cmdenvapp.h"
 #include "common/fileutil.h"
@@ -57,7 +64,9 @@ namespace cmdenv {
 Register_GlobalConfigOption(CFGID_CMDENV_CONFIG_NAME, "cmdenv-config-name", CFG_STRING, nullptr, "Specifies the name of the configuration to be run (for a value `Foo`, section `[Config Foo]` will be used from the ini file). See also `cmdenv-runs-to-execute`. The `-c` command line option overrides this setting.")
 Register_GlobalConfigOption(CFGID_CMDENV_RUNS_TO_EXECUTE, "cmdenv-runs-to-execute", CFG_STRING, nullptr, "Specifies which runs to execute from the selected configuration (see `cmdenv-config-name` option). It accepts a filter expression of iteration variables such as `$numHosts>10 && $iatime==1s`, or a comma-separated list of run numbers or run number ranges, e.g. `1,3..4,7..9`. If the value is missing, CmdenvCore executes all runs in the selected configuration. The `-r` command line option overrides this setting.")
 Register_GlobalConfigOption(CFGID_CMDENV_STOP_BATCH_ON_ERROR, "cmdenv-stop-batch-on-error", CFG_BOOL, "true", "Decides whether CmdenvCore should skip the rest of the runs when an error occurs during the execution of one run.")
-Register_GlobalConfigOption(CFGID_CMDENV_NUM_THREADS, "cmdenv-num-threads", CFG_INT, "1", "Specifies the number of threads to use when running multiple simulations is requested. (Each simulation will still run sequentially in its thread.) When -1 is given, the number of concurrent threads supported by the hardware will be used.");
+Register_GlobalConfigOption(CFGID_CMDENV_NUM_THREADS, "cmdenv-num-threads", CFG_INT, "1", "Specifies the number of threads to use when running multiple simulations is requested. (Each simulation will still run sequentially in its thread.) When -1 is given, the number of concurrent threads supported by the hardware will be used. With `cmdenv-fork-repetitions=true`, it limits the number of concurrently running worker processes instead.");
+Register_GlobalConfigOption(CFGID_CMDENV_FORK_REPETITIONS, "cmdenv-fork-repetitions", CFG_BOOL, "false", "When enabled, runs that only differ in the repetition share the network setup: the network is set up (and possibly initialized and run for a while, see `cmdenv-fork-point`) only once, and the repetitions continue in worker processes forked from that state, each with the seeds and result files of its own run. Repetitions whose configuration also differs in other settings (e.g. because a parameter refers to `${repetition}` or `${runnumber}`) do not share the network setup. The number of concurrently running worker processes is limited by `cmdenv-num-threads`. Note that random numbers drawn before the fork point are shared among the repetitions. Not supported on Windows, and together with parallel simulation, eventlog recording and fingerprint checking.");
+Register_GlobalConfigOption(CFGID_CMDENV_FORK_POINT, "cmdenv-fork-point", CFG_STRING, "initialize", "When `cmdenv-fork-repetitions=true`: the point at which worker processes are forked. Accepted values are `setup` (after setting up the network), `initialize` (after initializing it), or a simulation time such as `100s`, meaning that events before that time are also executed only once. No results may be recorded before the fork point; consider setting `warmup-period` accordingly.");
 
 Register_GlobalConfigOption(CFGID_CMDENV_OUTPUT_FILE, "cmdenv-output-file", CFG_FILENAME, "${resultdir}/${configname}-${iterationvarsf}#${repetition}.out", "When `cmdenv-record-output=true`: file name to redirect standard output to. See also `fname-append-host`.")
 Register_GlobalConfigOption(CFGID_CMDENV_REDIRECT_OUTPUT, "cmdenv-redirect-output", CFG_BOOL, "false", "Causes Cmdenv to redirect standard output of simulation runs to a file or separate files per run. This option can be useful with running simulation campaigns (e.g. using opp_runall), and also with parallel simulation. See also: `cmdenv-output-file`, `fname-append-host`.");
@@ -120,19 +129,26 @@ CmdenvSimulationRunner::BatchResult CmdenvSimulationRunner::runParameterStudy(In
 
     cConfiguration *masterCfg = ini->extractConfig(configName, runNumbers[0]);
     int numThreads = masterCfg->getAsInt(CFGID_CMDENV_NUM_THREADS);
+    bool forkRepetitions = masterCfg->getAsBool(CFGID_CMDENV_FORK_REPETITIONS);
     delete masterCfg;
 
-    bool threaded = numThreads != 1;
+    bool threaded = numThreads != 1 && !forkRepetitions;
 
 #if defined(_WIN32) && defined(WITH_SHARED_LIBS)
     if (threaded)
         throw cRuntimeError("Multi-threaded execution is not supported on Windows when the simulation library is built as a DLL.");
 #endif
+#ifdef _WIN32
+    if (forkRepetitions)
+        throw cRuntimeError("Forking repetitions (cmdenv-fork-repetitions=true) is not supported on Windows");
+#endif
 
     BatchResult result;
     result.numRuns = (int)runNumbers.size();
 
-    if (!threaded)
+    if (forkRepetitions)
+        result = runSimulationsForked(ini, configName, runNumbers, numThreads); // does not throw
+    else if (!threaded)
         result = runSimulations(ini, configName, runNumbers); // does not throw
     else
         result = runSimulationsInThreads(ini, configName, runNumbers, numThreads); // does not throw
@@ -312,6 +328,298 @@ cTerminationException *CmdenvSimulationRunner::setupAndRunSimulation(BatchState&
     }
 }
 
+// Runs the simulation until the next event would occur at or after the given simulation time
+class ForkPointEventLoopRunner : public cIEventLoopRunner
+{
+  private:
+    simtime_t forkTime;
+    bool& sigintReceived;
+
+  public:
+    ForkPointEventLoopRunner(cSimulation *simulation, simtime_t forkTime, bool& sigintReceived) :
+        cIEventLoopRunner(simulation), forkTime(forkTime), sigintReceived(sigintReceived) {}
+    virtual void configure(cConfiguration *cfg) override {}
+    virtual void runEventLoop() override {
+        while (!sigintReceived) {
+            cEvent *event = simulation->guessNextEvent();
+            if (event && event->getArrivalTime() >= forkTime)
+                break;
+            event = simulation->takeNextEvent();
+            if (!event)
+                throw cTerminationException("Scheduler interrupted while waiting");
+            simulation->executeEvent(event);
+        }
+    }
+};
+
+std::string CmdenvSimulationRunner::getForkGroupKey(cConfiguration *cfg)
+{
+    // Runs can only share the network setup if their configurations are identical
+    // except for the settings that cSimulation::switchRun() applies to the forked
+    // process, i.e. the RNG seeds and the result files. Note that entries whose
+    // value refers to ${repetition}, ${runnumber} etc. appear here with the
+    // variables already substituted.
+    static const char *runSpecificKeys[] = {
+        "seed-set", "output-vector-file", "output-scalar-file", "snapshot-file", "cmdenv-output-file", nullptr
+    };
+    std::stringstream os;
+    os << opp_nulltoempty(cfg->getVariable(CFGVAR_ITERATIONVARS)) << "\n";
+    std::vector<const char *> keysValues = cfg->getKeyValuePairs(cConfiguration::FILT_ALL);
+    for (size_t i = 0; i < keysValues.size(); i += 2) {
+        const char *key = keysValues[i];
+        bool isRunSpecific = opp_stringbeginswith(key, "seed-");  // seed-%-mt, seed-%-lcg32, etc.
+        for (const char **p = runSpecificKeys; *p && !isRunSpecific; p++)
+            if (strcmp(key, *p) == 0)
+                isRunSpecific = true;
+        if (!isRunSpecific)
+            os << key << " = " << opp_nulltoempty(keysValues[i+1]) << "\n";
+    }
+    return os.str();
+}
+
+CmdenvSimulationRunner::BatchResult CmdenvSimulationRunner::runSimulationsForked(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int numProcesses)
+{
+    if (numProcesses <= 0) {
+        numProcesses = std::thread::hardware_concurrency();
+        if (numProcesses <= 0)
+            numProcesses = 1;
+    }
+
+    BatchState state;
+    state.numRuns = (int)runNumbers.size();
+
+    // group the runs that only differ in the repetition; each group shares the network setup
+    std::vector<std::vector<int>> groups;
+    try {
+        std::map<std::string,size_t> groupIndex;
+        for (int runNumber : runNumbers) {
+            std::unique_ptr<cConfiguration> cfg(ini->extractConfig(configName, runNumber));
+            std::string groupKey = getForkGroupKey(cfg.get());
+            auto it = groupIndex.find(groupKey);
+            if (it == groupIndex.end()) {
+                it = groupIndex.insert(std::make_pair(groupKey, groups.size())).first;
+                groups.push_back(std::vector<int>());
+            }
+            groups[it->second].push_back(runNumber);
+        }
+    }
+    catch (std::exception& e) {
+        narrator->displayException(e);
+        state.numErrors++;
+        return extractResult(state);
+    }
+
+    narrator->usingProcesses(numProcesses);
+
+    for (const std::vector<int>& group : groups) {
+        doRunRepetitionsForked(state, ini, configName, group, numProcesses);
+        if (sigintReceived || (state.numErrors > 0 && state.stopBatchOnError))
+            break;
+    }
+    return extractResult(state);
+}
+
+void CmdenvSimulationRunner::doRunRepetitionsForked(BatchState& state, InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int numProcesses)
+{
+    int runsTriedBefore = state.runsTried;
+    try {
+        narrator->preparing(configName, runNumbers[0]);
+
+        // set up the network that will be shared by the worker processes
+        std::unique_ptr<cConfiguration> cfg(ini->extractConfig(configName, runNumbers[0]));
+        state.stopBatchOnError = cfg->getAsBool(CFGID_CMDENV_STOP_BATCH_ON_ERROR);
+        std::string forkPoint = cfg->getAsString(CFGID_CMDENV_FORK_POINT);
+
+        ensureNedLoader(cfg.get());
+
+        std::ofstream fout; // not used (there is no redirection in the parent process), but the narrator's listener refers to it
+        std::unique_ptr<cSimulation> tmp(createSimulation(out));
+        cSimulation *simulation = tmp.get();
+
+        std::unique_ptr<cIEventLoopRunner> tmp2(createEventLoopRunner(state, simulation, out, cfg.get()));
+        cIEventLoopRunner *runner = tmp2.get();
+
+        narrator->simulationCreated(simulation, fout);
+
+        cSimulation::setActiveSimulation(simulation);
+
+        try {
+            simulation->setupNetwork(cfg.get());
+
+            if (forkPoint != "setup") {
+                simulation->callInitialize();
+                if (forkPoint != "initialize") {
+                    simtime_t forkTime;
+                    try {
+                        forkTime = SimTime::parse(forkPoint.c_str());
+                    }
+                    catch (std::exception& e) {
+                        throw cRuntimeError("Invalid value '%s' for '%s', expecting 'setup', 'initialize' or a simulation time: %s",
+                                forkPoint.c_str(), CFGID_CMDENV_FORK_POINT->getName(), e.what());
+                    }
+                    ForkPointEventLoopRunner forkPointRunner(simulation, forkTime, sigintReceived);
+                    if (!simulation->run(&forkPointRunner, false))
+                        throw cRuntimeError("Simulation terminated before reaching the fork point t=%s", forkTime.ustr().c_str());
+                }
+            }
+
+            if (!sigintReceived)
+                forkWorkers(state, simulation, runner, ini, configName, runNumbers, numProcesses);
+
+            simulation->deleteNetwork();
+        }
+        catch (cRuntimeError& e) {
+            simulation->deleteNetworkOnError(e);
+            throw;
+        }
+        catch (std::exception& e) {
+            cRuntimeError re(e);
+            simulation->deleteNetworkOnError(re);
+            throw re;
+        }
+    }
+    catch (std::exception& e) {
+        // an error in the shared part fails all runs of the group not yet started
+        narrator->displayException(e);
+        int numNotStarted = (int)runNumbers.size() - (state.runsTried - runsTriedBefore);
+        state.runsTried += numNotStarted;
+        state.numErrors += std::max(numNotStarted, 1);
+    }
+}
+
+void CmdenvSimulationRunner::forkWorkers(BatchState& state, cSimulation *simulation, cIEventLoopRunner *runner, InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int numProcesses)
+{
+#ifdef _WIN32
+    throw cRuntimeError("Forking worker processes is not supported on Windows");
+#else
+    narrator->forking(configName, runNumbers);
+
+    std::map<pid_t,int> workers;  // pid -> run number
+    size_t next = 0;
+    while (!workers.empty() || next < runNumbers.size()) {
+        bool mayStartMore = !sigintReceived && !(state.numErrors > 0 && state.stopBatchOnError);
+        if (mayStartMore && next < runNumbers.size() && (int)workers.size() < numProcesses) {
+            int runNumber = runNumbers[next++];
+            state.runsTried++;
+
+            // buffered output would be written out by both processes
+            out.flush();
+            fflush(nullptr);
+
+            pid_t pid = fork();
+            if (pid == 0)
+                _exit(runForkedRepetition(state, simulation, runner, ini, configName, runNumber));  // worker process
+            if (pid == -1) {
+                cRuntimeError e("Cannot fork worker process for run #%d: %s", runNumber, strerror(errno));
+                narrator->displayException(e);
+                state.numErrors++;
+                next = runNumbers.size();  // do not try starting further workers
+                continue;
+            }
+            workers[pid] = runNumber;
+        }
+        else if (workers.empty()) {
+            break;  // no more runs to start
+        }
+        else {
+            // only reap our own workers: other child processes (e.g. ones started by
+            // simulation models before the fork) are to be waited for by their owners
+            int status;
+            auto it = workers.begin();
+            pid_t pid = 0;
+            for ( ; it != workers.end(); ++it)
+                if ((pid = waitpid(it->first, &status, WNOHANG)) != 0)
+                    break;
+            if (pid == 0) {
+                // none has exited yet: block until some child becomes waitable, without reaping it
+                siginfo_t info;
+                info.si_pid = 0;
+                if (waitid(P_ALL, 0, &info, WEXITED|WNOWAIT) == -1 && errno != EINTR)
+                    throw cRuntimeError("Error waiting for worker processes: %s", strerror(errno));
+                if (info.si_pid != 0 && workers.find(info.si_pid) == workers.end())
+                    usleep(10000);  // another child, which stays waitable until its owner reaps it; avoid busy waiting
+                continue;
+            }
+            if (pid == -1) {
+                if (errno == EINTR)
+                    continue;
+                throw cRuntimeError("Error waiting for the worker process of run #%d: %s", it->second, strerror(errno));
+            }
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+                state.numCompleted++;
+            else {
+                if (!WIFEXITED(status)) {
+                    cRuntimeError e("Worker process of run #%d terminated abnormally", it->second);
+                    narrator->displayException(e);
+                }
+                state.numErrors++;
+            }
+            workers.erase(it);
+        }
+    }
+#endif
+}
+
+int CmdenvSimulationRunner::runForkedRepetition(BatchState& state, cSimulation *simulation, cIEventLoopRunner *runner, InifileContents *ini, const char *configName, int runNumber)
+{
+#ifdef _WIN32
+    throw cRuntimeError("Forking worker processes is not supported on Windows");
+#else
+    int exitCode = 0;
+    std::unique_ptr<cConfiguration> cfg;  // must outlive the network
+    try {
+        narrator->preparing(configName, runNumber);
+        cfg.reset(ini->extractConfig(configName, runNumber));
+
+        // redirect the standard output of the whole worker process
+        narrator->beforeRedirecting(cfg.get());
+        if (cfg->getAsBool(CFGID_CMDENV_REDIRECT_OUTPUT)) {
+            std::string outputFile = ResultFileUtils(cfg.get()).augmentFileName(cfg->getAsFilename(CFGID_CMDENV_OUTPUT_FILE));
+            const char *redirectFileName = outputFile.c_str();
+            narrator->redirectingTo(cfg.get(), redirectFileName);
+            mkPath(directoryOf(redirectFileName).c_str());
+            out.flush();
+            fflush(stdout);
+            int fd = open(redirectFileName, O_WRONLY|O_CREAT|O_TRUNC, 0666);
+            if (fd == -1 || dup2(fd, STDOUT_FILENO) == -1)
+                throw cRuntimeError("Cannot redirect standard output to file '%s': %s", redirectFileName, strerror(errno));
+            close(fd);
+            narrator->onRedirectionFileOpen(out, cfg.get(), redirectFileName);
+        }
+
+        if (GenericEventLoopRunner *genericRunner = dynamic_cast<GenericEventLoopRunner *>(runner))
+            genericRunner->setBatchProgress(state.runsTried, state.numRuns);
+
+        try {
+            simulation->switchRun(cfg.get());
+
+            bool isTerminated = !simulation->run(runner, true);
+            if (!isTerminated)
+                throw cRuntimeError("Simulation paused before running to completion");
+
+            simulation->deleteNetwork();
+        }
+        catch (cRuntimeError& e) {
+            simulation->deleteNetworkOnError(e);
+            throw;
+        }
+        catch (std::exception& e) {
+            cRuntimeError re(e);
+            simulation->deleteNetworkOnError(re);
+            throw re;
+        }
+    }
+    catch (std::exception& e) {
+        narrator->displayException(e);
+        exitCode = 1;
+    }
+
+    out.flush();
+    fflush(nullptr);
+    return exitCode;
+#endif
+}
+
 cSimulation *CmdenvSimulationRunner::createSimulation(std::ostream& simout)
 {
     CmdenvEnvir *envir = new CmdenvEnvir(simout, sigintReceived);
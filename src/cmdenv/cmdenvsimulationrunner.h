@@ -73,6 +73,10 @@ class CMDENV_API CmdenvSimulationRunner
      virtual void doRunSimulation(BatchState& state, InifileContents *ini, const char *configName, int runNumber); // note: throws on error
      virtual BatchResult extractResult(const BatchState& state);
      virtual cTerminationException *setupAndRunSimulation(BatchState& state, cConfiguration *cfg);
+     virtual std::string getForkGroupKey(cConfiguration *cfg);
+     virtual void doRunRepetitionsForked(BatchState& state, InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int numProcesses);
+     virtual void forkWorkers(BatchState& state, cSimulation *simulation, cIEventLoopRunner *runner, InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int numProcesses);
+     virtual int runForkedRepetition(BatchState& state, cSimulation *simulation, cIEventLoopRunner *runner, InifileContents *ini, const char *configName, int runNumber); // in the worker process; returns exit code
      static void sigintHandler(int signum);
 
    public:
@@ -89,6 +93,7 @@ class CMDENV_API CmdenvSimulationRunner
      virtual BatchResult runParameterStudy(InifileContents *ini, const char *configName, const char *runFilter);
      virtual BatchResult runSimulations(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers);
      virtual BatchResult runSimulationsInThreads(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int numThreads=-1);
+     virtual BatchResult runSimulationsForked(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int numProcesses=-1);
      virtual void runSimulation(InifileContents *ini, const char *configName, int runNumber); // note: throws on error
 };
 
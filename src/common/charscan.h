@@ -0,0 +1,149 @@
+//=========================================================================
+//  CHARSCAN.H - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_CHARSCAN_H
+#define __OMNETPP_COMMON_CHARSCAN_H
+
+#include <cstring>
+#include "commondefs.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define OPP_CHARSCAN_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OPP_CHARSCAN_SSE2
+#endif
+
+#if defined(_MSC_VER) && (defined(OPP_CHARSCAN_AVX2) || defined(OPP_CHARSCAN_SSE2))
+#include <intrin.h>
+#endif
+
+namespace omnetpp {
+namespace common {
+
+/**
+ * Byte scanning routines for the parsers of large text files (result files,
+ * event logs). They examine 32 or 16 bytes at a time using AVX2 or SSE2
+ * instructions if the compiler targets them, and fall back to memchr() or
+ * a plain loop otherwise.
+ *
+ * @{
+ */
+
+/**
+ * Number of bytes that must be readable after the terminating zero of the
+ * string passed to opp_findseparator().
+ */
+const int OPP_CHARSCAN_PADDING = 32;
+
+#if defined(OPP_CHARSCAN_AVX2) || defined(OPP_CHARSCAN_SSE2)
+inline int opp_charscan_ctz(unsigned int mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+/**
+ * Returns a pointer to the first CR or LF character in the range [s, end),
+ * or end if there is none. Does not read outside the range.
+ */
+inline const char *opp_findeol(const char *s, const char *end)
+{
+#if defined(OPP_CHARSCAN_AVX2)
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    for ( ; end - s >= 32; s += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)s);
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, cr), _mm256_cmpeq_epi8(chunk, lf)));
+        if (mask != 0)
+            return s + opp_charscan_ctz(mask);
+    }
+#elif defined(OPP_CHARSCAN_SSE2)
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    for ( ; end - s >= 16; s += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)s);
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf)));
+        if (mask != 0)
+            return s + opp_charscan_ctz(mask);
+    }
+#else
+    // CR normally only occurs right before LF, so look for LF first
+    const char *lf = (const char *)memchr(s, '\n', end - s);
+    if (!lf)
+        lf = end;
+    const char *cr = (const char *)memchr(s, '\r', lf - s);
+    return cr ? cr : lf;
+#endif
+    while (s < end && *s != '\r' && *s != '\n')
+        s++;
+    return s;
+}
+
+inline char *opp_findeol(char *s, const char *end)
+{
+    return const_cast<char *>(opp_findeol(const_cast<const char *>(s), end));
+}
+
+/**
+ * Returns a pointer to the first occurrence of sep1, sep2 or the terminating
+ * zero in the string s. The string is read in chunks, so the underlying
+ * buffer must extend to at least OPP_CHARSCAN_PADDING bytes past the
+ * terminating zero. The contents of the padding are irrelevant.
+ */
+inline char *opp_findseparator(char *s, char sep1, char sep2)
+{
+#if defined(OPP_CHARSCAN_AVX2)
+    const __m256i v1 = _mm256_set1_epi8(sep1);
+    const __m256i v2 = _mm256_set1_epi8(sep2);
+    const __m256i zero = _mm256_setzero_si256();
+    for ( ; ; s += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)s);
+        __m256i matches = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, v1), _mm256_cmpeq_epi8(chunk, v2)), _mm256_cmpeq_epi8(chunk, zero));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(matches);
+        if (mask != 0)
+            return s + opp_charscan_ctz(mask);
+    }
+#elif defined(OPP_CHARSCAN_SSE2)
+    const __m128i v1 = _mm_set1_epi8(sep1);
+    const __m128i v2 = _mm_set1_epi8(sep2);
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; ; s += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)s);
+        __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, v1), _mm_cmpeq_epi8(chunk, v2)), _mm_cmpeq_epi8(chunk, zero));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(matches);
+        if (mask != 0)
+            return s + opp_charscan_ctz(mask);
+    }
+#else
+    while (*s && *s != sep1 && *s != sep2)
+        s++;
+    return s;
+#endif
+}
+
+/** @} */
+
+}  // namespace common
+}  // namespace omnetpp
+
+
+#endif
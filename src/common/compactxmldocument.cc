@@ -0,0 +1,280 @@
+//==========================================================================
+//  COMPACTXMLDOCUMENT.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2002-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+#include <new>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "omnetpp/platdep/platmisc.h"  // strcasecmp
+#include "compactxmldocument.h"
+#include "saxparser_yxml.h"
+#include "stringutil.h"
+#include "exception.h"
+#include "yxml.h"
+
+namespace omnetpp {
+namespace common {
+
+static const size_t BLOCK_SIZE = 64*1024;
+
+const char *CompactXmlDocument::Node::getAttribute(const char *attr) const
+{
+    for (int i = 0; i < numAttrs; i++)
+        if (strcmp(attrs[2*i], attr) == 0)
+            return attrs[2*i+1];
+    return nullptr;
+}
+
+const CompactXmlDocument::Node *CompactXmlDocument::Node::getFirstChildWithTag(const char *tagName) const
+{
+    for (const Node *child = firstChild; child; child = child->nextSibling)
+        if (!strcasecmp(child->tagName, tagName))
+            return child;
+    return nullptr;
+}
+
+const CompactXmlDocument::Node *CompactXmlDocument::Node::getNextSiblingWithTag(const char *tagName) const
+{
+    for (const Node *node = nextSibling; node; node = node->nextSibling)
+        if (!strcasecmp(node->tagName, tagName))
+            return node;
+    return nullptr;
+}
+
+const CompactXmlDocument::Node *CompactXmlDocument::Node::getElementById(const char *idAttrValue) const
+{
+    const char *id = getAttribute("id");
+    if (id && !strcmp(id, idAttrValue))
+        return this;
+    for (const Node *child = firstChild; child; child = child->nextSibling)
+        if (const Node *res = child->getElementById(idAttrValue))
+            return res;
+    return nullptr;
+}
+
+//----
+
+CompactXmlDocument::CompactXmlDocument(const char *fileName) : fileName(fileName)
+{
+    documentNode = newNode("/");
+}
+
+CompactXmlDocument::~CompactXmlDocument()
+{
+    // nodes are trivially destructible, no need to call their destructors
+    for (char *block : blocks)
+        delete[] block;
+}
+
+void *CompactXmlDocument::allocate(size_t size, size_t alignment)
+{
+    size_t padding = (alignment - ((uintptr_t)freePtr & (alignment-1))) & (alignment-1);
+    if (padding + size > freeBytes) {
+        size_t blockSize = std::max(BLOCK_SIZE, size + alignment);
+        freePtr = new char[blockSize];
+        freeBytes = blockSize;
+        blocks.push_back(freePtr);
+        allocatedBytes += blockSize;
+        padding = (alignment - ((uintptr_t)freePtr & (alignment-1))) & (alignment-1);
+    }
+    void *result = freePtr + padding;
+    freePtr += padding + size;
+    freeBytes -= padding + size;
+    return result;
+}
+
+const char *CompactXmlDocument::copyString(const char *s, size_t len)
+{
+    if (len == 0)
+        return "";
+    char *result = (char *)allocate(len + 1, 1);
+    memcpy(result, s, len);
+    result[len] = '\0';
+    return result;
+}
+
+const char *CompactXmlDocument::internName(const char *s)
+{
+    return names.insert(s).first->c_str();
+}
+
+CompactXmlDocument::Node *CompactXmlDocument::newNode(const char *tagName)
+{
+    return new (allocate(sizeof(Node), alignof(Node))) Node(tagName);
+}
+
+size_t CompactXmlDocument::getMemoryUsage() const
+{
+    size_t namesBytes = 0;
+    for (const std::string& name : names)
+        namesBytes += sizeof(std::string) + name.capacity() + 2*sizeof(void *);
+    return sizeof(*this) + allocatedBytes + blocks.capacity() * sizeof(char *) + namesBytes;
+}
+
+void CompactXmlDocument::parse(const char *data, size_t len)
+{
+    char parserMemory[4096];
+    yxml_t parserState;
+    yxml_t *x = &parserState;
+    yxml_init(x, parserMemory, sizeof(parserMemory));
+
+    Node *current = documentNode;
+    bool insideElementOpenTag = false;
+    bool insideContent = false;
+    std::vector<const char *> attrs;  // name,value,name,value,...
+    std::string stringbuf;
+    std::vector<std::string> texts(1);  // character data of open elements, indexed by depth
+    int depth = 0;
+
+    for (const char *p = data, *endp = data + len; p < endp; p++) {
+        yxml_ret_t code = yxml_parse(x, *p);
+        if (code == YXML_OK)
+            continue;
+        if (code < 0)
+            throw opp_runtime_error("Parse error: %s at %s:%u", YxmlSaxParser::getErrorMessage(code), fileName.c_str(), (unsigned)x->line);
+
+        // the same event boundaries as in YxmlSaxParser, to produce the same tree
+        if (insideElementOpenTag && code != YXML_ATTRSTART && code != YXML_ATTRVAL && code != YXML_ATTREND) {
+            if (!attrs.empty()) {
+                const char **array = (const char **)allocate((attrs.size()+1) * sizeof(const char *), alignof(const char *));
+                std::copy(attrs.begin(), attrs.end(), array);
+                array[attrs.size()] = nullptr;
+                current->attrs = array;
+                current->numAttrs = attrs.size() / 2;
+                attrs.clear();
+            }
+            insideElementOpenTag = false;
+        }
+        else if (insideContent && code != YXML_CONTENT) {
+            if (!opp_isblank(stringbuf.c_str()))  // discard ignorable whitespace
+                texts[depth] += stringbuf;
+            stringbuf.clear();
+            insideContent = false;
+        }
+
+        switch (code) {
+            case YXML_ELEMSTART: {
+                Node *node = newNode(internName(x->elem));
+                node->lineNumber = x->line;
+                node->parent = current;
+                node->prevSibling = current->lastChild;
+                if (current->lastChild)
+                    current->lastChild->nextSibling = node;
+                else
+                    current->firstChild = node;
+                current->lastChild = node;
+                current = node;
+                numElements++;
+                if (++depth == (int)texts.size())
+                    texts.push_back(std::string());
+                texts[depth].clear();
+                insideElementOpenTag = true;
+                break;
+            }
+            case YXML_ATTRVAL:
+                stringbuf.append(x->data);
+                break;
+            case YXML_ATTREND:
+                attrs.push_back(internName(x->attr));
+                attrs.push_back(copyString(stringbuf.data(), stringbuf.size()));
+                stringbuf.clear();
+                break;
+            case YXML_ELEMEND:
+                if (!texts[depth].empty())
+                    current->value = copyString(texts[depth].data(), texts[depth].size());
+                current = current->parent;
+                depth--;
+                break;
+            case YXML_CONTENT:
+                stringbuf.append(x->data);
+                insideContent = true;
+                break;
+            default:
+                break;  // processing instructions are ignored
+        }
+    }
+
+    yxml_ret_t r = yxml_eof(x);
+    if (r != YXML_OK)
+        throw opp_runtime_error("Parse error: %s at %s:%u", YxmlSaxParser::getErrorMessage(r), fileName.c_str(), (unsigned)x->line);
+}
+
+static std::string readFile(const char *fileName)
+{
+    FILE *f = fopen(fileName, "rb");
+    if (!f)
+        throw opp_runtime_error("Cannot open file: '%s'", fileName);
+    std::string content;
+    char buf[65536];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), f)) > 0)
+        content.append(buf, len);
+    fclose(f);
+    return content;
+}
+
+CompactXmlDocument *CompactXmlDocument::parseFile(const char *fileName)
+{
+    std::unique_ptr<CompactXmlDocument> document(new CompactXmlDocument(fileName));
+#ifndef _WIN32
+    int fd = open(fileName, O_RDONLY);
+    if (fd == -1)
+        throw opp_runtime_error("Cannot open file: '%s'", fileName);
+    struct stat st;
+    void *data = MAP_FAILED;
+    size_t len = 0;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        len = st.st_size;
+        data = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (data != MAP_FAILED) {
+        madvise(data, len, MADV_SEQUENTIAL);
+        try {
+            document->parse((const char *)data, len);
+        }
+        catch (std::exception&) {
+            munmap(data, len);
+            throw;
+        }
+        munmap(data, len);
+        return document.release();
+    }
+    // empty file, special file, or mmap() not possible: fall back to reading it
+#endif
+    std::string content = readFile(fileName);
+    document->parse(content.data(), content.size());
+    return document.release();
+}
+
+CompactXmlDocument *CompactXmlDocument::parseContent(const char *content, const char *fileName)
+{
+    std::unique_ptr<CompactXmlDocument> document(new CompactXmlDocument(fileName));
+    document->parse(content, strlen(content));
+    return document.release();
+}
+
+}  // namespace common
+}  // namespace omnetpp
+
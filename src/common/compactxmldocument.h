@@ -0,0 +1,155 @@
+//==========================================================================
+//  COMPACTXMLDOCUMENT.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2002-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_COMPACTXMLDOCUMENT_H
+#define __OMNETPP_COMMON_COMPACTXMLDOCUMENT_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include "commondefs.h"
+
+namespace omnetpp {
+namespace common {
+
+/**
+ * A read-only XML DOM tree in compact form. The document is parsed with yxml
+ * directly into the tree (without SAX callbacks), from a memory-mapped file
+ * where possible. Nodes, strings and attribute arrays are allocated from an
+ * arena owned by the document, and element and attribute names are interned,
+ * so loading is fast and the tree takes little memory.
+ *
+ * Node accessors mirror those of cXMLElement. The tree has the same shape as
+ * the one built by the SAX-based loader: the document node is the parent of
+ * the root element, ignorable whitespace is discarded, and the character data
+ * of an element is concatenated into its node value. Processing instructions
+ * are ignored. DTDs are not supported.
+ *
+ * The object is immutable after parsing, so it can be shared among threads.
+ */
+class COMMON_API CompactXmlDocument
+{
+  public:
+    class COMMON_API Node
+    {
+        friend class CompactXmlDocument;
+      private:
+        const char *tagName;
+        const char *value = "";
+        const char **attrs = nullptr; // name,value,name,value,...,nullptr
+        int numAttrs = 0;
+        int lineNumber = -1;
+        Node *parent = nullptr;
+        Node *firstChild = nullptr;
+        Node *lastChild = nullptr;
+        Node *prevSibling = nullptr;
+        Node *nextSibling = nullptr;
+
+      public:
+        Node(const char *tagName) : tagName(tagName) {}
+        const char *getTagName() const {return tagName;}
+        const char *getNodeValue() const {return value;}
+        int getSourceLineNumber() const {return lineNumber;}
+
+        bool hasAttributes() const {return numAttrs > 0;}
+        int getNumAttrs() const {return numAttrs;}
+        const char *getAttrName(int i) const {return attrs[2*i];}
+        const char *getAttrValue(int i) const {return attrs[2*i+1];}
+        const char **getAttributes() const {return attrs;} // as name,value,...,nullptr, or nullptr if there are none
+        const char *getAttribute(const char *attr) const;
+
+        const Node *getParentNode() const {return parent;}
+        bool hasChildren() const {return firstChild != nullptr;}
+        const Node *getFirstChild() const {return firstChild;}
+        const Node *getLastChild() const {return lastChild;}
+        const Node *getNextSibling() const {return nextSibling;}
+        const Node *getPreviousSibling() const {return prevSibling;}
+        const Node *getFirstChildWithTag(const char *tagName) const;
+        const Node *getNextSiblingWithTag(const char *tagName) const;
+        const Node *getElementById(const char *idAttrValue) const;
+    };
+
+  private:
+    std::string fileName;
+    Node *documentNode = nullptr;
+    int numElements = 0;
+
+    // arena
+    std::vector<char *> blocks;
+    char *freePtr = nullptr;
+    size_t freeBytes = 0;
+    size_t allocatedBytes = 0;
+
+    // interned element and attribute names
+    std::unordered_set<std::string> names;
+
+  private:
+    CompactXmlDocument(const char *fileName);
+    CompactXmlDocument(const CompactXmlDocument&) = delete;
+    void operator=(const CompactXmlDocument&) = delete;
+    void *allocate(size_t size, size_t alignment);
+    const char *copyString(const char *s, size_t len);
+    const char *internName(const char *s);
+    Node *newNode(const char *tagName);
+    void parse(const char *data, size_t len);
+
+  public:
+    ~CompactXmlDocument();
+
+    /**
+     * Parses the given file. The caller takes ownership of the returned
+     * object. Errors are signaled via exceptions.
+     */
+    static CompactXmlDocument *parseFile(const char *fileName);
+
+    /**
+     * Parses the given string as XML content. The caller takes ownership of
+     * the returned object. Errors are signaled via exceptions. The source
+     * file name of the elements is set to the given string.
+     */
+    static CompactXmlDocument *parseContent(const char *content, const char *fileName="content");
+
+    /**
+     * Returns the document node, which is the parent of the root element.
+     * Its tag name is "/".
+     */
+    const Node *getDocumentNode() const {return documentNode;}
+
+    /**
+     * Returns the root element, or nullptr if there is none.
+     */
+    const Node *getRootElement() const {return documentNode->firstChild;}
+
+    /**
+     * The file name used for parsing; element source locations refer to it.
+     */
+    const char *getFileName() const {return fileName.c_str();}
+
+    /**
+     * Returns the number of elements in the document, excluding the document node.
+     */
+    int getNumElements() const {return numElements;}
+
+    /**
+     * Returns the approximate number of bytes taken up by the tree.
+     */
+    size_t getMemoryUsage() const;
+};
+
+}  // namespace common
+}  // namespace omnetpp
+
+#endif
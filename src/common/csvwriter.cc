@@ -25,6 +25,7 @@ namespace common {
 CsvWriter::~CsvWriter()
 {
     // note: no close() because it could throw! and std::ofstream closes automatically anyway
+    buffer.flush();
 }
 
 void CsvWriter::open(const char *filename, std::ios::openmode mode)
@@ -33,20 +34,31 @@ void CsvWriter::open(const char *filename, std::ios::openmode mode)
     if (fileStream.fail())
         throw opp_runtime_error("Cannot open '%s' for write", filename);
     outp = &fileStream;
+    buffer.setOutput(outp);
     lineNumber = columnNumber = 0;
 }
 
 void CsvWriter::close()
 {
     Assert(outp == &fileStream);
+    bool ok = buffer.flush();
     fileStream.close();
-    if (!fileStream)
+    if (!ok || !fileStream)
         throw opp_runtime_error("Error writing CSV file");
 }
 
+void CsvWriter::flush()
+{
+    Assert(outp);
+    if (!buffer.flush())
+        throw opp_runtime_error("Error writing CSV output");
+    outp->flush();
+}
+
 std::ostream& CsvWriter::out()
 {
     Assert(outp);
+    buffer.flush();
     return *outp;
 }
 
@@ -54,7 +66,7 @@ void CsvWriter::writeInt(int64_t value)
 {
     Assert(!insideRaw);
     writeSep();
-    out() << value;
+    buffer.writeInt(value);
     columnNumber++;
 }
 
@@ -70,7 +82,7 @@ void CsvWriter::writeBigDecimal(const BigDecimal& value)
 {
     Assert(!insideRaw);
     writeSep();
-    out() << value.str();
+    doWriteBigDecimal(value);
     columnNumber++;
 }
 
@@ -79,13 +91,13 @@ void CsvWriter::writeString(const std::string& value)
     Assert(!insideRaw);
     writeSep();
     if (needsQuote(value)) {
-        out() << quoteChar;
+        buffer.write(quoteChar);
         for (char c : value)
             writeChar(c);
-        out() << quoteChar;
+        buffer.write(quoteChar);
     }
     else {
-        out() << value;
+        buffer.write(value);
     }
     columnNumber++;
 }
@@ -100,7 +112,7 @@ void CsvWriter::writeBlank()
 void CsvWriter::writeNewLine()
 {
     Assert(!insideRaw);
-    out() << std::endl;
+    buffer.write('\n');
     lineNumber++;
     columnNumber = 0;
 }
@@ -119,12 +131,24 @@ void CsvWriter::endRaw()
     columnNumber++;
 }
 
+void CsvWriter::writeRaw(const char *value)
+{
+    Assert(insideRaw);
+    buffer.write(value);
+}
+
 void CsvWriter::writeRawDouble(double value)
 {
     Assert(insideRaw);
     doWriteDouble(value);
 }
 
+void CsvWriter::writeRawBigDecimal(const BigDecimal& value)
+{
+    Assert(insideRaw);
+    doWriteBigDecimal(value);
+}
+
 void CsvWriter::writeRawQuotedStringBody(const std::string& value)
 {
     Assert(insideRaw);
@@ -135,19 +159,26 @@ void CsvWriter::writeRawQuotedStringBody(const std::string& value)
 void CsvWriter::writeSep()
 {
     if (columnNumber != 0)
-        out() << separator;
+        buffer.write(separator);
 }
 
 void CsvWriter::doWriteDouble(double value)
 {
     if (std::isfinite(value))
-        out() << std::setprecision(prec) << value;
+        buffer.writeDouble(value, prec);
     else if (isPositiveInfinity(value))
-        out() << "Inf";
+        buffer.write("Inf", 3);
     else if (isNegativeInfinity(value))
-        out() << "-Inf";
+        buffer.write("-Inf", 4);
     else
-        out() << "NaN";
+        buffer.write("NaN", 3);
+}
+
+void CsvWriter::doWriteBigDecimal(const BigDecimal& value)
+{
+    char buf[64], *endp;
+    const char *str = BigDecimal::ttoa(buf, value, endp);  // same as value.str()
+    buffer.write(str, endp - str);
 }
 
 bool CsvWriter::needsQuote(const std::string& value)
@@ -176,14 +207,14 @@ void CsvWriter::writeChar(char ch)
     switch (quoteEscapingMethod) {
         case BACKSLASH:
             if (ch == '\\' || ch == quoteChar)
-                out() << '\\';
-            out() << ch;
+                buffer.write('\\');
+            buffer.write(ch);
             break;
 
         case DOUBLING:
             if (ch == quoteChar)
-                out() << ch;
-            out() << ch;
+                buffer.write(ch);
+            buffer.write(ch);
             break;
     }
 }
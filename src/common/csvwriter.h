@@ -19,6 +19,7 @@
 #include <string>
 #include <cstdint>
 #include "commondefs.h"
+#include "outputbuffer.h"
 
 namespace omnetpp {
 namespace common {
@@ -43,6 +44,7 @@ private:
 
     std::ostream *outp = nullptr;
     std::ofstream fileStream;
+    OutputBuffer buffer;  // all output goes through it
     int lineNumber = 0, columnNumber = 0;
     bool insideRaw = false;
 
@@ -51,6 +53,7 @@ private:
     void writeChar(char ch);
     void writeSep();
     void doWriteDouble(double value);
+    void doWriteBigDecimal(const BigDecimal& value);
 
 public:
     // creation, opening
@@ -59,9 +62,10 @@ public:
     CsvWriter(const char *filename, std::ios::openmode mode=std::ios::out) {open(filename, mode);}
     CsvWriter(std::ostream& out) {setOut(out);}
     void open(const char* filename, std::ios::openmode mode=std::ios::out);
-    void setOut(std::ostream& out) {outp = &out;}
+    void setOut(std::ostream& out) {outp = &out; buffer.setOutput(outp);}
     void close(); // only needed when using file output
-    std::ostream& out();
+    void flush(); // writes buffered output into the stream; needed at the end when not using file output
+    std::ostream& out(); // flushes buffered output first; only for writing a few bytes, prefer writeRaw()
 
     // configuration
     void setPrecision(int p) {prec = p;}
@@ -82,7 +86,9 @@ public:
     void writeNewLine();
     void beginRaw();
     void endRaw();
+    void writeRaw(const char *value); // omits separator, and writes the string as is
     void writeRawDouble(double value); // omits separator
+    void writeRawBigDecimal(const BigDecimal& value); // omits separator
     void writeRawQuotedStringBody(const std::string& value);  // omits separator and quote chars
 
     int getLine() const {return lineNumber;}
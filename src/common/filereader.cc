@@ -22,6 +22,7 @@
 #include <algorithm>
 #include "omnetpp/platdep/platmisc.h"
 #include "commonutil.h"
+#include "charscan.h"
 #include "filereader.h"
 #include "exception.h"
 #include "stringutil.h"
@@ -367,8 +368,7 @@ char *FileReader::findNextLineStart(char *start, bool bufferFilled)
     char *s = start;
 
     // find next CR/LF (fast path)
-    while (s < dataEnd && *s != '\r' && *s != '\n')
-        s++;
+    s = opp_findeol(s, dataEnd);
 
     if (s < dataEnd && *s == '\r')
         s++;
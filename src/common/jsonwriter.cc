@@ -15,6 +15,7 @@
 #include "commonutil.h"
 #include "bigdecimal.h"
 #include "stringutil.h"
+#include "opp_ctype.h"
 #include "jsonwriter.h"
 
 namespace omnetpp {
@@ -24,6 +25,7 @@ namespace common {
 JsonWriter::~JsonWriter()
 {
     // note: no close() because it could throw! and std::ofstream closes automatically anyway
+    buffer.flush();
 }
 
 void JsonWriter::reset()
@@ -38,65 +40,95 @@ void JsonWriter::open(const char *filename, std::ios::openmode mode)
     if (fileStream.fail())
         throw opp_runtime_error("Cannot open '%s' for write", filename);
     outp = &fileStream;
+    buffer.setOutput(outp);
     reset();
 }
 
 void JsonWriter::close()
 {
     Assert(outp == &fileStream);
+    bool ok = buffer.flush();
     fileStream.close();
-    if (!fileStream)
+    if (!ok || !fileStream)
         throw opp_runtime_error("Error writing JSON file");
 }
 
+void JsonWriter::flush()
+{
+    Assert(outp);
+    if (!buffer.flush())
+        throw opp_runtime_error("Error writing JSON output");
+    outp->flush();
+}
+
 std::ostream& JsonWriter::out()
 {
     Assert(outp);
+    buffer.flush();
     return *outp;
 }
 
 void JsonWriter::doWriteBool(bool b)
 {
-    out() << (b ? trueStr :falseStr);
+    buffer.write(b ? trueStr : falseStr);
 }
 
 void JsonWriter::doWriteInt(int64_t value)
 {
-    out() << value;
+    buffer.writeInt(value);
 }
 
 void JsonWriter::doWriteDouble(double value)
 {
     if (std::isfinite(value))
-        out() << std::setprecision(prec) << value;
+        buffer.writeDouble(value, prec);
     else if (isPositiveInfinity(value))
-        out() << infStr;
+        buffer.write(infStr);
     else if (isNegativeInfinity(value))
-        out() << negInfStr;
+        buffer.write(negInfStr);
     else
-        out() << nanStr;
+        buffer.write(nanStr);
 }
 
 void JsonWriter::doWriteBigDecimal(const BigDecimal& value)
 {
-    if (!value.isSpecial())
-        out() << value.str();
+    if (!value.isSpecial()) {
+        char buf[64], *endp;
+        const char *str = BigDecimal::ttoa(buf, value, endp);  // same as value.str()
+        buffer.write(str, endp - str);
+    }
     else if (value.isPositiveInfinity())
-        out() << infStr;
+        buffer.write(infStr);
     else if (value.isNegativeInfinity())
-        out() << negInfStr;
+        buffer.write(negInfStr);
     else
-        out() << nanStr;
+        buffer.write(nanStr);
 }
 
 void JsonWriter::doWriteString(const std::string& value)
 {
-    out() << opp_quotestr(value);
-}
-
-void JsonWriter::doWriteRaw(const std::string& value)
-{
-    out() << value;
+    // same as opp_quotestr(), but without creating a temporary string
+    static const char hexDigits[] = "0123456789ABCDEF";
+    buffer.write('"');
+    for (const char *s = value.c_str(); *s; s++) {
+        switch (*s) {
+            case '\b': buffer.write("\\b", 2); break;
+            case '\f': buffer.write("\\f", 2); break;
+            case '\n': buffer.write("\\n", 2); break;
+            case '\r': buffer.write("\\r", 2); break;
+            case '\t': buffer.write("\\t", 2); break;
+            case '"':  buffer.write("\\\"", 2); break;
+            case '\\': buffer.write("\\\\", 2); break;
+            default:
+                if (opp_iscntrl(*s)) {
+                    char hex[4] = {'\\', 'x', hexDigits[(*s >> 4) & 0xF], hexDigits[*s & 0xF]};
+                    buffer.write(hex, 4);
+                }
+                else
+                    buffer.write(*s);
+        }
+    }
+    buffer.write('"');
 }
 
 void JsonWriter::writeBool(const std::string& key, bool value)
@@ -186,12 +218,12 @@ void JsonWriter::doWriteKeyEtc(const std::string& key)
     if (stack.empty() || stack.top().type != OBJECT)
         throw opp_runtime_error("JSON: cannot write key, not inside an object");
     if (!isCurrentContainerEmpty)
-        out() << ",";
+        buffer.write(',');
     else
         isCurrentContainerEmpty = false;
     doWriteNewLine();
     doWriteString(key);
-    out() << " : ";
+    buffer.write(" : ", 3);
 }
 
 void JsonWriter::doWriteArraySep()
@@ -199,7 +231,7 @@ void JsonWriter::doWriteArraySep()
     if (stack.empty() || stack.top().type != ARRAY)
         throw opp_runtime_error("JSON: cannot write array item, not inside an array");
     if (!isCurrentContainerEmpty)
-        out() << ",";
+        buffer.write(',');
     else
         isCurrentContainerEmpty = false;
     doWriteNewLine();
@@ -208,9 +240,11 @@ void JsonWriter::doWriteArraySep()
 void JsonWriter::doWriteNewLine(int relDepth)
 {
     if (stack.top().isOneliner)
-        out() << " ";
-    else
-        out() << "\n" << std::setw(indentSize*(stack.size()+relDepth)) << "";
+        buffer.write(' ');
+    else {
+        buffer.write('\n');
+        buffer.writeSpaces(indentSize*(stack.size()+relDepth));
+    }
 }
 
 void JsonWriter::openObject(bool isOneliner)
@@ -220,7 +254,7 @@ void JsonWriter::openObject(bool isOneliner)
         isOneliner = isOneliner || stack.top().isOneliner; // make whole subtree one line
     }
     stack.push(Container{OBJECT, isOneliner});
-    out() << "{";
+    buffer.write('{');
     isCurrentContainerEmpty = true;
 }
 
@@ -229,7 +263,7 @@ void JsonWriter::openObject(const std::string& key, bool isOneliner)
     doWriteKeyEtc(key);
     isOneliner = isOneliner || stack.top().isOneliner; // make whole subtree one line
     stack.push(Container{OBJECT, isOneliner});
-    out() << "{";
+    buffer.write('{');
     isCurrentContainerEmpty = true;
 }
 
@@ -238,11 +272,11 @@ void JsonWriter::closeObject()
     if (stack.empty() || stack.top().type != OBJECT)
         throw opp_runtime_error("JSON: closeObject: not inside an object");
     doWriteNewLine(-1);
-    out() << "}";
+    buffer.write('}');
     stack.pop();
     isCurrentContainerEmpty = false;
     if (stack.empty())
-        out() << "\n";
+        buffer.write('\n');
 }
 
 void JsonWriter::openArray(bool isOneliner)
@@ -252,7 +286,7 @@ void JsonWriter::openArray(bool isOneliner)
         isOneliner = isOneliner || stack.top().isOneliner; // make whole subtree one line
     }
     stack.push(Container{ARRAY, isOneliner});
-    out() << "[";
+    buffer.write('[');
     isCurrentContainerEmpty = true;
 }
 
@@ -261,7 +295,7 @@ void JsonWriter::openArray(const std::string& key, bool isOneliner)
     doWriteKeyEtc(key);
     isOneliner = isOneliner || stack.top().isOneliner; // make whole subtree one line
     stack.push(Container{ARRAY, isOneliner});
-    out() << "[";
+    buffer.write('[');
     isCurrentContainerEmpty = true;
 }
 
@@ -270,11 +304,11 @@ void JsonWriter::closeArray()
     if (stack.empty() || stack.top().type != ARRAY)
         throw opp_runtime_error("JSON: closeArray, not inside an array");
     doWriteNewLine(-1);
-    out() << "]";
+    buffer.write(']');
     stack.pop();
     isCurrentContainerEmpty = false;
     if (stack.empty())
-        out() << "\n";
+        buffer.write('\n');
 }
 
 }  // namespace common
@@ -20,6 +20,7 @@
 #include <stack>
 #include <cstdint>
 #include "commondefs.h"
+#include "outputbuffer.h"
 
 namespace omnetpp {
 namespace common {
@@ -41,6 +42,7 @@ private:
 
     std::ostream *outp = nullptr;
     std::ofstream fileStream;
+    OutputBuffer buffer;  // all output goes through it
 
     enum Type {NONE, OBJECT, ARRAY};
     struct Container { Type type; bool isOneliner; };
@@ -57,9 +59,10 @@ public:
     JsonWriter(const char *filename, std::ios::openmode mode=std::ios::out) {open(filename, mode);}
     JsonWriter(std::ostream& out) {setOut(out);}
     void open(const char* filename, std::ios::openmode mode=std::ios::out);
-    void setOut(std::ostream& out) {outp = &out; reset();}
+    void setOut(std::ostream& out) {outp = &out; buffer.setOutput(outp); reset();}
     void close(); // only needed when using file output
-    std::ostream& out();
+    void flush(); // writes buffered output into the stream; needed at the end when not using file output
+    std::ostream& out(); // flushes buffered output first; only for writing a few bytes, prefer doWriteRaw()
 
     // configuration
     void setPrecision(int p) {prec = p;}
@@ -114,7 +117,8 @@ public:
     void doWriteDouble(double value);
     void doWriteBigDecimal(const BigDecimal& value);
     void doWriteString(const std::string& value);
-    void doWriteRaw(const std::string& value);
+    void doWriteRaw(const std::string& value) {buffer.write(value);}
+    void doWriteRaw(const char *value) {buffer.write(value);}
     void doWriteKeyEtc(const std::string& value);
     void doWriteArraySep();
     void doWriteNewLine(int relDepth=0);
@@ -16,6 +16,7 @@
 #include <sstream>
 #include <cstring>
 #include "exception.h"
+#include "charscan.h"
 #include "linetokenizer.h"
 
 namespace omnetpp {
@@ -31,7 +32,7 @@ LineTokenizer::LineTokenizer(int initialBufferSize, int maxTokenNum, char sep1,
     vec = new char *[vecsize];
 
     lineBufferSize = initialBufferSize;
-    lineBuffer = new char[lineBufferSize];
+    lineBuffer = new char[lineBufferSize + OPP_CHARSCAN_PADDING]();  // padding for opp_findseparator()
 }
 
 LineTokenizer::~LineTokenizer()
@@ -101,10 +102,11 @@ int LineTokenizer::tokenize(const char *line, int length)
     if (length >= lineBufferSize) {
         delete[] lineBuffer;
         lineBufferSize = length + 1;
-        lineBuffer = new char[lineBufferSize];
+        lineBuffer = new char[lineBufferSize + OPP_CHARSCAN_PADDING]();
     }
 
-    strncpy(lineBuffer, line, length);
+    // note: an embedded zero would end the line just like with strncpy()
+    memcpy(lineBuffer, line, length);
     lineBuffer[length] = '\0';  // guard
 
     char *s = lineBuffer + length - 1;
@@ -150,8 +152,7 @@ int LineTokenizer::tokenize(const char *line, int length)
             // parse unquoted string
             token = s;
             // try find end of string
-            while (*s && *s != sep1 && *s != sep2)
-                s++;
+            s = opp_findseparator(s, sep1, sep2);
             // terminate string with zero (if we are not already at end of the line)
             if (*s)
                 *s++ = 0;
@@ -16,7 +16,10 @@
 *--------------------------------------------------------------*/
 
 #include <algorithm>
+#include <system_error>
 #include "commonutil.h"
+#include "fileutil.h"
+#include "fileglobber.h"
 #include "stringutil.h"
 #include "omnetppvectorfilewriter.h"
 
@@ -69,10 +72,121 @@ void OmnetppVectorFileWriter::open(const char *filename)
 
     fprintf(fi, "%64s\n", "");  // leave blank space for "fingerprint" (size and modification date of the vector file)
     check(fprintf(fi, "version %d\n", INDEX_FILE_VERSION));
+
+    // open shard files, and list them in both the vector and the index file;
+    // shards left over from an earlier run (maybe with a different number of shards) are removed
+    removeShardFiles(fname);
+    shards.clear();
+    if (numShards == 1) {
+        Shard shard;
+        shard.fname = fname;
+        shard.f = f;
+        shards.push_back(shard);
+    }
+    else {
+        for (int i = 0; i < numShards; i++) {
+            Shard shard;
+            shard.fname = getShardFileName(fname, i);
+            shard.f = fopen(shard.fname.c_str(), "w");
+            if (shard.f == nullptr)
+                throw opp_runtime_error("Cannot open output vector shard file '%s'", shard.fname.c_str());
+            shards.push_back(shard);
+
+            std::string shardName = filenameOf(shard.fname.c_str());
+            check(fprintf(f, "shard %d %s\n", i, QUOTE(shardName.c_str())));
+            checki(fprintf(fi, "shard %d %s\n", i, QUOTE(shardName.c_str())));
+        }
+        startWorkers();
+    }
+}
+
+void OmnetppVectorFileWriter::setNumShards(int n)
+{
+    Assert(!isOpen());
+    if (n < 1)
+        throw opp_runtime_error("Invalid number of output vector shards %d, must be at least 1", n);
+    numShards = n;
+}
+
+std::string OmnetppVectorFileWriter::getShardFileName(const std::string& vectorFileName, int shard)
+{
+    return vectorFileName + "." + std::to_string(shard);
+}
+
+void OmnetppVectorFileWriter::removeShardFiles(const std::string& vectorFileName)
+{
+    std::string prefix = vectorFileName + ".";
+    std::vector<std::string> shardFiles;
+    FileGlobber globber((prefix + "*").c_str());
+    const char *fileName;
+    while ((fileName = globber.getNext()) != nullptr) {
+        std::string suffix = fileName + std::min(prefix.size(), strlen(fileName));
+        if (opp_stringbeginswith(fileName, prefix.c_str()) && !suffix.empty() && suffix.find_first_not_of("0123456789") == std::string::npos)
+            shardFiles.push_back(fileName);
+    }
+    for (const std::string& shardFile : shardFiles)
+        removeFile(shardFile.c_str(), "old output vector shard file");
+}
+
+void OmnetppVectorFileWriter::startWorkers()
+{
+    stopWorkers = false;
+    pendingShards = 0;
+    try {
+        for (int i = 1; i < numShards; i++)
+            workers.push_back(std::thread(&OmnetppVectorFileWriter::workerMain, this, i, batchNumber));
+    }
+    catch (std::system_error&) {
+        stopAndJoinWorkers(); // could not start all threads, write shards sequentially
+    }
+}
+
+void OmnetppVectorFileWriter::stopAndJoinWorkers()
+{
+    if (workers.empty())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        stopWorkers = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+    workers.clear();
+}
+
+void OmnetppVectorFileWriter::workerMain(int shard, uint64_t lastBatch)
+{
+    // note: lastBatch is passed in, because a batch may be posted before this thread gets to run
+    std::unique_lock<std::mutex> lock(workerMutex);
+    while (true) {
+        workAvailable.wait(lock, [&]() {return stopWorkers || batchNumber != lastBatch;});
+        if (stopWorkers)
+            return;
+        lastBatch = batchNumber;
+        lock.unlock();
+        writeShard(shard);
+        lock.lock();
+        if (--pendingShards == 0)
+            workDone.notify_one();
+    }
+}
+
+void OmnetppVectorFileWriter::writeShard(int shard)
+{
+    for (VectorData *vp : vectorsByShard[shard])
+        if (!(shardOk[shard] = writeBlockData(vp)))
+            break;
 }
 
 void OmnetppVectorFileWriter::close()
 {
+    stopAndJoinWorkers();
+    for (Shard& shard : shards)
+        if (shard.f != f)
+            fclose(shard.f);
+    shards.clear();
+
     if (f) {
         fclose(f);
         f = nullptr;
@@ -94,6 +208,10 @@ void OmnetppVectorFileWriter::close()
 
 void OmnetppVectorFileWriter::cleanup()  // MUST NOT THROW
 {
+    stopAndJoinWorkers();
+    for (Shard& shard : shards)
+        if (shard.f != f)
+            fclose(shard.f);
     if (f)
         fclose(f);
     if (fi)
@@ -144,10 +262,9 @@ void OmnetppVectorFileWriter::finalizeVector(VectorData *vp)
 void OmnetppVectorFileWriter::endRecordingForRun()
 {
     Assert(isOpen());
-    for (VectorData *vp : vectors) {
-        finalizeVector(vp);
+    writeRecords();
+    for (VectorData *vp : vectors)
         delete vp;
-    }
     vectors.clear();
 
     check(fprintf(f, "\n"));
@@ -162,6 +279,7 @@ void *OmnetppVectorFileWriter::registerVector(const std::string& componentFullPa
     VectorData *vp = new VectorData();
     vp->id = nextVectorId++;
     vp->recordEventNumbers = recordEventNumbers;
+    vp->shard = vp->id % numShards;
     vp->bufferedSamplesLimit = bufferSize / sizeof(Sample);
     if (vp->bufferedSamplesLimit > 0)
         vp->buffer.reserve(vp->bufferedSamplesLimit);
@@ -192,38 +310,92 @@ void OmnetppVectorFileWriter::deregisterVector(void *vectorhandle)
 }
 
 void OmnetppVectorFileWriter::recordInVector(void *vectorhandle, eventnumber_t eventNumber, rawsimtime_t t, int simtimeScaleExp, double value)
+{
+    //TODO ensure time and event number increase monotonically (and remove the same check from cOutVector)
+
+    recordInVector(vectorhandle, eventNumber, &t, simtimeScaleExp, &value, 1);
+}
+
+void OmnetppVectorFileWriter::recordInVector(void *vectorhandle, eventnumber_t eventNumber, const rawsimtime_t *times, int simtimeScaleExp, const double *values, int n)
 {
     Assert(f != nullptr && vectorhandle != nullptr);
     VectorData *vp = (VectorData *)vectorhandle;
 
-    //TODO ensure time and event number increase monotonically (and remove the same check from cOutVector)
+    int i = 0;
+    while (i < n) {
+        // append as many samples as fit into the vector's buffer
+        if (vp->buffer.empty()) {
+            vp->currentBlock.startEventNum = eventNumber;
+            vp->currentBlock.startTime = SimtimeValue{times[i], simtimeScaleExp};
+        }
+        int count = n - i;
+        if (vp->bufferedSamplesLimit > 0)
+            count = std::min(count, (int)(vp->bufferedSamplesLimit - vp->buffer.size()));
+        if (bufferedSamplesLimit > 0)
+            count = std::min(count, std::max(bufferedSamplesLimit - bufferedSamples, 1));
+        Statistics& statistics = vp->currentBlock.statistics;
+        for (int k = i; k < i + count; k++) {
+            vp->buffer.push_back(Sample(times[k], simtimeScaleExp, eventNumber, values[k]));
+            statistics.collect(values[k]);
+        }
+        i += count;
+        bufferedSamples += count;
 
-    // store value
-    vp->buffer.push_back(Sample(t, simtimeScaleExp, eventNumber, value));
-    this->bufferedSamples++;
+        vp->currentBlock.endEventNum = eventNumber;
+        vp->currentBlock.endTime = SimtimeValue{times[i-1], simtimeScaleExp};
 
-    // update vector statistics
-    if (vp->currentBlock.statistics.getCount() == 0) {
-        vp->currentBlock.startEventNum = eventNumber;
-        vp->currentBlock.startTime = SimtimeValue{t, simtimeScaleExp};
+        // write out block if necessary
+        if (vp->bufferedSamplesLimit > 0 && (int)vp->buffer.size() >= vp->bufferedSamplesLimit)
+            writeBlock(vp);
+        else if (bufferedSamplesLimit > 0 && bufferedSamples >= bufferedSamplesLimit)
+            writeRecords();
     }
-    vp->currentBlock.endEventNum = eventNumber;
-    vp->currentBlock.endTime = SimtimeValue{t, simtimeScaleExp};
-
-    vp->currentBlock.statistics.collect(value);
-
-    // write out block if necessary
-    if (vp->bufferedSamplesLimit > 0 && (int)vp->buffer.size() >= vp->bufferedSamplesLimit)
-        writeBlock(vp);
-    else if (bufferedSamplesLimit > 0 && bufferedSamples >= bufferedSamplesLimit)
-        writeRecords();
 }
 
 void OmnetppVectorFileWriter::writeRecords()
 {
+    if (shards.size() <= 1) {
+        for (auto vp : vectors)
+            if (!vp->buffer.empty())
+                writeBlock(vp);
+        return;
+    }
+
+    // write the data of the shards in parallel (shard 0 in this thread, the others
+    // by the workers), then the index entries sequentially
+    vectorsByShard.assign(shards.size(), Vectors());
     for (auto vp : vectors)
         if (!vp->buffer.empty())
-            writeBlock(vp);
+            vectorsByShard[vp->shard].push_back(vp);
+    shardOk.assign(shards.size(), true);
+
+    if (workers.empty()) {
+        for (int i = 0; i < (int)shards.size(); i++)
+            writeShard(i);
+    }
+    else {
+        {
+            std::lock_guard<std::mutex> lock(workerMutex);
+            batchNumber++;
+            pendingShards = (int)workers.size();
+        }
+        workAvailable.notify_all();
+        writeShard(0);
+        std::unique_lock<std::mutex> lock(workerMutex);
+        workDone.wait(lock, [this]() {return pendingShards == 0;});
+    }
+
+    for (int i = 0; i < (int)shards.size(); i++) {
+        if (!shardOk[i]) {
+            std::string shardFileName = shards[i].fname;
+            close();
+            throw opp_runtime_error("Cannot write output vector file '%s'", shardFileName.c_str());
+        }
+    }
+
+    for (auto vp : vectors)
+        if (!vp->buffer.empty())
+            writeBlockIndex(vp);
 }
 
 void OmnetppVectorFileWriter::writeBlock(VectorData *vp)
@@ -233,28 +405,75 @@ void OmnetppVectorFileWriter::writeBlock(VectorData *vp)
     Assert(vp != nullptr);
     Assert(!vp->buffer.empty());
 
-    char buf[64], buf2[64];
+    if (!writeBlockData(vp)) {
+        std::string shardFileName = shards[vp->shard].fname;
+        close();
+        throw opp_runtime_error("Cannot write output vector file '%s'", shardFileName.c_str());
+    }
+    writeBlockIndex(vp);
+}
 
-    Block& currentBlock = vp->currentBlock;
-    currentBlock.offset = opp_ftell(f);
+bool OmnetppVectorFileWriter::writeBlockData(VectorData *vp)
+{
+    FILE *fd = shards[vp->shard].f;
+    char buf[64];
 
-    if (vp->recordEventNumbers) {
-        for (auto sample : vp->buffer)
-            check(fprintf(f, "%d\t%" PRId64 "\t%s\t%.*g\n", vp->id, sample.eventNumber, sample.time.ttoa(buf), prec, sample.value));
+    Block& currentBlock = vp->currentBlock;
+    currentBlock.offset = opp_ftell(fd);
+
+    if (prec < 0 || prec > 40) {
+        // unusual precision, not supported by opp_writedouble()
+        for (const Sample& sample : vp->buffer) {
+            int result = vp->recordEventNumbers ?
+                    fprintf(fd, "%d\t%" PRId64 "\t%s\t%.*g\n", vp->id, sample.eventNumber, sample.time.ttoa(buf), prec, sample.value) :
+                    fprintf(fd, "%d\t%s\t%.*g\n", vp->id, sample.time.ttoa(buf), prec, sample.value);
+            if (result < 0)
+                return false;
+        }
     }
     else {
-        for (auto sample : vp->buffer)
-            check(fprintf(f, "%d\t%s\t%.*g\n", vp->id, sample.time.ttoa(buf), prec, sample.value));
+        // format lines into a chunk buffer without printf, and write it out with one call
+        const int MAX_LINE_LENGTH = 256;
+        char chunk[16384];
+        char *p = chunk;
+        for (const Sample& sample : vp->buffer) {
+            p = opp_writei64(p, vp->id);
+            *p++ = '\t';
+            if (vp->recordEventNumbers) {
+                p = opp_writei64(p, sample.eventNumber);
+                *p++ = '\t';
+            }
+            char *endp;
+            const char *time = opp_ttoa(buf, sample.time.t, sample.time.scaleExp, endp);
+            memcpy(p, time, endp - time);
+            p += endp - time;
+            *p++ = '\t';
+            p = opp_writedouble(p, sample.value, prec);
+            *p++ = '\n';
+            if (p > chunk + sizeof(chunk) - MAX_LINE_LENGTH) {
+                if (fwrite(chunk, 1, p - chunk, fd) != (size_t)(p - chunk))
+                    return false;
+                p = chunk;
+            }
+        }
+        if (p != chunk && fwrite(chunk, 1, p - chunk, fd) != (size_t)(p - chunk))
+            return false;
     }
 
-    currentBlock.size = opp_ftell(f) - currentBlock.offset;
-
-    Block& block = vp->currentBlock;
-    Statistics& stats = block.statistics;
+    currentBlock.size = opp_ftell(fd) - currentBlock.offset;
 
     // make sure that the offsets referred by the index file are exists in the vector file
     // so the index can be used to access the vector file while it is being written
-    fflush(f);
+    fflush(fd);
+    return true;
+}
+
+void OmnetppVectorFileWriter::writeBlockIndex(VectorData *vp)
+{
+    char buf[64], buf2[64];
+
+    Block& block = vp->currentBlock;
+    Statistics& stats = block.statistics;
 
     if (vp->recordEventNumbers) {
         checki(fprintf(fi, "%d\t%" PRId64 " %" PRId64 " %" PRId64 " %" PRId64 " %s %s %" PRId64 " %.*g %.*g %.*g %.*g\n",
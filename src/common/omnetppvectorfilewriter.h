@@ -21,6 +21,9 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "commondefs.h"
 #include "statistics.h"
 #include "omnetpp/platdep/platmisc.h"  // file_offset_t
@@ -31,6 +34,13 @@ namespace common {
 
 /**
  * Class for writing text-based output vector files.
+ *
+ * Vector data may optionally be sharded across several files (see
+ * setNumShards()). In that case the vector file itself only holds the run
+ * header, the vector declarations and the list of shard files, and data lines
+ * of vector i go into shard file i % numShards. Shards are written out in
+ * parallel on flush, by worker threads that live as long as the file is open.
+ * The index file (.vci) is common for all shards.
  */
 class COMMON_API OmnetppVectorFileWriter
 {
@@ -74,12 +84,18 @@ class COMMON_API OmnetppVectorFileWriter
 
     struct VectorData {
        int id;                    // vector ID
-       Samples buffer;            // buffer holding recorded data not yet written to the file
+       Samples buffer;            // buffer holding recorded data not yet written to the file (preallocated to bufferedSamplesLimit)
        long bufferedSamplesLimit; // maximum number of samples gathered in the buffer before writing out (0=no limit)
        bool recordEventNumbers;   // record the current event number for each sample
+       int shard;                 // index of the shard file that holds the vector data
        Block currentBlock;
     };
 
+    struct Shard {
+       std::string fname;     // file name of the shard
+       FILE *f = nullptr;     // file ptr of the shard, or the vector file if there is no sharding
+    };
+
     typedef std::vector<VectorData*> Vectors;
 
     std::string fname;     // output file name
@@ -90,6 +106,22 @@ class COMMON_API OmnetppVectorFileWriter
     std::string ifname;  // index file name
     FILE *fi = nullptr;  // file ptr of index file
 
+    int numShards = 1;             // number of files vector data are distributed among
+    std::vector<Shard> shards;     // data files; a single entry referring to the vector file if numShards==1
+
+    // worker threads for writing the shards in parallel; shard i (i>0) is written by
+    // workers[i-1], shard 0 by the calling thread. Empty if numShards==1 or if the
+    // threads could not be started (then shards are written sequentially)
+    std::vector<std::thread> workers;
+    std::mutex workerMutex;
+    std::condition_variable workAvailable;  // notified when a new batch is posted, or on shutdown
+    std::condition_variable workDone;       // notified when the last shard of the batch is written
+    uint64_t batchNumber = 0;               // incremented for each batch posted to the workers
+    int pendingShards = 0;                  // number of workers still busy with the current batch
+    bool stopWorkers = false;
+    std::vector<Vectors> vectorsByShard;    // vectors to be written in the current batch
+    std::vector<char> shardOk;              // result of writing each shard (not vector<bool>, as elements are written concurrently)
+
     Vectors vectors;               // registered output vectors
     int bufferedSamples = 0;       // currently total buffered samples
     int bufferedSamplesLimit = 0;  // limit of total buffered samples (0=no limit)
@@ -98,8 +130,14 @@ class COMMON_API OmnetppVectorFileWriter
     void cleanup();  // MUST NOT THROW
     void check(int fprintfResult);
     void checki(int fprintfResult);
+    void startWorkers();
+    void stopAndJoinWorkers();  // MUST NOT THROW
+    void workerMain(int shard, uint64_t lastBatch);
+    void writeShard(int shard);  // MUST NOT THROW
     virtual void writeRecords();
     virtual void writeBlock(VectorData *vp);
+    virtual bool writeBlockData(VectorData *vp);  // MUST NOT THROW (may be called from worker threads)
+    virtual void writeBlockIndex(VectorData *vp);
     virtual void finalizeVector(VectorData *vp);
 
   public:
@@ -114,12 +152,17 @@ class COMMON_API OmnetppVectorFileWriter
     int getPrecision() const {return prec;}
     void setOverallMemoryLimit(size_t limit) {bufferedSamplesLimit = limit / sizeof(Sample);}
     size_t getOverallMemoryLimit() const {return bufferedSamplesLimit * sizeof(Sample);}
+    void setNumShards(int n); // must be called before open()
+    int getNumShards() const {return numShards;}
+    static std::string getShardFileName(const std::string& vectorFileName, int shard);
+    static void removeShardFiles(const std::string& vectorFileName); // removes shard files of any number of shards
 
     void beginRecordingForRun(const std::string& runName, const StringMap& attributes, const StringMap& itervars, const OrderedKeyValueList& paramAssignments);
     void endRecordingForRun();
     void *registerVector(const std::string& componentFullPath, const std::string& name, const StringMap& attributes, size_t bufferSize, bool recordEventNumbers);
     void deregisterVector(void *vechandle);
     void recordInVector(void *vectorhandle, eventnumber_t eventNumber, rawsimtime_t t, int simtimeScaleExp, double value);
+    void recordInVector(void *vectorhandle, eventnumber_t eventNumber, const rawsimtime_t *times, int simtimeScaleExp, const double *values, int n);
 
     void flush();
 };
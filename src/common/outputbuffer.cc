@@ -0,0 +1,112 @@
+//=========================================================================
+//  OUTPUTBUFFER.CC - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <algorithm>
+#include "stringutil.h"
+#include "outputbuffer.h"
+
+namespace omnetpp {
+namespace common {
+
+OutputBuffer::OutputBuffer()
+{
+    buffer = end = new char[CAPACITY];
+    limit = buffer + CAPACITY - MAX_NUMBER_LENGTH;
+}
+
+OutputBuffer::~OutputBuffer()
+{
+    // note: no flush(), the owner is responsible for it
+    delete[] buffer;
+}
+
+void OutputBuffer::setOutput(std::ostream *os)
+{
+    flush();
+    this->os = os;
+    this->file = nullptr;
+}
+
+void OutputBuffer::setOutput(FILE *file)
+{
+    flush();
+    this->os = nullptr;
+    this->file = file;
+}
+
+bool OutputBuffer::flush()
+{
+    size_t len = end - buffer;
+    if (len != 0) {
+        if (os) {
+            os->write(buffer, len);
+            if (!*os)
+                error = true;
+        }
+        else if (file) {
+            if (fwrite(buffer, 1, len, file) != len)
+                error = true;
+        }
+        end = buffer;
+    }
+    return !error;
+}
+
+void OutputBuffer::write(const char *s, size_t len)
+{
+    if (end + len <= limit) {
+        memcpy(end, s, len);
+        end += len;
+    }
+    else {
+        while (len > 0) {
+            if (end == buffer + CAPACITY)
+                flush();
+            size_t chunk = std::min(len, (size_t)(buffer + CAPACITY - end));
+            memcpy(end, s, chunk);
+            end += chunk;
+            s += chunk;
+            len -= chunk;
+        }
+    }
+}
+
+void OutputBuffer::writeSpaces(int n)
+{
+    while (n > 0) {
+        static const char spaces[] = "                                ";
+        int chunk = std::min(n, (int)sizeof(spaces) - 1);
+        write(spaces, chunk);
+        n -= chunk;
+    }
+}
+
+void OutputBuffer::writeInt(int64_t value)
+{
+    makeRoom(MAX_NUMBER_LENGTH);
+    end = opp_writei64(end, value);
+}
+
+void OutputBuffer::writeDouble(double value, int prec)
+{
+    if (prec < 0 || prec > 40) {
+        write(opp_stringf("%.*g", prec, value));  // rare, and may be very long
+        return;
+    }
+    makeRoom(MAX_NUMBER_LENGTH);
+    end = opp_writedouble(end, value, prec);
+}
+
+}  // namespace common
+}  // namespace omnetpp
@@ -0,0 +1,86 @@
+//=========================================================================
+//  OUTPUTBUFFER.H - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_OUTPUTBUFFER_H
+#define __OMNETPP_COMMON_OUTPUTBUFFER_H
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <ostream>
+#include "commondefs.h"
+
+namespace omnetpp {
+namespace common {
+
+/**
+ * Output buffer for text writers (JSON, CSV, etc.) Numbers are formatted
+ * directly into the buffer, without iostreams and temporary strings, and
+ * the contents are passed to the underlying std::ostream or FILE in large
+ * chunks, when the buffer fills up or when flush() is called.
+ */
+class COMMON_API OutputBuffer
+{
+  private:
+    static const size_t CAPACITY = 64*1024;
+    static const size_t MAX_NUMBER_LENGTH = 64; // see opp_writedouble()
+    char *buffer;
+    char *end;    // end of the contents
+    char *limit;  // numbers and single chars are only written below this, to avoid range checks
+    std::ostream *os = nullptr;
+    FILE *file = nullptr;
+    bool error = false;
+
+  private:
+    void makeRoom(size_t len) {if (end + len > limit) flush();}
+
+  public:
+    OutputBuffer();
+    OutputBuffer(const OutputBuffer&) = delete;
+    ~OutputBuffer();
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    /**
+     * Sets the output, after flushing the contents to the previous one.
+     */
+    void setOutput(std::ostream *os);
+    void setOutput(FILE *file);
+
+    void write(const char *s, size_t len);
+    void write(const char *s) {write(s, strlen(s));}
+    void write(const std::string& s) {write(s.data(), s.size());}
+    void write(char c) {makeRoom(1); *end++ = c;}
+    void writeSpaces(int n);
+    void writeInt(int64_t value);
+    void writeDouble(double value, int prec); // like printf("%.*g"); value must be finite
+
+    /**
+     * Passes the contents to the output. Returns false if an error occurred,
+     * either now or during an earlier implicit flush.
+     */
+    bool flush();
+
+    /**
+     * Returns true if writing to the output has failed at some point.
+     */
+    bool hasError() const {return error;}
+    void clearError() {error = false;}
+};
+
+}  // namespace common
+}  // namespace omnetpp
+
+
+#endif
@@ -36,18 +36,9 @@ static const char *ERR_MISSING_LIBXML =
 void DefaultSaxParser::parseFile(const char *filename)
 {
     // The "yxml" parser does not support DTD validation, so use libXML instead
-    // for documents that have one. To this end, we read the beginning of the file
-    // to determine whether it contains a DOCTYPE declaration or not.
-
-    char head[4096] = "";
-    FILE *f = fopen(filename, "r");
-    if (f) {
-        size_t len = fread(head, 1, sizeof(head)-1, f);
-        head[len] = 0;
-        fclose(f);
-    }
+    // for documents that have one.
 
-    if (containsDoctype(head)) {
+    if (fileContainsDoctype(filename)) {
 #ifdef WITH_LIBXML
         LibxmlSaxParser parser;
         parser.setHandler(saxHandler);
@@ -84,6 +75,19 @@ void DefaultSaxParser::parseContent(const char *content)
     }
 }
 
+bool DefaultSaxParser::fileContainsDoctype(const char *filename)
+{
+    // read the beginning of the file to determine whether it contains a DOCTYPE declaration or not
+    char head[4096] = "";
+    FILE *f = fopen(filename, "r");
+    if (f) {
+        size_t len = fread(head, 1, sizeof(head)-1, f);
+        head[len] = 0;
+        fclose(f);
+    }
+    return containsDoctype(head);
+}
+
 bool DefaultSaxParser::containsDoctype(const char *s)
 {
     // a doctype declaration starts with "<!DOCTYPE", but that string may also occur inside of a CDATA section
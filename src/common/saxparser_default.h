@@ -25,9 +25,11 @@ namespace common {
 
 class COMMON_API DefaultSaxParser : public SaxParser
 {
-  protected:
-    bool containsDoctype(const char *s);
   public:
+    // whether the document contains a DOCTYPE declaration (i.e. needs a DTD-aware parser)
+    static bool containsDoctype(const char *s);
+    static bool fileContainsDoctype(const char *filename);
+
     virtual void parseFile(const char *filename) override;
     virtual void parseContent(const char *content) override;
     virtual int getCurrentLineNumber() override {return -1;} // unused
@@ -160,18 +160,21 @@ void YxmlSaxParser::parseChunk(const char *chunk, int chunklen)
     }
 }
 
-void YxmlSaxParser::error(yxml_ret_t r)
+const char *YxmlSaxParser::getErrorMessage(yxml_ret_t r)
 {
-    const char *msg;
     switch(r) {
-        case YXML_EEOF: msg = "Unexpected end of document"; break;
-        case YXML_EREF: msg = "Invalid character reference or entity reference"; break;
-        case YXML_ECLOSE: msg = "Close tag does not match open tag"; break;
-        case YXML_ESTACK: msg = "Parse buffer too small (document is too deeply nested or an element name, attribute name or PI target is too long)"; break;
-        case YXML_ESYN: msg = "Syntax error"; break;
-        default: msg = "Unknown error code"; break;
+        case YXML_EEOF: return "Unexpected end of document";
+        case YXML_EREF: return "Invalid character reference or entity reference";
+        case YXML_ECLOSE: return "Close tag does not match open tag";
+        case YXML_ESTACK: return "Parse buffer too small (document is too deeply nested or an element name, attribute name or PI target is too long)";
+        case YXML_ESYN: return "Syntax error";
+        default: return "Unknown error code";
     }
-    throw opp_runtime_error("Parse error: %s at %s:%u", msg, lastFilename.c_str(), (unsigned)parserState.line);
+}
+
+void YxmlSaxParser::error(yxml_ret_t r)
+{
+    throw opp_runtime_error("Parse error: %s at %s:%u", getErrorMessage(r), lastFilename.c_str(), (unsigned)parserState.line);
 }
 
 }  // namespace common
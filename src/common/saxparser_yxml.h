@@ -57,6 +57,9 @@ class COMMON_API YxmlSaxParser : public SaxParser
     virtual int getCurrentLineNumber() override;
     void setDiscardIgnorableWhitespace(bool b) {discardIgnorableWhitespace = b;}
     bool getDiscardIgnorableWhitespace() const {return discardIgnorableWhitespace;}
+
+    // for other users of yxml
+    static const char *getErrorMessage(yxml_ret_t r);
 };
 
 }  // namespace common
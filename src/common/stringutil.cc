@@ -20,6 +20,7 @@
 #include <cmath>  // HUGE_VAL
 #include <clocale>
 #include <algorithm>
+#include <charconv>
 #include "omnetpp/platdep/platmisc.h"
 #include "commonutil.h"
 #include "opp_ctype.h"
@@ -804,10 +805,57 @@ char *opp_ltoa(char *buf, long d)
 
 char *opp_i64toa(char *buf, int64_t d)
 {
-    snprintf(buf, 20, "%" PRId64, d);
+    opp_writei64(buf, d);
     return buf;
 }
 
+char *opp_writei64(char *buf, int64_t d)
+{
+    static const char digitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    // produce the digits backwards into a temp buffer, two at a time
+    char tmp[20];
+    char *p = tmp + sizeof(tmp);
+    uint64_t u = d < 0 ? -(uint64_t)d : (uint64_t)d;
+    while (u >= 100) {
+        const char *pair = digitPairs + 2 * (u % 100);
+        u /= 100;
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    if (u >= 10) {
+        const char *pair = digitPairs + 2 * u;
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    else {
+        *--p = '0' + u;
+    }
+
+    if (d < 0)
+        *buf++ = '-';
+    size_t len = tmp + sizeof(tmp) - p;
+    memcpy(buf, p, len);
+    buf[len] = '\0';
+    return buf + len;
+}
+
+char *opp_writedouble(char *buf, double d, int prec)
+{
+    Assert(prec >= 0 && prec <= 40);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    // specified to produce the same output as printf's "%.*g"
+    std::to_chars_result result = std::to_chars(buf, buf + 63, d, std::chars_format::general, prec);
+    *result.ptr = '\0';
+    return result.ptr;
+#else
+    return buf + snprintf(buf, 64, "%.*g", prec, d);
+#endif
+}
+
 char *opp_dtoa(char *buf, const char *format, double d)
 {
     if (std::isfinite(d))
@@ -413,6 +413,22 @@ COMMON_API char *opp_ltoa(char *buf, long d);
  */
 COMMON_API char *opp_i64toa(char *buf, int64_t d);
 
+/**
+ * Prints the d integer into the given buffer without going through printf,
+ * and returns a pointer to the terminating null character. The buffer must
+ * be at least 21 bytes long.
+ */
+COMMON_API char *opp_writei64(char *buf, int64_t d);
+
+/**
+ * Prints the d double into the given buffer in the same format as
+ * printf("%.*g", prec, d) would in the "C" locale, and returns a pointer to
+ * the terminating null character. It is considerably faster than printf
+ * where the C++ library provides floating-point std::to_chars(). prec must
+ * be in the 0..40 range, and the buffer must be at least 64 bytes long.
+ */
+COMMON_API char *opp_writedouble(char *buf, double d, int prec);
+
 /**
  * Prints the d double into the given buffer, then returns the buffer pointer.
  * If d is finite, the given printf format is used (e.g. "%g"), otherwise
@@ -140,6 +140,9 @@ const UnitConversion::Unit UnitConversion::unitTable[] = {  // note: imperial un
 const UnitConversion::Unit *UnitConversion::hashTable[HASHTABLESIZE];
 int UnitConversion::numCollisions = 0;
 
+unsigned char UnitConversion::shortNameTable[SHORTNAMETABLESIZE];
+unsigned UnitConversion::shortNameHashSeed = 0;
+
 const UnitConversion::Unit *UnitConversion::bitsUnit;
 const UnitConversion::Unit *UnitConversion::bytesUnit;
 const UnitConversion::Unit *UnitConversion::secondsUnit;
@@ -195,12 +198,33 @@ inline unsigned UnitConversion::hashCode(const char *unitName)
     return result;
 }
 
+inline unsigned UnitConversion::shortNameHashCode(const char *unitName, unsigned seed)
+{
+    // FNV-1a, with the seed mixed into the offset basis
+    unsigned result = 2166136261u ^ seed;
+    for (const char *s = unitName; *s; s++)
+        result = (result ^ (unsigned char)*s) * 16777619u;
+    return (result ^ (result >> 15)) & (SHORTNAMETABLESIZE-1);
+}
+
+inline const UnitConversion::Unit *UnitConversion::lookupUnitByShortName(const char *unitName)
+{
+    int id = shortNameTable[shortNameHashCode(unitName, shortNameHashSeed)];
+    if (id != 0 && strcmp(unitTable[id-1].name, unitName) == 0)
+        return unitTable + id - 1;
+    return nullptr;
+}
+
 const UnitConversion::Unit *UnitConversion::lookupUnit(const char *unitName)
 {
     if (!unitName || !*unitName)
         return nullptr; // nullptr or empty string is not a unit
 
-    // hash table lookup
+    // units in models and ini files are nearly always given with their short names
+    if (const Unit *unit = lookupUnitByShortName(unitName))
+        return unit;
+
+    // hash table lookup, also covers long names
     unsigned hash = hashCode(unitName);
     for (unsigned pos = hash & (HASHTABLESIZE-1); hashTable[pos]; pos = (pos+1) & (HASHTABLESIZE-1))
         if (matches(hashTable[pos], unitName))
@@ -244,6 +268,7 @@ void UnitConversion::insert(const char *key, const Unit *unit)
 void UnitConversion::init()
 {
     fillHashtable();
+    fillShortNameTable();
     fillUnitData();
 }
 
@@ -256,6 +281,32 @@ void UnitConversion::fillHashtable()
     Assert(numCollisions <= 25); // 21 collisions observed at the time of writing
 }
 
+void UnitConversion::fillShortNameTable()
+{
+    int numUnits = 0;
+    for (const Unit *p = unitTable; p->name; p++)
+        numUnits++;
+    Assert(numUnits < 256); // IDs must fit into the table entries
+
+    // find a seed for which the hash function has no collisions on the short names
+    for (unsigned seed = 0; seed < 100000; seed++) {
+        std::fill(shortNameTable, shortNameTable + SHORTNAMETABLESIZE, 0);
+        bool collision = false;
+        for (int i = 0; i < numUnits && !collision; i++) {
+            unsigned char& slot = shortNameTable[shortNameHashCode(unitTable[i].name, seed)];
+            if (slot != 0)
+                collision = true;
+            else
+                slot = i + 1;
+        }
+        if (!collision) {
+            shortNameHashSeed = seed;
+            return;
+        }
+    }
+    Assert(false); // no suitable seed found; increase SHORTNAMETABLESIZE
+}
+
 inline bool isWholeNumber(double x) { return fabs(x - floor(x+0.5)) < 1e-15; }
 
 void UnitConversion::fillUnitData()
@@ -326,11 +377,12 @@ bool UnitConversion::readNumber(const char *& s, double& number)
 
 bool UnitConversion::readUnit(const char *& s, std::string& unitName)
 {
-    unitName = "";
     while (opp_isspace(*s))
         s++;
+    const char *start = s;
     while (opp_isalpha(*s))
-        unitName.append(1, *s++);
+        s++;
+    unitName.assign(start, s - start);
     while (opp_isspace(*s))
         s++;
     return !unitName.empty();
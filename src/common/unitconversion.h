@@ -57,6 +57,12 @@ class COMMON_API UnitConversion
     static const Unit *hashTable[HASHTABLESIZE];
     static int numCollisions;
 
+    // collision-free (perfect) hash table for the short names of units, keyed
+    // by a case-sensitive hash; contains unit IDs, 0 marks empty slots
+    static const int SHORTNAMETABLESIZE = 1024; // must be power of 2
+    static unsigned char shortNameTable[SHORTNAMETABLESIZE];
+    static unsigned shortNameHashSeed;
+
   public:
     enum Preference { PREFER, AVOID, KEEP };
 
@@ -84,13 +90,17 @@ class COMMON_API UnitConversion
 
   protected:
     static unsigned hashCode(const char *unitName);
+    static unsigned shortNameHashCode(const char *unitName, unsigned seed);
     static bool matches(const Unit *unit, const char *unitName);
     static void insert(const char *key, const Unit *unit);
     static void fillHashtable();
+    static void fillShortNameTable();
     static void fillUnitData();
 
     static const Unit *lookupUnit(const char *unit);
+    static const Unit *lookupUnitByShortName(const char *unit);
     static const Unit *getUnit(const char *unit);
+    static int getUnitIdOf(const Unit *unit) {return unit ? unit - unitTable + 1 : -1;}
     static std::vector<const Unit *> lookupUnits(const std::vector<const char *>& unitNames);
     static bool readNumber(const char *&s, double& number);
     static bool readUnit(const char *&s, std::string& unit);
@@ -169,6 +179,35 @@ class COMMON_API UnitConversion
      */
     static double convertUnit(double d, const char *unit, const char *targetUnit);
 
+    /**
+     * Returns a small integer that identifies the given unit, for use with
+     * the ID-based conversion methods below. Returns 0 for no unit (nullptr
+     * or empty string), a positive number for known units, and -1 for
+     * unrecognized (custom) units. Note that all custom units share the
+     * same ID, so IDs cannot be used to tell whether two custom units match.
+     * Callers that convert the same unit repeatedly should obtain the ID
+     * once and store it.
+     */
+    static int getUnitId(const char *unit) {return (!unit || !*unit) ? 0 : getUnitIdOf(lookupUnit(unit));}
+
+    /**
+     * Like getConversionFactor(const char *, const char *), but with units
+     * given by their IDs (see getUnitId()). Returns 0.0 for custom units,
+     * even if they are the same.
+     */
+    static double getConversionFactor(int unitId, int targetUnitId);
+
+    /**
+     * Converts the given value between units given by their IDs (see
+     * getUnitId()) if the conversion is linear, i.e. the units measure the
+     * same quantity and are not logarithmic, and returns true. The result
+     * is exactly the same as that of convertUnit(). Otherwise, it returns
+     * false and leaves the value unchanged; callers should then fall back
+     * to convertUnit(), which also handles logarithmic units and reports
+     * errors.
+     */
+    static bool tryConvertLinear(double& d, int unitId, int targetUnitId);
+
     /**
      * Returns the list of known units that the given one may be converted into, i.e.
      * the ones for which convertUnit() will not raise an error. For unknown
@@ -237,6 +276,33 @@ class COMMON_API UnitConversion
     static std::vector<const char *> getKnownUnits();
 };
 
+inline double UnitConversion::getConversionFactor(int unitId, int targetUnitId)
+{
+    if (unitId == targetUnitId && unitId >= 0)
+        return 1.0;
+    if (unitId <= 0 || targetUnitId <= 0)
+        return 0;
+    const Unit *unit = unitTable + unitId - 1;
+    const Unit *targetUnit = unitTable + targetUnitId - 1;
+    if (unit->baseUnit != targetUnit->baseUnit || unit->mapping != LINEAR || targetUnit->mapping != LINEAR)
+        return 0;
+    return unit->mult * (1.0 / targetUnit->mult);  // same result as tryGetConversionFactor()
+}
+
+inline bool UnitConversion::tryConvertLinear(double& d, int unitId, int targetUnitId)
+{
+    if (unitId == targetUnitId && unitId >= 0)
+        return true;
+    if (unitId <= 0 || targetUnitId <= 0)
+        return false;
+    const Unit *unit = unitTable + unitId - 1;
+    const Unit *targetUnit = unitTable + targetUnitId - 1;
+    if (unit->baseUnit != targetUnit->baseUnit || unit->mapping != LINEAR || targetUnit->mapping != LINEAR)
+        return false;
+    d = d * unit->mult / targetUnit->mult;  // same operations as tryConvert(), for identical results
+    return true;
+}
+
 }  // namespace common
 }  // namespace omnetpp
 
@@ -273,7 +273,6 @@ void AppBase::printRunInfo(const char *configName, const char *runFilter, const
                 out << "Number of runs selected: " << runNumbers.size() << endl;
         }
 
-        std::vector<InifileContents::RunInfo> runInfos = ini->unrollConfig(configName);
         if (q == "numruns") {
             if (!verbose) // otherwise it was already printed
                 out << runNumbers.size() << endl;
@@ -291,7 +290,7 @@ void AppBase::printRunInfo(const char *configName, const char *runFilter, const
             if (verbose)
                 out << endl;
             for (int runNumber : runNumbers) {
-                const InifileContents::RunInfo& runInfo = runInfos[runNumber];
+                InifileContents::RunInfo runInfo = ini->getRunInfo(configName, runNumber);
                 out << "Run " << runNumber << ": " << runInfo.info << endl;
             }
         }
@@ -299,7 +298,7 @@ void AppBase::printRunInfo(const char *configName, const char *runFilter, const
             if (verbose)
                 out << endl;
             for (int runNumber : runNumbers) {
-                const InifileContents::RunInfo& runInfo = runInfos[runNumber];
+                InifileContents::RunInfo runInfo = ini->getRunInfo(configName, runNumber);
                 out << "Run " << runNumber << ": " << runInfo.info << endl;
                 out << opp_indentlines(runInfo.configBrief, "\t");
                 if (runNumber != runNumbers.back())
@@ -310,7 +309,7 @@ void AppBase::printRunInfo(const char *configName, const char *runFilter, const
             if (verbose)
                 out << endl;
             for (int runNumber : runNumbers) {
-                const InifileContents::RunInfo& runInfo = runInfos[runNumber];
+                InifileContents::RunInfo runInfo = ini->getRunInfo(configName, runNumber);
                 out << "Run " << runNumber << ": " << runInfo.info << endl;
                 cConfiguration *cfg = ini->extractConfig(configName, runNumber);
                 std::vector<const char *> keysValues = cfg->getKeyValuePairs(cConfiguration::FILT_ALL);
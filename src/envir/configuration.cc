@@ -39,22 +39,14 @@ Register_Class(Configuration);
 
 #define VARPOS_PREFIX    std::string("&")
 
-Configuration::MatchableEntry::MatchableEntry(const MatchableEntry& e) :
-    Entry(e),
-    ownerPattern(e.ownerPattern ? new PatternMatcher(*e.ownerPattern) : nullptr),
-    suffixPattern(e.suffixPattern ? new PatternMatcher(*e.suffixPattern) : nullptr),
-    fullPathPattern(e.fullPathPattern ? new PatternMatcher(*e.fullPathPattern) : nullptr)
-{
-}
-
-Configuration::MatchableEntry::~MatchableEntry()
+ConfigurationIndex::MatchableEntry::~MatchableEntry()
 {
     delete ownerPattern;
     delete suffixPattern;
     delete fullPathPattern;
 }
 
-std::string Configuration::MatchableEntry::debugStr() const
+std::string ConfigurationIndex::MatchableEntry::debugStr() const
 {
     return std::string("ownerPattern=") + (ownerPattern ? ownerPattern->str() : "nullptr") +
            " suffixPattern=" + (suffixPattern ? suffixPattern->str() : "nullptr") +
@@ -63,22 +55,139 @@ std::string Configuration::MatchableEntry::debugStr() const
 
 //----
 
-Configuration::Configuration(const std::vector<InifileContents::Entry>& entries, const StringMap& predefinedVars, const StringMap& iterationVars, const char *fileName)
+ConfigurationIndex::ConfigurationIndex(const std::vector<Entry>& entries) : entries(entries)
+{
+    for (int i = 0; i < (int)entries.size(); i++)
+        addEntry(i);
+}
+
+ConfigurationIndex::~ConfigurationIndex()
+{
+    for (MatchableEntry *entry : matchableEntries)
+        delete entry;
+}
+
+void ConfigurationIndex::addEntry(int entryIndex)
+{
+    const char *key = entries[entryIndex].getKey();
+    const char *lastDot = strrchr(key, '.');
+    if (!lastDot && !PatternMatcher::containsWildcards(key)) {
+        // config: add if not already in there
+        if (config.find(key) == config.end())
+            config[key] = entryIndex;
+    }
+    else {
+        // key contains wildcard or dot: parameter or per-object configuration
+        // (example: "**", "**.param", "**.partition-id")
+        // Note: since the last part of they key might contain wildcards, it is not really possible
+        // to distinguish the two. Cf "vector-recording", "vector-*" and "vector*"
+
+        // analyze key and create appropriate entry
+        std::string ownerName;
+        std::string suffix;
+        splitKey(key, ownerName, suffix);
+        bool suffixContainsWildcards = PatternMatcher::containsWildcards(suffix.c_str());
+
+        MatchableEntry *entry = new MatchableEntry(entryIndex);
+        if (!ownerName.empty())
+            entry->ownerPattern = new PatternMatcher(ownerName.c_str(), true, true, true);
+        else
+            entry->fullPathPattern = new PatternMatcher(key, true, true, true);
+        entry->suffixPattern = suffixContainsWildcards ? new PatternMatcher(suffix.c_str(), true, true, true) : nullptr;
+        matchableEntries.push_back(entry);
+
+        // find which bin it should go into
+        if (!suffixContainsWildcards) {
+            // no wildcard in suffix
+            SuffixBin& bin = getOrCreateBin(suffix);
+            bin.entries.push_back(entry);
+        }
+        else {
+            // suffix contains wildcard
+            wildcardSuffixBin.entries.push_back(entry);
+
+            // We also need to add it to all existing suffix bins it matches.
+            // Note: if suffix also contains a hyphen, that's actually illegal (per-object
+            // config entry names cannot be wildcarded, ie. "foo.bar.cmdenv-*" is illegal),
+            // but causes no harm, because getPerObjectConfigEntry() won't look into the
+            // wildcard bin
+            for (auto & suffixBin : suffixBins)
+                if (entry->suffixPattern->covers(suffixBin.first.c_str()))
+                    (suffixBin.second).entries.push_back(entry);
+        }
+    }
+}
+
+ConfigurationIndex::SuffixBin& ConfigurationIndex::getOrCreateBin(const std::string& suffix)
+{
+    auto it = suffixBins.find(suffix);
+    if (it != suffixBins.end())
+        return it->second;
+
+    // suffix bin not yet exists, create it
+    SuffixBin& bin = suffixBins[suffix];
+
+    // initialize bin with matching wildcard keys seen so far
+    for (auto wildcardEntry : wildcardSuffixBin.entries)
+        if (wildcardEntry->suffixPattern->covers(suffix.c_str()))
+            bin.entries.push_back(wildcardEntry);
+    return bin;
+}
+
+const ConfigurationIndex::SuffixBin *ConfigurationIndex::findSuffixBin(const char *suffix) const
+{
+    auto it = suffixBins.find(suffix);
+    return it == suffixBins.end() ? nullptr : &it->second;
+}
+
+//----
+
+Configuration::Configuration() :
+    index(std::make_shared<ConfigurationIndex>(std::vector<InifileContents::Entry>()))
+{
+}
+
+Configuration::Configuration(const std::vector<InifileContents::Entry>& entries, const StringMap& predefinedVars, const StringMap& iterationVars, const char *fileName) :
+    index(std::make_shared<ConfigurationIndex>(entries))
 {
-    for (const InifileContents::Entry& entry : entries)
-        addEntry(Entry(entry));
+    setEntries(std::map<int,std::string>());
 
     predefinedVariables = predefinedVars;
     iterationVariables = iterationVars;
     allVariables = unionOf(predefinedVariables, iterationVariables);
 
-    fileName = opp_nulltoempty(fileName);
+    this->fileName = opp_nulltoempty(fileName);
+}
+
+Configuration::Configuration(const std::shared_ptr<const ConfigurationIndex>& index, const std::map<int,std::string>& substitutedValues, const StringMap& predefinedVars, const StringMap& iterationVars, const char *fileName) :
+    index(index)
+{
+    setEntries(substitutedValues);
+
+    predefinedVariables = predefinedVars;
+    iterationVariables = iterationVars;
+    allVariables = unionOf(predefinedVariables, iterationVariables);
+
+    this->fileName = opp_nulltoempty(fileName);
 }
 
 Configuration::~Configuration()
 {
-    for (Entry *entry : entries)
-        delete entry;
+}
+
+void Configuration::setEntries(const std::map<int,std::string>& substitutedValues)
+{
+    // entries are shared with the index, except those whose values have been substituted
+    int numEntries = index->getNumEntries();
+    entries.resize(numEntries);
+    accessed.assign(numEntries, false);
+    for (int i = 0; i < numEntries; i++)
+        entries[i] = &index->getEntry(i);
+    for (const auto& pair : substitutedValues) {
+        const Entry& e = index->getEntry(pair.first);
+        ownEntries.push_back(std::unique_ptr<Entry>(new Entry(e.getBaseDirectory(), e.getKey(), pair.second.c_str(), e.getComment(), e.getOriginSection(), e.getSourceLocation())));
+        entries[pair.first] = ownEntries.back().get();
+    }
 }
 
 const char *Configuration::getFileName() const
@@ -225,82 +334,7 @@ const char *Configuration::getVariable(const char *varname) const
     return nullptr;
 }
 
-void Configuration::addEntry(const InifileContents::Entry& iniEntry)
-{
-    const char *key = iniEntry.getKey();
-    const char *lastDot = strrchr(key, '.');
-    if (!lastDot && !PatternMatcher::containsWildcards(key)) {
-        Entry *entry = new Entry(iniEntry);
-        entries.push_back(entry);
-
-        // config: add if not already in there
-        if (config.find(key) == config.end())
-            config[key] = entry;
-    }
-    else {
-        // key contains wildcard or dot: parameter or per-object configuration
-        // (example: "**", "**.param", "**.partition-id")
-        // Note: since the last part of they key might contain wildcards, it is not really possible
-        // to distinguish the two. Cf "vector-recording", "vector-*" and "vector*"
-
-        // analyze key and create appropriate entry
-        std::string ownerName;
-        std::string suffix;
-        splitKey(key, ownerName, suffix);
-        bool suffixContainsWildcards = PatternMatcher::containsWildcards(suffix.c_str());
-
-        MatchableEntry *entry = new MatchableEntry(iniEntry);
-        if (!ownerName.empty())
-            entry->ownerPattern = new PatternMatcher(ownerName.c_str(), true, true, true);
-        else
-            entry->fullPathPattern = new PatternMatcher(key, true, true, true);
-        entry->suffixPattern = suffixContainsWildcards ? new PatternMatcher(suffix.c_str(), true, true, true) : nullptr;
-        entries.push_back(entry);
-
-        // find which bin it should go into
-        if (!suffixContainsWildcards) {
-            // no wildcard in suffix
-            SuffixBin& bin = getOrCreateBin(suffix);
-            addToBin(bin, entry);
-        }
-        else {
-            // suffix contains wildcard
-            addToBin(wildcardSuffixBin, entry);
-
-            // We also need to add it to all existing suffix bins it matches.
-            // Note: if suffix also contains a hyphen, that's actually illegal (per-object
-            // config entry names cannot be wildcarded, ie. "foo.bar.cmdenv-*" is illegal),
-            // but causes no harm, because getPerObjectConfigEntry() won't look into the
-            // wildcard bin
-            for (auto & suffixBin : suffixBins)
-                if (entry->suffixPattern->covers(suffixBin.first.c_str()))
-                    (suffixBin.second).entries.push_back(entry);
-        }
-    }
-}
-
-Configuration::SuffixBin& Configuration::getOrCreateBin(const std::string& suffix)
-{
-    auto it = suffixBins.find(suffix);
-    if (it != suffixBins.end())
-        return it->second;
-
-    // suffix bin not yet exists, create it
-    SuffixBin& bin = suffixBins[suffix];
-
-    // initialize bin with matching wildcard keys seen so far
-    for (auto wildcardEntry : wildcardSuffixBin.entries)
-        if (wildcardEntry->suffixPattern->covers(suffix.c_str()))
-            bin.entries.push_back(wildcardEntry);
-    return bin;
-}
-
-void Configuration::addToBin(SuffixBin& bin, MatchableEntry *entry)
-{
-    bin.entries.push_back(entry);
-}
-
-void Configuration::splitKey(const char *key, std::string& outOwnerName, std::string& outBinName)
+void ConfigurationIndex::splitKey(const char *key, std::string& outOwnerName, std::string& outBinName)
 {
     std::string tmp = key;
 
@@ -333,16 +367,18 @@ void Configuration::splitKey(const char *key, std::string& outOwnerName, std::st
 
 const char *Configuration::getConfigValue(const char *key) const
 {
+    const auto& config = index->getConfigEntries();
     auto it = config.find(key);
-    return it == config.end() ? nullptr : it->second->markAccessed().getValue();
+    return it == config.end() ? nullptr : markAccessed(it->second).getValue();
 }
 
 const cConfiguration::KeyValue& Configuration::getConfigEntry(const char *key) const
 {
+    const auto& config = index->getConfigEntries();
     auto it = config.find(key);
     if (it == config.end())
         return nullEntry;
-    return it->second->markAccessed();
+    return markAccessed(it->second);
 }
 
 std::vector<const char *> Configuration::getMatchingConfigKeys(const char *pattern) const
@@ -351,7 +387,7 @@ std::vector<const char *> Configuration::getMatchingConfigKeys(const char *patte
     PatternMatcher matcher(pattern, true, true, true);
 
     // iterate over the map -- this is going to be sloooow...
-    for (const auto & it : config)
+    for (const auto & it : index->getConfigEntries())
         if (matcher.matches(it.first.c_str()))
             result.push_back(it.first.c_str());
     return result;
@@ -367,14 +403,15 @@ const char *Configuration::getParameterValue(const char *moduleFullPath, const c
 const cConfiguration::KeyValue& Configuration::getParameterEntry(const char *moduleFullPath, const char *paramName, bool hasDefaultValue) const
 {
     // look up which bin; paramName serves as suffix (ie. bin name)
-    auto it = suffixBins.find(paramName);
-    const SuffixBin *bin = it == suffixBins.end() ? &wildcardSuffixBin : &it->second;
+    const SuffixBin *bin = index->findSuffixBin(paramName);
+    if (!bin)
+        bin = &index->getWildcardSuffixBin();
 
     // find first match in the bin
     for (const auto & entry : bin->entries) {
         if (entryMatches(entry, moduleFullPath, paramName))
-            if (hasDefaultValue || !opp_streq(entry->getValue(), "default"))
-                return entry->markAccessed();
+            if (hasDefaultValue || !opp_streq(entries[entry->entryIndex]->getValue(), "default"))
+                return markAccessed(entry->entryIndex);
     }
     return nullEntry;
 }
@@ -450,16 +487,14 @@ const cConfiguration::KeyValue& Configuration::getPerObjectConfigEntry(const cha
     // look up which bin; keySuffix serves as bin name
     // Note: we do not accept wildcards in the config key's name (ie. "**.record-*" is invalid),
     // so we ignore the wildcard bin.
-    std::map<std::string, SuffixBin>::const_iterator it = suffixBins.find(keySuffix);
-    if (it == suffixBins.end())
+    const SuffixBin *suffixBin = index->findSuffixBin(keySuffix);
+    if (!suffixBin)
         return nullEntry;  // no such bin
 
-    const SuffixBin *suffixBin = &it->second;
-
     // find first match in the bin
     for (const auto & entry : suffixBin->entries) {
         if (entryMatches(entry, objectFullPath, keySuffix))
-            return entry->markAccessed();  // found value
+            return markAccessed(entry->entryIndex);  // found value
     }
     return nullEntry;  // not found
 }
@@ -482,7 +517,7 @@ std::vector<const char *> Configuration::getMatchingPerObjectConfigKeySuffixes(c
 
     // check all suffix bins whose name matches the pattern
     PatternMatcher suffixMatcher(keySuffixPattern, true, true, true);
-    for (const auto & suffixBin : suffixBins) {
+    for (const auto & suffixBin : index->getSuffixBins()) {
         const char *suffix = suffixBin.first.c_str();
         if (suffixMatcher.matches(suffix)) {
             // find all matching entries from this suffix bin.
@@ -491,16 +526,17 @@ std::vector<const char *> Configuration::getMatchingPerObjectConfigKeySuffixes(c
             // by checking whether one pattern matches the other one as string, and vice versa.
             const SuffixBin& bin = suffixBin.second;
             for (const auto & entry : bin.entries) {
+                const char *key = entries[entry->entryIndex]->getKey();
                 if (entry->fullPathPattern) {
-                    if (PatternMatcher((std::string(objectFullPath)+"."+keySuffixPattern).c_str(), true, true, true).matches(entry->getKey()))
-                        result.push_back(partAfterLastDot(entry->getKey()));
+                    if (PatternMatcher((std::string(objectFullPath)+"."+keySuffixPattern).c_str(), true, true, true).matches(key))
+                        result.push_back(partAfterLastDot(key));
                 }
                 else if ((anyObject || entry->ownerPattern->matches(objectFullPath))
                     &&
                     (entry->suffixPattern == nullptr ||
-                     suffixMatcher.matches(partAfterLastDot(entry->getKey())) ||
+                     suffixMatcher.matches(partAfterLastDot(key)) ||
                      entry->suffixPattern->matches(keySuffixPattern)))
-                    result.push_back(partAfterLastDot(entry->getKey()));
+                    result.push_back(partAfterLastDot(key));
             }
         }
     }
@@ -511,19 +547,19 @@ std::vector<const char *> Configuration::getMatchingPerObjectConfigKeySuffixes(c
 void Configuration::dump() const
 {
     std::cout << "Config:" << std::endl;
-    for (const auto & pair : config)
-        std::cout << "  " << pair.second->str() << std::endl;
+    for (const auto & pair : index->getConfigEntries())
+        std::cout << "  " << entries[pair.second]->str() << std::endl;
 
-    for (const auto & suffixBin : suffixBins) {
+    for (const auto & suffixBin : index->getSuffixBins()) {
         const std::string& suffix = suffixBin.first;
         const SuffixBin& bin = suffixBin.second;
         std::cout << "Suffix Bin " << suffix << ":" << std::endl;
         for (const auto & entry : bin.entries)
-            std::cout << "  " << entry->str() << std::endl;
+            std::cout << "  " << entries[entry->entryIndex]->str() << std::endl;
     }
     std::cout << "Wildcard Suffix Bin:" << std::endl;
-    for (const auto & entry : wildcardSuffixBin.entries)
-        std::cout << "  " << entry->str() << std::endl;
+    for (const auto & entry : index->getWildcardSuffixBin().entries)
+        std::cout << "  " << entries[entry->entryIndex]->str() << std::endl;
 
     std::cout << "Iteration Variables:" << std::endl;
     for (const auto & entry : iterationVariables)
@@ -537,9 +573,9 @@ void Configuration::dump() const
 std::vector<const cConfiguration::KeyValue*> Configuration::getUnusedEntries(bool all, bool postsimulation) const
 {
     std::vector<const KeyValue*> result;
-    for (auto entry : entries)
-        if (!entry->isAccessed() && (all || reportAsUnaccessed(entry, postsimulation)))
-            result.push_back(entry);
+    for (int i = 0; i < (int)entries.size(); i++)
+        if (!accessed[i] && (all || reportAsUnaccessed(i, postsimulation)))
+            result.push_back(entries[i]);
     return result;
 }
 
@@ -548,8 +584,10 @@ inline bool fromSameSection(const cConfiguration::KeyValue *a, const cConfigurat
     return opp_streq(a->getOriginSection(), b->getOriginSection());
 }
 
-bool Configuration::reportAsUnaccessed(const Entry *entry, bool postsimulation) const
+bool Configuration::reportAsUnaccessed(int entryIndex, bool postsimulation) const
 {
+    const Entry *entry = entries[entryIndex];
+
     //
     // Common causes of an entry being unused are:
     // 1. Mistyped or otherwise bogus key -- this is the type we primarily want to detect and report
@@ -563,7 +601,7 @@ bool Configuration::reportAsUnaccessed(const Entry *entry, bool postsimulation)
     // If shadowed by another entry, it can never be accessed.
     // However, if shadowed from a derived section, that's probably an
     // intentional override and should NOT be reported.
-    const Entry *shadowedBy = findFirstEntryThatShadows(entry);
+    const Entry *shadowedBy = findFirstEntryThatShadows(entryIndex);
     if (shadowedBy != nullptr)
         return fromSameSection(shadowedBy, entry);
 
@@ -582,21 +620,18 @@ bool Configuration::reportAsUnaccessed(const Entry *entry, bool postsimulation)
     return true;
 }
 
-const Configuration::Entry *Configuration::findFirstEntryThatShadows(const Entry *entry) const
+const Configuration::Entry *Configuration::findFirstEntryThatShadows(int entryIndex) const
 {
-    for (auto e : entries)
-        if (e == entry)
-            break;
-        else if (PatternMatcher(e->getKey(), true, true, true).covers(entry->getKey()))
-            return e;
+    const char *key = entries[entryIndex]->getKey();
+    for (int i = 0; i < entryIndex; i++)
+        if (PatternMatcher(entries[i]->getKey(), true, true, true).covers(key))
+            return entries[i];
     return nullptr;
 }
 
 void Configuration::clearUsageInfo()
 {
-    for (auto entry : entries)
-        if (!entry->isAccessed())
-            entry->clearAccessInfo();
+    accessed.assign(entries.size(), false);
 }
 
 }  // namespace envir
@@ -20,6 +20,7 @@
 #include <vector>
 #include <set>
 #include <string>
+#include <memory>
 #include "common/pooledstring.h"
 #include "omnetpp/cconfiguration.h"
 #include "envirdefs.h"
@@ -33,61 +34,32 @@ namespace envir {
 
 
 /**
- * Wraps a cConfigurationReader (usually an InifileReader), and presents
- * its contents on a higher level towards the simulation.
+ * The run-independent part of a Configuration: the flattened list of entries,
+ * with the keys compiled into patterns and sorted into suffix bins. Entry values
+ * are stored as in the ini file, i.e. with inifile variables unsubstituted.
  *
- * This object "flattens out" the configuration with respect to an
- * active section, i.e. the section fallback sequence ("extends") is
- * resolved, and sections are made invisible to the user.
+ * The object is immutable after construction, so it can be shared among the
+ * Configuration objects of all runs of a config, also across threads.
  */
-class ENVIR_API Configuration : public cConfiguration  //TODO rename Configuration, cIConfiguration?
+class ENVIR_API ConfigurationIndex
 {
-  private:
-    typedef omnetpp::common::opp_staticpooledstring opp_staticpooledstring;
+  public:
     typedef omnetpp::common::PatternMatcher PatternMatcher;
-    typedef std::set<std::string> StringSet;
-    typedef std::map<std::string,std::string> StringMap;
+    typedef InifileContents::Entry Entry;
 
-    class Entry : public InifileContents::Entry {
-      private:
-        mutable bool accessed = false;
-      public:
-        Entry() {}
-        Entry(const InifileContents::Entry& e) : InifileContents::Entry(e) {}
-        Entry(const char *baseDir, const char *key, const char *value, const char *comment, const char *originSection, FileLine loc) :
-            InifileContents::Entry(baseDir, key, value, comment, originSection, loc) {}
-        bool isAccessed() const {return accessed;}
-        Entry& markAccessed() {accessed = true; return *this;}
-        const Entry& markAccessed() const {accessed = true; return *this;}
-        void clearAccessInfo() {accessed = false;}
-    };
-
-    class MatchableEntry : public Entry {
+    class MatchableEntry {
       public:
+        int entryIndex; // into the entries[] array
         PatternMatcher *ownerPattern = nullptr; // key without the suffix
         PatternMatcher *suffixPattern = nullptr; // only filled in when this is a wildcard bin
         PatternMatcher *fullPathPattern = nullptr; // when present, match against this instead of ownerPattern & suffixPattern
 
-        MatchableEntry(const Entry& e) : Entry(e) {}
-        MatchableEntry(const MatchableEntry& e);   // apparently only used for std::vector storage
+        MatchableEntry(int entryIndex) : entryIndex(entryIndex) {}
+        MatchableEntry(const MatchableEntry&) = delete;
         ~MatchableEntry();
         std::string debugStr() const;
     };
 
-    //
-    // getConfigEntry() etc return a reference to nullEntry when the requested key is not found
-    //
-    class NullEntry : public cConfiguration::KeyValue
-    {
-      private:
-        std::string defaultBasedir;
-      public:
-        void setBaseDirectory(const char *s) {defaultBasedir = s;}
-        virtual const char *getKey() const override   {return nullptr;}
-        virtual const char *getValue() const override {return nullptr;}
-        virtual const char *getBaseDirectory() const override {return defaultBasedir.c_str();}
-    };
-
     // Some explanation. Basically we could just store all entries in order,
     // and when a param fullPath etc comes in, just match it against all entries
     // linearly. However, we optimize on this: the parameter names in the keys
@@ -116,15 +88,77 @@ class ENVIR_API Configuration : public cConfiguration  //TODO rename Configurati
     //   **.tcp.eedVector.record-*"       ==> goes into the wildcard bin; ownerPattern="**.tcp.eedVector", suffixPattern="record-*"
     //
     struct SuffixBin {
-        std::vector<MatchableEntry*> entries;
+        std::vector<const MatchableEntry*> entries;
     };
 
   private:
-    std::vector<Entry*> entries; // entries of the activated configuration, with itervars substituted
-    std::map<std::string,Entry*> config; // config entries (i.e. keys not containing a dot or wildcard)
+    std::vector<Entry> entries; // all entries, in order
+    std::vector<MatchableEntry*> matchableEntries; // owned; entries that contain a dot or wildcard
+    std::map<std::string,int> config; // config entries (i.e. keys not containing a dot or wildcard)
     std::map<std::string,SuffixBin> suffixBins;  // bins for each non-wildcard suffix
     SuffixBin wildcardSuffixBin; // bin for entries that contain wildcards
 
+  private:
+    void addEntry(int entryIndex);
+    SuffixBin& getOrCreateBin(const std::string& suffix);
+    static void splitKey(const char *key, std::string& outOwnerName, std::string& outBinName);
+
+  public:
+    ConfigurationIndex(const std::vector<Entry>& entries);
+    ConfigurationIndex(const ConfigurationIndex&) = delete;
+    ~ConfigurationIndex();
+
+    int getNumEntries() const {return entries.size();}
+    const Entry& getEntry(int entryIndex) const {return entries[entryIndex];}
+    const std::map<std::string,int>& getConfigEntries() const {return config;}
+    const std::map<std::string,SuffixBin>& getSuffixBins() const {return suffixBins;}
+    const SuffixBin *findSuffixBin(const char *suffix) const;
+    const SuffixBin& getWildcardSuffixBin() const {return wildcardSuffixBin;}
+};
+
+/**
+ * Wraps a cConfigurationReader (usually an InifileReader), and presents
+ * its contents on a higher level towards the simulation.
+ *
+ * This object "flattens out" the configuration with respect to an
+ * active section, i.e. the section fallback sequence ("extends") is
+ * resolved, and sections are made invisible to the user.
+ *
+ * Lookup tables are in a ConfigurationIndex, which may be shared among the
+ * runs of the same config. Only entries whose values contain inifile variables
+ * (${...}) are stored in the Configuration, with the values substituted.
+ */
+class ENVIR_API Configuration : public cConfiguration  //TODO rename Configuration, cIConfiguration?
+{
+  private:
+    typedef omnetpp::common::opp_staticpooledstring opp_staticpooledstring;
+    typedef omnetpp::common::PatternMatcher PatternMatcher;
+    typedef std::set<std::string> StringSet;
+    typedef std::map<std::string,std::string> StringMap;
+    typedef InifileContents::Entry Entry;
+    typedef ConfigurationIndex::MatchableEntry MatchableEntry;
+    typedef ConfigurationIndex::SuffixBin SuffixBin;
+
+    //
+    // getConfigEntry() etc return a reference to nullEntry when the requested key is not found
+    //
+    class NullEntry : public cConfiguration::KeyValue
+    {
+      private:
+        std::string defaultBasedir;
+      public:
+        void setBaseDirectory(const char *s) {defaultBasedir = s;}
+        virtual const char *getKey() const override   {return nullptr;}
+        virtual const char *getValue() const override {return nullptr;}
+        virtual const char *getBaseDirectory() const override {return defaultBasedir.c_str();}
+    };
+
+  private:
+    std::shared_ptr<const ConfigurationIndex> index;
+    std::vector<const Entry*> entries; // entries of the activated configuration, with itervars substituted; point into index or ownEntries
+    std::vector<std::unique_ptr<Entry>> ownEntries; // entries with substituted values
+    mutable std::vector<bool> accessed; // indexed like entries[]
+
     // predefined variables (${configname} etc) and iteration variables
     StringMap predefinedVariables;
     StringMap iterationVariables;
@@ -134,21 +168,26 @@ class ENVIR_API Configuration : public cConfiguration  //TODO rename Configurati
     std::string fileName;
 
   private:
-    void addEntry(const InifileContents::Entry& iniEntry);
-    SuffixBin& getOrCreateBin(const std::string& suffix);
-    void addToBin(SuffixBin& bin, MatchableEntry *entry);
+    void setEntries(const std::map<int,std::string>& substitutedValues);
+    const Entry& markAccessed(int entryIndex) const {accessed[entryIndex] = true; return *entries[entryIndex];}
     static void parseVariable(const char *txt, std::string& outVarname, std::string& outValue, std::string& outParVar, const char *&outEndPtr);
-    static void splitKey(const char *key, std::string& outOwnerName, std::string& outBinName);
     static bool entryMatches(const MatchableEntry *entry, const char *moduleFullPath, const char *paramName);
     static bool isPredefinedVariable(const char *varname);
     virtual bool isEssentialOption(const char *key) const;
     virtual std::string substituteVariables(const char *text, const StringMap& variables) const;
-    virtual bool reportAsUnaccessed(const Entry *entry, bool postsimulation) const;
-    const Entry *findFirstEntryThatShadows(const Entry *entry) const;
+    virtual bool reportAsUnaccessed(int entryIndex, bool postsimulation) const;
+    const Entry *findFirstEntryThatShadows(int entryIndex) const;
 
   public:
-    Configuration() {}
+    Configuration();
     Configuration(const std::vector<InifileContents::Entry>& entries, const StringMap& predefinedVariables, const StringMap& iterationVariables, const char *fileName=nullptr);
+
+    /**
+     * Creates a configuration that shares the given index. substitutedValues
+     * maps entry indices to the values to be used instead of the ones in the
+     * index, i.e. the values with the inifile variables substituted.
+     */
+    Configuration(const std::shared_ptr<const ConfigurationIndex>& index, const std::map<int,std::string>& substitutedValues, const StringMap& predefinedVariables, const StringMap& iterationVariables, const char *fileName=nullptr);
     virtual ~Configuration();
 
     virtual const char *getFileName() const override;
@@ -56,6 +56,12 @@ void FileSnapshotManager::endRun()
 {
 }
 
+void FileSnapshotManager::switchRun(cConfiguration *cfg)
+{
+    configure(getSimulation(), cfg);
+    startRun();
+}
+
 ostream *FileSnapshotManager::getStreamForSnapshot()
 {
     mkPath(directoryOf(fname.c_str()).c_str());
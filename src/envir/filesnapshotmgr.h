@@ -66,6 +66,12 @@ class ENVIR_API FileSnapshotManager : public cISnapshotManager
      * Called at the end of a simulation run.
      */
     virtual void endRun() override;
+
+    /**
+     * Re-reads the configuration for the given run, and deletes its left-over
+     * snapshot file.
+     */
+    virtual void switchRun(cConfiguration *cfg) override;
     //@}
 
     /** @name Snapshot management */
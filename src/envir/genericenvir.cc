@@ -124,6 +124,18 @@ void GenericEnvir::configure(cConfiguration *cfg)
     recordEventlog = cfg->getAsBool(CFGID_RECORD_EVENTLOG);  // TODO tmp solution: cannot call setEventlogRecording(), because it calls eventlogRecorder->suspend()/resume(), which is NOT what we want here
 }
 
+void GenericEnvir::switchRun(cConfiguration *cfg)
+{
+    if (recordEventlog)
+        throw cRuntimeError("Cannot switch to another run while recording an eventlog (record-eventlog=true)");
+
+    this->cfg = cfg;
+
+    outVectorManager->switchRun(cfg);
+    outScalarManager->switchRun(cfg);
+    snapshotManager->switchRun(cfg);
+}
+
 std::string GenericEnvir::extractImagePath(cConfiguration *cfg, ArgList *args)
 {
     std::string imagePath;
@@ -546,6 +558,15 @@ bool GenericEnvir::recordInOutputVector(void *vechandle, simtime_t t, double val
     return outVectorManager->record(vechandle, t, value);
 }
 
+int GenericEnvir::recordManyInOutputVector(void *vechandle, const simtime_t *times, const double *values, int n)
+{
+    ASSERT(outVectorManager);
+    if (getSimulation()->getFingerprintCalculator())
+        for (int i = 0; i < n; i++)
+            getSimulation()->getFingerprintCalculator()->addVectorResult(nullptr, "", times[i], values[i]);
+    return outVectorManager->recordMany(vechandle, times, values, n);
+}
+
 void GenericEnvir::recordScalar(cComponent *component, const char *name, double value, opp_string_map *attributes)
 {
     ASSERT(outScalarManager);
@@ -118,6 +118,7 @@ class ENVIR_API GenericEnvir : public cEnvir, protected cISimulationLifecycleLis
 
     virtual void setSimulation(cSimulation *simulation) override;
     virtual void configure(cConfiguration *cfg) override;
+    virtual void switchRun(cConfiguration *cfg) override;
 
     // getters/setters
     virtual cSimulation *getSimulation() const override {return simulation;}
@@ -215,6 +216,7 @@ class ENVIR_API GenericEnvir : public cEnvir, protected cISimulationLifecycleLis
     virtual void deregisterOutputVector(void *vechandle) override;
     virtual void setVectorAttribute(void *vechandle, const char *name, const char *value) override;
     virtual bool recordInOutputVector(void *vechandle, simtime_t t, double value) override;
+    virtual int recordManyInOutputVector(void *vechandle, const simtime_t *times, const double *values, int n) override;
 
     // output scalars
     virtual void recordScalar(cComponent *component, const char *name, double value, opp_string_map *attributes=nullptr) override;
@@ -309,6 +309,12 @@ void InifileContents::setCommandLineConfigOptions(const std::map<std::string, st
 void InifileContents::invalidateCaches()
 {
     cachedSectionChains.clear();
+    {
+        std::lock_guard<std::mutex> lock(runIndexCacheMutex);
+        cachedRunIndices.clear();
+    }
+    std::lock_guard<std::mutex> lock(configIndexCacheMutex);
+    cachedConfigIndices.clear();
 }
 
 void InifileContents::clear()
@@ -317,7 +323,7 @@ void InifileContents::clear()
     defaultBasedir = "";
     sections.clear();
     commandLineOptions.clear();
-    cachedSectionChains.clear();
+    invalidateCaches();
 }
 
 std::vector<std::string> InifileContents::getConfigNames()
@@ -451,6 +457,7 @@ cConfiguration *InifileContents::extractConfig(const char *configName, int runNu
    // determine the values to substitute into the iteration vars (${...})
    try {
        Scenario scenario(itervars, constraint, nestingSpec);
+       installRunIndex(configName, scenario);
        int numRuns = scenario.getNumRuns();
        if (runNumber < 0 || runNumber >= numRuns)
            throw cRuntimeError("Run number %d is out of range for configuration '%s': It contains %d run(s)", runNumber, configName, numRuns);
@@ -462,6 +469,36 @@ cConfiguration *InifileContents::extractConfig(const char *configName, int runNu
        throw cRuntimeError("Scenario generator: %s", e.what());
    }
 
+   // the lookup tables only depend on the keys, so they are shared among the runs;
+   // only entries that contain inifile variables need to be substituted per run
+   std::shared_ptr<const ConfigurationIndex> index = getConfigIndex(configName, sectionChain);
+   std::map<int,std::string> substitutedValues;
+   int entryIndex = 0;
+   for (auto & e : commandLineOptions) {
+       if (strstr(e.getValue(), "${") != nullptr)
+           substitutedValues[entryIndex] = substituteVariables(e.getValue(), variables, -1, -1);
+       entryIndex++;
+   }
+   for (int sectionId : sectionChain) {
+       for (int entryId = 0; entryId < getNumEntries(sectionId); entryId++) {
+           const auto& e = getEntry(sectionId, entryId);
+           if (strstr(e.getValue(), "${") != nullptr)
+               substitutedValues[entryIndex] = substituteVariables(e.getValue(), variables, sectionId, entryId);
+           entryIndex++;
+       }
+   }
+
+   return new Configuration(index, substitutedValues, variables.predefinedVariables, variables.iterationVariables, rootFilename.c_str());
+}
+
+std::shared_ptr<const ConfigurationIndex> InifileContents::getConfigIndex(const char *configName, const std::vector<int>& sectionChain) const
+{
+   // building the index involves compiling all keys into patterns, so only do it once per config
+   std::lock_guard<std::mutex> lock(configIndexCacheMutex);
+   auto& index = cachedConfigIndices[configName];
+   if (index)
+       return index;
+
    auto addWildcardIfNeeded = [](const char *key) {
        if (strchr(key, '.') == nullptr) {
            cConfigOption *e = lookupConfigOption(key);
@@ -473,23 +510,22 @@ cConfiguration *InifileContents::extractConfig(const char *configName, int runNu
 
    std::vector<Entry> entries;
 
-   // concatenate the contents of the sections and the command line into a common flat list (entries[])
+   // concatenate the contents of the sections and the command line into a common flat list (entries[]);
+   // values are substituted by extractConfig()
    for (auto & e : commandLineOptions) {
        std::string key = addWildcardIfNeeded(e.getKey());
-       std::string value = substituteVariables(e.getValue(), variables, -1, -1);
-       entries.push_back(Entry(e.getBaseDirectory(), key.c_str(), value.c_str(), e.getComment(), e.getOriginSection(), e.getSourceLocation()));
+       entries.push_back(Entry(e.getBaseDirectory(), key.c_str(), e.getValue(), e.getComment(), e.getOriginSection(), e.getSourceLocation()));
    }
    for (int sectionId : sectionChain) {
        for (int entryId = 0; entryId < getNumEntries(sectionId); entryId++) {
-           // add entry to our tables
            const auto& e = getEntry(sectionId, entryId);
            std::string key = addWildcardIfNeeded(e.getKey());
-           std::string value = substituteVariables(e.getValue(), variables, sectionId, entryId);
-           entries.push_back(Entry(e.getBaseDirectory(), key.c_str(), value.c_str(), e.getComment(), e.getOriginSection(), e.getSourceLocation()));
+           entries.push_back(Entry(e.getBaseDirectory(), key.c_str(), e.getValue(), e.getComment(), e.getOriginSection(), e.getSourceLocation()));
        }
    }
 
-   return new Configuration(entries, variables.predefinedVariables, variables.iterationVariables, rootFilename.c_str());
+   index = std::make_shared<ConfigurationIndex>(entries);
+   return index;
 }
 
 inline std::string unquote(const std::string& txt)
@@ -611,18 +647,56 @@ int InifileContents::getNumRunsInConfig(const char *configName) const
    StringMap locationToVarNameMap;
    std::vector<Scenario::IterationVariable> v = collectIterationVariables(sectionChain, locationToVarNameMap); // also fills locationToVarNameMap
 
-   // see if there's a constraint given
+   // see if there's a constraint and/or iteration nesting order given
    const char *constraint = internalGetValue(sectionChain, CFGID_CONSTRAINT->getName(), nullptr);
+   const char *nestingSpec = internalGetValue(sectionChain, CFGID_ITERATION_NESTING_ORDER->getName(), nullptr);
 
    // count the runs and return the result
    try {
-       return Scenario(v, constraint, "").getNumRuns();
+       Scenario scenario(v, constraint, nestingSpec);
+       installRunIndex(configName, scenario);
+       return scenario.getNumRuns();
    }
    catch (std::exception& e) {
        throw cRuntimeError("Could not compute number of runs in config %s: %s", configName, e.what());
    }
 }
 
+void InifileContents::installRunIndex(const char *configName, Scenario& scenario) const
+{
+    // computing the run index may need a pass over all runs, so only do it once per config
+    std::lock_guard<std::mutex> lock(runIndexCacheMutex);
+    auto& runIndex = cachedRunIndices[configName];
+    if (runIndex)
+        scenario.setRunIndex(runIndex);
+    else
+        runIndex = scenario.getRunIndex();
+}
+
+InifileContents::RunInfo InifileContents::makeRunInfo(const char *configName, int runNumber, const std::vector<int>& sectionChain, const Scenario& scenario, const StringMap& locationToVarNameMap) const
+{
+    VariablesInfo variables = computeVariables(configName, runNumber, sectionChain, &scenario, locationToVarNameMap);
+
+    RunInfo runInfo;
+    runInfo.info = scenario.str();
+    runInfo.iterVars = variables.iterationVariables;
+    runInfo.runAttrs = variables.predefinedVariables;
+
+    // collect entries that contain ${..}
+    std::string tmp;
+    for (int sectionId : sectionChain) {
+        for (int entryId = 0; entryId < getNumEntries(sectionId); entryId++) {
+            const auto& entry = getEntry(sectionId, entryId);
+            if (strstr(entry.getValue(), "${") != nullptr) {
+                std::string expandedValue = substituteVariables(entry.getValue(), variables, sectionId, entryId);
+                tmp += std::string(entry.getKey()) + " = " + expandedValue + "\n";
+            }
+        }
+    }
+    runInfo.configBrief = tmp;
+    return runInfo;
+}
+
 std::vector<InifileContents::RunInfo> InifileContents::unrollConfig(const char *configName) const
 {
    // extract all iteration vars from values within this section
@@ -641,26 +715,7 @@ std::vector<InifileContents::RunInfo> InifileContents::unrollConfig(const char *
        if (scenario.restart()) {
            for (;;) {
                int runNumber = result.size();
-               VariablesInfo variables = computeVariables(configName, runNumber, sectionChain, &scenario, locationToVarNameMap);
-
-               RunInfo runInfo;
-               runInfo.info = scenario.str();
-               runInfo.iterVars = variables.iterationVariables;
-               runInfo.runAttrs = variables.predefinedVariables;
-
-               // collect entries that contain ${..}
-               std::string tmp;
-               for (int sectionId : sectionChain) {
-                   for (int entryId = 0; entryId < getNumEntries(sectionId); entryId++) {
-                       const auto& entry = getEntry(sectionId, entryId);
-                       if (strstr(entry.getValue(), "${") != nullptr) {
-                           std::string expandedValue = substituteVariables(entry.getValue(), variables, sectionId, entryId);
-                           tmp += std::string(entry.getKey()) + " = " + expandedValue + "\n";
-                       }
-                   }
-               }
-               runInfo.configBrief = tmp;
-               result.push_back(runInfo);
+               result.push_back(makeRunInfo(configName, runNumber, sectionChain, scenario, locationToVarNameMap));
 
                // move to the next run
                if (!scenario.next())
@@ -674,6 +729,29 @@ std::vector<InifileContents::RunInfo> InifileContents::unrollConfig(const char *
    }
 }
 
+InifileContents::RunInfo InifileContents::getRunInfo(const char *configName, int runNumber) const
+{
+   std::vector<int> sectionChain = resolveSectionChain(configName);
+   StringMap locationToVarNameMap;
+   std::vector<Scenario::IterationVariable> itervars = collectIterationVariables(sectionChain, locationToVarNameMap);
+
+   const char *constraint = internalGetValue(sectionChain, CFGID_CONSTRAINT->getName(), nullptr);
+   const char *nestingSpec = internalGetValue(sectionChain, CFGID_ITERATION_NESTING_ORDER->getName(), nullptr);
+
+   try {
+       Scenario scenario(itervars, constraint, nestingSpec);
+       installRunIndex(configName, scenario);
+       int numRuns = scenario.getNumRuns();
+       if (runNumber < 0 || runNumber >= numRuns)
+           throw cRuntimeError("Run number %d is out of range for configuration '%s': It contains %d run(s)", runNumber, configName, numRuns);
+       scenario.gotoRun(runNumber);
+       return makeRunInfo(configName, runNumber, sectionChain, scenario, locationToVarNameMap);
+   }
+   catch (std::exception& e) {
+       throw cRuntimeError("Scenario generator: %s", e.what());
+   }
+}
+
 std::vector<int> InifileContents::resolveRunFilter(const char *configName, const char *runFilter)
 {
     std::vector<int> runNumbers;
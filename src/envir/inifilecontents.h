@@ -21,6 +21,7 @@
 #include <set>
 #include <string>
 #include <iostream>
+#include <mutex>
 #include "common/pooledstring.h"
 #include "omnetpp/cconfiguration.h"
 #include "omnetpp/cconfigurationreader.h"
@@ -33,6 +34,8 @@ using omnetpp::common::opp_staticpooledstring;
 namespace omnetpp {
 namespace envir {
 
+class ConfigurationIndex;
+
 class ENVIR_API InifileContents
 {
   public:
@@ -90,6 +93,14 @@ class ENVIR_API InifileContents
     // section inheritance chains, computed from the input data
     mutable std::vector<std::vector<int> > cachedSectionChains;
 
+    // run indices of the scenarios of configs, computed on demand; may be accessed from several threads
+    mutable std::map<std::string, std::shared_ptr<const Scenario::RunIndex>> cachedRunIndices;
+    mutable std::mutex runIndexCacheMutex;
+
+    // lookup tables of configs, shared by the Configuration objects of their runs; may be accessed from several threads
+    mutable std::map<std::string, std::shared_ptr<const ConfigurationIndex>> cachedConfigIndices;
+    mutable std::mutex configIndexCacheMutex;
+
   private:
     static void parseVariable(const char *txt, std::string& outVarname, std::string& outValue, std::string& outParVar, const char *&outEndPtr);
     static bool isIgnorableConfigKey(const char *ignoredKeyPatterns, const char *key);
@@ -111,6 +122,9 @@ class ENVIR_API InifileContents
     std::vector<int> getBaseConfigIds(int sectionId) const;
     std::vector<Scenario::IterationVariable> collectIterationVariables(const std::vector<int>& sectionChain, StringMap& outLocationToNameMap) const;
     std::string substituteVariables(const char *text, const VariablesInfo& variables, int sectionId, int entryId) const;
+    void installRunIndex(const char *configName, Scenario& scenario) const;
+    std::shared_ptr<const ConfigurationIndex> getConfigIndex(const char *configName, const std::vector<int>& sectionChain) const;
+    RunInfo makeRunInfo(const char *configName, int runNumber, const std::vector<int>& sectionChain, const Scenario& scenario, const StringMap& locationToVarNameMap) const;
     VariablesInfo computeVariables(const char *configName, int runNumber, std::vector<int> sectionChain, const Scenario *scenario, const StringMap& locationToVarName) const;
     std::string internalGetConfigAsString(cConfigOption *option, const std::vector<int>& sectionChain, const VariablesInfo& variables) const;
     intval_t internalGetConfigAsInt(cConfigOption *option, const std::vector<int>& sectionChain, const VariablesInfo& variables) const;
@@ -172,6 +186,7 @@ class ENVIR_API InifileContents
    virtual int getNumRunsInConfig(const char *configName) const;
    virtual std::vector<int> resolveRunFilter(const char *configName, const char *runFilter);
    virtual std::vector<RunInfo> unrollConfig(const char *configName) const;
+   virtual RunInfo getRunInfo(const char *configName, int runNumber) const;
    virtual void dump(bool printBaseDir=true) const;
 };
 
@@ -91,6 +91,17 @@ void OmnetppOutputScalarManager::endRun()
     }
 }
 
+void OmnetppOutputScalarManager::switchRun(cConfiguration *cfg)
+{
+    if (state != NEW && state != STARTED)
+        throw cRuntimeError("%s: Cannot switch to another run after results have been recorded", getClassName());
+    bool started = state == STARTED;
+    state = NEW;
+    configure(getSimulation(), cfg);
+    if (started)
+        startRun();
+}
+
 void OmnetppOutputScalarManager::openFileForRun()
 {
     // ensure startRun() has been invoked
@@ -47,6 +47,7 @@ Register_Class(OmnetppOutputVectorManager);
 Register_GlobalConfigOption(CFGID_OUTPUT_VECTOR_FILE, "output-vector-file", CFG_FILENAME, "${resultdir}/${configname}-${iterationvarsf}#${repetition}.vec", "Name for the output vector file.");
 Register_GlobalConfigOption(CFGID_OUTPUT_VECTOR_FILE_APPEND, "output-vector-file-append", CFG_BOOL, "false", "What to do when the output vector file already exists: append to it, or delete it and begin a new file (default). Note: `cIndexedFileOutputVectorManager` currently does not support appending.");
 Register_GlobalConfigOption(CFGID_OUTPUT_VECTOR_PRECISION, "output-vector-precision", CFG_INT, DEFAULT_OUTPUT_VECTOR_PRECISION, "The number of significant digits for recording data into the output vector file. The maximum value is ~15 (IEEE double precision). This setting has no effect on SQLite recording (it stores values as 8-byte IEEE floating point numbers), and for the \"time\" column which is represented as fixed-point numbers and always get recorded precisely.");
+Register_GlobalConfigOption(CFGID_OUTPUT_VECTOR_FILE_SHARDS, "output-vector-file-shards", CFG_INT, "1", "The number of files output vector data are distributed among. With values larger than one, the data of vector i are written into the file `<output-vector-file>.<k>` where k = i mod N, the shards are written in parallel, and the output vector file itself only contains the run header, the vector declarations and the list of shards. The index file (.vci) is common for all shards, and result analysis tools present the shards as one file.");
 Register_GlobalConfigOptionU(CFGID_OUTPUTVECTOR_MEMORY_LIMIT, "output-vectors-memory-limit", "B", DEFAULT_OUTPUT_VECTOR_MEMORY_LIMIT, "Total memory that can be used for buffering output vectors. Larger values produce less fragmented vector files (i.e. cause vector data to be grouped into larger chunks), and therefore allow more efficient processing later. There is also a per-vector limit, see `**.vector-buffer`.");
 
 // per-vector options
@@ -71,6 +72,11 @@ void OmnetppOutputVectorManager::configure(cSimulation *simulation, cConfigurati
 
     size_t memoryLimit = (size_t) cfg->getAsDouble(CFGID_OUTPUTVECTOR_MEMORY_LIMIT);
     writer.setOverallMemoryLimit(memoryLimit);
+
+    int numShards = cfg->getAsInt(CFGID_OUTPUT_VECTOR_FILE_SHARDS);
+    if (numShards < 1)
+        throw cRuntimeError("Invalid value %d for 'output-vector-file-shards', must be at least 1", numShards);
+    writer.setNumShards(numShards);
 }
 
 void OmnetppOutputVectorManager::startRun()
@@ -84,6 +90,7 @@ void OmnetppOutputVectorManager::startRun()
         throw cRuntimeError("%s does not support append mode", getClassName());
 
     removeFile(fname.c_str(), "old output vector file");
+    OmnetppVectorFileWriter::removeShardFiles(fname);
 
 }
 
@@ -98,6 +105,17 @@ void OmnetppOutputVectorManager::endRun()
     }
 }
 
+void OmnetppOutputVectorManager::switchRun(cConfiguration *cfg)
+{
+    if (state != NEW && state != STARTED)
+        throw cRuntimeError("%s: Cannot switch to another run after results have been recorded", getClassName());
+    bool started = state == STARTED;
+    state = NEW;
+    configure(getSimulation(), cfg);
+    if (started)
+        startRun();
+}
+
 void OmnetppOutputVectorManager::openFileForRun()
 {
     // ensure startRun() has been invoked
@@ -177,16 +195,65 @@ bool OmnetppOutputVectorManager::record(void *vectorhandle, simtime_t t, double
     if (isBad())
         return false;
 
+    ensureRegisteredInWriter(vp);
+
+    eventnumber_t eventNumber = getSimulation()->getEventNumber();
+    writer.recordInVector(vp->handleInWriter, eventNumber, t.raw(), t.getScaleExp(), value);
+    return true;
+}
+
+int OmnetppOutputVectorManager::recordMany(void *vectorhandle, const simtime_t *times, const double *values, int n)
+{
+    if (state == ENDED)
+        return 0;    // ignore writes during network teardown
+
+    Assert(state == STARTED || state == OPENED);
+
+    ASSERT(vectorhandle != nullptr);
+    VectorData *vp = (VectorData *)vectorhandle;
+
+    if (!vp->enabled || n <= 0)
+        return 0;
+
+    // recording intervals are checked sample by sample
+    if (!vp->intervals.empty()) {
+        int count = 0;
+        for (int i = 0; i < n; i++)
+            if (record(vectorhandle, times[i], values[i]))
+                count++;
+        return count;
+    }
+
+    if (state != OPENED)
+        openFileForRun();
+
+    if (isBad())
+        return 0;
+
+    ensureRegisteredInWriter(vp);
+
+    // pass the samples to the writer in batches of raw simtime values
+    eventnumber_t eventNumber = getSimulation()->getEventNumber();
+    int scaleExp = SimTime::getScaleExp();
+    const int BATCH = 256;
+    OmnetppVectorFileWriter::rawsimtime_t rawTimes[BATCH];
+    for (int i = 0; i < n; i += BATCH) {
+        int m = std::min(BATCH, n - i);
+        for (int k = 0; k < m; k++)
+            rawTimes[k] = times[i+k].raw();
+        writer.recordInVector(vp->handleInWriter, eventNumber, rawTimes, scaleExp, values + i, m);
+    }
+    return n;
+}
+
+void OmnetppOutputVectorManager::ensureRegisteredInWriter(VectorData *vp)
+{
     if (vp->handleInWriter == nullptr) {
         std::string vectorFullPath = vp->moduleName.str() + "." + vp->vectorName.c_str();
         size_t bufferSize = (size_t) cfg->getAsDouble(vectorFullPath.c_str(), CFGID_VECTOR_BUFFER);
         bool recordEventNumbers = cfg->getAsBool(vectorFullPath.c_str(), CFGID_VECTOR_RECORD_EVENTNUMBERS);
         vp->handleInWriter = writer.registerVector(vp->moduleName.c_str(), vp->vectorName.c_str(), convertMap(&vp->attributes), bufferSize, recordEventNumbers);
     }
-
-    eventnumber_t eventNumber = getSimulation()->getEventNumber();
-    writer.recordInVector(vp->handleInWriter, eventNumber, t.raw(), t.getScaleExp(), value);
-    return true;
 }
 
 void OmnetppOutputVectorManager::flush()
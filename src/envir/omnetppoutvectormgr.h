@@ -60,6 +60,7 @@ class OmnetppOutputVectorManager : public cIOutputVectorManager, private ResultF
   protected:
     virtual void openFileForRun();
     virtual void closeFile();
+    void ensureRegisteredInWriter(VectorData *vp);
     bool isBad() {return state==OPENED && !writer.isOpen();}
 
   public:
@@ -95,6 +96,13 @@ class OmnetppOutputVectorManager : public cIOutputVectorManager, private ResultF
      */
     virtual void endRun() override;
 
+    /**
+     * Re-reads the configuration for the given run, and deletes its left-over
+     * output file if the run has already been started. It is an error if
+     * the output file of the current run has already been opened.
+     */
+    virtual void switchRun(cConfiguration *cfg) override;
+
     /**
      * Registers a vector and returns a handle.
      */
@@ -115,6 +123,12 @@ class OmnetppOutputVectorManager : public cIOutputVectorManager, private ResultF
      */
     virtual bool record(void *vectorhandle, simtime_t t, double value) override;
 
+    /**
+     * Writes n (time, value) pairs into the output file, passing them to the
+     * writer in batches.
+     */
+    virtual int recordMany(void *vectorhandle, const simtime_t *times, const double *values, int n) override;
+
     /**
      * Returns the file name.
      */
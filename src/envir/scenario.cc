@@ -15,6 +15,7 @@
 
 #include <cassert>
 #include <algorithm>
+#include <climits>
 #include <sstream>
 #include "common/stringutil.h"
 #include "common/stringtokenizer.h"
@@ -173,15 +174,56 @@ ExprValue Scenario::getIterationVariableValue(const char *varName)
 
 int Scenario::getNumRuns()
 {
-    if (!restart())
-        return 0;
-    int count = 1;
-    while (next()) {
-        if (count > 1000000)
-            throw cRuntimeError("Are you sure you want to generate more than one million runs?");
-        count++;
+    return getRunIndex()->numRuns;
+}
+
+std::shared_ptr<const Scenario::RunIndex> Scenario::getRunIndex()
+{
+    if (!runIndex)
+        runIndex = std::shared_ptr<const RunIndex>(buildRunIndex());
+    return runIndex;
+}
+
+bool Scenario::canIndexDirectly() const
+{
+    if (constraint)
+        return false;
+    for (auto var : variables)
+        if (!var->parvar.empty() || !var->iterator.getReferencedVariableNames().empty())
+            return false;
+    return true;
+}
+
+Scenario::RunIndex *Scenario::buildRunIndex()
+{
+    std::unique_ptr<RunIndex> index(new RunIndex());
+    if (canIndexDirectly()) {
+        // iterations are independent of each other: the number of values is fixed for each
+        index->direct = true;
+        int64_t numRuns = 1;
+        for (auto var : variables) {
+            var->iterator.restart(iteratorsByName);
+            int numValues = var->iterator.length();
+            index->radices.push_back(numValues);
+            numRuns *= numValues;
+            if (numRuns > INT_MAX)
+                throw cRuntimeError("Too many runs, the number of runs would exceed %d", INT_MAX);
+        }
+        index->numRuns = (int)numRuns;
     }
-    return count;
+    else {
+        // step through all valid runs, and record the iterator positions for each
+        if (restart()) {
+            do {
+                if (index->numRuns >= 10000000)
+                    throw cRuntimeError("Are you sure you want to generate more than ten million runs?");
+                for (auto var : variables)
+                    index->positions.push_back(var->iterator.getPosition());
+                index->numRuns++;
+            } while (next());
+        }
+    }
+    return index.release();
 }
 
 bool Scenario::restart()
@@ -280,12 +322,27 @@ bool Scenario::evaluateConstraint()
 
 void Scenario::gotoRun(int runNumber)
 {
-    // spin the iteration variables to the given run number
-    if (!restart())
+    std::shared_ptr<const RunIndex> index = getRunIndex();
+    if (index->numRuns == 0)
         throw cRuntimeError("Iterators or constraint too restrictive: Not even one run can be generated");
-    for (int i = 0; i < runNumber; i++)
-        if (!next())
-            throw cRuntimeError("Run number %d is out of range", runNumber);
+    if (runNumber < 0 || runNumber >= index->numRuns)
+        throw cRuntimeError("Run number %d is out of range", runNumber);
+
+    int numVariables = variables.size();
+    if (index->direct) {
+        // innermost variable is the least significant digit
+        for (int i = numVariables-1; i >= 0; i--) {
+            int radix = index->radices[i];
+            variables[i]->iterator.gotoPosition(runNumber % radix, iteratorsByName);
+            runNumber /= radix;
+        }
+    }
+    else {
+        // in nesting order, as iterations may refer to the values of outer variables
+        const int *positions = index->positions.data() + (size_t)runNumber * numVariables;
+        for (int i = 0; i < numVariables; i++)
+            variables[i]->iterator.gotoPosition(positions[i], iteratorsByName);
+    }
 }
 
 std::string Scenario::getVariable(const char *varName) const
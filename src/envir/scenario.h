@@ -17,6 +17,7 @@
 #define __OMNETPP_ENVIR_SCENARIO_H
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <set>
 #include <string>
@@ -54,6 +55,25 @@ class ENVIR_API Scenario
         std::string parvar;  // "in parallel to" variable", as in the ${1,2,5..10 ! var} notation
     };
 
+    /**
+     * Maps run numbers to the positions of the iterators, so that gotoRun()
+     * does not need to step through all preceding runs. When there is no
+     * constraint and the iterations do not refer to other variables, run
+     * numbers are decoded as mixed-radix numbers, with the number of values
+     * of each variable as radix. Otherwise, the iterator positions of all
+     * valid runs are collected into a table in one pass.
+     *
+     * A RunIndex only depends on the iteration variables, the constraint and
+     * the nesting order, so it can be shared among Scenario objects created
+     * with the same arguments (see getRunIndex(), setRunIndex()).
+     */
+    struct RunIndex {
+        bool direct = false;        // whether the mixed-radix decoding can be used
+        int numRuns = 0;
+        std::vector<int> radices;   // if direct: number of values of each variable, in nesting order
+        std::vector<int> positions; // if !direct: iterator positions of each run, numRuns * numVariables elements
+    };
+
   private:
     struct IterationVariableExt : IterationVariable {
         ValueIterator iterator;
@@ -64,6 +84,8 @@ class ENVIR_API Scenario
 
     std::map<std::string,ValueIterator*> iteratorsByName;  // only for IterationVariable
 
+    std::shared_ptr<const RunIndex> runIndex; // computed on demand
+
   private:
     bool inc() { return incOuter(variables.size()); }
     bool incOuter(int n);
@@ -71,6 +93,8 @@ class ENVIR_API Scenario
     ExprValue getIterationVariableValue(const char *varname);
     int getIteratorPosition(const char *varid) const;
     std::vector<std::string> resolveNestingOrderSpec(const char *orderSpec);
+    bool canIndexDirectly() const;
+    RunIndex *buildRunIndex();
 
   public:
     Scenario(const std::vector<IterationVariable>& iterationVariables, const char *constraint, const char *nestingSpec);
@@ -89,10 +113,27 @@ class ENVIR_API Scenario
     int getNumRuns();
 
     /**
-     * Spins the iteration variables to the given run.
+     * Spins the iteration variables to the given run. Apart from the first
+     * call which may need to compute the run index, the cost does not depend
+     * on the run number.
+     *
+     * The current iteration state is NOT preserved.
      */
     void gotoRun(int runNumber);
 
+    /**
+     * Returns the run index, computing it if needed.
+     *
+     * The current iteration state is NOT preserved.
+     */
+    std::shared_ptr<const RunIndex> getRunIndex();
+
+    /**
+     * Installs a run index obtained from another Scenario object that was
+     * created with the same arguments.
+     */
+    void setRunIndex(std::shared_ptr<const RunIndex> index) {runIndex = index;}
+
     /**
      * Restarts the iteration. Returns false if there is no valid config at all,
      * that is, get() and next() may not be called.
@@ -86,6 +86,17 @@ void SqliteOutputScalarManager::endRun()
     closeFile();
 }
 
+void SqliteOutputScalarManager::switchRun(cConfiguration *cfg)
+{
+    if (state != NEW && state != STARTED)
+        throw cRuntimeError("%s: Cannot switch to another run after results have been recorded", getClassName());
+    bool started = state == STARTED;
+    state = NEW;
+    configure(getSimulation(), cfg);
+    if (started)
+        startRun();
+}
+
 void SqliteOutputScalarManager::openFileForRun()
 {
     // ensure startRun() has been invoked
@@ -78,6 +78,13 @@ class SqliteOutputScalarManager : public cIOutputScalarManager, private ResultFi
      */
     virtual void endRun() override;
 
+    /**
+     * Re-reads the configuration for the given run, and deletes its left-over
+     * output file if the run has already been started. It is an error if
+     * the output file of the current run has already been opened.
+     */
+    virtual void switchRun(cConfiguration *cfg) override;
+
     /** @name Scalar statistics */
     //@{
 
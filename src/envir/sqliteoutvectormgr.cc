@@ -108,6 +108,17 @@ void SqliteOutputVectorManager::endRun()
     }
 }
 
+void SqliteOutputVectorManager::switchRun(cConfiguration *cfg)
+{
+    if (state != NEW && state != STARTED)
+        throw cRuntimeError("%s: Cannot switch to another run after results have been recorded", getClassName());
+    bool started = state == STARTED;
+    state = NEW;
+    configure(getSimulation(), cfg);
+    if (started)
+        startRun();
+}
+
 void SqliteOutputVectorManager::openFileForRun()
 {
     // ensure startRun() has been invoked
@@ -96,6 +96,13 @@ class SqliteOutputVectorManager : public cIOutputVectorManager, private ResultFi
      */
     virtual void endRun() override;
 
+    /**
+     * Re-reads the configuration for the given run, and deletes its left-over
+     * output file if the run has already been started. It is an error if
+     * the output file of the current run has already been opened.
+     */
+    virtual void switchRun(cConfiguration *cfg) override;
+
     /**
      * Registers a vector and returns a handle.
      */
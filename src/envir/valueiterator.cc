@@ -280,11 +280,25 @@ void ValueIterator::operator++(int)
     }
 }
 
-bool ValueIterator::gotoPosition(int pos, const VariableMap& vars)
+bool ValueIterator::gotoPosition(int position, const VariableMap& vars)
 {
     restart(vars);
-    for ( ; pos > 0 && !end(); --pos)
-        (*this)++;
+
+    // same as calling operator++ position times, but skips over whole items
+    while (position > 0 && !end()) {
+        int numValues = items[itemIndex].getNumValues();
+        if (k + position < numValues) {
+            k += position;
+            pos += position;
+            break;
+        }
+        int step = numValues - k;
+        position -= step;
+        pos += step;
+        k = 0;
+        while (++itemIndex < (int)items.size() && items[itemIndex].getNumValues() == 0)
+            ;
+    }
     return !end();
 }
 
@@ -116,37 +116,31 @@ void cFilteredCollectObjectsVisitor::setFilterPars(unsigned int cat,
         objFullpathPattern = new MatchExpression(objfullpathpatt, false, true, true);
 }
 
+unsigned int cFilteredCollectObjectsVisitor::getCategories(cObject *obj)
+{
+    unsigned int result = 0;
+    if (dynamic_cast<cModule *>(obj))
+        result |= CATEGORY_MODULES;
+    if (dynamic_cast<cMessage *>(obj))
+        result |= CATEGORY_MESSAGES;
+    if (dynamic_cast<cQueue *>(obj))
+        result |= CATEGORY_QUEUES;
+    if (dynamic_cast<cWatchBase *>(obj) || dynamic_cast<cFSM *>(obj))
+        result |= CATEGORY_WATCHES;
+    if (dynamic_cast<cOutVector *>(obj) || dynamic_cast<cResultRecorder *>(obj) || dynamic_cast<cStatistic *>(obj))
+        result |= CATEGORY_STATISTICS;
+    if (dynamic_cast<cPar *>(obj))
+        result |= CATEGORY_PARAMS;
+    if (dynamic_cast<cChannel *>(obj) || dynamic_cast<cGate *>(obj))
+        result |= CATEGORY_CHANSGATES;
+    if (dynamic_cast<cFigure *>(obj) || dynamic_cast<cCanvas *>(obj) || dynamic_cast<cOsgCanvas *>(obj))
+        result |= CATEGORY_FIGURES;
+    return result != 0 ? result : CATEGORY_OTHERS;
+}
+
 bool cFilteredCollectObjectsVisitor::visit(cObject *obj)
 {
-    bool ok = (category == ~0U) ||
-        ((category&CATEGORY_MODULES) && dynamic_cast<cModule *>(obj)) ||
-        ((category&CATEGORY_MESSAGES) && dynamic_cast<cMessage *>(obj)) ||
-        ((category&CATEGORY_QUEUES) && dynamic_cast<cQueue *>(obj)) ||
-        ((category&CATEGORY_WATCHES) && (dynamic_cast<cWatchBase *>(obj) ||
-                                         dynamic_cast<cFSM *>(obj))) ||
-        ((category&CATEGORY_STATISTICS) && (dynamic_cast<cOutVector *>(obj) ||
-                                            dynamic_cast<cResultRecorder *>(obj) ||
-                                            dynamic_cast<cStatistic *>(obj))) ||
-        ((category&CATEGORY_PARAMS) && (dynamic_cast<cPar *>(obj))) ||
-        ((category&CATEGORY_CHANSGATES) && (dynamic_cast<cChannel *>(obj) ||
-                                            dynamic_cast<cGate *>(obj))) ||
-        ((category&CATEGORY_FIGURES) && (dynamic_cast<cFigure *>(obj) ||
-                                         dynamic_cast<cCanvas *>(obj) ||
-                                         dynamic_cast<cOsgCanvas *>(obj))) ||
-        ((category&CATEGORY_OTHERS) && (!dynamic_cast<cModule *>(obj) &&
-                                        !dynamic_cast<cMessage *>(obj) &&
-                                        !dynamic_cast<cQueue *>(obj) &&
-                                        !dynamic_cast<cWatchBase *>(obj) &&
-                                        !dynamic_cast<cFSM *>(obj) &&
-                                        !dynamic_cast<cOutVector *>(obj) &&
-                                        !dynamic_cast<cResultRecorder *>(obj) &&
-                                        !dynamic_cast<cStatistic *>(obj) &&
-                                        !dynamic_cast<cPar *>(obj) &&
-                                        !dynamic_cast<cChannel *>(obj) &&
-                                        !dynamic_cast<cGate *>(obj) &&
-                                        !dynamic_cast<cFigure *>(obj) &&
-                                        !dynamic_cast<cCanvas *>(obj) &&
-                                        !dynamic_cast<cOsgCanvas *>(obj)));
+    bool ok = (category == ~0U) || (category & getCategories(obj)) != 0;
     if (objFullpathPattern || classnamePattern) {
         MatchableObjectAdapter objAdapter(MatchableObjectAdapter::FULLPATH, obj);
         ok = ok && (!objFullpathPattern || objFullpathPattern->matches(&objAdapter));
@@ -97,6 +97,13 @@ class ENVIR_API cFilteredCollectObjectsVisitor : public cCollectObjectsVisitor
     void setFilterPars(unsigned int category,
                        const char *classnamepattern,
                        const char *objfullpathpattern);
+
+    /**
+     * Returns the categories the object belongs to, as the binary OR'ed
+     * value of CATEGORY_... constants. Objects that do not fit into any
+     * other category belong to CATEGORY_OTHERS.
+     */
+    static unsigned int getCategories(cObject *obj);
 };
 
 /**
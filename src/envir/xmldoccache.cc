@@ -13,10 +13,14 @@
   `license' for details on this and other legal matters.
 *--------------------------------------------------------------*/
 
+#include <mutex>
+#include <sys/stat.h>
 #include "xmldoccache.h"
 
 #include "common/fileutil.h"
 #include "common/saxparser_default.h"
+#include "common/compactxmldocument.h"
+#include "omnetpp/platdep/platmisc.h"
 #include "omnetpp/cobject.h"
 #include "omnetpp/cxmlelement.h"
 #include "omnetpp/cexception.h"
@@ -106,6 +110,77 @@ void cXmlSaxHandler::processingInstruction(const char *target, const char *data)
 
 //=========================================================
 
+/**
+ * A cXMLElement backed by a node of a shared CompactXmlDocument. The child
+ * elements are created when the children of the element are first accessed.
+ */
+class cCompactXmlElement : public cXMLElement
+{
+  protected:
+    std::shared_ptr<const CompactXmlDocument> document;
+    const CompactXmlDocument::Node *node;
+    bool expanded = false;
+
+  protected:
+    void expand() const {if (!expanded) const_cast<cCompactXmlElement*>(this)->doExpand();}
+    void doExpand();
+
+  public:
+    cCompactXmlElement(const std::shared_ptr<const CompactXmlDocument>& document, const CompactXmlDocument::Node *node);
+
+    virtual bool hasChildren() const override {return expanded ? cXMLElement::hasChildren() : node->hasChildren();}
+    virtual cXMLElement *getFirstChild() const override {expand(); return cXMLElement::getFirstChild();}
+    virtual cXMLElement *getLastChild() const override {expand(); return cXMLElement::getLastChild();}
+    virtual void appendChild(cXMLElement *node) override {expand(); cXMLElement::appendChild(node);}
+    virtual void insertChildBefore(cXMLElement *where, cXMLElement *node) override {expand(); cXMLElement::insertChildBefore(where, node);}
+    virtual cXMLElement *removeChild(cXMLElement *node) override {expand(); return cXMLElement::removeChild(node);}
+};
+
+cCompactXmlElement::cCompactXmlElement(const std::shared_ptr<const CompactXmlDocument>& document, const CompactXmlDocument::Node *node) :
+    cXMLElement(node->getTagName()), document(document), node(node)
+{
+    if (node != document->getDocumentNode()) {
+        setSourceLocation(document->getFileName(), node->getSourceLineNumber());
+        if (node->hasAttributes())
+            setAttributes(node->getAttributes());
+        if (*node->getNodeValue())
+            setNodeValue(node->getNodeValue());
+    }
+}
+
+void cCompactXmlElement::doExpand()
+{
+    expanded = true;
+    for (const CompactXmlDocument::Node *child = node->getFirstChild(); child; child = child->getNextSibling())
+        cXMLElement::appendChild(new cCompactXmlElement(document, child));
+}
+
+//=========================================================
+
+namespace {
+
+struct SharedDocument {
+    std::shared_ptr<const CompactXmlDocument> document;
+    int64_t fileSize;
+    int64_t modificationTime;
+};
+
+struct SharedCache {
+    std::mutex mutex;
+    std::map<std::string, SharedDocument> documents;  // key is the absolute file name
+    std::map<std::string, std::shared_ptr<const CompactXmlDocument>> contents;  // key is the content (XML text)
+};
+
+SharedCache& sharedCache()
+{
+    static SharedCache cache;
+    return cache;
+}
+
+}  // namespace
+
+//=========================================================
+
 XMLDocCache::~XMLDocCache()
 {
     for (auto & i : documentCache)
@@ -114,9 +189,53 @@ XMLDocCache::~XMLDocCache()
         dropAndDelete(i.second);
 }
 
-cXMLElement *XMLDocCache::parseDocument(const char *filename)
+std::shared_ptr<const CompactXmlDocument> XMLDocCache::getSharedDocument(const char *filename, const std::string& key)
+{
+    struct opp_stat_t statbuf;
+    bool statOk = opp_stat(filename, &statbuf) == 0;
+    int64_t fileSize = statOk ? (int64_t)statbuf.st_size : -1;
+    int64_t modificationTime = statOk ? (int64_t)statbuf.st_mtime : -1;
+
+    SharedCache& cache = sharedCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.documents.find(key);
+        if (it != cache.documents.end() && it->second.fileSize == fileSize && it->second.modificationTime == modificationTime)
+            return it->second.document;
+    }
+
+    // parse outside the lock; if several threads load the same file concurrently, the last one wins
+    std::shared_ptr<const CompactXmlDocument> document(CompactXmlDocument::parseFile(filename));
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.documents[key] = SharedDocument { document, fileSize, modificationTime };
+    return document;
+}
+
+std::shared_ptr<const CompactXmlDocument> XMLDocCache::getSharedContent(const char *content)
+{
+    SharedCache& cache = sharedCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.contents.find(content);
+        if (it != cache.contents.end())
+            return it->second;
+    }
+
+    std::shared_ptr<const CompactXmlDocument> document(CompactXmlDocument::parseContent(content));
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.contents[content] = document;
+    return document;
+}
+
+cXMLElement *XMLDocCache::parseDocument(const char *filename, const std::string& key)
 {
     try {
+        if (!DefaultSaxParser::fileContainsDoctype(filename)) {
+            std::shared_ptr<const CompactXmlDocument> document = getSharedDocument(filename, key);
+            return new cCompactXmlElement(document, document->getDocumentNode());
+        }
+
+        // DTD may alter document content, let DefaultSaxParser deal with it
         cXmlSaxHandler saxHandler(filename);
         DefaultSaxParser parser;
 
@@ -132,6 +251,11 @@ cXMLElement *XMLDocCache::parseDocument(const char *filename)
 cXMLElement *XMLDocCache::parseContent(const char *content)
 {
     try {
+        if (!DefaultSaxParser::containsDoctype(content)) {
+            std::shared_ptr<const CompactXmlDocument> document = getSharedContent(content);
+            return new cCompactXmlElement(document, document->getDocumentNode());
+        }
+
         cXmlSaxHandler saxHandler("content");
         DefaultSaxParser parser;
 
@@ -153,7 +277,7 @@ cXMLElement *XMLDocCache::getDocument(const char *filename)
         return it->second;
 
     // load and store in cache
-    cXMLElement *documentnode = parseDocument(filename);
+    cXMLElement *documentnode = parseDocument(filename, key);
     documentCache[key] = documentnode;
     take(documentnode);
     return documentnode;
@@ -176,6 +300,11 @@ cXMLElement *XMLDocCache::getParsed(const char *content)
 void XMLDocCache::forgetDocument(const char *filename)
 {
     std::string key = tidyFilename(toAbsolutePath(filename).c_str());
+    {
+        SharedCache& cache = sharedCache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.documents.erase(key);
+    }
     XMLDocMap::iterator it = documentCache.find(key);
     if (it != documentCache.end()) {
         cXMLElement *node = it->second;
@@ -186,6 +315,11 @@ void XMLDocCache::forgetDocument(const char *filename)
 
 void XMLDocCache::forgetParsed(const char *content)
 {
+    {
+        SharedCache& cache = sharedCache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.contents.erase(content);
+    }
     XMLDocMap::iterator it = contentCache.find(content);
     if (it != contentCache.end()) {
         cXMLElement *node = it->second;
@@ -208,6 +342,14 @@ void XMLDocCache::flushParsedContentCache()
     contentCache.clear();
 }
 
+void XMLDocCache::flushSharedCache()
+{
+    SharedCache& cache = sharedCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.documents.clear();
+    cache.contents.clear();
+}
+
 }  // namespace envir
 }  // namespace omnetpp
 
@@ -21,15 +21,29 @@
 
 #include <map>
 #include <string>
+#include <memory>
 #include "omnetpp/simkerneldefs.h"
 #include "omnetpp/cxmlelement.h"
 #include "envirdefs.h"
 
 namespace omnetpp {
+
+namespace common { class CompactXmlDocument; }
+
 namespace envir {
 
 /**
  * Reads and caches XML config files.
+ *
+ * Documents are parsed into read-only common::CompactXmlDocument trees, which
+ * are kept in a process-wide cache, and are shared by all XMLDocCache
+ * instances (i.e. by subsequent and concurrent simulation runs in the same
+ * process). A file is parsed again if its size or modification time has
+ * changed. The cXMLElement trees returned by this class are per instance,
+ * and they are created on demand: child elements are only created when the
+ * children of an element are first accessed. Documents with a DOCTYPE
+ * declaration are loaded with the SAX-based parser (see DefaultSaxParser),
+ * and are not shared.
  */
 class ENVIR_API XMLDocCache : public cObject
 {
@@ -39,8 +53,10 @@ class ENVIR_API XMLDocCache : public cObject
     XMLDocMap contentCache; // key is the content (XML text)
 
   protected:
-    cXMLElement *parseDocument(const char *filename);
+    cXMLElement *parseDocument(const char *filename, const std::string& key);
     cXMLElement *parseContent(const char *content);
+    std::shared_ptr<const common::CompactXmlDocument> getSharedDocument(const char *filename, const std::string& key);
+    std::shared_ptr<const common::CompactXmlDocument> getSharedContent(const char *content);
 
   public:
     /**
@@ -93,6 +109,12 @@ class ENVIR_API XMLDocCache : public cObject
      * Empties the parsed content cache.
      */
     virtual void flushParsedContentCache();
+
+    /**
+     * Empties the process-wide cache of shared documents. cXMLElement trees
+     * that have already been created remain valid.
+     */
+    static void flushSharedCache();
 };
 
 }  // namespace envir
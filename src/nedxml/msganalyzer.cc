@@ -18,6 +18,8 @@
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstdlib>
 
 #include "common/stringtokenizer.h"
 #include "common/fileutil.h"
@@ -49,6 +51,18 @@ inline bool isQualified(const std::string& qname)
     return qname.find("::") != qname.npos;
 }
 
+// upper limit for @inlineCapacity; the inline buffer is part of every object
+static const int MAX_INLINE_CAPACITY = 1024;
+
+static bool isValidInlineCapacity(const std::string& capacity)
+{
+    if (capacity.empty() || capacity.find_first_not_of("0123456789") != std::string::npos)
+        return false;
+    errno = 0;
+    long value = strtol(capacity.c_str(), nullptr, 10);
+    return errno == 0 && value >= 1 && value <= MAX_INLINE_CAPACITY;
+}
+
 static std::string makeIdentifier(const std::string& qname)
 {
     std::string tmp = qname;
@@ -314,6 +328,7 @@ void MsgAnalyzer::analyzeClassOrStruct(ClassInfo& classInfo, const std::string&
         errors->addError(classInfo.astNode, "invalid value '%s' for @descriptor, should be 'true', 'false' or 'readonly'", descProp.c_str());
     classInfo.generateDescriptor = opts.generateDescriptors && !classInfo.isOpaque && descProp != "false"; // opaque also means no descriptor
     classInfo.generateSettersInDescriptor = opts.generateSettersInDescriptors && descProp != "readonly";
+    classInfo.generateBinaryPacking = getPropertyAsBool(classInfo.props, PROP_BINARYPACKING, opts.generateBinaryPacking);
 
     if (!existingClass && isQualified(classInfo.name))
         errors->addError(classInfo.astNode, "class name may only contain '::' when generating descriptor for an existing class");
@@ -576,6 +591,21 @@ void MsgAnalyzer::analyzeField(ClassInfo& classInfo, FieldInfo *field, const std
     std::string sizetypeprop = getProperty(field->props, PROP_SIZETYPE);
     field->sizeType = !sizetypeprop.empty() ? sizetypeprop : "size_t";
 
+    // small-buffer storage for dynamic arrays
+    if (hasProperty(field->props, PROP_INLINECAPACITY)) {
+        std::string capacity = getProperty(field->props, PROP_INLINECAPACITY);
+        if (!field->isDynamicArray)
+            errors->addError(field->astNode, "@inlineCapacity may only be specified for dynamic arrays (field '%s' in '%s')", field->name.c_str(), classInfo.name.c_str());
+        else if (!isValidInlineCapacity(capacity))
+            errors->addError(field->astNode, "invalid value '%s' for @inlineCapacity, should be an integer between 1 and %d (field '%s' in '%s')", capacity.c_str(), MAX_INLINE_CAPACITY, field->name.c_str(), classInfo.name.c_str());
+        else if (!field->isPointer && field->iscOwnedObject)
+            errors->addError(field->astNode, "@inlineCapacity is not supported for arrays of cOwnedObject values (field '%s' in '%s')", field->name.c_str(), classInfo.name.c_str());
+        else {
+            field->inlineCapacity = capacity;
+            field->inlineVar = field->var + "_inline";
+        }
+    }
+
     // data type, argument type, conversion to/from string...
     std::string cpptypeBase = getProperty(field->props, PROP_CPPTYPE, "");
     std::string datatypeBase = getProperty(field->props, PROP_DATAMEMBERTYPE, cpptypeBase);
@@ -123,6 +123,7 @@ class NEDXML_API MsgAnalyzer
     static constexpr const char* PROP_BEFORECHANGE = "beforeChange";
     static constexpr const char* PROP_IMPLEMENTS = "implements";
     static constexpr const char* PROP_NOPACK = "nopack";
+    static constexpr const char* PROP_BINARYPACKING = "binaryPacking";
     static constexpr const char* PROP_OWNED = "owned";
     static constexpr const char* PROP_EDITABLE = "editable";
     static constexpr const char* PROP_REPLACEABLE = "replaceable";
@@ -132,6 +133,7 @@ class NEDXML_API MsgAnalyzer
     static constexpr const char* PROP_OVERRIDESETTER = "overrideSetter";
     static constexpr const char* PROP_ENUM = "enum";
     static constexpr const char* PROP_SIZETYPE = "sizeType";
+    static constexpr const char* PROP_INLINECAPACITY = "inlineCapacity";
     static constexpr const char* PROP_SETTER = "setter";
     static constexpr const char* PROP_GETTER = "getter";
     static constexpr const char* PROP_GETTERFORUPDATE = "getterForUpdate";
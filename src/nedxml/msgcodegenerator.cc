@@ -390,6 +390,11 @@ void MsgCodeGenerator::generateClassDecl(const ClassInfo& classInfo, const std::
         if (field.isFixedArray) {
             H << "    " << field.dataType << " " << field.var << "[" << field.arraySize << "]" << (field.value == "0" ? " = {0}" : "") << ";\n"; // note: C++ has no syntax for filling a full array with a (nonzero) value in an expression
         }
+        else if (field.isDynamicArray && !field.inlineCapacity.empty()) {
+            H << "    " << field.dataType << " " << field.inlineVar << "[" << field.inlineCapacity << "];\n";
+            H << "    " << field.dataType << " *" << field.var << " = " << field.inlineVar << ";\n";
+            H << "    " << field.sizeType << " " << field.sizeVar << " = 0;\n";
+        }
         else if (field.isDynamicArray) {
             H << "    " << field.dataType << " *" << field.var << " = nullptr;\n";
             H << "    " << field.sizeType << " " << field.sizeVar << " = 0;\n";
@@ -504,6 +509,25 @@ inline std::string var(const MsgTypeTable::FieldInfo& field)
     return str("this->") + field.var;
 }
 
+// dynamic arrays: expression for the storage of an array of the given size; with @inlineCapacity,
+// the inline buffer is used for sizes up to the capacity (including zero)
+inline std::string allocArray(const MsgTypeTable::FieldInfo& field, const std::string& size, const std::string& obj="this->")
+{
+    if (field.inlineCapacity.empty())
+        return str("(") + size + "==0) ? nullptr : new " + field.dataType + "[" + size + "]";
+    else
+        return str("(") + size + "<=" + field.inlineCapacity + ") ? " + obj + field.inlineVar + " : new " + field.dataType + "[" + size + "]";
+}
+
+// dynamic arrays: statement to release the storage (unless it is the inline buffer)
+inline std::string freeArray(const MsgTypeTable::FieldInfo& field, const std::string& obj="this->")
+{
+    if (field.inlineCapacity.empty())
+        return str("delete [] ") + obj + field.var + ";";
+    else
+        return str("if (") + obj + field.var + " != " + obj + field.inlineVar + ") delete [] " + obj + field.var + ";";
+}
+
 inline std::string varElem(const MsgTypeTable::FieldInfo& field)
 {
     return str("this->") + field.var + (field.isArray ? "[i]" : "");
@@ -595,7 +619,7 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             if (!releaseElem.str().empty())
                 CC << forEachIndex(field) << "\n" << opp_indentlines(releaseElem.str(), "    ");
             if (field.isDynamicArray)
-                CC << "    delete [] " << var(field) << ";\n";
+                CC << "    " << freeArray(field) << "\n";
         }
         else {
             CC << releaseElem.str();
@@ -638,11 +662,11 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
         if (field.isArray && !releaseElem.str().empty())
             CC << forEachIndex(field) << "\n" << opp_indentlines(releaseElem.str(), "    ");
         if (field.isDynamicArray)
-            CC << "    delete [] " << var(field) << ";\n";
+            CC << "    " << freeArray(field) << "\n";
 
         // allocate new dynamic array
         if (field.isDynamicArray) {
-            CC << "    " << var(field) << " = (other." << field.sizeVar << "==0) ? nullptr : new " << field.dataType << "[other." << field.sizeVar << "];\n";
+            CC << "    " << var(field) << " = " << allocArray(field, "other." + field.sizeVar) << ";\n";
             CC << "    " << field.sizeVar << " = other." << field.sizeVar << ";\n";
         }
 
@@ -709,20 +733,24 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             CC << "    doParsimPacking(b,(::" << classInfo.baseClass << "&)*this);\n";  // this would do for cOwnedObject too, but the other is nicer
         }
     }
-    for (const auto& field : classInfo.fieldList) {
-        if (field.nopack)
-            continue; // @nopack specified
-        if (field.isAbstract || field.isCustom) {
-            CC << "    // field " << field.name << " is abstract or custom -- please do packing in customized class\n";
-        }
-        else {
-            if (field.isArray) {
-                if (field.isDynamicArray)
-                    CC << "    b->pack(" << field.sizeVar << ");\n";
-                CC << "    doParsimArrayPacking(b," << var(field) << "," << field.sizeVar << ");\n";
+    if (classInfo.generateBinaryPacking)
+        generateBinaryPacking(classInfo, "this->");
+    else {
+        for (const auto& field : classInfo.fieldList) {
+            if (field.nopack)
+                continue; // @nopack specified
+            if (field.isAbstract || field.isCustom) {
+                CC << "    // field " << field.name << " is abstract or custom -- please do packing in customized class\n";
             }
             else {
-                CC << "    doParsimPacking(b," << var(field) << ");\n";
+                if (field.isArray) {
+                    if (field.isDynamicArray)
+                        CC << "    b->pack(" << field.sizeVar << ");\n";
+                    CC << "    doParsimArrayPacking(b," << var(field) << "," << field.sizeVar << ");\n";
+                }
+                else {
+                    CC << "    doParsimPacking(b," << var(field) << ");\n";
+                }
             }
         }
     }
@@ -740,31 +768,32 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             CC << "    doParsimUnpacking(b,(::" << classInfo.baseClass << "&)*this);\n";  // this would do for cOwnedObject too, but the other is nicer
         }
     }
-    for (const auto& field : classInfo.fieldList) {
-        if (field.nopack)
-            continue; // @nopack specified
-        if (field.isAbstract || field.isCustom) {
-            CC << "    // field " << field.name << " is abstract or custom -- please do unpacking in customized class\n";
-        }
-        else {
-            if (field.isArray) {
-                if (field.isFixedArray) {
-                    CC << "    doParsimArrayUnpacking(b," << var(field) << "," << field.arraySize << ");\n";
+    if (classInfo.generateBinaryPacking)
+        generateBinaryUnpacking(classInfo, "this->");
+    else {
+        for (const auto& field : classInfo.fieldList) {
+            if (field.nopack)
+                continue; // @nopack specified
+            if (field.isAbstract || field.isCustom) {
+                CC << "    // field " << field.name << " is abstract or custom -- please do unpacking in customized class\n";
+            }
+            else {
+                if (field.isArray) {
+                    if (field.isFixedArray) {
+                        CC << "    doParsimArrayUnpacking(b," << var(field) << "," << field.arraySize << ");\n";
+                    }
+                    else {
+                        CC << "    " << freeArray(field) << "\n";
+                        CC << "    b->unpack(" << field.sizeVar << ");\n";
+                        CC << "    " << var(field) << " = " << allocArray(field, field.sizeVar) << ";\n";
+                        CC << "    if (" << field.sizeVar << " != 0)\n";
+                        CC << "        doParsimArrayUnpacking(b," << var(field) << "," << field.sizeVar << ");\n";
+                    }
                 }
                 else {
-                    CC << "    delete [] " << var(field) << ";\n";
-                    CC << "    b->unpack(" << field.sizeVar << ");\n";
-                    CC << "    if (" << field.sizeVar << " == 0) {\n";
-                    CC << "        " << var(field) << " = nullptr;\n";
-                    CC << "    } else {\n";
-                    CC << "        " << var(field) << " = new " << field.dataType << "[" << field.sizeVar << "];\n";
-                    CC << "        doParsimArrayUnpacking(b," << var(field) << "," << field.sizeVar << ");\n";
-                    CC << "    }\n";
+                    CC << "    doParsimUnpacking(b," << var(field) << ");\n";
                 }
             }
-            else {
-                CC << "    doParsimUnpacking(b," << var(field) << ");\n";
-            }
         }
     }
     generateMethodCplusplusBlock(classInfo, "parsimUnpack");
@@ -801,13 +830,22 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             CC << "void " << classInfo.className << "::" << field.sizeSetter << "(" << field.sizeType << " newSize)\n";
             CC << "{\n";
             CC << maybe_handleChange_line;
-            CC << "    " << field.dataType << " *" << field.var << "2 = (newSize==0) ? nullptr : new " << field.dataType << "[newSize];\n";
+            CC << "    " << field.dataType << " *" << field.var << "2 = " << allocArray(field, "newSize") << ";\n";
             CC << "    " << field.sizeType << " minSize = " << field.sizeVar << " < newSize ? " << field.sizeVar << " : newSize;\n";
-            CC << "    for (" << field.sizeType << " i = 0; i < minSize; i++)\n";
-            CC << "        " << field.var << "2[i] = " << var(field) << "[i];\n";
-            if (!field.value.empty()) {
+            if (!field.inlineCapacity.empty()) {
+                CC << "    if (" << field.var << "2 != " << var(field) << ")\n";
+                CC << "        for (" << field.sizeType << " i = 0; i < minSize; i++)\n";
+                CC << "            " << field.var << "2[i] = " << var(field) << "[i];\n";
+            }
+            else {
+                CC << "    for (" << field.sizeType << " i = 0; i < minSize; i++)\n";
+                CC << "        " << field.var << "2[i] = " << var(field) << "[i];\n";
+            }
+            // note: the inline buffer may hold stale elements beyond the current size, so reset them explicitly
+            std::string fillValue = !field.value.empty() ? field.value : !field.inlineCapacity.empty() ? field.dataType + "()" : "";
+            if (!fillValue.empty()) {
                 CC << "    for (" << field.sizeType << " i = minSize; i < newSize; i++)\n";
-                CC << "        " << field.var << "2[i] = " << field.value << ";\n";
+                CC << "        " << field.var << "2[i] = " << fillValue << ";\n";
             }
             if (!field.isPointer && field.iscOwnedObject)
                 CC << forEachIndex(field) << "\n" << "        drop(&" << varElem(field) << ");\n";
@@ -818,7 +856,7 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
                 else
                     CC << "        delete " << field.var << "[i];\n";
             }
-            CC << "    delete [] " << var(field) << ";\n";
+            CC << "    " << freeArray(field) << "\n";
             CC << "    " << var(field) << " = " << field.var << "2;\n";
             CC << "    " << field.sizeVar << " = newSize;\n";
             if (!field.isPointer && field.iscOwnedObject)
@@ -876,6 +914,17 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             CC << maybe_handleChange_line;
             generateMethodCplusplusBlock(classInfo, field.inserter);
             CC << "    " << field.sizeType << " newSize = " << field.sizeVar << " + 1;\n";
+            if (!field.inlineCapacity.empty()) {
+                CC << "    if (newSize <= " << field.inlineCapacity << ") {\n";
+                CC << "        for (" << field.sizeType << " i = " << field.sizeVar << "; i > k; i--)\n";
+                CC << "            " << var(field) << "[i] = " << var(field) << "[i-1];\n";
+                CC << "        " << var(field) << "[k] = " << field.argName << ";\n";
+                if (field.isOwnedPointer && !makeOwnershipOp(field, var(field) + "[k]", "take").empty())
+                    CC << "        " << makeOwnershipOp(field, var(field) + "[k]", "take") << "\n";
+                CC << "        " << field.sizeVar << " = newSize;\n";
+                CC << "        return;\n";
+                CC << "    }\n";
+            }
             CC << "    " << field.dataType << " *" << field.var << "2 = new " << field.dataType << "[newSize];\n";
             CC << "    " << field.sizeType << " i;\n";
             CC << "    for (i = 0; i < k; i++)\n";
@@ -887,7 +936,7 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             CC << "        " << field.var << "2[i] = " << var(field) << "[i-1];\n";
             if (!field.isPointer && field.iscOwnedObject)
                 CC << forEachIndex(field) << "\n" << "        drop(&" << varElem(field) << ");\n";
-            CC << "    delete [] " << var(field) << ";\n";
+            CC << "    " << freeArray(field) << "\n";
             CC << "    " << var(field) << " = " << field.var << "2;\n";
             CC << "    " << field.sizeVar << " = newSize;\n";
             if (!field.isPointer && field.iscOwnedObject)
@@ -908,7 +957,17 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             CC << maybe_handleChange_line;
             generateMethodCplusplusBlock(classInfo, field.eraser);
             CC << "    " << field.sizeType << " newSize = " << field.sizeVar << " - 1;\n";
-            CC << "    " << field.dataType << " *" << field.var << "2 = (newSize == 0) ? nullptr : new " << field.dataType << "[newSize];\n";
+            if (!field.inlineCapacity.empty()) {
+                CC << "    if (" << var(field) << " == this->" << field.inlineVar << ") {\n";
+                if (field.isOwnedPointer && !makeOwnershipOp(field, var(field) + "[k]", "delete").empty())
+                    CC << "        " << makeOwnershipOp(field, var(field) + "[k]", "delete") << "\n";
+                CC << "        for (" << field.sizeType << " i = k; i < newSize; i++)\n";
+                CC << "            " << var(field) << "[i] = " << var(field) << "[i+1];\n";
+                CC << "        " << field.sizeVar << " = newSize;\n";
+                CC << "        return;\n";
+                CC << "    }\n";
+            }
+            CC << "    " << field.dataType << " *" << field.var << "2 = " << allocArray(field, "newSize") << ";\n";
             CC << "    " << field.sizeType << " i;\n";
             CC << "    for (i = 0; i < k; i++)\n";
             CC << "        " << field.var << "2[i] = " << var(field) << "[i];\n";
@@ -918,7 +977,7 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
                 CC << forEachIndex(field) << "\n" << "        drop(&" << varElem(field) << ");\n";
             if (field.isOwnedPointer)
                 generateOwnershipOp(field, var(field) + "[k]", "delete");
-            CC << "    delete [] " << var(field) << ";\n";
+            CC << "    " << freeArray(field) << "\n";
             CC << "    " << var(field) << " = " << field.var << "2;\n";
             CC << "    " << field.sizeVar << " = newSize;\n";
             if (!field.isPointer && field.iscOwnedObject)
@@ -1010,13 +1069,17 @@ void MsgCodeGenerator::generateStructImpl(const ClassInfo& classInfo)
     CC << "{\n";
     if (!classInfo.baseClass.empty())
         CC << "    doParsimPacking(b,(::" << classInfo.baseClass << "&)a);\n";
-    for (const auto& field : classInfo.fieldList) {
-        if (field.isCustom)
-            continue;
-        if (field.isArray)
-            CC << "    doParsimArrayPacking(b,a." << field.var << "," << field.arraySize << ");\n";
-        else
-            CC << "    doParsimPacking(b,a." << field.var << ");\n";
+    if (classInfo.generateBinaryPacking)
+        generateBinaryPacking(classInfo, "a.");
+    else {
+        for (const auto& field : classInfo.fieldList) {
+            if (field.isCustom)
+                continue;
+            if (field.isArray)
+                CC << "    doParsimArrayPacking(b,a." << field.var << "," << field.arraySize << ");\n";
+            else
+                CC << "    doParsimPacking(b,a." << field.var << ");\n";
+        }
     }
     generateMethodCplusplusBlock(classInfo, "__doPacking");
     CC << "}\n\n";
@@ -1025,13 +1088,17 @@ void MsgCodeGenerator::generateStructImpl(const ClassInfo& classInfo)
     CC << "{\n";
     if (!classInfo.baseClass.empty())
         CC << "    doParsimUnpacking(b,(::" << classInfo.baseClass << "&)a);\n";
-    for (const auto& field : classInfo.fieldList) {
-        if (field.isCustom)
-            continue;
-        if (field.isArray)
-            CC << "    doParsimArrayUnpacking(b,a." << field.var << "," << field.arraySize << ");\n";
-        else
-            CC << "    doParsimUnpacking(b,a." << field.var << ");\n";
+    if (classInfo.generateBinaryPacking)
+        generateBinaryUnpacking(classInfo, "a.");
+    else {
+        for (const auto& field : classInfo.fieldList) {
+            if (field.isCustom)
+                continue;
+            if (field.isArray)
+                CC << "    doParsimArrayUnpacking(b,a." << field.var << "," << field.arraySize << ");\n";
+            else
+                CC << "    doParsimUnpacking(b,a." << field.var << ");\n";
+        }
     }
     generateMethodCplusplusBlock(classInfo, "__doUnpacking");
     CC << "}\n\n";
@@ -1039,6 +1106,123 @@ void MsgCodeGenerator::generateStructImpl(const ClassInfo& classInfo)
     reportUnusedMethodCplusplusBlocks(classInfo);
 }
 
+bool MsgCodeGenerator::isBinaryPackable(const FieldInfo& field)
+{
+    // types for which cCommBuffer has both scalar and array pack()/unpack() overloads
+    // (note: int8_t is missing because there is no overload for signed char)
+    static const std::set<std::string> types {
+        "bool", "char", "unsigned char", "short", "unsigned short", "int", "unsigned int",
+        "long", "unsigned long", "float", "double", "omnetpp::simtime_t",
+        "uint8_t", "int16_t", "uint16_t", "int32_t", "uint32_t", "int64_t", "uint64_t",
+    };
+    return !field.nopack && !field.isAbstract && !field.isCustom && !field.isPointer && !field.isConst && contains(types, field.baseDataType);
+}
+
+size_t MsgCodeGenerator::findBinaryPackableRun(const ClassInfo& classInfo, size_t start)
+{
+    // returns the index one past the last scalar binary-packable field in the
+    // run that starts at 'start'. Only fields of the same type are grouped, so
+    // that they can be copied into a local array and transferred with one call
+    // to the typed pack(const T*, n) overloads, which lets cCommBuffer
+    // implementations (e.g. MPI) convert the values
+    const auto& fields = classInfo.fieldList;
+    size_t end = start;
+    while (end < fields.size() && isBinaryPackable(fields[end]) && !fields[end].isArray && fields[end].baseDataType == fields[start].baseDataType)
+        end++;
+    return end;
+}
+
+void MsgCodeGenerator::generateBinaryPacking(const ClassInfo& classInfo, const std::string& obj)
+{
+    const auto& fields = classInfo.fieldList;
+    for (size_t i = 0; i < fields.size(); i++) {
+        const FieldInfo& field = fields[i];
+        std::string var = obj + field.var;
+        if (field.nopack)
+            continue; // @nopack specified
+        if (field.isAbstract || field.isCustom) {
+            CC << "    // field " << field.name << " is abstract or custom -- please do packing in customized class\n";
+        }
+        else if (!isBinaryPackable(field)) {
+            if (field.isArray) {
+                if (field.isDynamicArray)
+                    CC << "    b->pack(" << field.sizeVar << ");\n";
+                CC << "    doParsimArrayPacking(b," << var << "," << field.sizeVar << ");\n";
+            }
+            else {
+                CC << "    doParsimPacking(b," << var << ");\n";
+            }
+        }
+        else if (field.isArray) {
+            if (field.isDynamicArray)
+                CC << "    b->pack(" << field.sizeVar << ");\n";
+            CC << "    b->pack(" << var << ", " << field.sizeVar << ");\n";
+        }
+        else {
+            size_t end = findBinaryPackableRun(classInfo, i);
+            if (end == i + 1)
+                CC << "    b->pack(" << var << ");\n";
+            else {
+                // copy into an array: separate data members must not be accessed as one
+                CC << "    {\n";
+                CC << "        const " << field.baseDataType << " values[] = {";
+                for (size_t k = i; k < end; k++)
+                    CC << (k == i ? "" : ", ") << obj << fields[k].var;
+                CC << "}; // fields " << field.name << ".." << fields[end-1].name << "\n";
+                CC << "        b->pack(values, " << (end - i) << ");\n";
+                CC << "    }\n";
+            }
+            i = end - 1;
+        }
+    }
+}
+
+void MsgCodeGenerator::generateBinaryUnpacking(const ClassInfo& classInfo, const std::string& obj)
+{
+    const auto& fields = classInfo.fieldList;
+    for (size_t i = 0; i < fields.size(); i++) {
+        const FieldInfo& field = fields[i];
+        std::string var = obj + field.var;
+        if (field.nopack)
+            continue; // @nopack specified
+        if (field.isAbstract || field.isCustom) {
+            CC << "    // field " << field.name << " is abstract or custom -- please do unpacking in customized class\n";
+        }
+        else if (field.isArray) {
+            bool packable = isBinaryPackable(field);
+            std::string unpackCall = packable ? "b->unpack(" + var + ", " : "doParsimArrayUnpacking(b," + var + ",";
+            if (field.isFixedArray) {
+                CC << "    " << unpackCall << field.arraySize << ");\n";
+            }
+            else {
+                const std::string& size = field.sizeVar;
+                CC << "    " << freeArray(field, obj) << "\n";
+                CC << "    b->unpack(" << size << ");\n";
+                CC << "    " << var << " = " << allocArray(field, size, obj) << ";\n";
+                CC << "    if (" << size << " != 0)\n";
+                CC << "        " << unpackCall << size << ");\n";
+            }
+        }
+        else if (!isBinaryPackable(field)) {
+            CC << "    doParsimUnpacking(b," << var << ");\n";
+        }
+        else {
+            size_t end = findBinaryPackableRun(classInfo, i);
+            if (end == i + 1)
+                CC << "    b->unpack(" << var << ");\n";
+            else {
+                CC << "    {\n";
+                CC << "        " << field.baseDataType << " values[" << (end - i) << "]; // fields " << field.name << ".." << fields[end-1].name << "\n";
+                CC << "        b->unpack(values, " << (end - i) << ");\n";
+                for (size_t k = i; k < end; k++)
+                    CC << "        " << obj << fields[k].var << " = values[" << (k - i) << "];\n";
+                CC << "    }\n";
+            }
+            i = end - 1;
+        }
+    }
+}
+
 void MsgCodeGenerator::generateToAnyPtr(const ClassInfo& classInfo)
 {
     // only for root classes! and for classes with multiple inheritance, to prevent compiler errors due to ambiguity
@@ -1717,6 +1901,13 @@ std::string MsgCodeGenerator::makeFuncall(const std::string& var, bool isPointer
 }
 
 void MsgCodeGenerator::generateOwnershipOp(const FieldInfo& field, const std::string& var, const std::string& op)
+{
+    std::string code = makeOwnershipOp(field, var, op);
+    if (!code.empty())
+        CC << "    " + code + "\n";
+}
+
+std::string MsgCodeGenerator::makeOwnershipOp(const FieldInfo& field, const std::string& var, const std::string& op)
 {
     Assert(field.isOwnedPointer);
     std::string code;
@@ -1737,8 +1928,7 @@ void MsgCodeGenerator::generateOwnershipOp(const FieldInfo& field, const std::st
         else // plain cObject*
             code = "if (" + var + " != nullptr && " + var +"->isOwnedObject()) " + op + "((cOwnedObject*)" + var +");";
     }
-    if (!code.empty())
-        CC << "    " + code + "\n";
+    return code;
 }
 
 void MsgCodeGenerator::generateImport(const std::string& importName)
@@ -59,6 +59,7 @@ class NEDXML_API MsgCodeGenerator
     std::string prefixWithNamespace(const std::string& name, const std::string& namespaceName);
     std::string makeFuncall(const std::string& var, bool isPointer, const std::string& funcTemplate, bool withIndex=false, const std::string& value="");
     void generateOwnershipOp(const FieldInfo& field, const std::string& var, const std::string& op);
+    std::string makeOwnershipOp(const FieldInfo& field, const std::string& var, const std::string& op);
 
     void generateClassDecl(const ClassInfo& classInfo, const std::string& exportDef);
     void generateClassImpl(const ClassInfo& classInfo);
@@ -67,6 +68,10 @@ class NEDXML_API MsgCodeGenerator
     void generateCplusplusBlock(std::ofstream& out, const std::string& body);
     void generateMethodCplusplusBlock(const ClassInfo& classInfo, const std::string& method);
     void reportUnusedMethodCplusplusBlocks(const ClassInfo& classInfo);
+    bool isBinaryPackable(const FieldInfo& field);
+    size_t findBinaryPackableRun(const ClassInfo& classInfo, size_t start);
+    void generateBinaryPacking(const ClassInfo& classInfo, const std::string& obj);
+    void generateBinaryUnpacking(const ClassInfo& classInfo, const std::string& obj);
     void generateDelegationForBaseClassFields(const std::string& code);
 
   public:
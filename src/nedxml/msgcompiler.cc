@@ -63,6 +63,7 @@ const char *MsgCompiler::BUILTIN_DEFINITIONS =
         @property[beforeChange](type=string; usage=class; desc="Method to be called before mutator code (in setters, non-const getters, operator=, etc.).");
         @property[implements](type=stringlist; usage=class; desc="Names of additional base classes.");
         @property[nopack](type=bool; usage=field; desc="If true: Ignore this field in parsimPack/parsimUnpack methods.");
+        @property[binaryPacking](type=bool; usage=class; desc="If true: Generate parsimPack/parsimUnpack methods that transfer fields of fundamental types (and arrays of them) with bulk pack()/unpack() calls, and consecutive scalar fields of such types as a single raw memory block. The latter assumes that all partitions use the same data layout (compiler, architecture). The default is set by the opp_msgc --binary-packing option.");
         @property[editable](type=bool; usage=field,class; desc="Affects descriptor class only. If true: Value of the field (or value of fields that are instances of this type) can be set via the class descriptor's setFieldValueFromString() and setFieldValue() methods.");
         @property[replaceable](type=bool; usage=field; desc="Affects descriptor class only. If true: Field is a pointer whose value can be set via the class descriptor's setFieldStructValuePointer() and setFieldValue() methods.");
         @property[resizable](type=bool; usage=field; desc="Affects descriptor class only. If true: Field is a variable-size array whose size can be set via the class descriptor's setFieldArraySize() method.");
@@ -71,6 +72,7 @@ const char *MsgCompiler::BUILTIN_DEFINITIONS =
         @property[overrideSetter](type=bool; usage=field; desc="If true: Add the 'override' keyword to the declaration of the setter method.");
         @property[enum](type=string; usage=field; desc="For integer fields: Values are from the given enum.");
         @property[sizeType](type=string; usage=field; desc="C++ type to use for array sizes and indices.");
+        @property[inlineCapacity](type=int; usage=field; desc="For dynamic arrays: Number of elements to store inside the object itself. Arrays up to that size need no heap allocation (neither on construction, copying nor resizing); larger arrays are allocated on the heap.");
         @property[setter](type=string; usage=field; desc="Name of the setter method. When generating a descriptor for an existing class (see @existingClass), a code fragment or funcall template for the equivalent functionality is also accepted.");
         @property[getter](type=string; usage=field; desc="Name of the (const) getter method. When generating a descriptor for an existing class (see @existingClass), a code fragment or funcall template for the equivalent functionality is also accepted.");
         @property[getterForUpdate](type=string; usage=field; desc="Name of the non-const getter method. When generating a descriptor for an existing class (see @existingClass), a code fragment or funcall template for the equivalent functionality is also accepted.");
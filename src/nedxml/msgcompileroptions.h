@@ -36,6 +36,7 @@ struct MsgCompilerOptions
     bool generateClasses = true;
     bool generateDescriptors = true;
     bool generateSettersInDescriptors = true;
+    bool generateBinaryPacking = false;
 };
 
 }  // namespace nedxml
@@ -108,6 +108,8 @@ class NEDXML_API MsgTypeTable
         std::string argName;    // setter argument name
         std::string sizeVar;    // data member to store size of dynamic array
         std::string sizeType;   // type of array sizes and array indices
+        std::string inlineCapacity; // @inlineCapacity; for dynamic arrays: number of elements stored inside the object without heap allocation (or empty)
+        std::string inlineVar;  // data member for the inline storage of dynamic arrays with @inlineCapacity
         std::string getter;     // getter function name:  "T getter() const;" "const T& getter() const"  default value is getFoo
         std::string getterForUpdate; // mutable getter function name:  "T& getterForUpdate();" default value is getFooForUpdate
         bool hasGetterForUpdate; // whether a getterForUpdate method needs to be generated
@@ -194,6 +196,7 @@ class NEDXML_API MsgTypeTable
         bool generateDescriptor = true;
         bool generateSettersInDescriptor = true;
         bool generateCastFunction = false;
+        bool generateBinaryPacking = false;  // from @binaryPacking; use bulk pack()/unpack() calls for fields of fundamental types in parsimPack()/parsimUnpack()
 
         std::vector<std::string> rootClasses; // root(s) of its C++ class hierarchy
         StringVector implementsQNames;       // qnames of additional base classes, from @implements property
@@ -343,6 +343,7 @@ void MsgTool::printHelpPage(const std::string& page)
         help.option("-Xnc", "Do not generate classes, only descriptors (cf. @existingClass MSG property)");
         help.option("-Xnd", "Do not generate class descriptors (cf. @descriptor(false) MSG property)");
         help.option("-Xns", "Do not generate setters in class descriptors (cf. @descriptor(readonly) MSG property)");
+        help.option("--binary-packing", "Generate parsimPack()/parsimUnpack() methods that use bulk transfer for fields of fundamental types (cf. @binaryPacking MSG property).");
         help.option("-v", "Verbose");
         help.line();
     }
@@ -602,6 +603,9 @@ void MsgTool::generateCppCommand(int argc, char **argv)
         else if (!strcmp(argv[i], "-MP")) {
             opt_phonytargets = true;
         }
+        else if (!strcmp(argv[i], "--binary-packing")) {
+            msg_options.generateBinaryPacking = true;
+        }
         else if (!strncmp(argv[i], "-X", 2)) {
             const char *arg = argv[i]+2;
             if (!*arg) {
@@ -27,6 +27,9 @@
 #include "objectlistmodel.h"
 #include "objectlistview.h"
 #include "mainwindow.h"
+#include "objectindex.h"
+#include <QtCore/QPointer>
+#include <QtWidgets/QApplication>
 #include <QtWidgets/QMessageBox>
 #include <QtGui/QKeyEvent>
 
@@ -319,6 +322,14 @@ void FindObjectsDialog::refresh()
     }
     // get list
     int maxCount = getPref("maxcount", 1000).toInt();
+
+    ObjectIndex *index = getQtenv()->getObjectIndex();
+    if (index && index->canSearch(rootObject, getCategories(), className.toStdString().c_str())) {
+        searchIndex(index, rootObject, className.toStdString().c_str(), name.toStdString().c_str(), maxCount);
+        setPref("outofdate", false);
+        return;
+    }
+
     int num = 0;
     cObject **objList = getSubObjectsFilt(rootObject, className.toStdString().c_str(), name.toStdString().c_str(), maxCount, num);
 
@@ -350,12 +361,8 @@ void FindObjectsDialog::refresh()
     setPref("outofdate", false);
 }
 
-cObject **FindObjectsDialog::getSubObjectsFilt(cObject *object, const char *classNamePattern, const char *objFullPathPattern,
-                                                 int maxCount, int &num)
+unsigned int FindObjectsDialog::getCategories()
 {
-    // args: <ptr> <class> <fullpath> <maxcount>, where
-    //    <class> and <fullpath> may contain wildcards
-
     unsigned int category = 0;
 
     if (ui->modulesCheckBox->isChecked())
@@ -376,11 +383,19 @@ cObject **FindObjectsDialog::getSubObjectsFilt(cObject *object, const char *clas
         category |= CATEGORY_FIGURES;
     if (ui->otherCheckBox->isChecked())
         category |= CATEGORY_OTHERS;
+    return category;
+}
+
+cObject **FindObjectsDialog::getSubObjectsFilt(cObject *object, const char *classNamePattern, const char *objFullPathPattern,
+                                                 int maxCount, int &num)
+{
+    // args: <ptr> <class> <fullpath> <maxcount>, where
+    //    <class> and <fullpath> may contain wildcards
 
     // get filtered list
     cFilteredCollectObjectsVisitor visitor;
     visitor.setSizeLimit(maxCount);
-    visitor.setFilterPars(category, classNamePattern, objFullPathPattern);
+    visitor.setFilterPars(getCategories(), classNamePattern, objFullPathPattern);
     visitor.process(object);
     num = visitor.getArraySize();
 
@@ -392,6 +407,38 @@ cObject **FindObjectsDialog::getSubObjectsFilt(cObject *object, const char *clas
     return objs;
 }
 
+void FindObjectsDialog::searchIndex(ObjectIndex *index, cObject *object, const char *classNamePattern, const char *objFullPathPattern, int maxCount)
+{
+    listModel->setObjects(QVector<cObject *>());
+    ui->label->setText("Searching...");
+
+    // Results are displayed as they arrive. Meanwhile we only process non-input
+    // events (e.g. repaints), so the simulation cannot be started, or another
+    // search requested; objects deleted meanwhile are taken care of by the index.
+    QPointer<FindObjectsDialog> self(this);
+    int numFound = 0;
+    int num = index->search(object, getCategories(), classNamePattern, objFullPathPattern, maxCount,
+        [&](const std::vector<cObject *>& objects) -> bool {
+            QVector<cObject *> batch;
+            batch.reserve((int)objects.size());
+            for (cObject *obj : objects)
+                batch.push_back(obj);
+            listModel->addObjects(batch);
+            numFound += (int)objects.size();
+            ui->label->setText("Searching, found " + QString::number(numFound) + " objects so far...");
+            QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+            return !self.isNull();
+        });
+    if (self.isNull())
+        return;
+
+    listModel->sort(listModel->getLastSortColumn(), listModel->getLastSortOrder());
+    if (num == maxCount)
+        ui->label->setText("The first " + QString::number(num) + " objects found:");
+    else
+        ui->label->setText("Found " + QString::number(num) + " objects:");
+}
+
 void FindObjectsDialog::checkPattern(const char *pattern)
 {
     // try parse className
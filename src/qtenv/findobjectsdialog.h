@@ -34,6 +34,7 @@ class cObject;
 namespace qtenv {
 
 class ObjectListView;
+class ObjectIndex;
 
 class QTENV_API FindObjectsDialog : public QDialog
 {
@@ -65,7 +66,9 @@ private:
 
     QStringList getClassNames();
     void checkPattern(const char *pattern);
+    unsigned int getCategories();
     cObject **getSubObjectsFilt(cObject *object, const char *classNamePattern, const char *objFullPathPattern, int maxCount, int &num);
+    void searchIndex(ObjectIndex *index, cObject *object, const char *classNamePattern, const char *objFullPathPattern, int maxCount);
 };
 
 }  // namespace qtenv
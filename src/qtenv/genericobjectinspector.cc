@@ -294,7 +294,7 @@ void GenericObjectInspector::gatherVisibleDataIfSafe()
 void GenericObjectInspector::createContextMenu(QPoint pos)
 {
     QModelIndex sourceIndex = proxyModel->mapToSource(treeView->indexAt(pos));
-    TreeNode *node = static_cast<TreeNode*>(sourceIndex.internalPointer());
+    TreeNode *node = sourceModel->getNode(sourceIndex);
 
     if (node) {
         QMenu *menu;
@@ -368,7 +368,7 @@ void GenericObjectInspector::copySelectedLineToClipboard(bool onlyHighlightedPar
     QModelIndexList selection = treeView->selectionModel()->selectedIndexes();
 
     if (!selection.isEmpty()) {
-        TreeNode *node = static_cast<TreeNode*>(proxyModel->mapToSource(selection.first()).internalPointer());
+        TreeNode *node = sourceModel->getNode(proxyModel->mapToSource(selection.first()));
         QString text = node->getData(Qt::DisplayRole).toString();
 
         if (onlyHighlightedPart) {
@@ -386,7 +386,7 @@ void GenericObjectInspector::cycleSelectedSubtreeMode()
     QModelIndexList selection = treeView->selectionModel()->selectedIndexes();
     if (!selection.isEmpty()) {
         QModelIndex sourceIndex = proxyModel->mapToSource(selection.first());
-        TreeNode *node = static_cast<TreeNode*>(sourceIndex.internalPointer());
+        TreeNode *node = sourceModel->getNode(sourceIndex);
 
         Mode currMode = node->getMode();
         Mode nextMode;
@@ -423,7 +423,7 @@ bool GenericObjectInspector::updateData()
         if (i.isValid()) {
             QModelIndex sourceIndex = proxyModel->mapToSource(i);
             if (sourceIndex.isValid()) {
-                TreeNode *node = static_cast<TreeNode *>(sourceIndex.internalPointer());
+                TreeNode *node = sourceModel->getNode(sourceIndex);
                 if (node->updateData()) {
                     changed = true;
                     // we should do this here, but we don't because it is super slow
@@ -442,7 +442,7 @@ QString GenericObjectInspector::getSelectedNode()
     if (selection.isEmpty())
         return "";
 
-    TreeNode *node = static_cast<TreeNode*>(proxyModel->mapToSource(selection.first()).internalPointer());
+    TreeNode *node = sourceModel->getNode(proxyModel->mapToSource(selection.first()));
     return node->getNodeIdentifier();
 }
 
@@ -451,7 +451,7 @@ void GenericObjectInspector::selectNode(const QString &identifier)
     QModelIndexList visible = getVisibleNodes();
 
     for (auto v : visible) {
-        TreeNode *node = static_cast<TreeNode*>(proxyModel->mapToSource(v).internalPointer());
+        TreeNode *node = sourceModel->getNode(proxyModel->mapToSource(v));
         if (node->getNodeIdentifier() == identifier) {
             treeView->clearSelection();
             treeView->selectionModel()->select(v, QItemSelectionModel::Select | QItemSelectionModel::Rows);
@@ -471,7 +471,7 @@ QSet<QString> GenericObjectInspector::getExpandedNodes(const QModelIndex &index)
 {
     QSet<QString> result;
     if (treeView->isExpanded(index)) {
-        result.insert(static_cast<TreeNode *>(proxyModel->mapToSource(index).internalPointer())->getNodeIdentifier());
+        result.insert(sourceModel->getNode(proxyModel->mapToSource(index))->getNodeIdentifier());
         int numChildren = proxyModel->rowCount(index);
         for (int i = 0; i < numChildren; ++i) {
             result.unite(getExpandedNodes(proxyModel->index(i, 0, index)));
@@ -492,12 +492,25 @@ void GenericObjectInspector::expandNodes(const QSet<QString> &ids)
 
 void GenericObjectInspector::expandNodes(const QSet<QString> &ids, const QModelIndex &index)
 {
-    if (ids.contains(static_cast<TreeNode *>(proxyModel->mapToSource(index).internalPointer())->getNodeIdentifier())) {
+    QString id = sourceModel->getNode(proxyModel->mapToSource(index))->getNodeIdentifier();
+    if (ids.contains(id)) {
         treeView->expand(index);
 
-        int numChildren = proxyModel->rowCount(index);
-        for (int i = 0; i < numChildren; ++i)
-            expandNodes(ids, proxyModel->index(i, 0, index));
+        // checking the children creates a node for each of them, which is
+        // only worth it if some expanded node is among their descendants
+        QString prefix = id + "|";
+        bool expandedBelow = false;
+        for (const QString& other : ids)
+            if (other.startsWith(prefix)) {
+                expandedBelow = true;
+                break;
+            }
+
+        if (expandedBelow) {
+            int numChildren = proxyModel->rowCount(index);
+            for (int i = 0; i < numChildren; ++i)
+                expandNodes(ids, proxyModel->index(i, 0, index));
+        }
     }
 }
 
@@ -522,7 +535,7 @@ bool GenericObjectInspector::gatherMissingData()
     bool changed = false;
     QModelIndexList indices = getVisibleNodes();
     for (auto i : indices) {
-        TreeNode *node = static_cast<TreeNode *>(proxyModel->mapToSource(i).internalPointer());
+        TreeNode *node = sourceModel->getNode(proxyModel->mapToSource(i));
         if (node->gatherDataIfMissing()) {
             // not doing it, super slow, see caller
             //Q_EMIT dataChanged(i, i);
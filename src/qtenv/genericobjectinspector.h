@@ -55,7 +55,7 @@ protected:
     // In PACKET mode, it filters the source model (which should be set to FLAT mode in this case)
     // to match a certain (object or field) property - "packetData" at the moment.
     // The view is always connected to this model, so accessing TreeNodes
-    // (internalPointer, then static_cast) requires index mapping (mapToSource) first.
+    // (sourceModel->getNode()) requires index mapping (mapToSource) first.
     PropertyFilteredGenericObjectTreeModel *proxyModel = nullptr;
 
     QAction *copyLineAction;
@@ -49,7 +49,7 @@ bool PropertyFilteredGenericObjectTreeModel::filterAcceptsRow(int sourceRow, con
 
     QModelIndex sourceIndex = sourceModel()->index(sourceRow, 0, sourceParent);
 
-    TreeNode *treeNode = static_cast<TreeNode *>(sourceIndex.internalPointer());
+    TreeNode *treeNode = static_cast<GenericObjectTreeModel *>(sourceModel())->getNode(sourceIndex);
 
     return treeNode ? treeNode->matchesPropertyFilter(relevantProperty) : true;
 }
@@ -85,16 +85,28 @@ std::vector<cObject *> GenericObjectTreeModel::getRootObjects()
     return result;
 }
 
+TreeNode *GenericObjectTreeModel::getNode(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return nullptr;
+    ASSERT(index.model() == this);
+    TreeNode *parentNode = static_cast<TreeNode *>(index.internalPointer());
+    return parentNode ? parentNode->getChild(index.row()) : rootNodes[index.row()];
+}
+
+// The internal pointer of an index is the parent node of the one it refers to
+// (nullptr for the roots), so views can create indices for all rows without
+// the model having to create a node for each of them.
 QModelIndex GenericObjectTreeModel::index(int row, int column, const QModelIndex& parent) const
 {
     if (!parent.isValid()) {
         ASSERT(row < rootNodes.size());
-        return createIndex(row, column, rootNodes[row]);
+        return createIndex(row, column, nullptr);
     }
     else {
-        TreeNode *parentNode = static_cast<TreeNode *>(parent.internalPointer());
+        TreeNode *parentNode = getNode(parent);
         if (parentNode && (parentNode->getCurrentChildCount() > row)) {
-            return createIndex(row, column, parentNode->getChild(row));
+            return createIndex(row, column, parentNode);
         }
         return QModelIndex();
     }
@@ -103,11 +115,11 @@ QModelIndex GenericObjectTreeModel::index(int row, int column, const QModelIndex
 QModelIndex GenericObjectTreeModel::parent(const QModelIndex& child) const
 {
     ASSERT(child.model() == this);
-    TreeNode *node = static_cast<TreeNode *>(child.internalPointer());
+    TreeNode *parentNode = static_cast<TreeNode *>(child.internalPointer());
     // the "row" of the parent ModelIndex is its own index in its parent,
     // and not the index of this child in the parent ModelIndex
-    return node->getParent()
-            ? createIndex(node->getParent()->getIndexInParent(), 0, node->getParent())
+    return parentNode
+            ? createIndex(parentNode->getIndexInParent(), 0, parentNode->getParent())
             : QModelIndex();
 }
 
@@ -119,7 +131,7 @@ bool GenericObjectTreeModel::hasChildren(const QModelIndex& parent) const
     }
     else {
         ASSERT(parent.model() == this);
-        TreeNode *parentNode = static_cast<TreeNode *>(parent.internalPointer());
+        TreeNode *parentNode = getNode(parent);
         return parentNode ? parentNode->getHasChildren() : false;
     }
 }
@@ -132,7 +144,7 @@ int GenericObjectTreeModel::rowCount(const QModelIndex& parent) const
     }
     else {
         ASSERT(parent.model() == this);
-        TreeNode *parentNode = static_cast<TreeNode *>(parent.internalPointer());
+        TreeNode *parentNode = getNode(parent);
         int childCount = parentNode ? parentNode->getCurrentChildCount() : 0;
         return childCount;
     }
@@ -146,7 +158,7 @@ int GenericObjectTreeModel::columnCount(const QModelIndex& parent) const
 QVariant GenericObjectTreeModel::data(const QModelIndex& index, int role) const
 {
     ASSERT(index.model() == this);
-    auto node = static_cast<TreeNode *>(index.internalPointer());
+    auto node = getNode(index);
 
     if (!index.parent().isValid() && role == (int)DataRole::NODE_MODE_OVERRIDE)
         return inspectorMode == node->getMode() ? -1 : (int)node->getMode();
@@ -162,7 +174,7 @@ QVariant GenericObjectTreeModel::data(const QModelIndex& index, int role) const
 bool GenericObjectTreeModel::setData(const QModelIndex& index, const QVariant& value, int role)
 {
     ASSERT(index.model() == this);
-    TreeNode *node = static_cast<TreeNode *>(index.internalPointer());
+    TreeNode *node = getNode(index);
     ASSERT(node != nullptr);
 
     bool success;
@@ -191,7 +203,7 @@ Qt::ItemFlags GenericObjectTreeModel::flags(const QModelIndex& index) const
         return flags;
 
     ASSERT(index.model() == this);
-    TreeNode *node = static_cast<TreeNode *>(index.internalPointer());
+    TreeNode *node = getNode(index);
 
     ASSERT(node != nullptr);
     if (node->isEditable()) {
@@ -204,7 +216,7 @@ bool GenericObjectTreeModel::canFetchMore(const QModelIndex &parent) const
 {
     if (!parent.isValid())
         return false;
-    TreeNode *node = static_cast<TreeNode *>(parent.internalPointer());
+    TreeNode *node = getNode(parent);
     return !node->isFilled();
 }
 
@@ -212,7 +224,7 @@ void GenericObjectTreeModel::fetchMore(const QModelIndex &parent)
 {
     ASSERT(parent.model() == this);
     if (parent.isValid()) {
-        TreeNode *node = static_cast<TreeNode *>(parent.internalPointer());
+        TreeNode *node = getNode(parent);
         int n = node->getPotentialChildCount();
         beginInsertRows(parent, 0, n - 1);
         node->fill();
@@ -240,63 +252,45 @@ void GenericObjectTreeModel::refreshTreeStructure()
 
 void GenericObjectTreeModel::refreshNodeChildrenRec(const QModelIndex &index)
 {
-    TreeNode *node = static_cast<TreeNode *>(index.internalPointer());
+    TreeNode *node = getNode(index);
 
     if (node->isFilled()) {
         refreshChildList(index);
 
+        // only descending into the children that were created already,
+        // the others will be created in an up-to-date state anyway
         int n = node->getCurrentChildCount();
         for (int i = 0; i < n; ++i)
-            refreshNodeChildrenRec(this->index(i, 0, index));
+            if (node->hasChild(i))
+                refreshNodeChildrenRec(this->index(i, 0, index));
     }
 }
 
-// XXX this is not the most efficient... Maybe could add TreeNode::fillWith(vector)
-// to just pass in the child list we have to create here?
 void GenericObjectTreeModel::refreshChildList(const QModelIndex &index)
 {
     ASSERT(index.model() == this);
-    TreeNode *node = static_cast<TreeNode *>(index.internalPointer());
+    TreeNode *node = getNode(index);
 
     node->updatePotentialChildCount();
 
-    auto oldChildren = node->getExistingChildren(); // we just borrow the list of pointers
-    auto newChildren = node->makeChildren(); // we get ownership of some newly created nodes
-    for (auto nc : newChildren)
-        nc->restoreModeFromOverrides();
-    // no need to call init on newChildren, because we don't use anything in them, just isSameAs
-
-    bool same = oldChildren.size() == newChildren.size();
-
-    for (size_t i = 0; same && (i < oldChildren.size()); ++i)
-        if (!newChildren[i]->isSameAs(oldChildren[i]))
-            same = false;
-
-    // not else, 'same' might have changed
-    if (!same) {
+    if (!node->childrenAreUpToDate()) {
         if (node->isFilled()) {
-            beginRemoveRows(index, 0, oldChildren.size()-1);
+            beginRemoveRows(index, 0, node->getCurrentChildCount()-1);
             node->unfill();
             endRemoveRows();
         }
 
-        beginInsertRows(index, 0, newChildren.size()-1);
+        beginInsertRows(index, 0, node->getPotentialChildCount()-1);
         ASSERT(!node->isFilled());
         node->fill();
         endInsertRows();
     }
-
-    ASSERT((int)newChildren.size() == node->getPotentialChildCount());
-
-    // the old children have already been deleted in unfill(), but the "new ones" still exist
-    for (auto c : newChildren)
-        delete c;
 }
 
 void GenericObjectTreeModel::setNodeMode(const QModelIndex &index, Mode mode)
 {
     ASSERT(index.model() == this);
-    TreeNode *node = static_cast<TreeNode *>(index.internalPointer());
+    TreeNode *node = getNode(index);
 
     Q_EMIT layoutAboutToBeChanged();
 
@@ -318,7 +312,7 @@ void GenericObjectTreeModel::setNodeMode(const QModelIndex &index, Mode mode)
 void GenericObjectTreeModel::unsetNodeMode(const QModelIndex &index)
 {
     ASSERT(index.model() == this);
-    TreeNode *node = static_cast<TreeNode *>(index.internalPointer());
+    TreeNode *node = getNode(index);
 
     Q_EMIT layoutAboutToBeChanged();
 
@@ -343,7 +337,7 @@ void GenericObjectTreeModel::unsetNodeMode(const QModelIndex &index)
 cObject *GenericObjectTreeModel::getCObjectPointer(const QModelIndex &index)
 {
     ASSERT(index.model() == this);
-    auto node = static_cast<TreeNode *>(index.internalPointer());
+    auto node = getNode(index);
     return node ? node->getCObjectPointer() : nullptr;
 }
 
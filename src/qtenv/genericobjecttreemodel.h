@@ -29,6 +29,7 @@
 namespace omnetpp {
 namespace qtenv {
 
+class TreeNode;
 class RootNode;
 
 // this is wrapped in a QVariant to be returned by the model
@@ -94,6 +95,9 @@ public:
 
     const NodeModeOverrideMap& getNodeModeOverrides() const { return nodeModeOverrides;}
 
+    // returns the node the index refers to, creating it if it doesn't exist yet
+    TreeNode *getNode(const QModelIndex &index) const;
+
     QModelIndex index(int row, int column, const QModelIndex &parent) const override;
     QModelIndex parent(const QModelIndex &child) const override;
     bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
@@ -22,6 +22,7 @@
 #include "qtenvapp.h"  // for getQtenv
 #include <QtCore/QElapsedTimer>
 #include <set>
+#include <memory>
 #include "envir/visitor.h"
 
 namespace omnetpp {
@@ -39,14 +40,20 @@ void TreeNode::fill()
     ASSERT(!filled);
     ASSERT(children.empty());
 
-    children = makeChildren();
-    potentialChildCount = computeChildCount();
+    if (createsChildrenOnDemand()) {
+        potentialChildCount = computeChildCount();
+        children.assign(potentialChildCount, nullptr);  // see getChild()
+    }
+    else {
+        children = makeChildren();
+        potentialChildCount = computeChildCount();
 
-    ASSERT((int)children.size() == potentialChildCount);
+        ASSERT((int)children.size() == potentialChildCount);
 
-    for (auto c : children) {
-        c->restoreModeFromOverrides();
-        c->init();
+        for (auto c : children) {
+            c->restoreModeFromOverrides();
+            c->init();
+        }
     }
 
     filled = true;
@@ -60,11 +67,90 @@ void TreeNode::unfill()
         delete c;
     children.clear();
 
+    childObjectsCollected = false;
+    childObjects.clear();
+    childObjectsError.clear();
+
     data.clear();
 
     filled = false;
 }
 
+bool TreeNode::childrenAreUpToDate()
+{
+    if (!filled)
+        return potentialChildCount == 0;
+
+    if ((int)children.size() != potentialChildCount)
+        return false;
+
+    if (createsChildrenOnDemand()) {
+        // only the children created so far are compared, the rest
+        // will be made from the current state of the object anyway
+        childObjectsCollected = false;
+        for (int i = 0; i < (int)children.size(); ++i) {
+            if (!children[i])
+                continue;
+            std::unique_ptr<TreeNode> newChild(makeChild(i));
+            newChild->restoreModeFromOverrides();
+            if (!newChild->isSameAs(children[i]))
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<TreeNode *> newChildren = makeChildren();
+    bool same = newChildren.size() == children.size();
+    for (size_t i = 0; same && i < newChildren.size(); ++i) {
+        newChildren[i]->restoreModeFromOverrides();
+        // the node may have created its children on demand in its previous mode
+        same = children[i] && newChildren[i]->isSameAs(children[i]);
+    }
+    for (auto c : newChildren)
+        delete c;
+    return same;
+}
+
+TreeNode *TreeNode::makeChild(int index)
+{
+    ASSERT(mode == Mode::CHILDREN);
+
+    if (!childObjectsCollected)
+        collectChildObjects();
+
+    if (!childObjectsError.empty())
+        return new TextNode(this, index, QString("<!> Error: ") + childObjectsError.c_str(), mode);
+
+    // the object may have lost some children since they were counted
+    if (index >= (int)childObjects.size())
+        return new TextNode(this, index, "<!> Error: child object no longer exists", mode);
+
+    cObject *obj = getChildListObject();
+    return new ChildObjectNode(this, index, toAnyPtr(obj), obj->getDescriptor(), childObjects[index], mode);
+}
+
+void TreeNode::collectChildObjects()
+{
+    childObjectsCollected = true;
+    childObjects.clear();
+    childObjectsError.clear();
+
+    cObject *obj = getChildListObject();
+    if (!obj)
+        return;
+
+    DisableDebugOnErrors dummy;
+    envir::cCollectChildrenVisitor visitor(obj);
+    try {
+        visitor.process(obj);
+        cObject **objs = visitor.getArray();
+        childObjects.assign(objs, objs + visitor.getArraySize());
+    }
+    catch (std::exception& e) {
+        childObjectsError = e.what();
+    }
+}
+
 bool TreeNode::isSameAs(TreeNode *other)
 {
     return mode == other->mode
@@ -142,24 +228,8 @@ std::vector<TreeNode *> TreeNode::makeObjectChildNodes(any_ptr obj, cClassDescri
     std::vector<TreeNode *> result;
 
     switch (mode) {
-        case Mode::CHILDREN: {
-            if (!obj.contains<cObject>())
-                break;
-
-            envir::cCollectChildrenVisitor visitor(fromAnyPtr<cObject>(obj));
-            try {
-                visitor.process(fromAnyPtr<cObject>(obj));
-
-                cObject **objs = visitor.getArray();
-                for (int i = 0; i < visitor.getArraySize(); ++i)
-                    result.push_back(new ChildObjectNode(this, result.size(), obj, desc, objs[i], mode));
-            }
-            catch (std::exception &e) {
-                result.push_back(new TextNode(this, result.size(), QString("<!> Error: ") + e.what(), mode));
-            }
-
-            break;
-        }
+        case Mode::CHILDREN:
+            break;  // these are created on demand, see makeChild()
 
         case Mode::INHERITANCE:
             if (!excludeInherited) {
@@ -186,13 +256,19 @@ std::vector<TreeNode *> TreeNode::makeObjectChildNodes(any_ptr obj, cClassDescri
                     result.push_back(new FieldGroupNode(this, result.size(), obj, desc, name, mode));
 
             else { // FLAT
-                // sorting the fields alphabetically
-                std::sort(result.begin(), result.end(), [](TreeNode *a, TreeNode *b) {
-                    return a->computeData(Qt::DisplayRole).toString() < b->computeData(Qt::DisplayRole).toString();
+                // sorting the fields alphabetically, computing each text only once
+                std::vector<std::pair<QString, TreeNode *>> sorted;
+                sorted.reserve(result.size());
+                for (auto node : result)
+                    sorted.push_back(std::make_pair(node->computeData(Qt::DisplayRole).toString(), node));
+                std::sort(sorted.begin(), sorted.end(), [](const std::pair<QString, TreeNode *>& a, const std::pair<QString, TreeNode *>& b) {
+                    return a.first < b.first;
                 });
                 // then adjusting the indexInParent field accordingly
-                for (size_t i = 0; i < result.size(); ++i)
+                for (size_t i = 0; i < result.size(); ++i) {
+                    result[i] = sorted[i].second;
                     result[i]->indexInParent = i;
+                }
             }
         }
     }
@@ -291,7 +367,13 @@ TreeNode *TreeNode::getChild(int index)
 {
     ASSERT(filled);
     ASSERT(index < (int)children.size());
-    return children[index];
+    TreeNode *& child = children[index];
+    if (!child) {
+        child = makeChild(index);
+        child->restoreModeFromOverrides();
+        child->init();
+    }
+    return child;
 }
 
 QVariant TreeNode::getData(int role)
@@ -310,27 +392,36 @@ QVariant TreeNode::getData(int role)
     return data[role];
 }
 
+std::map<int, QVariant> TreeNode::computeAllData()
+{
+    std::map<int, QVariant> result;
+    for (auto role : supportedDataRoles)
+        result[role] = computeData(role);
+    return result;
+}
+
+// for the nodes that compute their data for all roles at once
+static QVariant getRoleData(const std::map<int, QVariant>& allData, int role)
+{
+    auto it = allData.find(role);
+    return it != allData.end() ? it->second : QVariant();
+}
+
 bool TreeNode::gatherDataIfMissing()
 {
     if (!data.empty())
         return false;
 
-    for (auto role : supportedDataRoles)
-        data[role] = computeData(role);
+    data = computeAllData();
 
     return true;
 }
 
 bool TreeNode::updateData()
 {
-    bool changed = false;
-    for (auto role : supportedDataRoles) {
-        QVariant newData = computeData(role);
-        if (!containsKey(data, role) || data[role] != newData)
-            changed = true;
-
-        data[role] = newData;
-    }
+    std::map<int, QVariant> newData = computeAllData();
+    bool changed = newData != data;
+    data = std::move(newData);
 
     potentialChildCount = computeChildCount();
 
@@ -418,6 +509,11 @@ std::vector<TreeNode *> SuperClassNode::makeChildren()
     return makeObjectChildNodes(containingObject, superDesc, true);
 }
 
+cObject *SuperClassNode::getChildListObject()
+{
+    return containingObject.contains<cObject>() ? fromAnyPtr<cObject>(containingObject) : nullptr;
+}
+
 bool SuperClassNode::isSameAs(TreeNode *other)
 {
     if (typeid(*this) != typeid(*other) || !TreeNode::isSameAs(other))
@@ -462,17 +558,24 @@ int ChildObjectNode::computeChildCount()
 }
 
 QVariant ChildObjectNode::computeData(int role)
+{
+    return getRoleData(computeAllData(), role);
+}
+
+std::map<int, QVariant> ChildObjectNode::computeAllData()
 {
     DisableDebugOnErrors dummy;
 
     QString defaultText = getDefaultObjectData(object, Qt::DisplayRole).value<QString>();
     QString infoText = object->str().c_str();
 
-    switch (role) {
-        case Qt::DisplayRole: return defaultText + (infoText.isEmpty() ? "" : (QString(" ") + infoText));
-        case (int)DataRole::HIGHLIGHT_RANGE: return QVariant::fromValue(HighlightRange{defaultText.length(), infoText.isEmpty() ? 0 : infoText.length() + 1});
-        default: return getDefaultObjectData(object, role);
-    }
+    std::map<int, QVariant> result;
+    for (auto role : supportedDataRoles)
+        if (role != Qt::DisplayRole && role != (int)DataRole::HIGHLIGHT_RANGE)
+            result[role] = getDefaultObjectData(object, role);
+    result[Qt::DisplayRole] = defaultText + (infoText.isEmpty() ? "" : (QString(" ") + infoText));
+    result[(int)DataRole::HIGHLIGHT_RANGE] = QVariant::fromValue(HighlightRange{defaultText.length(), infoText.isEmpty() ? 0 : infoText.length() + 1});
+    return result;
 }
 
 QString ChildObjectNode::computeNodeIdentifier()
@@ -564,25 +667,22 @@ int FieldNode::computeChildCount()
 
 std::vector<TreeNode *> FieldNode::makeChildren()
 {
-    if (containingObject != nullptr && containingDesc != nullptr && containingDesc->getFieldIsArray(fieldIndex)) {
-        DisableDebugOnErrors dummy;
-        std::vector<TreeNode *> result;
-        int size = 0;
-        try {
-            size = containingDesc->getFieldArraySize(containingObject, fieldIndex);
-        }
-        catch (std::exception& e) {
-            errorText = e.what();
-            return result;
-        }
-        for (int i = 0; i < size; ++i)
-            result.push_back(new ArrayElementNode(this, result.size(), containingObject, containingDesc, fieldIndex, i, mode));
+    // arrays always create their elements on demand
+    return makeObjectChildNodes(object, desc);
+}
 
-        return result;
-    }
-    else {
-        return makeObjectChildNodes(object, desc);
-    }
+bool FieldNode::createsChildrenOnDemand()
+{
+    return (containingObject != nullptr && containingDesc != nullptr && containingDesc->getFieldIsArray(fieldIndex))
+            || TreeNode::createsChildrenOnDemand();
+}
+
+TreeNode *FieldNode::makeChild(int index)
+{
+    if (containingObject != nullptr && containingDesc != nullptr && containingDesc->getFieldIsArray(fieldIndex))
+        return new ArrayElementNode(this, index, containingObject, containingDesc, fieldIndex, index, mode);
+    else
+        return TreeNode::makeChild(index);
 }
 
 bool FieldNode::isSameAs(TreeNode *other)
@@ -595,6 +695,11 @@ bool FieldNode::isSameAs(TreeNode *other)
 }
 
 QVariant FieldNode::computeData(int role)
+{
+    return getRoleData(computeAllData(), role);
+}
+
+std::map<int, QVariant> FieldNode::computeAllData()
 {
     DisableDebugOnErrors dummy;
 
@@ -603,10 +708,8 @@ QVariant FieldNode::computeData(int role)
                 ? fromAnyPtr<cObject>(object)
                 : nullptr;
 
-    if ((role == Qt::DecorationRole) && objectCasted)
-        return object != nullptr ? getObjectIcon(objectCasted) : QVariant();
-
-    // the rest is for the regular, non-root nodes
+    std::map<int, QVariant> result;
+    result[Qt::DecorationRole] = objectCasted ? getObjectIcon(objectCasted) : QVariant();
 
     bool isPointer = containingDesc->getFieldIsPointer(fieldIndex);
     bool isCObject = containingDesc->getFieldIsCObject(fieldIndex);
@@ -689,22 +792,11 @@ QVariant FieldNode::computeData(int role)
     if (!errorText.empty())
         fieldValue += QString(" <!> Error: ") + errorText.c_str();
 
-    switch (role) {
-        case Qt::EditRole:
-            return fieldValue;
-
-        case Qt::ToolTipRole:
-            return tooltip;
-
-        case Qt::DisplayRole:
-            return fieldName + arraySize + equals + prefix + fieldValue + postfix + objectClassName + objectName + objectInfo + editable + " (" + fieldType + ")";
-
-        case Qt::UserRole:
-            return QVariant::fromValue(HighlightRange { fieldName.length() + arraySize.length() + equals.length() + prefix.length(), fieldValue.length() + objectClassName.length() + objectName.length() + objectInfo.length() });
-
-        default:
-            return QVariant();
-    }
+    result[Qt::EditRole] = fieldValue;
+    result[Qt::ToolTipRole] = tooltip;
+    result[Qt::DisplayRole] = fieldName + arraySize + equals + prefix + fieldValue + postfix + objectClassName + objectName + objectInfo + editable + " (" + fieldType + ")";
+    result[Qt::UserRole] = QVariant::fromValue(HighlightRange { fieldName.length() + arraySize.length() + equals.length() + prefix.length(), fieldValue.length() + objectClassName.length() + objectName.length() + objectInfo.length() });
+    return result;
 }
 
 bool FieldNode::isEditable()
@@ -768,22 +860,30 @@ int RootNode::computeChildCount()
 }
 
 QVariant RootNode::computeData(int role)
+{
+    return getRoleData(computeAllData(), role);
+}
+
+std::map<int, QVariant> RootNode::computeAllData()
 {
     DisableDebugOnErrors dummy;
 
+    std::map<int, QVariant> result;
+    for (auto role : supportedDataRoles)
+        if (!object || (role != Qt::DisplayRole && role != (int)DataRole::HIGHLIGHT_RANGE))
+            result[role] = getDefaultObjectData(object, role);
+
     if (!object)
-        return getDefaultObjectData(object, role);
+        return result;
 
     QString pathAndType = QString(object->getFullPath().c_str()) + " (" + getObjectShortTypeName(object) + ")";
     QString infoText = object->str().c_str();
     if (!infoText.isEmpty())
         infoText = " " + infoText;
 
-    switch (role) {
-        case Qt::DisplayRole: return pathAndType + infoText;
-        case (int)DataRole::HIGHLIGHT_RANGE: return QVariant::fromValue(HighlightRange { pathAndType.length(), infoText.length() });
-        default: return getDefaultObjectData(object, role);
-    }
+    result[Qt::DisplayRole] = pathAndType + infoText;
+    result[(int)DataRole::HIGHLIGHT_RANGE] = QVariant::fromValue(HighlightRange { pathAndType.length(), infoText.length() });
+    return result;
 }
 
 QString RootNode::computeNodeIdentifier()
@@ -914,6 +1014,11 @@ int ArrayElementNode::computeChildCount()
 }
 
 QVariant ArrayElementNode::computeData(int role)
+{
+    return getRoleData(computeAllData(), role);
+}
+
+std::map<int, QVariant> ArrayElementNode::computeAllData()
 {
     DisableDebugOnErrors dummy;
 
@@ -976,22 +1081,13 @@ QVariant ArrayElementNode::computeData(int role)
 
     QString editable = containingDesc->getFieldIsEditable(fieldIndex) ? " [...]" : "";
 
-    switch (role) {
-        case Qt::DisplayRole:
-            return indexEquals + info + value + editable;
-
-        case Qt::DecorationRole:
-            return fieldObjectPointer ? getObjectIcon(fieldObjectPointer) : QVariant();
-
-        case Qt::EditRole:
-            return value;
-
-        case Qt::UserRole:
-            return QVariant::fromValue(HighlightRange { indexEquals.length() + info.length(), value.length() });
-
-        default:
-            return QVariant();
-    }
+    std::map<int, QVariant> result;
+    result[Qt::DisplayRole] = indexEquals + info + value + editable;
+    result[Qt::DecorationRole] = fieldObjectPointer ? getObjectIcon(fieldObjectPointer) : QVariant();
+    result[Qt::EditRole] = value;
+    result[Qt::ToolTipRole] = QVariant();
+    result[Qt::UserRole] = QVariant::fromValue(HighlightRange { indexEquals.length() + info.length(), value.length() });
+    return result;
 }
 
 bool ArrayElementNode::isEditable()
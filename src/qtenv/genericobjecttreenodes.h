@@ -42,7 +42,7 @@ class QTENV_API TreeNode
     // these make up the tree structure of the model
     TreeNode *parent = nullptr;
     int indexInParent = 0;
-    std::vector<TreeNode *> children; // empty if not filled, holds potentialChildCount elements if filled
+    std::vector<TreeNode *> children; // empty if not filled, holds potentialChildCount elements if filled (nullptr for children not yet created, see createsChildrenOnDemand())
 
     // Whether or not the "children" vector actually holds the (potential) children.
     bool filled = false;
@@ -55,12 +55,18 @@ class QTENV_API TreeNode
     any_ptr containingObject = any_ptr(nullptr);  // may or may not be a cObject, so we need the descriptor for it
     cClassDescriptor *containingDesc = nullptr;
 
+    // in CHILDREN mode: the child objects, collected when the first child is created
+    bool childObjectsCollected = false;
+    std::vector<cObject *> childObjects;
+    std::string childObjectsError; // not empty if collecting the children failed
+
     // helpers
     static cClassDescriptor *getDescriptorForField(any_ptr obj, cClassDescriptor *desc, int fieldIndex, int arrayIndex = 0);
     static int computeObjectChildCount(any_ptr obj, cClassDescriptor *desc, Mode mode, bool excludeInherited = false);
     static bool fieldMatchesPropertyFilter(cClassDescriptor *containingDesc, int fieldIndex, const char *property);
     // this is not static just to avoid having to pass mode and this (as parent)
     std::vector<TreeNode *> makeObjectChildNodes(any_ptr obj, cClassDescriptor *desc, bool excludeInherited = false);
+    void collectChildObjects();
     // more helpers, not static only to check if "parent in model tree is parent in ownership tree"
     QVariant getDefaultObjectData(cObject *object, int role);
     QString getObjectFullNameOrPath(cObject *object);
@@ -76,12 +82,30 @@ class QTENV_API TreeNode
     //  - TooltipRole: optional and pretty obvious
     virtual QVariant computeData(int role) = 0;
 
+    // Computes the data for all supported roles. Nodes whose data is built from
+    // expensive string conversions (field values, str()) override this to do
+    // the conversions only once, instead of once for every role.
+    virtual std::map<int, QVariant> computeAllData();
+
     // regardless of the children vector
     virtual int computeChildCount() = 0;
 
     // only used to save and restore the expansion state and selection in the views (and for debugging)
     virtual QString computeNodeIdentifier() = 0;
 
+    // Nodes that may have a huge number of children (array fields, child object
+    // lists in CHILDREN mode) create them one by one with makeChild(), as they
+    // are accessed (usually because they become visible in the view), instead
+    // of all at once with makeChildren().
+    virtual bool createsChildrenOnDemand() { return mode == Mode::CHILDREN && getChildListObject() != nullptr; }
+
+    // creates the child with the given index, only called if createsChildrenOnDemand() is true.
+    // does not need to call init on the infant.
+    virtual TreeNode *makeChild(int index);
+
+    // the object whose children are listed in CHILDREN mode, or nullptr
+    virtual cObject *getChildListObject() { return getCObjectPointer(); }
+
     // these are really Qt::ItemDataRole values
     static const std::vector<int> supportedDataRoles;
 
@@ -100,18 +124,20 @@ class QTENV_API TreeNode
 
     int getPotentialChildCount() { ASSERT(potentialChildCount >= 0); return potentialChildCount; }
     int getCurrentChildCount() { return children.size(); } // the actual size of the children vector right now (0 if not yet filled)
-    TreeNode *getChild(int index); // should only be called after filling
-
-    // will be empty if not yet filled. does not fill.
-    const std::vector<TreeNode *>& getExistingChildren() { return children; }
+    TreeNode *getChild(int index); // should only be called after filling. creates the child if needed
+    bool hasChild(int index) { return children[index] != nullptr; } // whether the child has already been created
 
     void fill(); // populates the children vector
     void unfill(); // deletes the children and clears the data map
 
+    // Checks whether the existing children still represent the same things, and
+    // the child count has not changed. Call updatePotentialChildCount() first.
+    bool childrenAreUpToDate();
+
     bool isFilled() { return filled; }
 
     // creates the child nodes and returns a vector of them, but does not touch anything else.
-    // does not need to call init on the infants
+    // does not need to call init on the infants. not called if createsChildrenOnDemand() is true.
     virtual std::vector<TreeNode *> makeChildren() = 0;
 
     bool getHasChildren() { ASSERT(potentialChildCount >= 0); return potentialChildCount > 0; } // even if not filled, will decide if it "would have" children after filling
@@ -155,6 +181,8 @@ class QTENV_API SuperClassNode : public TreeNode
     std::vector<TreeNode *> makeChildren() override;
     bool isSameAs(TreeNode *other) override;
 
+    cObject *getChildListObject() override;
+
   public:
     // superClassIndex: up in the inheritance chain, 0 is the most specialized class, and cObject is at the highest level
     SuperClassNode(TreeNode *parent, int indexInParent, any_ptr contObject, cClassDescriptor *contDesc, int superClassIndex, Mode mode);
@@ -177,6 +205,7 @@ class QTENV_API ChildObjectNode : public TreeNode
     ChildObjectNode(TreeNode *parent, int indexInParent, any_ptr contObject, cClassDescriptor *contDesc, cObject *object, Mode mode);
     int computeChildCount() override;
     QVariant computeData(int role) override;
+    std::map<int, QVariant> computeAllData() override;
     QString computeNodeIdentifier() override;
     cObject *getCObjectPointer() override;
 };
@@ -206,6 +235,8 @@ class QTENV_API FieldNode : public TreeNode
     std::string errorText; // not empty if there was an error
 
     std::vector<TreeNode *> makeChildren() override;
+    bool createsChildrenOnDemand() override;
+    TreeNode *makeChild(int index) override;
     bool isSameAs(TreeNode *other) override;
 
   public:
@@ -213,6 +244,7 @@ class QTENV_API FieldNode : public TreeNode
 
     int computeChildCount() override;
     QVariant computeData(int role) override;
+    std::map<int, QVariant> computeAllData() override;
 
     bool isEditable() override;
     bool setData(const QVariant& value, int role) override;
@@ -235,6 +267,7 @@ class QTENV_API RootNode : public TreeNode
     RootNode(cObject *object, int indexInParent, Mode mode, const NodeModeOverrideMap& nodeModeOverrides);
     int computeChildCount() override;
     QVariant computeData(int role) override;
+    std::map<int, QVariant> computeAllData() override;
     QString computeNodeIdentifier() override;
     cObject *getCObjectPointer() override;
 
@@ -272,6 +305,7 @@ class QTENV_API ArrayElementNode : public TreeNode
     int computeChildCount() override;
 
     QVariant computeData(int role) override;
+    std::map<int, QVariant> computeAllData() override;
 
     bool isEditable() override;
     virtual bool setData(const QVariant& value, int role) override;
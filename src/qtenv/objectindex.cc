@@ -0,0 +1,259 @@
+//==========================================================================
+//  OBJECTINDEX.CC - part of
+//
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstring>
+#include "omnetpp/ccomponent.h"
+#include "omnetpp/csimulation.h"
+#include "omnetpp/cvisitor.h"
+#include "common/matchexpression.h"
+#include "envir/visitor.h"
+#include "envir/matchableobject.h"
+#include "objectindex.h"
+
+using namespace omnetpp::common;
+using namespace omnetpp::envir;
+
+namespace omnetpp {
+namespace qtenv {
+
+typedef std::chrono::steady_clock Clock;
+
+// time between passing two batches of results to the callback
+static const std::chrono::milliseconds BATCH_INTERVAL(100);
+
+// Adds all cOwnedObjects in the tree to the index
+class IndexFillerVisitor : public cVisitor
+{
+  private:
+    ObjectIndex *index;
+  protected:
+    virtual bool visit(cObject *obj) override {
+        if (obj->isOwnedObject())
+            index->objectCreated(static_cast<cOwnedObject *>(obj));
+        obj->forEachChild(this);
+        return true;
+    }
+  public:
+    IndexFillerVisitor(ObjectIndex *index) : index(index) {}
+};
+
+// Collects the objects under a component that are not cOwnedObjects
+// (parameters, gates, result filters and recorders); these are not in the index
+class NonOwnedChildrenVisitor : public cVisitor
+{
+  private:
+    cObject *parent;
+    std::vector<cObject *>& result;
+  protected:
+    virtual bool visit(cObject *obj) override {
+        if (obj == parent)
+            obj->forEachChild(this);
+        else if (!obj->isOwnedObject()) {
+            result.push_back(obj);
+            obj->forEachChild(this);
+        }
+        return true;
+    }
+  public:
+    NonOwnedChildrenVisitor(cObject *parent, std::vector<cObject *>& result) : parent(parent), result(result) {}
+};
+
+ObjectIndex::ObjectIndex()
+{
+    IndexFillerVisitor visitor(this);
+    visitor.process(cSimulation::getActiveSimulation());
+    chainedObserver = cOwnedObject::setObserver(this);
+}
+
+ObjectIndex::~ObjectIndex()
+{
+    if (cOwnedObject::getObserver() == this)
+        cOwnedObject::setObserver(chainedObserver);
+}
+
+void ObjectIndex::objectCreated(cOwnedObject *obj)
+{
+    auto result = locations.emplace(obj, Location {&newObjects, newObjects.objects.size()});
+    if (result.second)
+        newObjects.objects.push_back(obj);
+
+    if (chainedObserver)
+        chainedObserver->objectCreated(obj);
+}
+
+void ObjectIndex::objectDeleted(cOwnedObject *obj)
+{
+    if (chainedObserver)
+        chainedObserver->objectDeleted(obj);
+
+    auto it = locations.find(obj);
+    if (it == locations.end())
+        return;  // existed before the index was created, and was not in the object tree
+
+    // remove from the bucket by moving the last object into its place
+    Location loc = it->second;
+    locations.erase(it);
+    std::vector<cOwnedObject *>& objects = loc.bucket->objects;
+    cOwnedObject *last = objects.back();
+    objects.pop_back();
+    if (last != obj) {
+        objects[loc.pos] = last;
+        locations[last].pos = loc.pos;
+    }
+
+    if (searching)
+        deletedDuringSearch.insert(obj);
+}
+
+ObjectIndex::Bucket *ObjectIndex::getBucketFor(cOwnedObject *obj)
+{
+    std::unique_ptr<Bucket>& bucket = buckets[std::type_index(typeid(*obj))];
+    if (!bucket) {
+        bucket.reset(new Bucket());
+        bucket->categories = cFilteredCollectObjectsVisitor::getCategories(obj);
+        bucket->isComponent = dynamic_cast<cComponent *>(obj) != nullptr;
+    }
+    return bucket.get();
+}
+
+void ObjectIndex::classifyNewObjects()
+{
+    for (cOwnedObject *obj : newObjects.objects) {
+        Bucket *bucket = getBucketFor(obj);
+        locations[obj] = Location {bucket, bucket->objects.size()};
+        bucket->objects.push_back(obj);
+    }
+    newObjects.objects.clear();
+}
+
+bool ObjectIndex::isUnder(cObject *obj, cObject *root)
+{
+    for (cObject *o = obj; o; o = o->getOwner())
+        if (o == root)
+            return true;
+    return false;
+}
+
+bool ObjectIndex::canSearch(cObject *root, unsigned int category, const char *classNamePattern) const
+{
+    // a field matcher in the class name pattern ("kind =~ 3") may match differently
+    // for objects of the same type; we conservatively detect them by the operator
+    if (classNamePattern && strstr(classNamePattern, "=~"))
+        return false;
+    if (category & CATEGORY_OTHERS)
+        return false;
+    return isUnder(root, cSimulation::getActiveSimulation());
+}
+
+int ObjectIndex::search(cObject *root, unsigned int category, const char *classNamePattern,
+                        const char *objFullPathPattern, int maxCount, const BatchCallback& callback)
+{
+    classifyNewObjects();
+
+    std::unique_ptr<MatchExpression> classNameMatcher;
+    if (classNamePattern && classNamePattern[0])
+        classNameMatcher.reset(new MatchExpression(classNamePattern, false, true, true));
+    std::unique_ptr<MatchExpression> fullPathMatcher;
+    if (objFullPathPattern && objFullPathPattern[0])
+        fullPathMatcher.reset(new MatchExpression(objFullPathPattern, false, true, true));
+
+    auto classNameMatches = [&](cObject *obj) {
+        MatchableString className(obj->getClassName());
+        return !classNameMatcher || classNameMatcher->matches(&className);
+    };
+
+    // collect the candidates: objects of the matching types, each paired with an owned
+    // object whose deletion during the search makes the candidate invalid
+    std::vector<std::pair<cObject *, cOwnedObject *>> candidates;
+    for (auto& entry : buckets) {
+        Bucket *bucket = entry.second.get();
+        if (bucket->objects.empty() || (bucket->categories & category) == 0 || !classNameMatches(bucket->objects.front()))
+            continue;
+        for (cOwnedObject *obj : bucket->objects)
+            candidates.push_back(std::make_pair(obj, obj));
+    }
+
+    if (category & (CATEGORY_PARAMS | CATEGORY_CHANSGATES | CATEGORY_STATISTICS)) {
+        std::unordered_map<std::type_index, bool> typeMatches;
+        std::vector<cObject *> children;
+        for (auto& entry : buckets) {
+            Bucket *bucket = entry.second.get();
+            if (!bucket->isComponent)
+                continue;
+            for (cOwnedObject *component : bucket->objects) {
+                if (!isUnder(component, root))
+                    continue;
+                children.clear();
+                NonOwnedChildrenVisitor visitor(component, children);
+                visitor.process(component);
+                for (cObject *child : children) {
+                    auto it = typeMatches.find(std::type_index(typeid(*child)));
+                    if (it == typeMatches.end()) {
+                        bool matches = (cFilteredCollectObjectsVisitor::getCategories(child) & category) != 0 && classNameMatches(child);
+                        it = typeMatches.emplace(std::type_index(typeid(*child)), matches).first;
+                    }
+                    if (it->second)
+                        candidates.push_back(std::make_pair(child, component));
+                }
+            }
+        }
+    }
+
+    // check ownership and full path, and pass the results to the callback in batches;
+    // the callback may process GUI events, so look out for deleted objects
+    searching = true;
+    deletedDuringSearch.clear();
+    int count = 0;
+    std::vector<cObject *> batch;
+    Clock::time_point lastBatchTime = Clock::now();
+    try {
+        for (size_t i = 0; i < candidates.size() && count < maxCount; i++) {
+            if ((i & 0xff) == 0 && !batch.empty() && Clock::now() - lastBatchTime >= BATCH_INTERVAL) {
+                bool proceed = callback(batch);
+                batch.clear();
+                lastBatchTime = Clock::now();
+                if (!proceed)
+                    break;
+            }
+
+            cObject *obj = candidates[i].first;
+            if (!deletedDuringSearch.empty() && deletedDuringSearch.count(candidates[i].second))
+                continue;
+            if (!isUnder(obj, root))
+                continue;
+            if (fullPathMatcher) {
+                MatchableObjectAdapter objAdapter(MatchableObjectAdapter::FULLPATH, obj);
+                if (!fullPathMatcher->matches(&objAdapter))
+                    continue;
+            }
+            batch.push_back(obj);
+            count++;
+        }
+        if (!batch.empty())
+            callback(batch);
+    }
+    catch (...) {
+        searching = false;
+        throw;
+    }
+    searching = false;
+    deletedDuringSearch.clear();
+    return count;
+}
+
+}  // namespace qtenv
+}  // namespace omnetpp
@@ -0,0 +1,119 @@
+//==========================================================================
+//  OBJECTINDEX.H - part of
+//
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_QTENV_OBJECTINDEX_H
+#define __OMNETPP_QTENV_OBJECTINDEX_H
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include "omnetpp/cownedobject.h"
+#include "qtenvdefs.h"
+
+namespace omnetpp {
+namespace qtenv {
+
+/**
+ * Index of the live cOwnedObjects of the simulation, used by the Find/Inspect
+ * Objects dialog to avoid walking the whole object tree on each search.
+ *
+ * Objects are registered via the cOwnedObject creation/deletion hooks. They
+ * are assigned to per-type buckets lazily, at the next search, because type
+ * information is not yet available when the cOwnedObject constructor runs.
+ * Category and class name pattern are evaluated once per type; ownership
+ * (whether the object is under the search root) and the full path pattern
+ * are evaluated at search time for the objects of the matching types only.
+ *
+ * Objects that are not cOwnedObjects (parameters, gates, result recorders)
+ * are collected from the components of the matching subtree.
+ */
+class QTENV_API ObjectIndex : public cIOwnedObjectObserver
+{
+  public:
+    /**
+     * Receives the search results in batches. Returning false stops the search.
+     * The callback may process GUI events, even ones that create or delete objects.
+     */
+    typedef std::function<bool(const std::vector<cObject *>& objects)> BatchCallback;
+
+  private:
+    struct Bucket {
+        std::vector<cOwnedObject *> objects;
+        unsigned int categories = 0; // CATEGORY_xxx bits of the type
+        bool isComponent = false;
+    };
+
+    struct Location {
+        Bucket *bucket;
+        size_t pos;
+    };
+
+    Bucket newObjects; // objects created since the last search, not yet classified by type
+    std::unordered_map<std::type_index, std::unique_ptr<Bucket>> buckets;
+    std::unordered_map<cOwnedObject *, Location> locations;
+
+    bool searching = false;
+    std::unordered_set<cObject *> deletedDuringSearch;
+
+    cIOwnedObjectObserver *chainedObserver = nullptr; // the previously installed observer, receives all notifications as well
+
+  protected:
+    void classifyNewObjects();
+    Bucket *getBucketFor(cOwnedObject *obj);
+    static bool isUnder(cObject *obj, cObject *root);
+
+  public:
+    /**
+     * Creates the index and installs it as cOwnedObject observer, forwarding
+     * notifications to the previously installed one. Objects already existing
+     * in the simulation are added by walking the object tree.
+     */
+    ObjectIndex();
+    virtual ~ObjectIndex();
+
+    virtual void objectCreated(cOwnedObject *obj) override;
+    virtual void objectDeleted(cOwnedObject *obj) override;
+
+    /**
+     * Returns the number of objects in the index.
+     */
+    size_t size() const {return locations.size();}
+
+    /**
+     * Returns true if the given search can be answered from the index. This
+     * is not the case if the OTHERS category is selected (it may contain
+     * objects that are not cOwnedObjects), if the class name pattern matches
+     * on fields other than the class name, or if the search root is not
+     * inside the simulation.
+     */
+    bool canSearch(cObject *root, unsigned int category, const char *classNamePattern) const;
+
+    /**
+     * Searches the objects under root, with the same semantics as
+     * cFilteredCollectObjectsVisitor. Results are passed to the callback
+     * in batches as they are found. Returns the number of objects found.
+     */
+    int search(cObject *root, unsigned int category, const char *classNamePattern,
+               const char *objFullPathPattern, int maxCount, const BatchCallback& callback);
+};
+
+}  // namespace qtenv
+}  // namespace omnetpp
+
+#endif
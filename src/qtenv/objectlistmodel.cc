@@ -118,6 +118,15 @@ void ObjectListModel::setObjects(QVector<cObject *> objects)
     sort(lastSortColumn, lastSortOrder);
 }
 
+void ObjectListModel::addObjects(const QVector<cObject *>& objects)
+{
+    if (objects.isEmpty())
+        return;
+    beginInsertRows(QModelIndex(), this->objects.size(), this->objects.size() + objects.size() - 1);
+    this->objects += objects;
+    endInsertRows();
+}
+
 }  // namespace qtenv
 }  // namespace omnetpp
 
@@ -48,6 +48,7 @@ public:
     virtual QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
     virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
     void setObjects(QVector<cObject *> objects);
+    void addObjects(const QVector<cObject *>& objects); // appends them unsorted
 
     int getLastSortColumn() { return lastSortColumn; }
     Qt::SortOrder getLastSortOrder() { return lastSortOrder; }
@@ -153,7 +153,7 @@ bool ObjectTreeInspector::gatherVisibleData()
         indices.append(bottomIndex);
 
     for (auto i : indices) {
-        TreeNode *node = static_cast<TreeNode *>(i.internalPointer());
+        TreeNode *node = model->getNode(i);
         if (node->updateData()) { // gatherDataIfMissing()?
             // not doing it, super slow, see caller
             //Q_EMIT dataChanged(i, i);
@@ -103,6 +103,7 @@ SOURCES += mainwindow.cc \
     objectlistmodel.cc \
     objectlistview.cc \
     findobjectsdialog.cc \
+    objectindex.cc \
     outputvectorinspectorconfigdialog.cc \
     outputvectorview.cc \
     histogramview.cc \
@@ -172,6 +173,7 @@ HEADERS += mainwindow.h \
     objectlistmodel.h \
     objectlistview.h \
     findobjectsdialog.h \
+    objectindex.h \
     outputvectorinspectorconfigdialog.h \
     outputvectorview.h \
     histogramview.h \
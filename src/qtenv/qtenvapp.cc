@@ -75,6 +75,7 @@
 #include "mainwindow.h"
 #include "timelineinspector.h"
 #include "objecttreeinspector.h"
+#include "objectindex.h"
 #include "canvasinspector.h"
 #include "iosgviewer.h"
 #include "messageanimator.h"
@@ -146,6 +147,7 @@ extern "C" QTENV_API void _qtenv_lib() {}
 Register_GlobalConfigOptionU(CFGID_QTENV_EXTRA_STACK, "qtenv-extra-stack", "B", "80KiB", "Specifies the extra amount of stack that is reserved for each `activity()` simple module when the simulation is run under Qtenv.");
 Register_GlobalConfigOption(CFGID_QTENV_DEFAULT_CONFIG, "qtenv-default-config", CFG_STRING, nullptr, "Specifies which config Qtenv should set up automatically on startup. The default is to ask the user.");
 Register_GlobalConfigOption(CFGID_QTENV_DEFAULT_RUN, "qtenv-default-run", CFG_STRING, nullptr, "Specifies which run (of the default config, see `qtenv-default-config`) Qtenv should set up automatically on startup. A run filter is also accepted. The default is to ask the user.");
+Register_GlobalConfigOption(CFGID_QTENV_OBJECT_INDEX, "qtenv-object-index", CFG_BOOL, "true", "Enables an index of live objects that speeds up the Find/Inspect Objects dialog on large models. The index is built on the first search, and afterwards it is updated on every object creation and deletion, which slightly slows down the simulation.");
 
 
 // According to: https://doc.qt.io/qt-5/qproxystyle.html#details
@@ -611,6 +613,7 @@ QtenvApp::~QtenvApp()
     }
 
     delete messageAnimator;
+    delete objectIndex;
     for (auto & silentEventFilter : silentEventFilters)
         delete silentEventFilter;
     delete opt;
@@ -1735,6 +1738,8 @@ void QtenvApp::readOptions(cConfiguration *cfg)
 
     const char *r = args->optionValue('r');
     opt->runFilter = r ? r : cfg->getAsString(CFGID_QTENV_DEFAULT_RUN);
+
+    opt->useObjectIndex = cfg->getAsBool(CFGID_QTENV_OBJECT_INDEX);
 }
 
 void QtenvApp::readPerRunOptions(cConfiguration *cfg)
@@ -1971,6 +1976,13 @@ bool QtenvApp::ensureDebugger(cRuntimeError *error)
     return debuggerSupport->detectDebugger() != DebuggerPresence::NOT_PRESENT;
 }
 
+ObjectIndex *QtenvApp::getObjectIndex()
+{
+    if (!objectIndex && opt->useObjectIndex)
+        objectIndex = new ObjectIndex();
+    return objectIndex;
+}
+
 void QtenvApp::objectDeleted(cObject *object)
 {
     if (object == runUntil.msg) {
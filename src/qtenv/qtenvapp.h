@@ -57,6 +57,7 @@ class TimeLineInspector;
 class ObjectTreeInspector;
 class DisplayUpdateController;
 class MessageAnimator;
+class ObjectIndex;
 
 using common::MatchExpression;
 
@@ -89,6 +90,7 @@ struct QtenvOptions
 
     // Qtenv specific:
     size_t extraStack;                     // per-module extra stack for activity() modules
+    bool useObjectIndex = true;            // maintain an index of live objects for the Find/Inspect Objects dialog
     std::string defaultConfig;             // automatically set up this config at startup
     std::string runFilter;                 // groups the matching runs to the beginning of the list, or if only one matches, will set up that one automatically
     bool printInitBanners = true;          // print "initializing..." banners
@@ -190,6 +192,7 @@ class QTENV_API QtenvApp : public QObject, public AppBase
 
       MessageAnimator *messageAnimator = nullptr;
       DisplayUpdateController *displayUpdateController = nullptr;
+      ObjectIndex *objectIndex = nullptr; // created on first use, see getObjectIndex()
 
       int refreshDisplayCount = 0;
 
@@ -283,6 +286,7 @@ class QTENV_API QtenvApp : public QObject, public AppBase
       MainWindow *getMainWindow() { return mainWindow; }
       MessageAnimator *getMessageAnimator() { return messageAnimator; }
       DisplayUpdateController *getDisplayUpdateController() { return displayUpdateController; }
+      ObjectIndex *getObjectIndex(); // nullptr if disabled
       ModuleLayouter *getModuleLayouter() { return &moduleLayouter; }
 
       GenericObjectInspector *getMainObjectInspector() { return mainInspector; }
@@ -161,6 +161,8 @@ void CsvRecordsExporter::saveResults(const std::string& fileName, ResultFileMana
 
     if (fileName != "-")
         csv.close();
+    else
+        csv.flush();
 }
 
 void CsvRecordsExporter::saveResultsAsRecords(ResultFileManager *manager, const IDList& idlist, IProgressMonitor *monitor)
@@ -341,46 +343,43 @@ void CsvRecordsExporter::finishRecord(int numColumns)
 
 void CsvRecordsExporter::writeAsString(const std::vector<double>& data)
 {
-    std::ostream& out = csv.out();
     csv.beginRaw();
-    out << "\"";
+    csv.writeRaw("\"");
     for (size_t i = 0; i < data.size(); i++) {
         if (i != 0)
-            out << " ";
+            csv.writeRaw(" ");
         csv.writeRawDouble(data[i]);
     }
-    csv.out() << "\"";
+    csv.writeRaw("\"");
     csv.endRaw();
 }
 
 void CsvRecordsExporter::writeXAsString(const XYArray *data)
 {
-    std::ostream& out = csv.out();
     csv.beginRaw();
-    out << "\"";
+    csv.writeRaw("\"");
     for (size_t j = 0; j < data->length(); j++) {
         if (j != 0)
-            out << " ";
+            csv.writeRaw(" ");
         if (data->hasPreciseX())
-            out << data->getPreciseX(j).str();
+            csv.writeRawBigDecimal(data->getPreciseX(j));
         else
             csv.writeRawDouble(data->getX(j));
     }
-    csv.out() << "\"";
+    csv.writeRaw("\"");
     csv.endRaw();
 }
 
 void CsvRecordsExporter::writeYAsString(const XYArray *data)
 {
-    std::ostream& out = csv.out();
     csv.beginRaw();
-    out << "\"";
+    csv.writeRaw("\"");
     for (size_t j = 0; j < data->length(); j++) {
         if (j != 0)
-            out << " ";
+            csv.writeRaw(" ");
         csv.writeRawDouble(data->getY(j));
     }
-    csv.out() << "\"";
+    csv.writeRaw("\"");
     csv.endRaw();
 }
 
@@ -202,6 +202,8 @@ void CsvForSpreadsheetExporter::saveResults(const std::string& fileName, ResultF
 
     if (fileName != "-")
         csv.close();
+    else
+        csv.flush();
 }
 
 void CsvForSpreadsheetExporter::collectItervars(ResultFileManager *manager, const IDList& idlist)
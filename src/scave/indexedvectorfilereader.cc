@@ -15,6 +15,7 @@
 #include <clocale>
 #include <cstdlib>
 #include "common/exception.h"
+#include "common/fileutil.h"
 #include "common/linetokenizer.h"
 #include "common/stringutil.h"
 #include "common/stlutil.h"
@@ -37,6 +38,14 @@ IndexedVectorFileReader::IndexedVectorFileReader(const char *filename, bool incl
     index = indexReader.readAll();
 }
 
+std::string IndexedVectorFileReader::getDataFileName(int vectorId) const
+{
+    const char *shardFileName = index->getShardFileName(vectorId);
+    if (!shardFileName)
+        return fname;
+    return concatDirAndFile(directoryOf(fname.c_str()).c_str(), shardFileName);
+}
+
 IndexedVectorFileReader::~IndexedVectorFileReader()
 {
     delete index;
@@ -52,7 +61,7 @@ IndexedVectorFileReader::~IndexedVectorFileReader()
             if (!(cond))\
             {\
                 throw opp_runtime_error("Invalid vector file syntax: %s, file %s, block offset %" PRId64 ", line in block %d", \
-                                        msg, fname.c_str(), (int64_t)block.startOffset, line);\
+                                        msg, dataFileName.c_str(), (int64_t)block.startOffset, line);\
             }
 
 Entries IndexedVectorFileReader::loadBlock(const Block& block, std::function<bool(const VectorDatum&)> filter)
@@ -70,7 +79,8 @@ Entries IndexedVectorFileReader::loadBlock(const Block& block, std::function<boo
     size_t bufferSize = vector->blockSize;
     if (bufferSize < MIN_BUFFER_SIZE)
         bufferSize = MIN_BUFFER_SIZE;
-    FileReader reader(fname.c_str(), bufferSize);
+    std::string dataFileName = getDataFileName(block.vectorId);
+    FileReader reader(dataFileName.c_str(), bufferSize);
 
     long count = block.getCount();
     reader.seekTo(block.startOffset);
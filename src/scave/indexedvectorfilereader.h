@@ -35,7 +35,8 @@ namespace scave {
 
 /**
  * Vector file reader with random access.
- * Each instance reads one vector from a vector file.
+ * Each instance reads one vector from a vector file. Sharded vector files
+ * are supported, with block data read from the shard files listed in the index.
  */
 class SCAVE_API IndexedVectorFileReader : public IVectorDataReader
 {
@@ -51,6 +52,9 @@ class SCAVE_API IndexedVectorFileReader : public IVectorDataReader
         FileFingerprint expectedFingerprint; // vec file fingerprint; empty = unspecified
 
     protected:
+        /** returns the file that holds the data of the given vector: the vector file, or one of its shards */
+        std::string getDataFileName(int vectorId) const;
+
         /** reads a block from the vector file */
         Entries loadBlock(const Block& block, std::function<bool(const VectorDatum&)> filter = nullptr);
 
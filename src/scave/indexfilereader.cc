@@ -20,6 +20,7 @@
 #include "common/filereader.h"
 #include "common/linetokenizer.h"
 #include "common/stringutil.h"
+#include "common/opp_ctype.h"
 #include "scaveutils.h"
 #include "scaveexception.h"
 #include "indexfilereader.h"
@@ -66,6 +67,31 @@ VectorFileIndex *IndexFileReader::readAll()
     return index;
 }
 
+VectorFileIndex *IndexFileReader::readVectorDeclarations()
+{
+    FileReader reader(filename.c_str());
+    LineTokenizer tokenizer(1024);
+    int numTokens;
+    char *line, **tokens;
+
+    VectorFileIndex *index = new VectorFileIndex();
+    reader.setCheckFileForChanges(false);
+    while ((line = reader.getNextLineBufferPointer()) != nullptr) {
+        // block lines (which start with the vector id) and vector attributes
+        // make up the bulk of the file; skip them without tokenizing
+        if (opp_isdigit(line[0]))
+            continue;
+        if (line[0] == 'a' && index->getNumberOfVectors() > 0 && strncmp(line, "attr ", 5) == 0)
+            continue;
+        int64_t lineNum = reader.getNumReadLines();
+        int len = reader.getCurrentLineLength();
+        numTokens = tokenizer.tokenize(line, len);
+        tokens = tokenizer.tokens();
+        parseLine(tokens, numTokens, index, lineNum);
+    }
+    return index;
+}
+
 FileFingerprint IndexFileReader::readRecordedFingerprint()
 {
     FileReader reader(filename.c_str());
@@ -142,6 +168,13 @@ void IndexFileReader::parseLine(char **tokens, int numTokens, VectorFileIndex *i
         CHECK(parseInt(tokens[1], version), "version is not a number", lineNum);
         CHECK(version == 2 || version == 3, "unsupported file version (version 2 or version 3 expected)", lineNum);
     }
+    else if (tokens[0][0] == 's' && strcmp(tokens[0], "shard") == 0) {
+        int shard;
+        CHECK(numTokens == 3, "incorrect 'shard' line -- shard <index> <filename> expected", lineNum);
+        CHECK(parseInt(tokens[1], shard), "shard index is not a number", lineNum);
+        CHECK(shard == (int)index->shardFileNames.size(), "shards must be listed in increasing order", lineNum);
+        index->shardFileNames.push_back(tokens[2]);
+    }
     else if (index->run.parseLine(tokens, numTokens, filename.c_str(), lineNum)) {
         return;
     }
@@ -49,6 +49,14 @@ class SCAVE_API IndexFileReader  //TODO this class should share the reader/parse
          */
         VectorFileIndex *readAll();
 
+        /**
+         * Reads the header (fingerprint, run data) and the vector declarations
+         * only. Vector attributes and blocks are skipped without being parsed,
+         * so the vectors in the returned index have no attributes, blocks or
+         * statistics.
+         */
+        VectorFileIndex *readVectorDeclarations();
+
         /**
          * Reads the fingerprint of the vector file this index file belongs to.
          */
@@ -166,13 +166,12 @@ void JsonExporter::writeStatisticsFields(const Statistics& stat)
 
 void JsonExporter::writeVector(const std::vector<double>& v)
 {
-    std::ostream& out = writer.out();
     writeVectorProlog();
     bool first = true;
     int n = v.size();
     for (int i = 0; i < n; i++) {
         if (!first)
-            out << ", ";
+            writer.doWriteRaw(", ");
         first = false;
         if (i % 10 == 0 && i > 0)
             writer.doWriteNewLine(1);
@@ -183,14 +182,13 @@ void JsonExporter::writeVector(const std::vector<double>& v)
 
 void JsonExporter::writeX(XYArray *array)
 {
-    std::ostream& out = writer.out();
     writeVectorProlog();
     bool first = true;
     size_t n = array->length();
     bool hasPreciseX = array->hasPreciseX();
     for (size_t i = 0; i < n; i++) {
         if (!first)
-            out << ", ";
+            writer.doWriteRaw(", ");
         first = false;
         if (i % 10 == 0 && i > 0)
             writer.doWriteNewLine(1);
@@ -204,13 +202,12 @@ void JsonExporter::writeX(XYArray *array)
 
 void JsonExporter::writeY(XYArray *array)
 {
-    std::ostream& out = writer.out();
     writeVectorProlog();
     bool first = true;
     size_t n = array->length();
     for (size_t i = 0; i < n; i++) {
         if (!first)
-            out << ", ";
+            writer.doWriteRaw(", ");
         first = false;
         if (i % 10 == 0 && i > 0)
             writer.doWriteNewLine(1);
@@ -221,13 +218,12 @@ void JsonExporter::writeY(XYArray *array)
 
 void JsonExporter::writeEventNumbers(XYArray *array)
 {
-    std::ostream& out = writer.out();
     writeVectorProlog();
     bool first = true;
     size_t n = array->length();
     for (size_t i = 0; i < n; i++) {
         if (!first)
-            out << ", ";
+            writer.doWriteRaw(", ");
         first = false;
         if (i % 10 == 0 && i > 0)
             writer.doWriteNewLine(1);
@@ -238,18 +234,16 @@ void JsonExporter::writeEventNumbers(XYArray *array)
 
 void JsonExporter::writeVectorProlog()
 {
-    std::ostream& out = writer.out();
     if (useNumpy)
-        out << "np.array(";
-    out << "[";
+        writer.doWriteRaw("np.array(");
+    writer.doWriteRaw("[");
 }
 
 void JsonExporter::writeVectorEpilog()
 {
-    std::ostream& out = writer.out();
-    out << "]";
+    writer.doWriteRaw("]");
     if (useNumpy)
-        out << ",  dtype=np.float64)";
+        writer.doWriteRaw(",  dtype=np.float64)");
 }
 
 void JsonExporter::saveResults(const std::string& fileName, ResultFileManager *manager, const IDList& idlist, IProgressMonitor *monitor)
@@ -280,7 +274,7 @@ void JsonExporter::saveResults(const std::string& fileName, ResultFileManager *m
         }
 
         // write banner comment
-        writer.out() << "# To load into Python, use: " << (useNumpy ? "import numpy as np; " : "") << "results = eval(open(filename).read())\n";
+        writer.doWriteRaw(std::string("# To load into Python, use: ") + (useNumpy ? "import numpy as np; " : "") + "results = eval(open(filename).read())\n");
     }
 
     writer.openObject();
@@ -412,6 +406,8 @@ void JsonExporter::saveResults(const std::string& fileName, ResultFileManager *m
 
     if (fileName != "-")
         writer.close();
+    else
+        writer.flush();
 }
 
 }  // namespace scave
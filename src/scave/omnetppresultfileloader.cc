@@ -69,6 +69,7 @@ OmnetppResultFileLoader::OmnetppResultFileLoader(ResultFileManager *resultFileMa
     indexingOption(flags & (ResultFileManager::ALLOW_INDEXING|ResultFileManager::SKIP_IF_NO_INDEX|ResultFileManager::ALLOW_LOADING_WITHOUT_INDEX)),
     lockfileOption(flags & (ResultFileManager::SKIP_IF_LOCKED|ResultFileManager::IGNORE_LOCK_FILE)),
     verbose(flags & ResultFileManager::VERBOSE),
+    lazyVectorMetadata(flags & ResultFileManager::LAZY_VECTOR_METADATA),
     interrupted(interrupted)
 {
 }
@@ -93,6 +94,12 @@ void OmnetppResultFileLoader::processLine(char **vec, int numTokens, ParseContex
         return;
     }
 
+    // "shard" lines list the data files of a sharded vector file; vector data are accessed via the index
+    if (vec[0][0] == 's' && strcmp(vec[0], "shard") == 0) {
+        CHECK(numTokens == 3, "incorrect 'shard' line -- shard <index> <filename> expected");
+        return;
+    }
+
     // process "run" lines
     if (vec[0][0] == 'r' && !strcmp(vec[0], "run")) {
         flush(ctx); // last result item in previous run
@@ -166,27 +173,27 @@ void OmnetppResultFileLoader::processLine(char **vec, int numTokens, ParseContex
         CHECK(ctx.currentItemType == ParseContext::STATISTICS, "stray 'field' line, must be under a 'statistic'");
         CHECK(numTokens == 3, "incorrect 'field' line -- field <name> <value> expected");
 
-        std::string fieldName = vec[1];
+        const char *fieldName = vec[1];
         double value;
         CHECK(parseDouble(vec[2], value), "invalid scalar file: invalid field value");
 
-        if (fieldName == "count")
+        if (strcmp(fieldName, "count") == 0)
             ctx.fields.count = value;
-        else if (fieldName == "min")
+        else if (strcmp(fieldName, "min") == 0)
             ctx.fields.minValue = value;
-        else if (fieldName == "max")
+        else if (strcmp(fieldName, "max") == 0)
             ctx.fields.maxValue = value;
-        else if (fieldName == "sum")
+        else if (strcmp(fieldName, "sum") == 0)
             ctx.fields.sum = value;
-        else if (fieldName == "sqrsum")
+        else if (strcmp(fieldName, "sqrsum") == 0)
             ctx.fields.sumSquares = value;
-        else if (fieldName == "weights")
+        else if (strcmp(fieldName, "weights") == 0)
             ctx.fields.sumWeights = value;
-        else if (fieldName == "weightedSum")
+        else if (strcmp(fieldName, "weightedSum") == 0)
             ctx.fields.sumWeightedValues = value;
-        else if (fieldName == "sqrSumWeights")
+        else if (strcmp(fieldName, "sqrSumWeights") == 0)
             ctx.fields.sumSquaredWeights = value;
-        else if (fieldName == "weightedSqrSum")
+        else if (strcmp(fieldName, "weightedSqrSum") == 0)
             ctx.fields.sumWeightedSquaredValues = value;
     }
     else if (vec[0][0] == 'b' && !strcmp(vec[0], "bin")) {
@@ -214,27 +221,21 @@ void OmnetppResultFileLoader::processLine(char **vec, int numTokens, ParseContex
         CHECK(ctx.currentItemType != ParseContext::NONE, "stray 'attr' line");
         CHECK(numTokens == 3, "incorrect 'attr' line -- attr <name> <value> expected");
 
-        std::string attrName = vec[1];
-        std::string attrValue = vec[2];
-        ctx.attrs[attrName] = attrValue;
+        ctx.attrs[vec[1]] = vec[2];
     }
     else if (vec[0][0] == 'i' && !strcmp(vec[0], "itervar")) {
         // syntax: "itervar <name> <value>"
         CHECK(ctx.currentItemType == ParseContext::RUN, "stray 'itervar' line, must be under a 'run' line");
         CHECK(numTokens == 3, "incorrect 'itervar' line -- itervar <name> <value> expected");
 
-        std::string name = vec[1];
-        std::string value = vec[2];
-        ctx.itervars[name] = value;
+        ctx.itervars[vec[1]] = vec[2];
     }
     else if (vec[0][0] == 'c' && !strcmp(vec[0], "config")) {
         // syntax: "config <key> <value>"
         CHECK(ctx.currentItemType == ParseContext::RUN, "stray 'config' line, must be under a 'run' line");
         CHECK(numTokens == 3, "incorrect 'config' line -- config <key> <value> expected");
 
-        std::string key = vec[1];
-        std::string value = vec[2];
-        ctx.configEntries.push_back(std::make_pair(key, value));
+        ctx.configEntries.emplace_back(vec[1], vec[2]);
     }
     else if (vec[0][0] == 'p' && !strcmp(vec[0], "param")) {
         // "param" is an obsolete form of "config", just for parameter values; we treat it exactly like "config".
@@ -242,9 +243,7 @@ void OmnetppResultFileLoader::processLine(char **vec, int numTokens, ParseContex
         CHECK(ctx.currentItemType == ParseContext::RUN, "stray 'param' line, must be under a 'run' line");
         CHECK(numTokens == 3, "incorrect 'param' line -- param <namePattern> <value> expected");
 
-        std::string paramName = vec[1];
-        std::string paramValue = vec[2];
-        ctx.configEntries.push_back(std::make_pair(paramName, paramValue));
+        ctx.configEntries.emplace_back(vec[1], vec[2]);
     }
     else if (opp_isdigit(vec[0][0]) && numTokens >= 3) {
         // this looks like a vector data line, skip it this time
@@ -447,13 +446,11 @@ void OmnetppResultFileLoader::doLoadFile(const char *fileName, ResultFile *fileR
 
 void OmnetppResultFileLoader::loadVectorsFromIndex(const char *filename, ResultFile *fileRef)
 {
-    VectorFileIndex *index = IndexFileReader(filename).readAll();
+    std::unique_ptr<VectorFileIndex> index(lazyVectorMetadata ? IndexFileReader(filename).readVectorDeclarations() : IndexFileReader(filename).readAll());
     int numOfVectors = index->getNumberOfVectors();
 
-    if (numOfVectors == 0) {
-        delete index;
+    if (numOfVectors == 0)
         return;
-    }
 
     Run *runRef = resultFileManager->getRunByName(index->run.runName.c_str());
     if (!runRef)
@@ -466,13 +463,34 @@ void OmnetppResultFileLoader::loadVectorsFromIndex(const char *filename, ResultF
     runRef->configEntries = index->run.configEntries;
     FileRun *fileRunRef = resultFileManager->addFileRun(fileRef, runRef);
 
-    const StringMap emptyAttrs;
+    if (lazyVectorMetadata) {
+        // only remember the names; see loadPendingVectors()
+        fileRunRef->vectorNames.reserve(numOfVectors);
+        for (int i = 0; i < numOfVectors; ++i) {
+            const VectorInfo *vectorRef = index->getVectorAt(i);
+            fileRunRef->vectorNames.push_back(std::make_pair(resultFileManager->moduleNames.insert(vectorRef->moduleName), resultFileManager->names.insert(vectorRef->name)));
+        }
+        fileRunRef->vectorsPending = true;
+    }
+    else {
+        addVectorsFromIndex(index.get(), fileRunRef);
+    }
+}
+
+void OmnetppResultFileLoader::addVectorsFromIndex(VectorFileIndex *index, FileRun *fileRunRef)
+{
+    int numOfVectors = index->getNumberOfVectors();
+    fileRunRef->vectorResults.reserve(numOfVectors);
+    // when called from loadPendingVectors(), the names were pooled at load time:
+    // use those, as the name pools must not be modified under the read lock
+    bool pooledNames = fileRunRef->vectorsPending.load(std::memory_order_relaxed);
     for (int i = 0; i < numOfVectors; ++i) {
         const VectorInfo *vectorRef = index->getVectorAt(i);
         assert(vectorRef);
 
-        VectorResult vectorResult(fileRunRef, vectorRef->moduleName, vectorRef->name, emptyAttrs, vectorRef->vectorId, vectorRef->columns);
-        vectorResult.setAttributes(vectorRef->attributes);
+        VectorResult vectorResult = pooledNames ?
+                VectorResult(fileRunRef, fileRunRef->vectorNames[i].first, fileRunRef->vectorNames[i].second, vectorRef->attributes, vectorRef->vectorId, vectorRef->columns) :
+                VectorResult(fileRunRef, vectorRef->moduleName, vectorRef->name, vectorRef->attributes, vectorRef->vectorId, vectorRef->columns);
         vectorResult.startEventNum = vectorRef->startEventNum;
         vectorResult.endEventNum = vectorRef->endEventNum;
         vectorResult.startTime = vectorRef->startTime;
@@ -480,7 +498,25 @@ void OmnetppResultFileLoader::loadVectorsFromIndex(const char *filename, ResultF
         vectorResult.stat = vectorRef->stat;
         fileRunRef->vectorResults.push_back(vectorResult); //TODO use addVector()
     }
-    delete index;
+}
+
+void OmnetppResultFileLoader::loadPendingVectors(FileRun *fileRunRef)
+{
+    ResultFile *fileRef = fileRunRef->getFile();
+    std::string indexFileName = IndexFileUtils::getIndexFileName(fileRef->getFileSystemFilePath().c_str());
+    std::unique_ptr<VectorFileIndex> index(IndexFileReader(indexFileName.c_str()).readAll());
+
+    // the vectors must be the same ones (and in the same order) as at load time
+    bool unchanged = index->fingerprint == fileRef->getFingerprint() && index->getNumberOfVectors() == (int)fileRunRef->vectorNames.size();
+    for (int i = 0; unchanged && i < (int)fileRunRef->vectorNames.size(); i++) {
+        const VectorInfo *vectorRef = index->getVectorAt(i);
+        unchanged = vectorRef->moduleName == *fileRunRef->vectorNames[i].first && vectorRef->name == *fileRunRef->vectorNames[i].second;
+    }
+    if (!unchanged)
+        throw opp_runtime_error("Cannot load vector data for '%s': Index file '%s' has changed since the file was loaded, reload it",
+                fileRef->getFilePath().c_str(), indexFileName.c_str());
+
+    addVectorsFromIndex(index.get(), fileRunRef);
 }
 
 }  // namespace scave
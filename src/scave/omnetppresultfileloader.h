@@ -50,6 +50,7 @@ class SCAVE_API OmnetppResultFileLoader : public IResultFileLoader
     int indexingOption;
     int lockfileOption;
     bool verbose;
+    bool lazyVectorMetadata;
     InterruptedFlag *interrupted;
 
     struct ParseContext {
@@ -86,6 +87,7 @@ class SCAVE_API OmnetppResultFileLoader : public IResultFileLoader
   protected:
     void doLoadFile(const char *fileName, ResultFile *fileRef);
     void loadVectorsFromIndex(const char *filename, ResultFile *fileRef);
+    void addVectorsFromIndex(VectorFileIndex *index, FileRun *fileRunRef);
     void processLine(char **vec, int numTokens, ParseContext& ctx);
     void flush(ParseContext& ctx);
     void resetFields(ParseContext& ctx);
@@ -94,6 +96,12 @@ class SCAVE_API OmnetppResultFileLoader : public IResultFileLoader
   public:
     OmnetppResultFileLoader(ResultFileManager *resultFileManagerPar, int flags, InterruptedFlag *interrupted);
     virtual ResultFile *loadFile(const char *displayName, const char *fileSystemFileName) override;
+
+    /**
+     * Fills in the vectors of a file run loaded with LAZY_VECTOR_METADATA
+     * from the index file.
+     */
+    void loadPendingVectors(FileRun *fileRunRef);
 };
 
 }  // namespace scave
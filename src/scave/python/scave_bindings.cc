@@ -135,6 +135,7 @@ NB_MODULE(MODULENAME, m) {
         .value("IGNORE_LOCK_FILE", ResultFileManager::LoadFlags::IGNORE_LOCK_FILE)
 
         .value("VERBOSE", ResultFileManager::LoadFlags::VERBOSE)
+        .value("LAZY_VECTOR_METADATA", ResultFileManager::LoadFlags::LAZY_VECTOR_METADATA)
         .value("LOADFLAGS_DEFAULTS", ResultFileManager::LoadFlags::LOADFLAGS_DEFAULTS)
         ;
 
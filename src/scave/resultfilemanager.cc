@@ -171,7 +171,11 @@ const ResultItem *ResultFileManager::getNonfieldItem(ID id) const
         switch (_type(id)) {
             case SCALAR: return &getFileRunForID(id)->scalarResults.at(_pos(id));
             case PARAMETER: return &getFileRunForID(id)->parameterResults.at(_pos(id));
-            case VECTOR: return &getFileRunForID(id)->vectorResults.at(_pos(id));
+            case VECTOR: {
+                FileRun *fileRun = getFileRunForID(id);
+                ensureVectorsLoaded(fileRun);
+                return &fileRun->vectorResults.at(_pos(id));
+            }
             case STATISTICS: return &getFileRunForID(id)->statisticsResults.at(_pos(id));
             case HISTOGRAM: return &getFileRunForID(id)->histogramResults.at(_pos(id));
             default: throw opp_runtime_error("ResultFileManager: Invalid ID: Wrong type");
@@ -245,10 +249,10 @@ StringSet ResultFileManager::getUniqueModuleNames(const IDList& ids) const
 {
     READER_MUTEX
     std::set<const std::string*> set;  // all strings are stringpooled, so we can collect unique *pointers* instead of unique strings
-    ScalarResult buffer;
     const std::string *lastModuleName = nullptr;
     for (ID id : ids) {
-        const std::string *moduleName = &getItem(id, buffer)->getModuleName();
+        const std::string *moduleName, *name;
+        getModuleAndResultName(id, moduleName, name);
         if (moduleName != lastModuleName) {
             set.insert(moduleName);
             lastModuleName = moduleName;
@@ -264,9 +268,11 @@ StringSet ResultFileManager::getUniqueResultNames(const IDList& ids) const
 {
     READER_MUTEX
     std::set<const std::string*> set;  // all strings are stringpooled, so we can collect unique *pointers* instead of unique strings
-    ScalarResult buffer;
-    for (ID id : ids)
-        set.insert(&getItem(id, buffer)->getName());
+    for (ID id : ids) {
+        const std::string *moduleName, *name;
+        getModuleAndResultName(id, moduleName, name);
+        set.insert(name);
+    }
 
     StringSet result;
     for (const std::string *e : set)
@@ -278,10 +284,10 @@ StringSet ResultFileManager::getUniqueModuleAndResultNamePairs(const IDList& ids
 {
     READER_MUTEX
     StringSet set;
-    ScalarResult buffer;
     for (ID id : ids) {
-        const ResultItem *result = getItem(id, buffer);
-        set.insert(result->getModuleName() + "." + result->getName());
+        const std::string *moduleName, *name;
+        getModuleAndResultName(id, moduleName, name);
+        set.insert(*moduleName + "." + *name);
     }
     return set;
 }
@@ -472,6 +478,41 @@ ScalarResult ResultFileManager::getFieldScalar(ID id) const
     return result;
 }
 
+void ResultFileManager::loadPendingVectors(FileRun *fileRun) const
+{
+    // Called under the read lock, so it may run concurrently with readers, but
+    // not with loading/unloading. It must not touch the string pools that
+    // readers search: the vectors reuse the names pooled at load time. The
+    // attribute pool is only used by loaders, and pendingVectorsMutex
+    // serializes the pending loads among themselves.
+#ifdef THREADED
+    std::lock_guard<std::mutex> guard(pendingVectorsMutex);
+#endif
+    if (!fileRun->vectorsPending.load(std::memory_order_relaxed))
+        return; // loaded by another thread in the meantime
+    OmnetppResultFileLoader(const_cast<ResultFileManager*>(this), 0, nullptr).loadPendingVectors(fileRun);
+    fileRun->vectorsPending.store(false, std::memory_order_release);
+}
+
+void ResultFileManager::getModuleAndResultName(ID id, const std::string *& moduleName, const std::string *& name) const
+{
+    ID itemId = isField(id) ? _containingItemID(id) : id; // field scalar has the same module as its containing result item
+    FileRun *fileRun = getFileRunForID(itemId);
+    if (_type(itemId) == VECTOR && fileRun->vectorsPending.load(std::memory_order_acquire)) {
+        if (_pos(itemId) >= (int)fileRun->vectorNames.size())
+            throw opp_runtime_error("ResultFileManager::getItem(id): Invalid ID");
+        moduleName = fileRun->vectorNames[_pos(itemId)].first;
+        name = fileRun->vectorNames[_pos(itemId)].second;
+    }
+    else {
+        const ResultItem *item = getNonfieldItem(itemId);
+        moduleName = &item->getModuleName();
+        name = &item->getName();
+    }
+    if (isField(id))
+        name = getPooledNameWithSuffix(name, (FieldNum)_fieldid(id));
+}
+
 void ResultFileManager::fillFieldScalar(ScalarResult& scalar, ID id) const
 {
     READER_MUTEX
@@ -521,7 +562,9 @@ const VectorResult *ResultFileManager::getVector(ID id) const
     READER_MUTEX
     if (_type(id) != VECTOR)
         throw opp_runtime_error("ResultFileManager::getVector(id): This item is not a vector");
-    return &getFileRunForID(id)->vectorResults.at(_pos(id));
+    FileRun *fileRun = getFileRunForID(id);
+    ensureVectorsLoaded(fileRun);
+    return &fileRun->vectorResults.at(_pos(id));
 }
 
 const StatisticsResult *ResultFileManager::getStatistics(ID id) const
@@ -570,19 +613,17 @@ const char *ResultFileManager::getItemProperty(ID id, const char *propertyName)
         }
         case Scave::MODULE[0]: {
             if (strcmp(propertyName, Scave::MODULE) == 0) {
-                if (isField(id))
-                    return getContainingItem(id)->getModuleName().c_str(); // field scalar has the same module as its containing result item
-                else
-                    return getNonfieldItem(id)->getModuleName().c_str();
+                const std::string *moduleName, *name;
+                getModuleAndResultName(id, moduleName, name);
+                return moduleName->c_str();
             }
             break;
         }
         case Scave::NAME[0]: {
             if (strcmp(propertyName, Scave::NAME) == 0) {
-                if (isField(id))
-                    return getPooledNameWithSuffix(&getContainingItem(id)->getName(), (FieldNum)_fieldid(id))->c_str();
-                else
-                    return getNonfieldItem(id)->getName().c_str();
+                const std::string *moduleName, *name;
+                getModuleAndResultName(id, moduleName, name);
+                return name->c_str();
             }
             break;
         }
@@ -637,7 +678,7 @@ IDList ResultFileManager::getItems(const FileRunList& fileRuns, int types, bool
                 if (includeFields) {
                     makeFieldScalarIDs(out, fileRun, fileRun->statisticsResults.size(), HOSTTYPE_STATISTICS, StatisticsResult::getAvailableFields());
                     makeFieldScalarIDs(out, fileRun, fileRun->histogramResults.size(), HOSTTYPE_HISTOGRAM, HistogramResult::getAvailableFields());
-                    makeFieldScalarIDs(out, fileRun, fileRun->vectorResults.size(), HOSTTYPE_VECTOR, VectorResult::getAvailableFields());
+                    makeFieldScalarIDs(out, fileRun, fileRun->getNumVectors(), HOSTTYPE_VECTOR, VectorResult::getAvailableFields());
                 }
             }
             if (types & STATISTICS)
@@ -645,7 +686,7 @@ IDList ResultFileManager::getItems(const FileRunList& fileRuns, int types, bool
             if (types & HISTOGRAM)
                 makeIDs(out, fileRun, fileRun->histogramResults.size(), HISTOGRAM);
             if (types & VECTOR)
-                makeIDs(out, fileRun, fileRun->vectorResults.size(), VECTOR);
+                makeIDs(out, fileRun, fileRun->getNumVectors(), VECTOR);
         }
     }
     return IDList(std::move(out));
@@ -722,6 +763,11 @@ ID ResultFileManager::getItemByName(FileRun *fileRunRef, const char *module, con
             return _mkID(PARAMETER, fileRunRef->id, i);
     }
 
+    if (fileRunRef->vectorsPending.load(std::memory_order_acquire)) {
+        for (int i = 0; i < (int)fileRunRef->vectorNames.size(); i++)
+            if (fileRunRef->vectorNames[i].first == moduleNameRef && fileRunRef->vectorNames[i].second == nameRef)
+                return _mkID(VECTOR, fileRunRef->id, i);
+    }
     VectorResults& vectorResults = fileRunRef->vectorResults;
     for (int i = 0; i < (int)vectorResults.size(); i++) {
         const ResultItem& d = vectorResults[i];
@@ -847,7 +893,6 @@ IDList ResultFileManager::filterIDList(const IDList& idlist,
     std::vector<ID> out;
     FileRun *lastFileRunRef = nullptr;
     bool lastFileRunMatched = false;
-    ScalarResult buffer;
     for (ID id : idlist) {
         if (fileRunFilter) {
             FileRun *fileRun = getFileRun(id);
@@ -859,17 +904,18 @@ IDList ResultFileManager::filterIDList(const IDList& idlist,
                 continue;
         }
 
-        const ResultItem *item = getItem(id, buffer);
+        const std::string *moduleName, *name;
+        getModuleAndResultName(id, moduleName, name);
 
         if (moduleFilter && moduleFilter[0] &&
-            (patMatchModule ? !modulePattern->matches(item->getModuleName().c_str())
-             : strcmp(item->getModuleName().c_str(), moduleFilter))
+            (patMatchModule ? !modulePattern->matches(moduleName->c_str())
+             : strcmp(moduleName->c_str(), moduleFilter))
             )
             continue;  // no match
 
         if (nameFilter && nameFilter[0] &&
-            (patMatchName ? !namePattern->matches(item->getName().c_str())
-             : strcmp(item->getName().c_str(), nameFilter))
+            (patMatchName ? !namePattern->matches(name->c_str())
+             : strcmp(name->c_str(), nameFilter))
             )
             continue;  // no match
 
@@ -893,17 +939,17 @@ IDList ResultFileManager::filterIDList(const IDList& idlist, const Run *run, con
     READER_MUTEX
 
     std::vector<ID> result;
-    ScalarResult buffer;
     for (ID id : idlist) {
         if (run && getFileRun(id)->runRef != run)
             continue;
 
-        const ResultItem *item = getItem(id, buffer);
+        const std::string *itemModuleName, *itemName;
+        getModuleAndResultName(id, itemModuleName, itemName);
 
-        if (moduleName && item->getModuleName() != moduleName)
+        if (moduleName && *itemModuleName != moduleName)
             continue;
 
-        if (name && item->getName() != name)
+        if (name && *itemName != name)
             continue;
 
         // everything matched, insert it.
@@ -35,6 +35,7 @@
 #include "enums.h"
 
 #ifdef THREADED
+#include <mutex>
 #include "common/rwlock.h"
 #endif
 
@@ -122,6 +123,10 @@ class SCAVE_API ResultFileManager
 
         VERBOSE = (1<<8), // print on stdout what it's doing
 
+        // When loading vectors from an index file: read only the module and vector names;
+        // attributes and statistics are read when the vectors of the file are first accessed
+        LAZY_VECTOR_METADATA = (1<<9),
+
         LOADFLAGS_DEFAULTS = RELOAD_IF_CHANGED | ALLOW_INDEXING | SKIP_IF_LOCKED
     };
 
@@ -155,6 +160,7 @@ class SCAVE_API ResultFileManager
 
 #ifdef THREADED
     omnetpp::common::ReentrantReadWriteLock lock;
+    mutable std::mutex pendingVectorsMutex; // serializes loadPendingVectors() calls under the read lock
 #endif
 
   public:
@@ -210,6 +216,11 @@ class SCAVE_API ResultFileManager
     inline const StatisticsResult *uncheckedGetStatistics(ID id) const;
     inline const HistogramResult *uncheckedGetHistogram(ID id) const;
 
+    // for LAZY_VECTOR_METADATA
+    inline void ensureVectorsLoaded(FileRun *fileRun) const;
+    void loadPendingVectors(FileRun *fileRun) const;
+    void getModuleAndResultName(ID id, const std::string *& moduleName, const std::string *& name) const; // does not load pending vectors
+
     void fillFieldScalar(ScalarResult& scalar, ID id) const;
     const std::string *getPooledNameWithSuffix(const std::string *name, FieldNum fieldId) const;
     static const char *getNameSuffixForFieldScalar(FieldNum fieldId);
@@ -302,7 +313,7 @@ class SCAVE_API ResultFileManager
     // these ones are called from InputsTree
     int getNumScalarsInFileRun(FileRun *fileRun) const {return fileRun->scalarResults.size();}
     int getNumParametersInFileRun(FileRun *fileRun) const {return fileRun->parameterResults.size();}
-    int getNumVectorsInFileRun(FileRun *fileRun) const {return fileRun->vectorResults.size();}
+    int getNumVectorsInFileRun(FileRun *fileRun) const {return fileRun->getNumVectors();}
     int getNumStatisticsInFileRun(FileRun *fileRun) const {return fileRun->statisticsResults.size();}
     int getNumHistogramsInFileRun(FileRun *fileRun) const {return fileRun->histogramResults.size();}
 
@@ -423,7 +434,7 @@ inline const ResultItem *ResultFileManager::uncheckedGetItem(ID id, ScalarResult
     {
         case SCALAR: return uncheckedGetScalar(id, buffer);
         case PARAMETER: return &fileRunList[_filerunid(id)]->parameterResults[_pos(id)];
-        case VECTOR: return &fileRunList[_filerunid(id)]->vectorResults[_pos(id)];
+        case VECTOR: return uncheckedGetVector(id);
         case STATISTICS: return &fileRunList[_filerunid(id)]->statisticsResults[_pos(id)];
         case HISTOGRAM: return &fileRunList[_filerunid(id)]->histogramResults[_pos(id)];
         default: throw opp_runtime_error("ResultFileManager: invalid ID: wrong type");
@@ -447,7 +458,9 @@ inline const ParameterResult *ResultFileManager::uncheckedGetParameter(ID id) co
 
 inline const VectorResult *ResultFileManager::uncheckedGetVector(ID id) const
 {
-    return &fileRunList[_filerunid(id)]->vectorResults[_pos(id)];
+    FileRun *fileRun = fileRunList[_filerunid(id)];
+    ensureVectorsLoaded(fileRun);
+    return &fileRun->vectorResults[_pos(id)];
 }
 
 inline const StatisticsResult *ResultFileManager::uncheckedGetStatistics(ID id) const
@@ -460,6 +473,12 @@ inline const HistogramResult *ResultFileManager::uncheckedGetHistogram(ID id) co
     return &fileRunList[_filerunid(id)]->histogramResults[_pos(id)];
 }
 
+inline void ResultFileManager::ensureVectorsLoaded(FileRun *fileRun) const
+{
+    if (fileRun->vectorsPending.load(std::memory_order_acquire))
+        loadPendingVectors(fileRun);
+}
+
 inline FileRun *ResultFileManager::getFileRunForID(ID id) const
 {
     FileRun *fileRun = fileRunList.at(_filerunid(id));
@@ -35,6 +35,12 @@ ResultItem::ResultItem(FileRun *fileRun, const std::string& moduleName, const st
     setAttributes(attrs);
 }
 
+ResultItem::ResultItem(FileRun *fileRun, const std::string *moduleNameRef, const std::string *nameRef, const StringMap& attrs):
+    fileRunRef(fileRun), moduleNameRef(moduleNameRef), nameRef(nameRef)
+{
+    setAttributes(attrs);
+}
+
 void ResultItem::setAttributes(const StringMap& attrs)
 {
     ResultFileManager *resultFileManager = fileRunRef->fileRef->getResultFileManager();
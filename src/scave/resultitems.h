@@ -16,6 +16,7 @@
 #ifndef __OMNETPP_SCAVE_RESULTITEMS_H
 #define __OMNETPP_SCAVE_RESULTITEMS_H
 
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <string>
@@ -82,6 +83,7 @@ class SCAVE_API ResultItem
   protected:
     ResultItem() {} // for ScalarResult default ctor
     ResultItem(FileRun *fileRun, const std::string& moduleName, const std::string& name, const StringMap& attrs);
+    ResultItem(FileRun *fileRun, const std::string *moduleNameRef, const std::string *nameRef, const StringMap& attrs); // names already pooled
     void setAttributes(const StringMap& attrs);
     void setAttribute(const std::string& attrName, const std::string& value);
 
@@ -191,6 +193,8 @@ class SCAVE_API VectorResult : public ResultItem
   protected:
     VectorResult(FileRun *fileRun, const std::string& moduleName, const std::string& name, const StringMap& attrs, int vectorId, const std::string& columns) :
         ResultItem(fileRun, moduleName, name, attrs), vectorId(vectorId), columns(columns), startEventNum(-1), endEventNum(-1), startTime(0.0), endTime(0.0) {}
+    VectorResult(FileRun *fileRun, const std::string *moduleNameRef, const std::string *nameRef, const StringMap& attrs, int vectorId, const std::string& columns) :
+        ResultItem(fileRun, moduleNameRef, nameRef, attrs), vectorId(vectorId), columns(columns), startEventNum(-1), endEventNum(-1), startTime(0.0), endTime(0.0) {}
   public:
     virtual int getItemType() const;
     int getVectorId() const {return vectorId;}
@@ -364,6 +368,15 @@ class SCAVE_API FileRun
     VectorResults vectorResults;
     StatisticsResults statisticsResults;
     HistogramResults histogramResults;
+
+    // With ResultFileManager::LAZY_VECTOR_METADATA, only the (pooled) module
+    // and vector names are loaded initially, and vectorResults is filled in
+    // from the index file on first access. vectorNames is kept afterwards,
+    // as readers may still be using it.
+    std::vector<std::pair<const std::string *, const std::string *>> vectorNames;
+    std::atomic<bool> vectorsPending {false};
+
+    int getNumVectors() const {return vectorsPending.load(std::memory_order_acquire) ? vectorNames.size() : vectorResults.size();}
   public:
     ResultFile *getFile() const {return fileRef;}
     Run *getRun() const {return runRef;}
@@ -14,6 +14,7 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <cfloat>
 #include <utility>
 #include <clocale>
 #include "omnetpp/platdep/platmisc.h"
@@ -23,8 +24,96 @@ namespace omnetpp {
 namespace scave {
 
 
+inline bool isDigit(char c)
+{
+    return (unsigned char)(c - '0') < 10;
+}
+
+// Fast path for the integers in result files: an optional minus sign followed by
+// at most maxDigits digits, so that there is no overflow. Returns false for anything
+// else (leading whitespace or plus sign, too many digits, etc.); those are left to strtol().
+static bool parseSimpleInteger(const char *s, int maxDigits, int64_t& dest)
+{
+    const char *p = s;
+    bool negative = (*p == '-');
+    if (negative)
+        p++;
+    const char *digitsStart = p;
+    int64_t value = 0;
+    while (isDigit(*p))
+        value = value * 10 + (*p++ - '0');
+    if (*p != '\0' || p == digitsStart || p - digitsStart > maxDigits)
+        return false;
+    dest = negative ? -value : value;
+    return true;
+}
+
+// Fast path for the doubles in result files (Clinger's algorithm). If the decimal
+// mantissa fits into 53 bits and the power of ten is at most 22, both are exactly
+// representable as doubles, so a single multiplication or division yields the
+// correctly rounded result, i.e. the same as strtod(). Returns false for anything
+// else (special values, more digits, larger exponents); those are left to strtod().
+static bool parseSimpleDouble(const char *s, double& dest)
+{
+#if FLT_EVAL_METHOD == 0
+    static const double powersOf10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char *p = s;
+    bool negative = (*p == '-');
+    if (negative)
+        p++;
+
+    uint64_t mantissa = 0;
+    int numDigits = 0;
+    int exponent = 0;
+    while (isDigit(*p)) {
+        mantissa = mantissa * 10 + (*p++ - '0');
+        numDigits++;
+    }
+    if (*p == '.') {
+        p++;
+        while (isDigit(*p)) {
+            mantissa = mantissa * 10 + (*p++ - '0');
+            numDigits++;
+            exponent--;
+        }
+    }
+    if (numDigits == 0 || numDigits > 19) // note: 19 digits cannot overflow uint64_t
+        return false;
+
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        bool negativeExponent = (*p == '-');
+        if (*p == '-' || *p == '+')
+            p++;
+        if (!isDigit(*p))
+            return false;
+        int e = 0;
+        while (isDigit(*p) && e < 1000)
+            e = e * 10 + (*p++ - '0');
+        exponent += negativeExponent ? -e : e;
+    }
+    if (*p != '\0' || mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22)
+        return false;
+
+    double d = (double)mantissa;
+    d = exponent < 0 ? d / powersOf10[-exponent] : d * powersOf10[exponent];
+    dest = negative ? -d : d;
+    return true;
+#else
+    return false;  // the fast path relies on the absence of extended-precision intermediate results
+#endif
+}
+
 bool parseInt(const char *s, int& dest)
 {
+    int64_t value;
+    if (parseSimpleInteger(s, 9, value)) {
+        dest = (int)value;
+        return true;
+    }
     char *e;
     dest = (int)strtol(s, &e, 10);
     return !*e;
@@ -32,6 +121,11 @@ bool parseInt(const char *s, int& dest)
 
 bool parseLong(const char *s, long& dest)
 {
+    int64_t value;
+    if (parseSimpleInteger(s, sizeof(long) >= 8 ? 18 : 9, value)) {
+        dest = (long)value;
+        return true;
+    }
     char *e;
     dest = strtol(s, &e, 10);
     return !*e;
@@ -39,6 +133,8 @@ bool parseLong(const char *s, long& dest)
 
 bool parseInt64(const char *s, int64_t& dest)
 {
+    if (parseSimpleInteger(s, 18, dest))
+        return true;
     char *e;
     dest = strtoll(s, &e, 10);
     return !*e;
@@ -46,6 +142,9 @@ bool parseInt64(const char *s, int64_t& dest)
 
 bool parseDouble(const char *s, double& dest)
 {
+    if (parseSimpleDouble(s, dest))
+        return true;
+
     char *e;
     setlocale(LC_NUMERIC, "C");
     dest = strtod(s, &e);
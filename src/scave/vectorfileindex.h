@@ -178,6 +178,7 @@ struct VectorFileIndex {
     std::string vectorFileName;
     FileFingerprint fingerprint;
     RunData run;
+    std::vector<std::string> shardFileNames; // for sharded vector files: the data files, relative to the vector file; data of vector i are in shard i % N
 private:
     std::vector<VectorInfo> vectors;
     typedef std::map<int,int> VectorIdToIndexMap;
@@ -214,6 +215,16 @@ public:
         VectorIdToIndexMap::const_iterator entry = map.find(vectorId);
         return entry!=map.end() ? getVectorAt(entry->second) : nullptr;
     }
+
+    bool isSharded() const { return !shardFileNames.empty(); }
+
+    /**
+     * Returns the name of the file (relative to the vector file) that contains
+     * the data of the given vector, or nullptr if the vector file is not sharded.
+     */
+    const char *getShardFileName(int vectorId) const {
+        return shardFileNames.empty() ? nullptr : shardFileNames[vectorId % shardFileNames.size()].c_str();
+    }
 };
 
 }  // namespace scave
@@ -137,6 +137,9 @@ void VectorFileIndexer::generateIndex(const char *vectorFileName, IProgressMonit
                 if (currentVectorRef != nullptr)
                     currentVectorRef = index.getVectorById(currentVectorId); // refresh currentVectorRef, as index.addVector() might have invalidated it due to std::vector reallocation
             }
+            else if (tokens[0][0] == 's' && strcmp(tokens[0], "shard") == 0) {
+                throw ResultFileFormatException("Vector file indexer: Cannot index sharded vector files, the index is written together with the shards", vectorFileName, lineNo);
+            }
             else if (tokens[0][0] == 'v' && strcmp(tokens[0], "version") == 0) {
                 int version;
                 if (numTokens < 2)
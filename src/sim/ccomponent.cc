@@ -40,6 +40,10 @@
 #include "omnetpp/cresultfilter.h"
 #include "omnetpp/crngmanager.h"
 
+#ifdef WITH_PYTHON
+#include "pythonutil.h"
+#endif
+
 using namespace omnetpp::common;
 
 namespace omnetpp {
@@ -312,11 +316,16 @@ void cComponent::finalizeParameters()
 
     // read parameters from that are still not set;
     // we need two stages (read+finalize) because of possible cross-parameter references
-    int n = getNumParams();
-    for (int i = 0; i < n; i++)
-        par(i).read();
-    for (int i = 0; i < n; i++)
-        par(i).finalize();
+    {
+#ifdef WITH_PYTHON
+        PythonGilBatch pythonGilBatch;  // keep the GIL between Python NED function calls in parameter expressions
+#endif
+        int n = getNumParams();
+        for (int i = 0; i < n; i++)
+            par(i).read();
+        for (int i = 0; i < n; i++)
+            par(i).finalize();
+    }
 
     setFlag(FL_PARAMSFINALIZED, true);
 
@@ -351,16 +351,16 @@ cModule *cModuleType::doCreate(cSimulation *simulation, cModule *parentModule, c
     module->setComponentType(this);
     module->setInitialNameAndIndex(moduleName, index);
 
-    // notify pre-change listeners
-    if (parentModule && parentModule->hasListeners(PRE_MODEL_CHANGE)) {
-        cPreModuleAddNotification tmp;
-        tmp.module = module;
-        tmp.parentModule = parentModule;
-        parentModule->emit(PRE_MODEL_CHANGE, &tmp);
-    }
-
-    // insert into network
     try {
+        // notify pre-change listeners (they may veto the change by throwing an exception)
+        if (parentModule && parentModule->hasListeners(PRE_MODEL_CHANGE)) {
+            cPreModuleAddNotification tmp;
+            tmp.module = module;
+            tmp.parentModule = parentModule;
+            parentModule->emit(PRE_MODEL_CHANGE, &tmp);
+        }
+
+        // insert into network
         if (parentModule)
             parentModule->insertSubmodule(module);
         else
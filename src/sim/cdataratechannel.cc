@@ -20,6 +20,7 @@
 #include "omnetpp/cenvir.h"
 #include "omnetpp/distrib.h"
 #include "omnetpp/csimulation.h"
+#include "omnetpp/cstatesaving.h"
 #include "omnetpp/globals.h"
 #include "omnetpp/cgate.h"
 #include "omnetpp/cexception.h"
@@ -151,6 +152,13 @@ cChannel::Result cDatarateChannel::processMessage(cMessage *msg, const SendOptio
     Result result;
 
     if (msg->isPacket()) {
+        // under optimistic parallel simulation, the transmission state must be restorable
+        if (mode != UNCHECKED && cStateSaving::isRecording()) {
+            cStateSaving::saveState(singleTx);
+            cStateSaving::saveState(txList);
+            cStateSaving::saveState(channelFinishTime);
+        }
+
         // disabled channel, transmission duration, and error modeling
         processPacket(static_cast<cPacket *>(msg), options, t, result);
     }
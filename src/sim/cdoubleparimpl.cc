@@ -113,7 +113,7 @@ double cDoubleParImpl::doubleValue(cComponent *context) const
         try {
             cTemporaryOwner tmp(cTemporaryOwner::DestructorMode::DISPOSE); // eventually dispose of potential object result
             cValue v = evaluate(expr, context);
-            return v.doubleValueInUnit(getUnit()); // allows conversion from INT
+            return v.doubleValueInUnit(getUnit(), getUnitId()); // allows conversion from INT
         }
         catch (std::exception& e) {
             throw cRuntimeError(e, expr->getSourceLocation().c_str());
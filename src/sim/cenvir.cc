@@ -54,6 +54,20 @@ uint64_t cEnvir::getUniqueNumber()
     return getSimulation()->getUniqueNumber();
 }
 
+int cEnvir::recordManyInOutputVector(void *vechandle, const simtime_t *times, const double *values, int n)
+{
+    int stored = 0;
+    for (int i = 0; i < n; i++)
+        if (recordInOutputVector(vechandle, times[i], values[i]))
+            stored++;
+    return stored;
+}
+
+void cEnvir::switchRun(cConfiguration *cfg)
+{
+    throw cRuntimeError("switchRun(): Not supported by this user interface");
+}
+
 int cEnvir::getParsimProcId() const
 {
     return getSimulation()->getParsimProcId();
@@ -20,6 +20,8 @@
 #include <cmath>  // pow
 #include <cstdio>  // sprintf
 #include <cstring>  // strcpy
+#include <typeinfo>
+#include <vector>
 #include "common/stringutil.h"
 #include "common/stringpool.h"
 #include "omnetpp/cpacket.h"
@@ -69,6 +71,28 @@ OPP_THREAD_LOCAL StaticStringPool gateFullnamePool;
 
 OPP_THREAD_LOCAL int cGate::lastConnectionId = -1;
 
+/*
+ * Flattened form of the connection path starting at a gate, so that deliver()
+ * can iterate over it instead of recursing through every gate of nested
+ * compound modules. Every hop is kept (the envir needs to be notified about
+ * each of them), but processMessage() is only called on channels that
+ * actually do something, i.e. not on plain cIdealChannel instances.
+ * The path is cut short at the first gate that overrides deliver() (e.g.
+ * cProxyGate in parallel simulation), and delivery is delegated to it.
+ */
+struct cGate::DeliveryPlan
+{
+    struct Hop {
+        cGate *gate;
+        cChannel *channel;   // nullptr if the connection has no channel object
+        bool processes;      // whether channel->processMessage() needs to be called
+    };
+    std::vector<Hop> hops;
+    cGate *endGate = nullptr;
+    bool endGateOverridesDeliver = false;
+    bool valid = false;
+};
+
 cGate::Name::Name(const char *name, Type type) : name(name), type(type)
 {
     if (type == cGate::INOUT) {
@@ -92,6 +116,7 @@ bool cGate::Name::operator<(const Name& other) const
 cGate::~cGate()
 {
     dropAndDelete(channel);
+    delete deliveryPlan;
 }
 
 void cGate::clearFullnamePool()
@@ -296,6 +321,7 @@ cChannel *cGate::connectTo(cGate *g, cChannel *chan, bool leaveUninitialized)
     nextGate = g;
     nextGate->prevGate = this;
     connectionId = ++lastConnectionId;
+    invalidateDeliveryPlans();
     if (chan)
         installChannel(chan);
 
@@ -342,6 +368,7 @@ void cGate::installChannel(cChannel *chan)
     channel = chan;
     channel->setSourceGate(this);
     take(channel);
+    invalidateDeliveryPlans();
 
     cModule *parentModule = channel->getParentModule();
     parentModule->insertChannel(chan);
@@ -386,12 +413,12 @@ void cGate::disconnect()
         channel = nullptr;
     }
 
+    invalidateDeliveryPlans();
     cGate *oldNextGate = nextGate;
     nextGate->prevGate = nullptr;
     nextGate = nullptr;
     connectionId = -1;
 
-
 #ifdef SIMFRONTEND_SUPPORT
     mod->updateLastChangeSerial();
 #endif
@@ -475,29 +502,77 @@ void cGate::setDeliverImmediately(bool d)
         pos &= ~2;
 }
 
+void cGate::invalidateDeliveryPlans()
+{
+    for (cGate *g = this; g != nullptr; g = g->prevGate)
+        if (g->deliveryPlan)
+            g->deliveryPlan->valid = false;
+}
+
+void cGate::buildDeliveryPlan()
+{
+    ASSERT(nextGate != nullptr);
+    if (!deliveryPlan)
+        deliveryPlan = new DeliveryPlan();
+
+    DeliveryPlan *plan = deliveryPlan;
+    plan->hops.clear();
+    cGate *g = this;
+    while (true) {
+        cChannel *chan = g->channel;
+        plan->hops.push_back(DeliveryPlan::Hop { g, chan, chan != nullptr && typeid(*chan) != typeid(cIdealChannel) });
+        g = g->nextGate;
+        if (g->nextGate == nullptr || typeid(*g) != typeid(cGate))
+            break;
+    }
+    plan->endGate = g;
+    plan->endGateOverridesDeliver = typeid(*g) != typeid(cGate);
+    plan->valid = true;
+}
+
 bool cGate::deliver(cMessage *msg, const SendOptions& options, simtime_t t)
 {
     if (!nextGate) {
         getOwnerModule()->arrived(msg, this, options, t);
         return true;
     }
-    else if (!channel) {
-        EVCB.messageSendHop(msg, this);
-        return nextGate->deliver(msg, options, t);
-    }
-    else {
-        if (!channel->initialized())
-            throw cRuntimeError(channel, "Channel not initialized (did you forget to invoke "
-                                         "callInitialize() for a dynamically created channel or "
-                                         "a dynamically created compound module that contains it?)");
+
+    if (!deliveryPlan || !deliveryPlan->valid)
+        buildDeliveryPlan();
+
+    DeliveryPlan *plan = deliveryPlan;
+    size_t numHops = plan->hops.size();
+    for (size_t i = 0; i < numHops; i++) {
+        const DeliveryPlan::Hop& hop = plan->hops[i];
+        if (!hop.channel) {
+            EVCB.messageSendHop(msg, hop.gate);
+            continue;
+        }
+
+        if (!hop.channel->initialized())
+            throw cRuntimeError(hop.channel, "Channel not initialized (did you forget to invoke "
+                                             "callInitialize() for a dynamically created channel or "
+                                             "a dynamically created compound module that contains it?)");
 
         // let the channel process the message
-        cChannel::Result result = channel->processMessage(msg, options, t);
-        EVCB.messageSendHop(msg, this, result);
+        cChannel::Result result;
+        if (hop.processes)
+            result = hop.channel->processMessage(msg, options, t);
+        EVCB.messageSendHop(msg, hop.gate, result);
         if (result.discard)
             return false;
-        return nextGate->deliver(msg, options, t + result.delay);
+        t += result.delay;
+
+        // if the channel changed the connection path, continue hop by hop
+        if (!plan->valid)
+            return hop.gate->nextGate->deliver(msg, options, t);
     }
+
+    cGate *endGate = plan->endGate;
+    if (plan->endGateOverridesDeliver)
+        return endGate->deliver(msg, options, t);
+    endGate->getOwnerModule()->arrived(msg, endGate, options, t);
+    return true;
 }
 
 cChannel *cGate::findTransmissionChannel() const
@@ -23,6 +23,7 @@
 #include "omnetpp/csimulation.h"
 #include "omnetpp/cexception.h"
 #include "omnetpp/cconfigoption.h"
+#include "omnetpp/checkandcast.h"
 
 namespace omnetpp {
 
@@ -67,6 +68,20 @@ void cLCG32::selfTest()
         throw cRuntimeError("cLCG32: selfTest() failed, please report this problem!");
 }
 
+cLCG32 *cLCG32::dup() const
+{
+    cLCG32 *copy = new cLCG32();
+    copy->restoreState(this);
+    return copy;
+}
+
+void cLCG32::restoreState(const cRNG *other)
+{
+    const cLCG32 *lcg = check_and_cast<const cLCG32 *>(other);
+    seed = lcg->seed;
+    numDrawn = lcg->numDrawn;
+}
+
 uint32_t cLCG32::intRand()
 {
     numDrawn++;
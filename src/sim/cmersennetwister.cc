@@ -23,6 +23,7 @@
 #include "omnetpp/cmersennetwister.h"
 #include "omnetpp/cmessage.h"
 #include "omnetpp/cconfigoption.h"
+#include "omnetpp/checkandcast.h"
 
 namespace omnetpp {
 
@@ -77,6 +78,23 @@ void cMersenneTwister::selfTest()
         throw cRuntimeError("cMersenneTwister: selfTest() failed, please report this problem!");
 }
 
+cMersenneTwister *cMersenneTwister::dup() const
+{
+    cMersenneTwister *copy = new cMersenneTwister();
+    copy->restoreState(this);
+    return copy;
+}
+
+void cMersenneTwister::restoreState(const cRNG *other)
+{
+    const cMersenneTwister *mt = check_and_cast<const cMersenneTwister *>(other);
+    // MTRand is not safely copyable (it points into its own state array), so go via save()/load()
+    MTRand::uint32 buffer[MTRand::SAVE];
+    mt->rng.save(buffer);
+    rng.load(buffer);
+    numDrawn = mt->numDrawn;
+}
+
 uint32_t cMersenneTwister::intRand()
 {
     numDrawn++;
@@ -27,6 +27,7 @@
 #include "omnetpp/cenvir.h"
 #include "omnetpp/cexception.h"
 #include "omnetpp/cenum.h"
+#include "omnetpp/cstatesaving.h"
 
 #ifdef WITH_PARSIM
 #include "omnetpp/ccommbuffer.h"
@@ -168,6 +169,7 @@ bool cOutVector::recordWithTimestamp(simtime_t t, double value)
     if (t < lastTimestamp)
         throw cRuntimeError(this, "Cannot record data with an earlier timestamp (t=%s) "
                                   "than the previously recorded value", SIMTIME_STR(t));
+    cStateSaving::saveState(lastTimestamp);  // events may be rolled back under optimistic parallel simulation
     lastTimestamp = t;
 
     numReceived++;
@@ -193,5 +195,51 @@ bool cOutVector::recordWithTimestamp(simtime_t t, double value)
     return stored;
 }
 
+int cOutVector::recordMany(const simtime_t *times, const double *values, int n)
+{
+    if (n <= 0)
+        return 0;
+
+    // check timestamps
+    simtime_t prevTime = lastTimestamp;
+    for (int i = 0; i < n; i++) {
+        if (times[i] < prevTime)
+            throw cRuntimeError(this, "Cannot record data with an earlier timestamp (t=%s) "
+                                      "than the previously recorded value", SIMTIME_STR(times[i]));
+        prevTime = times[i];
+    }
+    cStateSaving::saveState(lastTimestamp);  // events may be rolled back under optimistic parallel simulation
+    lastTimestamp = prevTime;
+
+    numReceived += n;
+
+    // pass data to inspector
+    if (recordInInspector)
+        for (int i = 0; i < n; i++)
+            recordInInspector(dataForInspector, times[i], values[i]);
+
+    if (!isEnabled())
+        return 0;
+
+    // skip values in the warm-up period (timestamps are increasing, so they are at the front)
+    int start = 0;
+    if (!getRecordDuringWarmupPeriod()) {
+        simtime_t warmupPeriod = getSimulation()->getWarmupPeriod();
+        while (start < n && times[start] < warmupPeriod)
+            start++;
+        if (start == n)
+            return 0;
+    }
+
+    // initialize if not yet done
+    if (!handle)
+        handle = getEnvir()->registerOutputVector(getSimulation()->getContext()->getFullPath().c_str(), getName());
+
+    // pass data to envir for storage
+    int stored = getEnvir()->recordManyInOutputVector(handle, times + start, values + start, n - start);
+    numStored += stored;
+    return stored;
+}
+
 }  // namespace omnetpp
 
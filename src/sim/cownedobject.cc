@@ -55,6 +55,7 @@ void printAllObjects()
 OPP_THREAD_LOCAL cSoftOwner *cOwnedObject::owningContext = &globalOwningContext;
 OPP_THREAD_LOCAL long cOwnedObject::totalObjectCount = 0;
 OPP_THREAD_LOCAL long cOwnedObject::liveObjectCount = 0;
+OPP_THREAD_LOCAL cIOwnedObjectObserver *cOwnedObject::observer = nullptr;
 
 OPP_THREAD_LOCAL cSoftOwner globalOwningContext("globalOwningContext", false, (internal::Void*)nullptr);
 
@@ -68,6 +69,8 @@ cOwnedObject::cOwnedObject()
 #ifdef DEVELOPER_DEBUG
     objectlist.insert(this);
 #endif
+    if (observer)
+        observer->objectCreated(this);
 }
 
 cOwnedObject::cOwnedObject(const char *name, bool namepooling) : cNamedObject(name, namepooling)
@@ -80,6 +83,8 @@ cOwnedObject::cOwnedObject(const char *name, bool namepooling) : cNamedObject(na
 #ifdef DEVELOPER_DEBUG
     objectlist.insert(this);
 #endif
+    if (observer)
+        observer->objectCreated(this);
 }
 
 // for constructing the global cSoftOwner instance globalOwningContext which has no owner
@@ -104,6 +109,8 @@ cOwnedObject::cOwnedObject(const cOwnedObject& obj) : cNamedObject(obj)
 #ifdef DEVELOPER_DEBUG
     objectlist.insert(this);
 #endif
+    if (observer)
+        observer->objectCreated(this);
 }
 
 cOwnedObject::~cOwnedObject()
@@ -117,6 +124,9 @@ cOwnedObject::~cOwnedObject()
 
     // statistics
     liveObjectCount--;
+
+    if (observer)
+        observer->objectDeleted(this);
 }
 
 void cOwnedObject::removeFromOwnershipTree()
@@ -132,6 +142,13 @@ void cOwnedObject::setOwningContext(cSoftOwner *list)
     owningContext = list;
 }
 
+cIOwnedObjectObserver *cOwnedObject::setObserver(cIOwnedObjectObserver *obs)
+{
+    cIOwnedObjectObserver *old = observer;
+    observer = obs;
+    return old;
+}
+
 cSoftOwner *cOwnedObject::getOwningContext()
 {
     return owningContext;
@@ -217,10 +217,10 @@ double cPar::doubleValue() const
 
 double cPar::doubleValueInUnit(const char *targetUnit) const
 {
-    if (getType() == INT)
-        return UnitConversion::convertUnit((double)intValue(), getUnit(), targetUnit); // note: possible precision loss
-    else
-        return UnitConversion::convertUnit(doubleValue(), getUnit(), targetUnit); // OK for DOUBLE, error for all others
+    double d = getType() == INT ? (double)intValue() : doubleValue(); // note: possible precision loss for INT; error for non-numeric types
+    if (UnitConversion::tryConvertLinear(d, p->getUnitId(), UnitConversion::getUnitId(targetUnit)))
+        return d;
+    return UnitConversion::convertUnit(d, getUnit(), targetUnit);
 }
 
 const char *cPar::getUnit() const
@@ -16,6 +16,7 @@
 
 #include <sstream>
 #include "common/stringutil.h"
+#include "common/unitconversion.h"
 #include "omnetpp/cparimpl.h"
 #include "omnetpp/cproperties.h"
 #include "omnetpp/ccomponent.h"
@@ -58,6 +59,12 @@ void cParImpl::copy(const cParImpl& other)
     sourceLoc = other.sourceLoc;
 }
 
+void cParImpl::setUnit(const char *s)
+{
+    unit = s;
+    unitId = UnitConversion::getUnitId(s);
+}
+
 cParImpl& cParImpl::operator=(const cParImpl& other)
 {
     bool shared = isShared();
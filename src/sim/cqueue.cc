@@ -61,6 +61,7 @@ cQueue::cQueue(const char *name, CompareFunc cmp) : cOwnedObject(name),
 cQueue::~cQueue()
 {
     clear();
+    delete[] elems;
     delete comparator;
 }
 
@@ -75,8 +76,8 @@ std::string cQueue::str() const
 
 void cQueue::forEachChild(cVisitor *v)
 {
-    for (QElem *p = frontp; p != nullptr; p = p->next)
-        if (!v->visit(p->obj))
+    for (int i = 0; i < len; i++)
+        if (!v->visit(at(i)))
             return;
 }
 
@@ -108,32 +109,32 @@ void cQueue::parsimUnpack(cCommBuffer *buffer)
 #else
     cOwnedObject::parsimUnpack(buffer);
 
-    buffer->unpack(len);
+    int n;
+    buffer->unpack(n);
 
     Comparator *oldCmp = comparator;
     comparator = nullptr;  // temporarily, so that insert() keeps the original order
-    for (int i = 0; i < len; i++) {
+    for (int i = 0; i < n; i++) {
         cObject *obj = buffer->unpackObject();
         insert(obj);
     }
     comparator = oldCmp;
+    unsorted = comparator && !isSorted();
 #endif
 }
 
 void cQueue::clear()
 {
-    while (frontp) {
-        QElem *tmp = frontp->next;
-        cObject *obj = frontp->obj;
+    for (int i = 0; i < len; i++) {
+        cObject *obj = at(i);
         if (!obj->isOwnedObject())
             delete obj;
         else if (obj->getOwner() == this)
             dropAndDelete(static_cast<cOwnedObject *>(obj));
-        delete frontp;
-        frontp = tmp;
     }
-    backp = nullptr;
+    head = 0;
     len = 0;
+    unsorted = false;
 }
 
 void cQueue::copy(const cQueue& queue)
@@ -158,6 +159,7 @@ void cQueue::copy(const cQueue& queue)
     takeOwnership = queue.takeOwnership;
     if (queue.comparator)
         comparator = queue.comparator->dup();
+    unsorted = queue.unsorted;
 }
 
 cQueue& cQueue::operator=(const cQueue& queue)
@@ -174,6 +176,7 @@ void cQueue::setup(Comparator *cmp)
 {
     delete comparator;
     comparator = cmp;
+    unsorted = comparator && !isSorted();
 }
 
 void cQueue::setup(CompareFunc cmp)
@@ -181,58 +184,94 @@ void cQueue::setup(CompareFunc cmp)
     setup(cmp ? new FunctionBasedComparator(cmp) : nullptr);
 }
 
-cQueue::QElem *cQueue::find_qelem(cObject *obj) const
+void cQueue::grow()
 {
-    QElem *p = frontp;
-    while (p && p->obj != obj)
-        p = p->next;
-    return p;
+    int newCapacity = capacity == 0 ? 16 : 2 * capacity;
+    cObject **newElems = new cObject *[newCapacity];
+    for (int i = 0; i < len; i++)
+        newElems[i] = at(i);
+    delete[] elems;
+    elems = newElems;
+    capacity = newCapacity;
+    head = 0;
 }
 
-void cQueue::insbefore_qelem(QElem *p, cObject *obj)
+int cQueue::find_pos(cObject *obj) const
 {
-    QElem *e = new QElem;
-    e->obj = obj;
-
-    e->prev = p->prev;
-    e->next = p;
-    p->prev = e;
-    if (e->prev)
-        e->prev->next = e;
-    else
-        frontp = e;
-    len++;
+    for (int i = 0; i < len; i++)
+        if (at(i) == obj)
+            return i;
+    return -1;
+}
+
+bool cQueue::isSorted() const
+{
+    for (int i = 1; i < len; i++)
+        if (comparator->less(at(i), at(i-1)))
+            return false;
+    return true;
+}
+
+int cQueue::find_insertion_pos(cObject *obj) const
+{
+    // after all elements that obj is not less than (i.e. after equal ones too);
+    // the common case of inserting at the back costs a single comparison
+    if (len == 0 || !comparator->less(obj, at(len-1)))
+        return len;
+    if (unsorted) {
+        int pos = len-1;
+        while (pos > 0 && comparator->less(obj, at(pos-1)))
+            pos--;
+        return pos;
+    }
+    int lo = 0, hi = len-1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (comparator->less(obj, at(mid)))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return lo;
 }
 
-void cQueue::insafter_qelem(QElem *p, cObject *obj)
+void cQueue::insert_at(int pos, cObject *obj)
 {
-    QElem *e = new QElem;
-    e->obj = obj;
-
-    e->next = p->next;
-    e->prev = p;
-    p->next = e;
-    if (e->next)
-        e->next->prev = e;
-    else
-        backp = e;
+    if (len == capacity)
+        grow();
+
+    // shift the shorter half of the queue to make room
+    if (pos < len / 2) {
+        head = (head - 1) & (capacity - 1);
+        for (int i = 0; i < pos; i++)
+            at(i) = at(i+1);
+    }
+    else {
+        for (int i = len; i > pos; i--)
+            at(i) = at(i-1);
+    }
+    at(pos) = obj;
     len++;
 }
 
-cObject *cQueue::remove_qelem(QElem *p)
+cObject *cQueue::remove_at(int pos)
 {
-    if (p->next)
-        p->next->prev = p->prev;
-    else
-        backp = p->prev;
-    if (p->prev)
-        p->prev->next = p->next;
-    else
-        frontp = p->next;
-
-    cObject *retobj = p->obj;
-    delete p;
+    cObject *retobj = at(pos);
+
+    // close the gap by shifting the shorter half of the queue
+    if (pos < len / 2) {
+        for (int i = pos; i > 0; i--)
+            at(i) = at(i-1);
+        head = (head + 1) & (capacity - 1);
+    }
+    else {
+        for (int i = pos; i < len-1; i++)
+            at(i) = at(i+1);
+    }
     len--;
+    if (len == 0)
+        unsorted = false;
+
     if (retobj->isOwnedObject() && retobj->getOwner() == this)
         drop(static_cast<cOwnedObject *>(retobj));
     return retobj;
@@ -246,27 +285,14 @@ void cQueue::insert(cObject *obj)
     if (obj->isOwnedObject() && getTakeOwnership())
         take(static_cast<cOwnedObject *>(obj));
 
-    if (!backp) {
-        // insert as the only item
-        QElem *e = new QElem;
-        e->obj = obj;
-        e->next = e->prev = nullptr;
-        frontp = backp = e;
-        len = 1;
-    }
-    else if (comparator == nullptr) {
-        insafter_qelem(backp, obj);
-    }
-    else {
-        // priority queue: seek insertion place
-        QElem *p = backp;
-        while (p && comparator->less(obj, p->obj))
-            p = p->prev;
-        if (p)
-            insafter_qelem(p, obj);
-        else
-            insbefore_qelem(frontp, obj);
-    }
+    insert_at(comparator == nullptr ? len : find_insertion_pos(obj), obj);
+}
+
+void cQueue::insert_explicit(int pos, cObject *obj)
+{
+    insert_at(pos, obj);
+    if (comparator && !unsorted)
+        unsorted = (pos > 0 && comparator->less(obj, at(pos-1))) || (pos < len-1 && comparator->less(at(pos+1), obj));
 }
 
 void cQueue::insertBefore(cObject *where, cObject *obj)
@@ -274,13 +300,13 @@ void cQueue::insertBefore(cObject *where, cObject *obj)
     if (!obj)
         throw cRuntimeError(this, "Cannot insert nullptr");
 
-    QElem *p = find_qelem(where);
-    if (!p)
+    int pos = find_pos(where);
+    if (pos == -1)
         throw cRuntimeError(this, "insertBefore(w,o): Object w='%s' not in the queue", where->getName());
 
     if (obj->isOwnedObject() && getTakeOwnership())
         take(static_cast<cOwnedObject *>(obj));
-    insbefore_qelem(p, obj);
+    insert_explicit(pos, obj);
 }
 
 void cQueue::insertAfter(cObject *where, cObject *obj)
@@ -288,41 +314,41 @@ void cQueue::insertAfter(cObject *where, cObject *obj)
     if (!obj)
         throw cRuntimeError(this, "Cannot insert nullptr");
 
-    QElem *p = find_qelem(where);
-    if (!p)
+    int pos = find_pos(where);
+    if (pos == -1)
         throw cRuntimeError(this, "insertAfter(w,o): Object w='%s' not in the queue", where->getName());
 
     if (obj->isOwnedObject() && getTakeOwnership())
         take(static_cast<cOwnedObject *>(obj));
-    insafter_qelem(p, obj);
+    insert_explicit(pos+1, obj);
 }
 
 cObject *cQueue::front() const
 {
-    return frontp ? frontp->obj : nullptr;
+    return len > 0 ? at(0) : nullptr;
 }
 
 cObject *cQueue::back() const
 {
-    return backp ? backp->obj : nullptr;
+    return len > 0 ? at(len-1) : nullptr;
 }
 
 cObject *cQueue::remove(cObject *obj)
 {
-    if (!obj)
+    if (!obj || len == 0)
         return nullptr;
-    QElem *p = find_qelem(obj);
-    if (!p)
+    int pos = at(0) == obj ? 0 : at(len-1) == obj ? len-1 : find_pos(obj);
+    if (pos == -1)
         return nullptr;
-    return remove_qelem(p);
+    return remove_at(pos);
 }
 
 cObject *cQueue::pop()
 {
-    if (!frontp)
+    if (len == 0)
         throw cRuntimeError(this, "pop(): Queue empty");
 
-    return remove_qelem(frontp);
+    return remove_at(0);
 }
 
 int cQueue::getLength() const
@@ -332,15 +358,14 @@ int cQueue::getLength() const
 
 bool cQueue::contains(cObject *obj) const
 {
-    return find_qelem(obj) != nullptr;
+    return find_pos(obj) != -1;
 }
 
 cObject *cQueue::get(int i) const
 {
-    QElem *p = frontp;
-    while (p != nullptr && i > 0)
-        p = p->next, i--;
-    return p ? p->obj : nullptr;
+    if (i < 0 || i >= len)
+        return nullptr;
+    return at(i);
 }
 
 }  // namespace omnetpp
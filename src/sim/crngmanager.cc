@@ -37,6 +37,11 @@ cIRngManager::~cIRngManager()
 {
 }
 
+void cIRngManager::reseed(cConfiguration *cfg)
+{
+    throw cRuntimeError("%s does not support re-seeding RNGs", getClassName());
+}
+
 cRngManager::~cRngManager()
 {
     for (int i = 0; i < numRNGs; i++)
@@ -47,6 +52,8 @@ cRngManager::~cRngManager()
 void cRngManager::configure(cSimulation *simulation, cConfiguration *cfg, int parsimProcId, int parsimNumPartitions)
 {
     this->cfg = cfg;
+    this->parsimProcId = parsimProcId;
+    this->parsimNumPartitions = parsimNumPartitions;
 
     // run RNG self-test on RNG class selected for this run
     std::string rngClass = cfg->getAsString(CFGID_RNG_CLASS);
@@ -68,6 +75,18 @@ void cRngManager::configure(cSimulation *simulation, cConfiguration *cfg, int pa
     }
 }
 
+void cRngManager::reseed(cConfiguration *cfg)
+{
+    if (cfg->getAsInt(CFGID_NUM_RNGS) != numRNGs)
+        throw cRuntimeError("Cannot re-seed RNGs: The new configuration specifies a different number of RNGs");
+
+    // note: RNG objects must stay the same, as components store pointers to them
+    this->cfg = cfg;
+    int seedset = cfg->getAsInt(CFGID_SEED_SET);
+    for (int i = 0; i < numRNGs; i++)
+        rngs[i]->configure(seedset, i, numRNGs, parsimProcId, parsimNumPartitions, cfg);
+}
+
 void cRngManager::configureRNGs(cComponent *component)
 {
     std::string componentFullPath = component->getFullPath();
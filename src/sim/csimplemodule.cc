@@ -37,6 +37,11 @@
 #include "omnetpp/cexception.h"
 #include "omnetpp/platdep/platmisc.h"  // for DEBUG_TRAP
 
+#ifdef WITH_PARSIM
+#include "sim/parsim/cparsimpartition.h"
+#include "sim/parsim/cparsimsynchr.h"
+#endif
+
 using namespace omnetpp::common;
 
 namespace omnetpp {
@@ -478,6 +483,30 @@ void cSimpleModule::sendDirect(cMessage *msg, const SendOptions& options, cGate
         EVCB.endSend(msg);
 }
 
+void cSimpleModule::sendDirectMulticast(cPacket *pkt, const std::vector<SendDirectTarget>& targets)
+{
+    if (pkt == nullptr)
+        throw cRuntimeError("sendDirectMulticast(): Packet pointer is nullptr");
+    if (pkt->getOwner() != this)
+        throwNotOwnerOfMessage("sendDirectMulticast()", pkt);
+
+    if (targets.empty()) {
+        delete pkt;
+        return;
+    }
+
+    // Note: copies share the encapsulated packet with the original (see cPacket
+    // refcounting), so each dup() only copies the outermost packet. The original
+    // must be sent last, as sending modifies it.
+    size_t lastIndex = targets.size() - 1;
+    for (size_t i = 0; i < lastIndex; i++) {
+        const SendDirectTarget& target = targets[i];
+        sendDirect(pkt->dup(), resolveSendDirectOptions(target.propagationDelay, target.duration), target.gate);
+    }
+    const SendDirectTarget& target = targets[lastIndex];
+    sendDirect(pkt, resolveSendDirectOptions(target.propagationDelay, target.duration), target.gate);
+}
+
 void cSimpleModule::throwNotOwnerOfMessage(const char *sendOp, cMessage *msg)
 {
     // try to give a meaningful error message
@@ -581,9 +610,14 @@ cMessage *cSimpleModule::cancelEvent(cMessage *msg)
         if (msg->getArrivalModuleId() != getId())
             throw cRuntimeError("cancelEvent(): Cannot cancel another module's self-message");
 
-        getSimulation()->getFES()->remove(msg);
+        cSimulation *simulation = getSimulation();
+        simulation->getFES()->remove(msg);
         EVCB.messageCancelled(msg);
-        msg->setPreviousEventNumber(getSimulation()->getEventNumber());
+#ifdef WITH_PARSIM
+        if (simulation->isParsimEnabled())
+            simulation->getParsimPartition()->getSynchronizer()->messageCancelled(msg);
+#endif
+        msg->setPreviousEventNumber(simulation->getEventNumber());
     }
 
     return msg;
@@ -58,6 +58,7 @@
 #include "omnetpp/platdep/platmisc.h"  // for DEBUG_TRAP
 #include "sim/netbuilder/cnedloader.h"
 #include "stopwatch.h"
+#include "hwcounters.h"
 
 #ifdef WITH_PARSIM
 #include "omnetpp/ccommbuffer.h"
@@ -104,6 +105,12 @@ Register_GlobalConfigOption(CFGID_ALLOW_OBJECT_STEALING_ON_DELETION, "allow-obje
 Register_GlobalConfigOption(CFGID_DEBUG_STATISTICS_RECORDING, "debug-statistics-recording", CFG_BOOL, "false", "Turns on the printing of debugging information related to statistics recording (`@statistic` properties)");
 Register_GlobalConfigOption(CFGID_PRINT_UNUSED_CONFIG, "print-unused-config", CFG_BOOL, "true", "Enables listing of unused configuration entries after network setup. Note that the reported entries are not necessarily redundant, e.g. they may be needed by modules created dynamically during simulation. It tries to be smart about which entries to report, e.g. entries overridden from a derived section, likely intentionally, are not reported.");
 Register_GlobalConfigOption(CFGID_PRINT_UNUSED_CONFIG_ON_COMPLETION, "print-unused-config-on-completion", CFG_BOOL, "false", "Enables listing of unused configuration entries after the simulation has successfully completed. It tries to be smart about which entries to report, e.g. entries overridden from a derived section, likely intentionally, are not reported.");
+Register_PerRunConfigOption(CFGID_RESULT_RECORDER_FUSION, "result-recorder-fusion", CFG_BOOL, "true", "When a `@statistic` records several simple results (e.g. `count`, `sum`, `mean`, `vector`, `timeavg`) directly from its source, whether to feed those recorders through a single listener instead of subscribing each to the source separately. This makes signal emission cheaper; the recorded results are the same either way.");
+Register_PerRunConfigOption(CFGID_HARDWARE_COUNTERS, "hardware-counters", CFG_BOOL, "false", "Enables sampling CPU hardware performance counters (instructions, cycles, cache misses, branch mispredictions) around the processing of each event, using `perf_event_open()` on Linux. Counts are attributed to the type of the target module (or channel) and to the class of the event; they are reported by Cmdenv at the end of the run, and recorded as scalars of the network module. When the counters are not available (non-Linux OS, no access to the PMU, restrictive `perf_event_paranoid` setting), only event counts are collected. Note that reading the counters adds some overhead to each event.");
+
+#ifdef WITH_PYTHON
+extern cConfigOption *CFGID_PYTHON_MEMOIZE_NED_FUNCTIONS;  // registered in nedpythonfunctions.cc
+#endif
 
 
 #ifdef DEVELOPER_DEBUG
@@ -208,6 +215,7 @@ cSimulation::~cSimulation()
         setActiveSimulation(nullptr);
 
     delete stopwatch;
+    delete hardwareCounters;
 
     delete envir;  // after setActiveSimulation(nullptr), due to objectDeleted() callbacks
 
@@ -328,6 +336,16 @@ void cSimulation::configure(cConfiguration *cfg)
         fingerprint->configure(this, cfg, expectedFingerprints.c_str());
     }
 
+    // hardware performance counters
+    delete hardwareCounters;
+    hardwareCounters = nullptr;
+    if (cfg->getAsBool(CFGID_HARDWARE_COUNTERS)) {
+        hardwareCounters = new HardwareCounters();
+        std::string errorMsg;
+        if (!hardwareCounters->open(errorMsg))
+            getEnvir()->printfmsg("Warning: %s, hardware-counters=true will only count events", errorMsg.c_str());
+    }
+
     // init nextUniqueNumber
     setUniqueNumberRange(0, 0); // =until it wraps
 #ifdef WITH_PARSIM
@@ -354,6 +372,9 @@ void cSimulation::configure(cConfiguration *cfg)
     bool checkParamMutability = cfg->getAsBool(CFGID_PARAMETER_MUTABILITY_CHECK);
     setParameterMutabilityCheck(checkParamMutability);
 
+    bool resultRecorderFusion = cfg->getAsBool(CFGID_RESULT_RECORDER_FUSION);
+    setResultRecorderFusion(resultRecorderFusion);
+
     bool allowObjectStealing = cfg->getAsBool(CFGID_ALLOW_OBJECT_STEALING_ON_DELETION);
     cSoftOwner::setAllowObjectStealing(allowObjectStealing);
 
@@ -716,6 +737,11 @@ void cSimulation::setupNetwork(cModuleType *networkType, cConfiguration *cfg)
 
     StageSwitcher _(this, STAGE_BUILD);
 
+#ifdef WITH_PYTHON
+    getPythonCallStats() = PythonCallStats();
+    getPythonNedFunctionSettings().memoizeResults = getConfig()->getAsBool(CFGID_PYTHON_MEMOIZE_NED_FUNCTIONS);
+#endif
+
     try {
         // set up the network by instantiating the toplevel module
         notifyLifecycleListeners(LF_PRE_NETWORK_SETUP, networkType);
@@ -785,6 +811,38 @@ void cSimulation::callInitialize()
     }
 }
 
+void cSimulation::switchRun(cConfiguration *cfg)
+{
+    checkActive();
+
+    switch (state) {
+        case SIM_NONETWORK: throw cRuntimeError("switchRun(): No network set up");
+        case SIM_NETWORKBUILT: case SIM_INITIALIZED: case SIM_PAUSED: break;
+        case SIM_RUNNING: throw cRuntimeError("switchRun(): Simulation currently running");
+        case SIM_TERMINATED: case SIM_FINISHCALLED: throw cRuntimeError("switchRun(): Simulation already terminated");
+        case SIM_ERROR: throw cRuntimeError("switchRun(): Cannot continue after an error");
+    }
+
+    if (parsim)
+        throw cRuntimeError("switchRun(): Not supported with parallel simulation");
+    if (fingerprint)
+        throw cRuntimeError("switchRun(): Not supported with fingerprint checking");
+
+    this->cfg = cfg;
+    rngManager->reseed(cfg);
+    envir->switchRun(cfg);
+
+    // Counts collected so far belong to the previous run. Also, if this is a
+    // forked process, the counters were opened by the parent and count the
+    // parent's thread only, so they need to be reopened.
+    if (hardwareCounters) {
+        hardwareCounters->clear();
+        std::string errorMsg;
+        if (!hardwareCounters->open(errorMsg))
+            getEnvir()->printfmsg("Warning: %s, hardware-counters=true will only count events", errorMsg.c_str());
+    }
+}
+
 void cSimulation::callFinish()
 {
     checkActive();
@@ -812,6 +870,17 @@ void cSimulation::callFinish()
     try {
         notifyLifecycleListeners(LF_PRE_NETWORK_FINISH);
         systemModule->callFinish();
+        if (hardwareCounters)
+            hardwareCounters->recordScalars(systemModule);
+#ifdef WITH_PYTHON
+        const PythonCallStats& pythonStats = getPythonCallStats();
+        if (pythonStats.numCalls > 0) {
+            systemModule->recordScalar("python:nedFunctionCalls", pythonStats.numCalls);
+            systemModule->recordScalar("python:nedFunctionCacheHits", pythonStats.numCacheHits);
+            systemModule->recordScalar("python:nedFunctionCompilations", pythonStats.numCompilations);
+            systemModule->recordScalar("python:nedFunctionTime", pythonStats.seconds, "s");
+        }
+#endif
         cLogProxy::flushLastLine();
         gotoState(SIM_FINISHCALLED);
         notifyLifecycleListeners(LF_POST_NETWORK_FINISH);
@@ -936,6 +1005,8 @@ void cSimulation::deleteNetwork()
         endSimulationEvent = nullptr;
 
         stopwatch->clear();
+        if (hardwareCounters)
+            hardwareCounters->clear();
     }
     catch (std::exception& e) {
         gotoState(SIM_ERROR);
@@ -1079,6 +1150,16 @@ void cSimulation::executeEvent(cEvent *event)
         DEBUG_TRAP_IF_REQUESTED;  // ABOUT TO PROCESS THE EVENT YOU REQUESTED TO DEBUG -- SELECT "STEP INTO" IN YOUR DEBUGGER
 #endif
 
+    // save what hardware counter data are attributed to, as the event may be deleted during processing
+    const cComponentType *targetType = nullptr;
+    const std::type_info *eventClass = nullptr;
+    if (hardwareCounters) {
+        cComponent *target = dynamic_cast<cComponent *>(event->getTargetObject());
+        targetType = target ? target->getComponentType() : nullptr;
+        eventClass = &typeid(*event);
+        hardwareCounters->beginEvent();
+    }
+
     try {
         event->execute();
     }
@@ -1100,6 +1181,9 @@ void cSimulation::executeEvent(cEvent *event)
     }
     setGlobalContext();
 
+    if (hardwareCounters)
+        hardwareCounters->endEvent(targetType, *eventClass);
+
     // Note: simulation time (as read via simTime() from modules) will be updated
     // in takeNextEvent(), called right before the next executeEvent().
     // Simtime must NOT be updated here, because it would interfere with parallel
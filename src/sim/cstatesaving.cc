@@ -0,0 +1,30 @@
+//==========================================================================
+//  CSTATESAVING.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include "omnetpp/cstatesaving.h"
+
+namespace omnetpp {
+
+OPP_THREAD_LOCAL cStateSaving::UndoLog *cStateSaving::undoLog = nullptr;
+
+cStateSaving::UndoLog *cStateSaving::setUndoLog(UndoLog *log)
+{
+    UndoLog *old = undoLog;
+    undoLog = log;
+    return old;
+}
+
+}  // namespace omnetpp
+
@@ -25,6 +25,7 @@
 #include "common/opp_ctype.h"
 #include "statisticsourceparser.h"
 #include "statisticrecorderparser.h"
+#include "fusedrecorderfilter.h"
 
 namespace omnetpp {
 
@@ -122,9 +123,20 @@ void cStatisticBuilder::doAddResultRecorders(cComponent *component, std::string&
             StatisticSourceParser::checkSignalDeclaration(component, cComponent::getSignalName(signal), checkSignalDecl);
         }
 
-        // add result recorders
-        for (auto & mode : modes)
-            doResultRecorder(source, mode.c_str(), component, statisticName, statisticProperty);
+        // add result recorders; consecutive plain recorders of supported types are grouped
+        // under a FusedRecorderFilter, so that they are fed from one listener
+        bool fusion = component->getSimulation()->getResultRecorderFusion();
+        std::vector<cResultRecorder *> fusibleRecorders;
+        for (auto & mode : modes) {
+            cResultRecorder *recorder = fusion ? createFusibleRecorder(mode.c_str(), component, statisticName, statisticProperty) : nullptr;
+            if (recorder)
+                fusibleRecorders.push_back(recorder);
+            else {
+                doFusedRecorders(source, fusibleRecorders, component, statisticProperty);
+                doResultRecorder(source, mode.c_str(), component, statisticName, statisticProperty);
+            }
+        }
+        doFusedRecorders(source, fusibleRecorders, component, statisticProperty);
     }
 }
 
@@ -236,6 +248,41 @@ void cStatisticBuilder::doResultRecorder(const SignalSource& source, const char
     }
 }
 
+cResultRecorder *cStatisticBuilder::createFusibleRecorder(const char *recordingMode, cComponent *component, const char *statisticName, cProperty *attrsProperty)
+{
+    if (!opp_isvalididentifier(recordingMode))
+        return nullptr;
+    try {
+        cResultRecorder *recorder = cResultRecorderType::get(recordingMode)->create();
+        if (!FusedRecorderFilter::canFuse(recorder)) {
+            delete recorder;
+            return nullptr;
+        }
+        cResultRecorder::Context ctx { component, statisticName, recordingMode, attrsProperty };
+        recorder->init(&ctx);
+        return recorder;
+    }
+    catch (std::exception& e) {
+        throw cRuntimeError("Cannot add statistic '%s' to module %s (NED type: %s): Bad recording mode '%s': %s",
+                statisticName, component->getFullPath().c_str(), component->getNedTypeName(), recordingMode, e.what());
+    }
+}
+
+void cStatisticBuilder::doFusedRecorders(const SignalSource& source, std::vector<cResultRecorder *>& recorders, cComponent *component, cProperty *attrsProperty)
+{
+    if (recorders.size() == 1)
+        source.subscribe(recorders[0]);  // nothing to fuse
+    else if (recorders.size() > 1) {
+        FusedRecorderFilter *fusedFilter = new FusedRecorderFilter();
+        cResultFilter::Context ctx { component, attrsProperty };
+        fusedFilter->init(&ctx);
+        for (cResultRecorder *recorder : recorders)
+            fusedFilter->addDelegate(recorder);
+        source.subscribe(fusedFilter);
+    }
+    recorders.clear();
+}
+
 void cStatisticBuilder::dumpResultRecorders(std::ostream& out, cComponent *component)
 {
     dumpComponentResultRecorders(out, component);
@@ -273,6 +320,13 @@ void cStatisticBuilder::dumpComponentResultRecorders(std::ostream& out, cCompone
 
 void cStatisticBuilder::dumpResultRecorderChain(std::ostream& out, cResultListener *listener, int depth)
 {
+    // FusedRecorderFilter is an implementation detail: list its recorders as if they were subscribed directly
+    if (FusedRecorderFilter *fusedFilter = dynamic_cast<FusedRecorderFilter *>(listener)) {
+        for (auto & delegate : fusedFilter->getDelegates())
+            dumpResultRecorderChain(out, delegate, depth);
+        return;
+    }
+
     std::string indent(4*depth+8, ' ');
     out << indent;
     if (ExpressionFilter *expressionFilter = dynamic_cast<ExpressionFilter *>(listener))
@@ -0,0 +1,495 @@
+//=========================================================================
+//  CTIMINGWHEEL.CC - part of
+//
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//   Member functions of
+//    cTimingWheel : future event set, implemented as hierarchical timing wheel
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <algorithm>
+#include <sstream>
+#include "omnetpp/globals.h"
+#include "omnetpp/cevent.h"
+#include "omnetpp/cconfiguration.h"
+#include "omnetpp/cconfigoption.h"
+#include "omnetpp/cexception.h"
+#include "omnetpp/ctimingwheel.h"
+
+namespace omnetpp {
+
+Register_Class(cTimingWheel);
+
+Register_GlobalConfigOptionU(CFGID_TIMINGWHEEL_RESOLUTION, "timingwheel-resolution", "s", "1us", "When cTimingWheel is selected as FES class: the length of one tick of the timing wheel. Events within the same tick are ordered using a binary heap.");
+Register_GlobalConfigOptionU(CFGID_TIMINGWHEEL_HORIZON, "timingwheel-horizon", "s", "1s", "When cTimingWheel is selected as FES class: events scheduled at most this far ahead are stored in the timing wheel, later ones in a binary heap. The value is rounded up so that the number of ticks is a power of 256.");
+
+#define SLOTBITS     8
+#define NUMSLOTS     (1<<SLOTBITS)
+#define WORDS        (NUMSLOTS/64)   // occupancy bitmap words per level
+#define MAXLEVELS    6
+
+// heapIndex encoding: position (heap index or index within the bucket) plus a tag
+// that tells which part of the data structure the event is in; never equals -1
+#define TAG_FRONT    1
+#define TAG_FAR      2
+#define TAG_WHEEL    3
+#define MKINDEX(pos, tag)    (((pos)<<2)|(tag))
+#define TAGOF(index)         ((index)&3)
+#define POSOF(index)         ((index)>>2)
+
+inline bool operator>(cEvent& a, cEvent& b)
+{
+    return b.shouldPrecede(&a);
+}
+
+inline bool operator<=(cEvent& a, cEvent& b)
+{
+    return !(a > b);
+}
+
+static inline int lowestSetBit(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int i = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+static inline int digitOf(int64_t tick, int level)
+{
+    return (int)(tick >> (SLOTBITS*level)) & (NUMSLOTS-1);
+}
+
+static bool lessBySchedulingOrder(const cEvent *a, const cEvent *b)
+{
+    return a->shouldPrecede(b);
+}
+
+//----
+
+cTimingWheel::cTimingWheel(const char *name, double resolution, double horizon) : cFutureEventSet(name)
+{
+    setParameters(resolution, horizon);
+}
+
+cTimingWheel::cTimingWheel(const cTimingWheel& other) : cFutureEventSet(other)
+{
+    copy(other);
+}
+
+cTimingWheel::~cTimingWheel()
+{
+    clear();
+    delete[] front.items;
+    delete[] far.items;
+}
+
+std::string cTimingWheel::str() const
+{
+    if (isEmpty())
+        return std::string("empty");
+    std::stringstream out;
+    out << "length=" << getLength();
+    return out.str();
+}
+
+void cTimingWheel::forEachChild(cVisitor *v)
+{
+    sort();
+
+    int n = getLength();
+    for (int i = 0; i < n; i++)
+        if (!v->visit(get(i)))
+            return;
+}
+
+void cTimingWheel::clear()
+{
+    for (int i = 1; i <= front.length; i++)
+        dropAndDelete(front.items[i]);
+    front.length = 0;
+
+    for (auto& bucket : buckets) {
+        for (cEvent *event : bucket)
+            dropAndDelete(event);
+        bucket.clear();
+    }
+    std::fill(occupancy.begin(), occupancy.end(), 0);
+    wheelLength = 0;
+    cachedBucket = -1;
+
+    for (int i = 1; i <= far.length; i++)
+        dropAndDelete(far.items[i]);
+    far.length = 0;
+}
+
+void cTimingWheel::copy(const cTimingWheel& other)
+{
+    resolution = other.resolution;
+    horizon = other.horizon;
+    tickSize = other.tickSize;
+    numLevels = other.numLevels;
+    buckets.clear();
+    buckets.resize(numLevels * NUMSLOTS);
+    occupancy.assign(numLevels * WORDS, 0);
+    curTick = other.curTick;
+    insertCount = other.insertCount;
+
+    // duplicate events, keeping their insertion order
+    auto add = [this](const cEvent *event) {
+        cEvent *dupEvent = event->dup();
+        dupEvent->insertOrder = event->insertOrder;
+        take(dupEvent);
+        place(dupEvent);
+    };
+    for (int i = 1; i <= other.front.length; i++)
+        add(other.front.items[i]);
+    for (auto& bucket : other.buckets)
+        for (cEvent *event : bucket)
+            add(event);
+    for (int i = 1; i <= other.far.length; i++)
+        add(other.far.items[i]);
+}
+
+cTimingWheel& cTimingWheel::operator=(const cTimingWheel& other)
+{
+    if (this == &other)
+        return *this;
+    cFutureEventSet::operator=(other);
+    clear();
+    copy(other);
+    return *this;
+}
+
+void cTimingWheel::configure(cSimulation *simulation, cConfiguration *cfg)
+{
+    setParameters(cfg->getAsDouble(CFGID_TIMINGWHEEL_RESOLUTION), cfg->getAsDouble(CFGID_TIMINGWHEEL_HORIZON));
+}
+
+void cTimingWheel::setParameters(double resolution, double horizon)
+{
+    if (!isEmpty())
+        throw cRuntimeError(this, "Cannot change parameters while the FES is not empty");
+    if (!(resolution > 0))
+        throw cRuntimeError(this, "Resolution must be positive");
+    if (!(horizon >= resolution))
+        throw cRuntimeError(this, "Horizon must not be smaller than the resolution");
+    this->resolution = resolution;
+    this->horizon = horizon;
+    tickSize = 0; // the rest is set up on first use, when the simtime scale is surely known
+}
+
+void cTimingWheel::setupWheel()
+{
+    tickSize = std::max(SimTime(resolution).raw(), (int64_t)1);
+
+    double ticks = horizon / resolution;
+    numLevels = 1;
+    while (numLevels < MAXLEVELS && ticks > (double)((int64_t)1 << (SLOTBITS*numLevels)))
+        numLevels++;
+
+    buckets.clear();
+    buckets.resize(numLevels * NUMSLOTS);
+    occupancy.assign(numLevels * WORDS, 0);
+    curTick = 0;
+    cachedBucket = -1;
+}
+
+inline int64_t cTimingWheel::tickOf(const cEvent *event) const
+{
+    return event->getArrivalTime().raw() / tickSize;
+}
+
+void cTimingWheel::place(cEvent *event)
+{
+    int64_t tick = tickOf(event);
+    if (tick <= curTick) {
+        heapInsert(front, TAG_FRONT, event);
+        return;
+    }
+
+    // the level is determined by the most significant digit in which tick differs from curTick
+    uint64_t diff = (uint64_t)(tick ^ curTick);
+    for (int level = 0; level < numLevels; level++) {
+        if ((diff >> (SLOTBITS*(level+1))) == 0) {
+            wheelInsert(level, digitOf(tick, level), event);
+            return;
+        }
+    }
+    heapInsert(far, TAG_FAR, event);
+}
+
+void cTimingWheel::advance()
+{
+    // move the events of the next non-empty tick into front
+    while (front.length == 0) {
+        if (wheelLength == 0) {
+            if (far.length == 0)
+                return;
+
+            // jump to the earliest far event, and move those within the span of the wheel from there
+            curTick = tickOf(far.items[1]);
+            while (far.length > 0 && ((uint64_t)(tickOf(far.items[1]) ^ curTick) >> (SLOTBITS*numLevels)) == 0)
+                place(heapRemove(far, TAG_FAR, 1));
+            continue;
+        }
+
+        // find the earliest non-empty bucket; lower levels hold earlier events.
+        // (Slots up to the current digit are always empty, see place().)
+        int level, slot = -1;
+        for (level = 0; level < numLevels; level++)
+            if ((slot = findOccupiedSlot(level, digitOf(curTick, level) + 1)) != -1)
+                break;
+        ASSERT(slot != -1);
+
+        // advance to the start of that bucket, and redistribute its events into front and the lower levels
+        int shift = SLOTBITS*level;
+        curTick = ((curTick >> (shift+SLOTBITS)) << (shift+SLOTBITS)) | ((int64_t)slot << shift);
+
+        cascadeBuffer.swap(buckets[level * NUMSLOTS + slot]);
+        occupancy[level * WORDS + slot/64] &= ~((uint64_t)1 << (slot%64));
+        wheelLength -= cascadeBuffer.size();
+        cachedBucket = -1;
+        for (cEvent *event : cascadeBuffer)
+            place(event);
+        cascadeBuffer.clear();
+    }
+}
+
+int cTimingWheel::findOccupiedSlot(int level, int from) const
+{
+    const uint64_t *words = &occupancy[level * WORDS];
+    for (int w = from/64; w < WORDS; w++) {
+        uint64_t word = words[w];
+        if (w == from/64)
+            word &= ~(uint64_t)0 << (from%64);
+        if (word != 0)
+            return w*64 + lowestSetBit(word);
+    }
+    return -1;
+}
+
+void cTimingWheel::insert(cEvent *event)
+{
+    if (tickSize == 0)
+        setupWheel();
+
+    take(event);
+    event->insertOrder = insertCount++;
+    place(event);
+}
+
+cEvent *cTimingWheel::peekFirst() const
+{
+    if (front.length == 0)
+        const_cast<cTimingWheel *>(this)->advance();  // only restructures, does not change the contents
+    return front.length != 0 ? front.items[1] : nullptr;
+}
+
+cEvent *cTimingWheel::removeFirst()
+{
+    if (front.length == 0) {
+        advance();
+        if (front.length == 0)
+            return nullptr;
+    }
+    cEvent *event = heapRemove(front, TAG_FRONT, 1);
+    drop(event);
+    event->heapIndex = -1;
+    return event;
+}
+
+void cTimingWheel::putBackFirst(cEvent *event)
+{
+    // note: the event's tick cannot be later than curTick, as it came from front
+    take(event);
+    heapInsert(front, TAG_FRONT, event);
+}
+
+cEvent *cTimingWheel::remove(cEvent *event)
+{
+    // make sure it is really in the FES
+    if (event->heapIndex == -1)
+        return nullptr;
+
+    switch (TAGOF(event->heapIndex)) {
+        case TAG_FRONT: heapRemove(front, TAG_FRONT, POSOF(event->heapIndex)); break;
+        case TAG_FAR: heapRemove(far, TAG_FAR, POSOF(event->heapIndex)); break;
+        case TAG_WHEEL: wheelRemove(event); break;
+        default: ASSERT(false);
+    }
+
+    drop(event);
+    event->heapIndex = -1;
+    return event;
+}
+
+void cTimingWheel::heapInsert(Heap& heap, int tag, cEvent *event)
+{
+    if (++heap.length > heap.capacity) {
+        heap.capacity = heap.capacity == 0 ? 64 : 2*heap.capacity;
+        cEvent **newItems = new cEvent *[heap.capacity+1];
+        for (int i = 1; i <= heap.length-1; i++)
+            newItems[i] = heap.items[i];
+        delete[] heap.items;
+        heap.items = newItems;
+    }
+
+    cEvent **h = heap.items;
+    int i, j;
+    for (j = heap.length; j > 1; j = i) {
+        i = j>>1;
+        if (*h[i] <= *event)  // direction
+            break;
+        (h[j] = h[i])->heapIndex = MKINDEX(j, tag);
+    }
+    (h[j] = event)->heapIndex = MKINDEX(j, tag);
+}
+
+cEvent *cTimingWheel::heapRemove(Heap& heap, int tag, int pos)
+{
+    cEvent **h = heap.items;
+    cEvent *event = h[pos];
+    ASSERT(pos >= 1 && pos <= heap.length && event->heapIndex == MKINDEX(pos, tag));
+
+    // last element will be used to fill the hole
+    cEvent *fill = h[heap.length--];
+    if (pos > heap.length)
+        return event;  // it was the last one
+    int father, out = pos;
+    while ((father = out>>1) != 0 && *h[father] > *fill) {
+        (h[out] = h[father])->heapIndex = MKINDEX(out, tag);  // father is moved down
+        out = father;
+    }
+    (h[out] = fill)->heapIndex = MKINDEX(out, tag);
+
+    // restore heap order below
+    int i = out, j;
+    while ((j = i<<1) <= heap.length) {
+        if (j < heap.length && (*h[j] > *h[j+1]))  // direction
+            j++;
+        if (*h[i] > *h[j]) {  // is change necessary?
+            cEvent *temp = h[j];
+            (h[j] = h[i])->heapIndex = MKINDEX(j, tag);
+            (h[i] = temp)->heapIndex = MKINDEX(i, tag);
+            i = j;
+        }
+        else
+            break;
+    }
+    return event;
+}
+
+void cTimingWheel::heapSort(Heap& heap, int tag)
+{
+    // note: a sorted array is also a valid heap
+    std::sort(heap.items+1, heap.items+1+heap.length, lessBySchedulingOrder);
+    for (int i = 1; i <= heap.length; i++)
+        heap.items[i]->heapIndex = MKINDEX(i, tag);
+}
+
+void cTimingWheel::wheelInsert(int level, int slot, cEvent *event)
+{
+    std::vector<cEvent*>& bucket = buckets[level * NUMSLOTS + slot];
+    event->heapIndex = MKINDEX((int)bucket.size(), TAG_WHEEL);
+    bucket.push_back(event);
+    occupancy[level * WORDS + slot/64] |= (uint64_t)1 << (slot%64);
+    wheelLength++;
+    cachedBucket = -1;
+}
+
+void cTimingWheel::wheelRemove(cEvent *event)
+{
+    // find the bucket the same way as place() did: the bucket an event is in
+    // stays valid while curTick advances, as its bucket would be cascaded before
+    int64_t tick = tickOf(event);
+    ASSERT(tick > curTick);
+    uint64_t diff = (uint64_t)(tick ^ curTick);
+    int level = 0;
+    while ((diff >> (SLOTBITS*(level+1))) != 0)
+        level++;
+    ASSERT(level < numLevels);
+    int slot = digitOf(tick, level);
+
+    std::vector<cEvent*>& bucket = buckets[level * NUMSLOTS + slot];
+    int pos = POSOF(event->heapIndex);
+    ASSERT(pos < (int)bucket.size() && bucket[pos] == event);
+
+    // fill the hole with the last element
+    cEvent *last = bucket.back();
+    bucket[pos] = last;
+    last->heapIndex = MKINDEX(pos, TAG_WHEEL);
+    bucket.pop_back();
+    if (bucket.empty())
+        occupancy[level * WORDS + slot/64] &= ~((uint64_t)1 << (slot%64));
+    wheelLength--;
+    cachedBucket = -1;
+}
+
+cEvent *cTimingWheel::get(int k)
+{
+    if (k < 0)
+        return nullptr;
+
+    // front first, then the wheel, then the far events
+    if (k < front.length)
+        return front.items[k+1];
+    k -= front.length;
+    if (k < wheelLength)
+        return wheelGet(k);
+    k -= wheelLength;
+    if (k < far.length)
+        return far.items[k+1];
+    return nullptr;
+}
+
+cEvent *cTimingWheel::wheelGet(int k)
+{
+    // buckets are visited in increasing time order: by level, then by slot;
+    // the bucket of the previous call is cached, as get(k) is typically called in a loop
+    int b = 0, base = 0;
+    if (cachedBucket != -1 && k >= cachedBase) {
+        b = cachedBucket;
+        base = cachedBase;
+    }
+    for (int n = (int)buckets.size(); b < n; b++) {
+        int size = buckets[b].size();
+        if (k < base + size) {
+            cachedBucket = b;
+            cachedBase = base;
+            return buckets[b][k - base];
+        }
+        base += size;
+    }
+    return nullptr;
+}
+
+void cTimingWheel::sort()
+{
+    heapSort(front, TAG_FRONT);
+    for (auto& bucket : buckets) {
+        std::sort(bucket.begin(), bucket.end(), lessBySchedulingOrder);
+        for (int i = 0; i < (int)bucket.size(); i++)
+            bucket[i]->heapIndex = MKINDEX(i, TAG_WHEEL);
+    }
+    heapSort(far, TAG_FAR);
+}
+
+}  // namespace omnetpp
+
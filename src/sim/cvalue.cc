@@ -14,6 +14,7 @@
 *--------------------------------------------------------------*/
 
 #include <cinttypes>  // PRId64
+#include <atomic>
 #include "common/stringutil.h"
 #include "common/pooledstring.h"
 #include "common/unitconversion.h"
@@ -33,17 +34,87 @@ namespace omnetpp {
 
 const char *cValue::OVERFLOW_MSG = "Integer overflow casting %s to a smaller or unsigned integer type";
 
-void cValue::operator=(const cValue& other)
+struct cValue::StringData
+{
+    std::atomic<int> refCount{1};
+    const std::string s;
+    StringData(const char *s) : s(s) {}
+    StringData(const std::string& s) : s(s) {}
+};
+
+void cValue::releaseString()
+{
+    if (sd && --sd->refCount == 0)
+        delete sd;
+}
+
+void cValue::copyFrom(const cValue& other)
 {
+    // precondition: this object holds nothing that needs to be released
+    switch (other.type) {
+        case UNDEF: break;
+        case BOOL: bl = other.bl; break;
+        case INT: case DOUBLE: num = other.num; unitId = other.unitId; break;
+        case STRING: sd = other.sd; if (sd) ++sd->refCount; break;
+        case POINTER: new (&ptr) any_ptr(other.ptr); break;
+    }
     type = other.type;
-    switch (type) {
+}
+
+void cValue::moveFrom(cValue& other) noexcept
+{
+    // precondition: this object holds nothing that needs to be released
+    switch (other.type) {
         case UNDEF: break;
         case BOOL: bl = other.bl; break;
-        case INT: intv = other.intv; unit = other.unit; break;
-        case DOUBLE: dbl = other.dbl; unit = other.unit; break;
-        case STRING: s = other.s; break;
-        case POINTER: ptr = other.ptr; break;
+        case INT: case DOUBLE: num = other.num; unitId = other.unitId; break;
+        case STRING: sd = other.sd; break;
+        case POINTER: new (&ptr) any_ptr(other.ptr); break;
     }
+    type = other.type;
+    other.type = UNDEF;
+}
+
+void cValue::operator=(const cValue& other)
+{
+    if (this == &other)
+        return;
+    destroy();
+    type = UNDEF;
+    copyFrom(other);
+}
+
+void cValue::operator=(cValue&& other) noexcept
+{
+    if (this == &other)
+        return;
+    destroy();
+    type = UNDEF;
+    moveFrom(other);
+}
+
+void cValue::set(const char *s)
+{
+    // create the new data before releasing the old one, as s may point into it
+    StringData *newData = (s && *s) ? new StringData(s) : nullptr;
+    destroy();
+    type = STRING;
+    sd = newData;
+}
+
+void cValue::set(const std::string& s)
+{
+    StringData *newData = !s.empty() ? new StringData(s) : nullptr;
+    destroy();
+    type = STRING;
+    sd = newData;
+}
+
+const std::string& cValue::stdstringValue() const
+{
+    static const std::string EMPTY;
+    assertType(STRING);
+    return sd ? sd->s : EMPTY;
 }
 
 const char *cValue::getTypeName(Type t)
@@ -71,16 +142,16 @@ intval_t cValue::intValue() const
 {
     if (type != INT)
         cannotCastError(INT);
-    if (!unit.empty())
+    if (!opp_isempty(num.unit))
         throw cRuntimeError("Attempt to use the value '%s' as a dimensionless number", str().c_str());
-    return intv;
+    return num.intv;
 }
 
 intval_t cValue::intValueRaw() const
 {
     if (type != INT)
         cannotCastError(INT);
-    return intv;
+    return num.intv;
 }
 
 inline double safeCastToDouble(intval_t x)
@@ -96,7 +167,7 @@ void cValue::convertToDouble()
 {
     if (type == INT) {
         type = DOUBLE;
-        dbl = safeCastToDouble(intv);
+        num.dbl = safeCastToDouble(num.intv);
     }
     else if (type != DOUBLE)
         cannotCastError(DOUBLE);
@@ -104,14 +175,23 @@ void cValue::convertToDouble()
 
 inline const char *emptyToNone(const char *s) { return (s && *s) ? s : "none"; }
 
+int cValue::getUnitId() const
+{
+    if (unitId == UNITID_UNRESOLVED)
+        unitId = UnitConversion::getUnitId(num.unit);
+    return unitId;
+}
+
 intval_t cValue::intValueInUnit(const char *targetUnit) const
 {
     if (type == INT) {
-        double c = UnitConversion::getConversionFactor(getUnit(), targetUnit);
+        double c = num.unit == targetUnit ? 1 : UnitConversion::getConversionFactor(getUnitId(), UnitConversion::getUnitId(targetUnit));
+        if (c == 0)
+            c = UnitConversion::getConversionFactor(getUnit(), targetUnit); // custom units
         if (c == 1)
-            return intv;
+            return num.intv;
         else if (c > 1 && c == floor(c))
-            return safeMul((intval_t)c, intv);
+            return safeMul((intval_t)c, num.intv);
         else
             throw cRuntimeError("Cannot convert integer from unit %s to %s: no conversion or conversion rate is not integer",
                     emptyToNone(getUnit()), emptyToNone(targetUnit));
@@ -125,43 +205,59 @@ double cValue::doubleValue() const
 {
     if (type != DOUBLE && type != INT)
         cannotCastError(DOUBLE);
-    if (!unit.empty())
+    if (!opp_isempty(num.unit))
         throw cRuntimeError("Attempt to use the value '%s' as a dimensionless number", str().c_str());
-    return type == DOUBLE ? dbl : intv;
+    return type == DOUBLE ? num.dbl : num.intv;
 }
 
 double cValue::doubleValueRaw() const
 {
     if (type == DOUBLE)
-        return dbl;
+        return num.dbl;
     else if (type == INT)
-        return intv;
+        return num.intv;
     else
         cannotCastError(DOUBLE);
 }
 
 double cValue::doubleValueInUnit(const char *targetUnit) const
 {
-    if (type == DOUBLE)
-        return UnitConversion::convertUnit(dbl, unit.c_str(), targetUnit);
-    else if (type == INT)
-        return UnitConversion::convertUnit(safeCastToDouble(intv), unit.c_str(), targetUnit);
-    else
+    if (type != DOUBLE && type != INT)
+        cannotCastError(DOUBLE);
+    double d = type == DOUBLE ? num.dbl : safeCastToDouble(num.intv);
+    if (num.unit == targetUnit || UnitConversion::tryConvertLinear(d, getUnitId(), UnitConversion::getUnitId(targetUnit)))
+        return d;
+    return UnitConversion::convertUnit(d, num.unit, targetUnit); // logarithmic and custom units, errors
+}
+
+double cValue::doubleValueInUnit(const char *targetUnit, int targetUnitId) const
+{
+    if (type != DOUBLE && type != INT)
         cannotCastError(DOUBLE);
+    double d = type == DOUBLE ? num.dbl : safeCastToDouble(num.intv);
+    if (UnitConversion::tryConvertLinear(d, getUnitId(), targetUnitId))
+        return d;
+    return UnitConversion::convertUnit(d, num.unit, targetUnit);
 }
 
 void cValue::convertTo(const char *targetUnit)
 {
     assertType(DOUBLE);
-    dbl = UnitConversion::convertUnit(dbl, unit.c_str(), targetUnit);
-    unit = targetUnit;
+    int targetUnitId = UnitConversion::getUnitId(targetUnit);
+    if (!UnitConversion::tryConvertLinear(num.dbl, getUnitId(), targetUnitId)) {
+        num.dbl = UnitConversion::convertUnit(num.dbl, num.unit, targetUnit);
+        targetUnitId = UNITID_UNRESOLVED;
+    }
+    num.unit = poolUnit(targetUnit);
+    unitId = targetUnitId;
 }
 
 void cValue::setUnit(const char* unit)
 {
     if (type != DOUBLE && type != INT)
         throw cRuntimeError("Cannot set measurement unit on a value of type %s", getTypeName(type));
-    this->unit = unit;
+    num.unit = poolUnit(unit);
+    unitId = UNITID_UNRESOLVED;
 }
 
 bool cValue::containsObject() const
@@ -218,21 +314,21 @@ std::string cValue::str() const
     switch (type) {
         case UNDEF: return "undefined";
         case BOOL: return bl ? "true" : "false";
-        case INT: snprintf(buf, sizeof(buf), "%" PRId64 "%s", (int64_t)intv, opp_nulltoempty(unit.c_str())); return buf;
+        case INT: snprintf(buf, sizeof(buf), "%" PRId64 "%s", (int64_t)num.intv, opp_nulltoempty(num.unit)); return buf;
         case DOUBLE: {
-            if (unit.empty())
-                return opp_dtoa(buf, "%g", dbl);
+            if (opp_isempty(num.unit))
+                return opp_dtoa(buf, "%g", num.dbl);
             else {
-                double value = dbl;
-                const char *displayUnit = unit.c_str();
+                double value = num.dbl;
+                const char *displayUnit = num.unit;
                 if (value < 0.1 || value >= 10000) {
                     displayUnit = UnitConversion::getBestUnit(value, displayUnit);
-                    value = UnitConversion::convertUnit(value, unit.c_str(), displayUnit);
+                    value = UnitConversion::convertUnit(value, num.unit, displayUnit);
                 }
                 return UnitConversion::formatQuantity(value, displayUnit);
             }
         }
-        case STRING: return opp_quotestr(s);
+        case STRING: return opp_quotestr(stdstringValue());
         case POINTER: return ptr.contains<cObject>() ? objectInfo(ptr.get<cObject>()) : ptr.str();
         default: throw cRuntimeError("Internal error: Invalid cValue type");
     }
@@ -246,9 +342,9 @@ bool cValue::operator==(const cValue& other)
     switch (type) {
         case UNDEF: return true;
         case BOOL: return bl == other.bl;
-        case INT: return intv == other.intv && opp_strcmp(unit.c_str(), other.unit.c_str()) == 0;
-        case DOUBLE: return dbl == other.dbl && opp_strcmp(unit.c_str(), other.unit.c_str()) == 0;
-        case STRING: return s == other.s;
+        case INT: return num.intv == other.num.intv && opp_strcmp(num.unit, other.num.unit) == 0;
+        case DOUBLE: return num.dbl == other.num.dbl && opp_strcmp(num.unit, other.num.unit) == 0;
+        case STRING: return sd == other.sd || stdstringValue() == other.stdstringValue();
         case POINTER: return ptr == other.ptr; // same object
         default: throw cRuntimeError("Internal error: Invalid cValue type");
     }
@@ -29,6 +29,7 @@
 #include "omnetpp/cmodule.h"  // for ModNameParamResolver
 #include "omnetpp/platdep/platmisc.h"
 #include "minixpath.h"
+#include "xmlelementindex.h"
 
 using namespace omnetpp::common;
 using namespace omnetpp::internal;
@@ -58,6 +59,7 @@ cXMLElement::~cXMLElement()
 
     while (firstChild)
         delete removeChild(firstChild);
+    delete index;
 }
 
 cXMLElement *cXMLElement::dupTree() const
@@ -92,6 +94,36 @@ void cXMLElement::forEachChild(cVisitor *v)
             return;
 }
 
+XMLElementIndex *cXMLElement::getIndex() const
+{
+    const cXMLElement *top = this;
+    while (top->parent)
+        top = top->parent;
+    if (!top->index) {
+        // note: building the index may expand lazily loaded subtrees (which
+        // invalidates the index), so only store it when it is complete
+        XMLElementIndex *newIndex = new XMLElementIndex(const_cast<cXMLElement *>(top));
+        delete top->index;
+        top->index = newIndex;
+    }
+    return top->index;
+}
+
+void cXMLElement::invalidateIndex()
+{
+    cXMLElement *top = this;
+    while (top->parent)
+        top = top->parent;
+    delete top->index;
+    top->index = nullptr;
+}
+
+void cXMLElement::setName(const char *name)
+{
+    invalidateIndex();
+    cOwnedObject::setName(name);
+}
+
 void cXMLElement::setSourceLocation(const char *fname, int line)
 {
     loc = FileLine(fname, line);
@@ -144,6 +176,7 @@ const char *cXMLElement::getAttribute(const char *name) const
 
 void cXMLElement::setAttribute(const char *name, const char *newValue)
 {
+    invalidateIndex();
     name = opp_nulltoempty(name);
     newValue = opp_nulltoempty(newValue);
     Attr *attr = findAttr(name);
@@ -155,6 +188,7 @@ void cXMLElement::setAttribute(const char *name, const char *newValue)
 
 void cXMLElement::setAttributes(const char **newAttrs)
 {
+    invalidateIndex();
     attrs.clear();
     if (newAttrs)
         for (const char **p = newAttrs; *p; p += 2)
@@ -188,6 +222,8 @@ cXMLElement *cXMLElement::getPreviousSibling() const
 
 void cXMLElement::appendChild(cXMLElement *node)
 {
+    invalidateIndex();
+    node->invalidateIndex();
     if (node->parent)
         node->parent->removeChild(node);
     take(node);
@@ -203,6 +239,8 @@ void cXMLElement::appendChild(cXMLElement *node)
 
 void cXMLElement::insertChildBefore(cXMLElement *where, cXMLElement *node)
 {
+    invalidateIndex();
+    node->invalidateIndex();
     if (node->parent)
         node->parent->removeChild(node);
     take(node);
@@ -218,6 +256,7 @@ void cXMLElement::insertChildBefore(cXMLElement *where, cXMLElement *node)
 
 cXMLElement *cXMLElement::removeChild(cXMLElement *node)
 {
+    invalidateIndex();
     if (node->prevSibling)
         node->prevSibling->nextSibling = node->nextSibling;
     else
@@ -321,6 +360,10 @@ cXMLElement *cXMLElement::getFirstChildWithAttribute(const char *tagName, const
 
 cXMLElement *cXMLElement::getElementById(const char *idAttrValue) const
 {
+    XMLElementIndex *index = getIndex();
+    if (index->getPosition(this) != -1)
+        return index->getElementById(this, idAttrValue);
+
     const char *id = getAttribute("id");
     if (id && !strcmp(id, idAttrValue))
         return const_cast<cXMLElement *>(this);
@@ -14,6 +14,7 @@
 *--------------------------------------------------------------*/
 
 #include "omnetpp/envirext.h"
+#include "omnetpp/cexception.h"
 
 using namespace omnetpp;
 
@@ -27,6 +28,20 @@ void cIOutputVectorManager::lifecycleEvent(SimulationLifecycleEventType eventTyp
     }
 }
 
+void cIOutputVectorManager::switchRun(cConfiguration *cfg)
+{
+    throw cRuntimeError("%s does not support switching to another run", getClassName());
+}
+
+int cIOutputVectorManager::recordMany(void *vechandle, const simtime_t *times, const double *values, int n)
+{
+    int stored = 0;
+    for (int i = 0; i < n; i++)
+        if (record(vechandle, times[i], values[i]))
+            stored++;
+    return stored;
+}
+
 void cIOutputScalarManager::lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details)
 {
     switch (eventType) {
@@ -37,6 +52,11 @@ void cIOutputScalarManager::lifecycleEvent(SimulationLifecycleEventType eventTyp
     }
 }
 
+void cIOutputScalarManager::switchRun(cConfiguration *cfg)
+{
+    throw cRuntimeError("%s does not support switching to another run", getClassName());
+}
+
 void cISnapshotManager::lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details)
 {
     switch (eventType) {
@@ -45,3 +65,8 @@ void cISnapshotManager::lifecycleEvent(SimulationLifecycleEventType eventType, c
         default: break;
     }
 }
+
+void cISnapshotManager::switchRun(cConfiguration *cfg)
+{
+    throw cRuntimeError("%s does not support switching to another run", getClassName());
+}
@@ -0,0 +1,83 @@
+//==========================================================================
+//  FUSEDRECORDERFILTER.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <typeinfo>
+#include "omnetpp/globals.h"
+#include "omnetpp/resultrecorders.h"
+#include "fusedrecorderfilter.h"
+
+namespace omnetpp {
+
+Register_Class(FusedRecorderFilter);
+
+bool FusedRecorderFilter::canFuse(const cResultRecorder *recorder)
+{
+    // note: exact type match, as subclasses may override collect() or receiveSignal()
+    const std::type_info& type = typeid(*recorder);
+    return type == typeid(CountRecorder) || type == typeid(SumRecorder) || type == typeid(MeanRecorder) ||
+           type == typeid(TimeAverageRecorder) || type == typeid(VectorRecorder) || type == typeid(LastValueRecorder) ||
+           type == typeid(MinRecorder) || type == typeid(MaxRecorder) || type == typeid(AverageRecorder);
+}
+
+void FusedRecorderFilter::addDelegate(cResultListener *delegate)
+{
+    cResultRecorder *recorder = dynamic_cast<cResultRecorder *>(delegate);
+    if (!recorder || !canFuse(recorder))
+        throw cRuntimeError("%s: Unsupported delegate type %s", getClassName(), delegate->getClassName());
+    cResultFilter::addDelegate(delegate);
+}
+
+void FusedRecorderFilter::receiveSignal(cResultFilter *prev, simtime_t_cref t, bool b, cObject *details)
+{
+    fire(this, t, (double)b, details);
+}
+
+void FusedRecorderFilter::receiveSignal(cResultFilter *prev, simtime_t_cref t, intval_t l, cObject *details)
+{
+    fire(this, t, (double)l, details);
+}
+
+void FusedRecorderFilter::receiveSignal(cResultFilter *prev, simtime_t_cref t, uintval_t l, cObject *details)
+{
+    fire(this, t, (double)l, details);
+}
+
+void FusedRecorderFilter::receiveSignal(cResultFilter *prev, simtime_t_cref t, double d, cObject *details)
+{
+    fire(this, t, d, details);
+}
+
+void FusedRecorderFilter::receiveSignal(cResultFilter *prev, simtime_t_cref t, const SimTime& v, cObject *details)
+{
+    fire(this, t, v.dbl(), details);
+}
+
+void FusedRecorderFilter::receiveSignal(cResultFilter *prev, simtime_t_cref t, const char *s, cObject *details)
+{
+    fire(this, t, s, details);
+}
+
+void FusedRecorderFilter::receiveSignal(cResultFilter *prev, simtime_t_cref t, cObject *obj, cObject *details)
+{
+    fire(this, t, obj, details);
+}
+
+std::string FusedRecorderFilter::str() const
+{
+    return std::to_string(getNumDelegates()) + " recorders";
+}
+
+}  // namespace omnetpp
+
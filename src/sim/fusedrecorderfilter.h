@@ -0,0 +1,72 @@
+//==========================================================================
+//  FUSEDRECORDERFILTER.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_FUSEDRECORDERFILTER_H
+#define __OMNETPP_FUSEDRECORDERFILTER_H
+
+#include "omnetpp/cresultfilter.h"
+#include "omnetpp/cresultrecorder.h"
+
+namespace omnetpp {
+
+/**
+ * @brief Feeds several built-in result recorders of the same statistic
+ * in one go.
+ *
+ * cStatisticBuilder inserts this filter between the signal source and a group
+ * of plain recorders (count, sum, mean, vector, timeavg, etc.) that would
+ * otherwise be subscribed to the source one by one. Instead of each recorder
+ * going through its own listener dispatch (simulation time lookup, exception
+ * handling) and data type conversion, this is done once for the group, and
+ * the value is passed on to the recorders as double. The recorders remain
+ * the delegates of this filter, so they can be enumerated and inspected as
+ * usual, and they record their results in finish() as before.
+ *
+ * Non-numeric values (strings and objects) are forwarded to the recorders
+ * unchanged, so they are counted or rejected exactly as with a direct
+ * subscription.
+ *
+ * @ingroup Internals
+ */
+class SIM_API FusedRecorderFilter : public cResultFilter
+{
+    protected:
+        virtual void receiveSignal(cResultFilter *prev, simtime_t_cref t, bool b, cObject *details) override;
+        virtual void receiveSignal(cResultFilter *prev, simtime_t_cref t, intval_t l, cObject *details) override;
+        virtual void receiveSignal(cResultFilter *prev, simtime_t_cref t, uintval_t l, cObject *details) override;
+        virtual void receiveSignal(cResultFilter *prev, simtime_t_cref t, double d, cObject *details) override;
+        virtual void receiveSignal(cResultFilter *prev, simtime_t_cref t, const SimTime& v, cObject *details) override;
+        virtual void receiveSignal(cResultFilter *prev, simtime_t_cref t, const char *s, cObject *details) override;
+        virtual void receiveSignal(cResultFilter *prev, simtime_t_cref t, cObject *obj, cObject *details) override;
+
+    public:
+        /**
+         * Returns true if the given recorder can be added to this filter, i.e.
+         * if it is an instance of one of the supported built-in recorder classes
+         * (and not of a subclass of those).
+         */
+        static bool canFuse(const cResultRecorder *recorder);
+
+        /**
+         * Adds a recorder. Only recorders accepted by canFuse() are allowed.
+         */
+        virtual void addDelegate(cResultListener *delegate) override;
+        virtual std::string str() const override;
+};
+
+}  // namespace omnetpp
+
+#endif
+
@@ -0,0 +1,219 @@
+//==========================================================================
+//  HWCOUNTERS.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstring>
+#include <cerrno>
+#include <vector>
+#include <algorithm>
+#include "common/stringutil.h"
+#include "omnetpp/ccomponent.h"
+#include "omnetpp/ccomponenttype.h"
+#include "omnetpp/globals.h"
+#include "hwcounters.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+using namespace omnetpp::common;
+
+namespace omnetpp {
+namespace internal {
+
+#ifdef __linux__
+static struct {
+    uint64_t config;
+    const char *name;
+} counterTable[HardwareCounters::MAX_COUNTERS] = {
+    { PERF_COUNT_HW_INSTRUCTIONS, "instructions" },  // first one is the group leader
+    { PERF_COUNT_HW_CPU_CYCLES, "cycles" },
+    { PERF_COUNT_HW_CACHE_MISSES, "cache-misses" },
+    { PERF_COUNT_HW_BRANCH_MISSES, "branch-misses" },
+};
+
+static int openCounter(uint64_t config, int groupFd)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = (groupFd == -1) ? 1 : 0;  // the whole group is enabled via the leader
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    // count in the calling thread only, on any CPU
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+#endif
+
+bool HardwareCounters::open(std::string& errorMsg)
+{
+    close();
+#ifdef __linux__
+    int leader = openCounter(counterTable[0].config, -1);
+    if (leader == -1) {
+        errorMsg = opp_stringf("perf_event_open() failed: %s", strerror(errno));
+        if (errno == EACCES || errno == EPERM)
+            errorMsg += " (check /proc/sys/kernel/perf_event_paranoid)";
+        return false;
+    }
+    groupFd = leader;
+    fds[0] = leader;
+    counterNames[0] = counterTable[0].name;
+    numCounters = 1;
+
+    // the rest are optional, some CPUs or VMs do not support all of them
+    for (int i = 1; i < MAX_COUNTERS; i++) {
+        int fd = openCounter(counterTable[i].config, leader);
+        if (fd != -1) {
+            fds[numCounters] = fd;
+            counterNames[numCounters] = counterTable[i].name;
+            numCounters++;
+        }
+    }
+
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    if (ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == -1 || !readCounters(startValues)) {
+        errorMsg = opp_stringf("Cannot enable hardware performance counters: %s", strerror(errno));
+        close();
+        return false;
+    }
+    return true;
+#else
+    errorMsg = "Hardware performance counters are only supported on Linux";
+    return false;
+#endif
+}
+
+void HardwareCounters::close()
+{
+#ifdef __linux__
+    for (int i = numCounters-1; i >= 0; i--)
+        ::close(fds[i]);
+#endif
+    groupFd = -1;
+    numCounters = 0;
+}
+
+void HardwareCounters::clear()
+{
+    byComponentType.clear();
+    byEventClass.clear();
+}
+
+bool HardwareCounters::readCounters(uint64_t *values)
+{
+#ifdef __linux__
+    // layout with PERF_FORMAT_GROUP: { nr, values[nr] }
+    uint64_t buf[1 + MAX_COUNTERS];
+    ssize_t n = ::read(groupFd, buf, sizeof(buf));
+    if (n < (ssize_t)sizeof(uint64_t) || buf[0] != (uint64_t)numCounters)
+        return false;
+    std::copy_n(buf + 1, numCounters, values);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void HardwareCounters::add(Counts& counts, const uint64_t *deltas)
+{
+    counts.numEvents++;
+    for (int i = 0; i < numCounters; i++)
+        counts.values[i] += deltas[i];
+}
+
+void HardwareCounters::endEvent(const cComponentType *componentType, const std::type_info& eventClass)
+{
+    uint64_t deltas[MAX_COUNTERS] = {};
+    uint64_t endValues[MAX_COUNTERS];
+    if (startValid && readCounters(endValues))  // otherwise only count the event
+        for (int i = 0; i < numCounters; i++)
+            deltas[i] = endValues[i] - startValues[i];
+
+    add(byComponentType[componentType], deltas);
+    add(byEventClass[&eventClass], deltas);
+}
+
+static std::string getName(const cComponentType *componentType)
+{
+    return componentType ? componentType->getFullName() : "(none)";
+}
+
+static std::string getName(const std::type_info *eventClass)
+{
+    return opp_typename(*eventClass);
+}
+
+template<typename K>
+static std::vector<std::pair<std::string, const HardwareCounters::Counts *>> sortForReport(const std::unordered_map<K, HardwareCounters::Counts>& map)
+{
+    // most expensive first
+    std::vector<std::pair<std::string, const HardwareCounters::Counts *>> result;
+    for (auto& entry : map)
+        result.push_back(std::make_pair(getName(entry.first), &entry.second));
+    std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+        if (a.second->values[0] != b.second->values[0])
+            return a.second->values[0] > b.second->values[0];
+        if (a.second->numEvents != b.second->numEvents)
+            return a.second->numEvents > b.second->numEvents;
+        return a.first < b.first;
+    });
+    return result;
+}
+
+void HardwareCounters::printReport(std::ostream& out) const
+{
+    auto printTable = [&](const char *title, const std::vector<std::pair<std::string, const Counts *>>& rows) {
+        out << "\nHardware counters by " << title << ":\n";
+        for (auto& row : rows) {
+            const Counts& counts = *row.second;
+            out << "  " << row.first << ": " << counts.numEvents << " events";
+            for (int i = 0; i < numCounters; i++)
+                out << ", " << counts.values[i] << " " << counterNames[i]
+                    << " (" << opp_stringf("%.1f", counts.values[i] / (double)counts.numEvents) << "/ev)";
+            out << "\n";
+        }
+    };
+
+    if (numCounters == 0)
+        out << "\nHardware performance counters were not available, reporting event counts only\n";
+    printTable("component type", sortForReport(byComponentType));
+    printTable("event class", sortForReport(byEventClass));
+    out.flush();
+}
+
+void HardwareCounters::recordScalars(cComponent *component) const
+{
+    auto record = [&](const char *kind, const std::string& name, const Counts& counts) {
+        std::string suffix = std::string(":") + kind + "=" + name;
+        component->recordScalar(("hwcounters:events" + suffix).c_str(), (double)counts.numEvents);
+        for (int i = 0; i < numCounters; i++)
+            component->recordScalar((std::string("hwcounters:") + counterNames[i] + suffix).c_str(), (double)counts.values[i]);
+    };
+
+    for (auto& entry : byComponentType)
+        record("componentType", getName(entry.first), entry.second);
+    for (auto& entry : byEventClass)
+        record("eventClass", getName(entry.first), entry.second);
+}
+
+}  // namespace internal
+}  // namespace omnetpp
+
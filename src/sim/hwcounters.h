@@ -0,0 +1,97 @@
+//==========================================================================
+//  HWCOUNTERS.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_HWCOUNTERS_H
+#define __OMNETPP_HWCOUNTERS_H
+
+#include <cstdint>
+#include <string>
+#include <ostream>
+#include <typeinfo>
+#include <unordered_map>
+#include "omnetpp/simkerneldefs.h"
+
+namespace omnetpp {
+
+class cComponent;
+class cComponentType;
+
+namespace internal {
+
+/**
+ * Internal class for sampling CPU hardware performance counters (instructions,
+ * cycles, cache misses, branch mispredictions) around the processing of each
+ * event, and attributing them to the type of the target component and the
+ * class of the event. Uses perf_event_open() on Linux. When the counters
+ * cannot be opened (other OS, no PMU in the VM, perf_event_paranoid setting),
+ * only the number of events is collected.
+ */
+class SIM_API HardwareCounters
+{
+  public:
+    enum { MAX_COUNTERS = 4 };
+
+    struct Counts {
+        uint64_t numEvents = 0;
+        uint64_t values[MAX_COUNTERS] = {};
+    };
+
+  private:
+    int groupFd = -1;   // group leader; -1 if counters are not available
+    int fds[MAX_COUNTERS];
+    const char *counterNames[MAX_COUNTERS];
+    int numCounters = 0;
+    uint64_t startValues[MAX_COUNTERS];
+    bool startValid = false;  // whether startValues were read for the current event
+
+    std::unordered_map<const cComponentType *, Counts> byComponentType;
+    std::unordered_map<const std::type_info *, Counts> byEventClass;
+
+  private:
+    bool readCounters(uint64_t *values);
+    void add(Counts& counts, const uint64_t *deltas);
+
+  public:
+    HardwareCounters() {}
+    ~HardwareCounters() {close();}
+
+    /**
+     * Opens the counters. Returns false and fills in errorMsg if they are not
+     * available; event counts are still collected in that case.
+     */
+    bool open(std::string& errorMsg);
+    void close();
+    bool isOpen() const {return groupFd != -1;}
+    void clear();  // clear collected counts
+
+    int getNumCounters() const {return numCounters;}
+    const char *getCounterName(int k) const {return counterNames[k];}
+
+    // to be called immediately before and after processing an event
+    void beginEvent() {startValid = groupFd != -1 && readCounters(startValues);}
+    void endEvent(const cComponentType *componentType, const std::type_info& eventClass);
+
+    const std::unordered_map<const cComponentType *, Counts>& getCountsByComponentType() const {return byComponentType;}
+    const std::unordered_map<const std::type_info *, Counts>& getCountsByEventClass() const {return byEventClass;}
+
+    void printReport(std::ostream& out) const;
+    void recordScalars(cComponent *component) const;
+};
+
+}  // namespace internal
+}  // namespace omnetpp
+
+#endif
+
@@ -17,17 +17,22 @@
 *--------------------------------------------------------------*/
 
 #include <cstring>
+#include <algorithm>
+#include <unordered_map>
 #include "common/opp_ctype.h"
 #include "common/stringutil.h"
 #include "omnetpp/cexception.h"
 #include "omnetpp/platdep/platmisc.h"
 #include "minixpath.h"
+#include "xmlelementindex.h"
 
 using namespace omnetpp::common;
 
 namespace omnetpp {
 namespace internal {
 
+static const size_t MAX_CACHED_EXPRESSIONS = 1000;
+
 MiniXPath::MiniXPath(cXMLElement::ParamResolver *resolver) : resolver(resolver)
 {
 }
@@ -67,10 +72,10 @@ bool MiniXPath::parseBracketedNum(int& n, const char *s, int len)
     return true;
 }
 
-bool MiniXPath::parseConstant(std::string& value, const char *s, int len)
+bool MiniXPath::parseConstant(std::string& value, std::string& paramName, const char *s, int len)
 {
     // we get the part after the equal sign in "[@attrname=...]", try to
-    // match 'value', "value" or $PARAM
+    // match 'value', "value" or $PARAM; parameters are resolved at match time
     const char *end = s+len;
     trim(s, end);
     if (*s == '\'' && *(end-1) == '\'') {
@@ -81,13 +86,14 @@ bool MiniXPath::parseConstant(std::string& value, const char *s, int len)
         value.assign(s+1, end-s-2);
         return true;
     }
-    else if (*s == '$' && resolver != nullptr) {
-        return resolver->resolve(std::string(s+1, end-s-1).c_str(), value);
+    else if (*s == '$') {
+        paramName.assign(s+1, end-s-1);
+        return true;
     }
     return false;
 }
 
-bool MiniXPath::parseBracketedAttrEquals(std::string& attr, std::string& value, const char *s, int len)
+bool MiniXPath::parseBracketedAttrEquals(std::string& attr, std::string& value, std::string& paramName, const char *s, int len)
 {
     // try to match "[@attrname='value']"
     if (len < 7)
@@ -107,19 +113,7 @@ bool MiniXPath::parseBracketedAttrEquals(std::string& attr, std::string& value,
     const char *endattr = equalsign;
     trim(s, endattr);
     attr.assign(s+1, endattr-s-1);
-    return parseConstant(value, equalsign+1, end-equalsign-1);
-}
-
-cXMLElement *MiniXPath::getFirstSiblingWithAttribute(cXMLElement *firstsibling, const char *tagname, const char *attr, const char *attrvalue)
-{
-    for (cXMLElement *child = firstsibling; child; child = child->getNextSibling()) {
-        if (!tagname || !strcasecmp(child->getTagName(), tagname)) {
-            const char *val = child->getAttribute(attr);
-            if (val && (!attrvalue || !strcmp(val, attrvalue)))
-                return child;
-        }
-    }
-    return nullptr;
+    return parseConstant(value, paramName, equalsign+1, end-equalsign-1);
 }
 
 cXMLElement *MiniXPath::getNthSibling(cXMLElement *firstsibling, const char *tagname, int n)
@@ -132,113 +126,225 @@ cXMLElement *MiniXPath::getNthSibling(cXMLElement *firstsibling, const char *tag
     return nullptr;
 }
 
-cXMLElement *MiniXPath::recursiveMatch(cXMLElement *node, const char *pathexpr)
+void MiniXPath::compileStep(Step& step, const char *stepexpr, int steplen)
+{
+    // might be one of: ".", "..", "*", "*[n]", "*[@attr='value']", "tagname", "tagname[n]", "tagname[@attr='value']"
+    std::string tagname;
+    if (!strncmp(stepexpr, ".", steplen))
+        step.kind = Step::SELF;
+    else if (!strncmp(stepexpr, "..", steplen))
+        step.kind = Step::PARENT;
+    else if (!strncmp(stepexpr, "*", steplen))
+        step.kind = Step::ANY;
+    else if (stepexpr[0] == '*' && parseBracketedNum(step.n, stepexpr+1, steplen-1))
+        step.kind = Step::ANY_NTH;
+    else if (stepexpr[0] == '*' && parseBracketedAttrEquals(step.attr, step.value, step.paramName, stepexpr+1, steplen-1))
+        step.kind = Step::ANY_ATTR;
+    else if (parseTagNameFromStepExpr(tagname, stepexpr, steplen) && steplen == (int)tagname.length())
+        step.kind = Step::TAG;
+    else if (parseTagNameFromStepExpr(tagname, stepexpr, steplen) && parseBracketedNum(step.n, stepexpr+tagname.length(), steplen-tagname.length()))
+        step.kind = Step::TAG_NTH;
+    else if (parseTagNameFromStepExpr(tagname, stepexpr, steplen) && parseBracketedAttrEquals(step.attr, step.value, step.paramName, stepexpr+tagname.length(), steplen-tagname.length()))
+        step.kind = Step::TAG_ATTR;
+    else
+        step.kind = Step::INVALID;  // error is reported when the step is reached
+    step.tagName = opp_trim(tagname);
+}
+
+void MiniXPath::compileSteps(Expression *expr, const char *pathexpr)
+{
+    while (true) {
+        // find end of pattern step
+        const char *sep = strchr(pathexpr, '/');
+        if (!sep)
+            sep = pathexpr+strlen(pathexpr);
+
+        expr->steps.push_back(Step());
+        Step& step = expr->steps.back();
+        step.expr = pathexpr;
+        compileStep(step, pathexpr, sep-pathexpr);
+
+        // separator after the step
+        if (!*sep) {
+            step.next = Step::END;
+            break;
+        }
+        else if (*(sep+1) == '/') {
+            step.next = Step::DESCENDANT;
+            pathexpr = sep+2;
+        }
+        else {
+            step.next = Step::CHILD;
+            pathexpr = sep+1;
+        }
+    }
+}
+
+std::shared_ptr<const MiniXPath::Expression> MiniXPath::compile(const char *pathexpr)
+{
+    static OPP_THREAD_LOCAL std::unordered_map<std::string, std::shared_ptr<const Expression>> cache;
+    auto it = cache.find(pathexpr);
+    if (it != cache.end())
+        return it->second;
+
+    std::shared_ptr<Expression> expr = std::make_shared<Expression>();
+    const char *originalPathexpr = pathexpr;
+    if (pathexpr[0] == '/') {
+        expr->absolute = true;
+
+        // plain "/" or "/." or "/./." doesn't match anything (try with any XPath interpreter)
+        while (pathexpr[0] == '/' && pathexpr[1] == '.' && pathexpr[2] == '/')
+            pathexpr += 2;
+        if (!pathexpr[0] || (pathexpr[0] == '/' && !pathexpr[1]) || (pathexpr[0] == '/' && pathexpr[1] == '.' && !pathexpr[2]))
+            expr->start = Expression::NOTHING;
+        else if (pathexpr[1] == '/') {
+            expr->start = Expression::DESCENDANT;
+            compileSteps(expr.get(), pathexpr+2);
+        }
+        else {
+            expr->start = Expression::CHILD;
+            compileSteps(expr.get(), pathexpr+1);
+        }
+    }
+    else {
+        // plain ".", "./." or "././." matches the context node itself
+        while (pathexpr[0] == '.' && pathexpr[1] == '/' && pathexpr[2] != '/')
+            pathexpr += 2;
+        if (!pathexpr[0])
+            expr->start = Expression::NOTHING;  // plain "./" is nothing
+        else if (pathexpr[0] == '.' && !pathexpr[1])
+            expr->start = Expression::CONTEXT;
+        else {
+            expr->start = Expression::STEP;
+            compileSteps(expr.get(), pathexpr);
+        }
+    }
+
+    if (cache.size() >= MAX_CACHED_EXPRESSIONS)
+        cache.clear();
+    cache[originalPathexpr] = expr;
+    return expr;
+}
+
+const char *MiniXPath::getValue(int stepIndex)
 {
-    cXMLElement *res = matchStep(node, pathexpr);
+    const Step& step = expr->steps[stepIndex];
+    if (step.paramName.empty())
+        return step.value.c_str();
+    if (!isResolved[stepIndex]) {
+        if (resolver == nullptr || !resolver->resolve(step.paramName.c_str(), resolvedValues[stepIndex]))
+            throw cRuntimeError("cXMLElement::getElementByPath(): Invalid path expression '%s'", step.expr.c_str());
+        isResolved[stepIndex] = true;
+    }
+    return resolvedValues[stepIndex].c_str();
+}
+
+cXMLElement *MiniXPath::recursiveMatch(cXMLElement *node, int stepIndex)
+{
+    Step::Kind kind = expr->steps[stepIndex].kind;
+    if (kind == Step::ANY_ATTR || kind == Step::TAG_ATTR)
+        return matchAttrStep(node, stepIndex, true);
+
+    cXMLElement *res = matchStep(node, stepIndex);
     if (res)
         return res;
     for (cXMLElement *child = node->getFirstChild(); child; child = child->getNextSibling()) {
-        res = recursiveMatch(child, pathexpr);
+        res = recursiveMatch(child, stepIndex);
         if (res)
             return res;
     }
     return nullptr;
 }
 
-// handle "/" or "//" at front of pattern
-cXMLElement *MiniXPath::matchSeparator(cXMLElement *node, const char *seppathexpr)
+// handle the separator after the given step: none, "/" or "//"
+cXMLElement *MiniXPath::matchNext(cXMLElement *node, int stepIndex)
 {
-    ASSERT(!*seppathexpr || *seppathexpr == '/');
-    if (!*seppathexpr)
-        return node;  // end of pattern
-    else if (*(seppathexpr+1) == '/')
-        return recursiveMatch(node, seppathexpr+2);  // separator is "//"  -- match in any depth
-    else
-        return matchStep(node, seppathexpr+1);  // separator is "/"  -- match a child
+    switch (expr->steps[stepIndex].next) {
+        case Step::END: return node;  // end of pattern
+        case Step::DESCENDANT: return recursiveMatch(node, stepIndex+1);  // separator is "//"  -- match in any depth
+        case Step::CHILD: return matchStep(node, stepIndex+1);  // separator is "/"  -- match a child
+        default: return nullptr;
+    }
 }
 
 // "node": the current node (".") whose children we'll try to match
-cXMLElement *MiniXPath::matchStep(cXMLElement *node, const char *pathexpr)
+cXMLElement *MiniXPath::matchStep(cXMLElement *node, int stepIndex)
 {
-    // find end of first pattern step
-    const char *sep = strchr(pathexpr, '/');
-    if (!sep)
-        sep = pathexpr+strlen(pathexpr);
+    const Step& step = expr->steps[stepIndex];
+    switch (step.kind) {
+        case Step::SELF:
+            return matchNext(node, stepIndex);
 
-    const char *stepexpr = pathexpr;
-    int steplen = sep-pathexpr;
+        case Step::PARENT:
+            if (node->getParentNode() && node->getParentNode() != docNode)
+                return matchNext(node->getParentNode(), stepIndex);
+            return nullptr;
 
-    // match first pattern step.
-    // might be one of: ".", "..", "*", "tagname", "tagname[n]", "tagname[@attr='value']"
-    int n;
-    std::string tagname, attr, value;
-    if (!strncmp(stepexpr, ".", steplen)) {
-        return matchSeparator(node, sep);
-    }
-    else if (!strncmp(stepexpr, "..", steplen)) {
-        if (node->getParentNode() && node->getParentNode() != docNode)
-            return matchSeparator(node->getParentNode(), sep);
-        return nullptr;
-    }
-    else if (!strncmp(stepexpr, "*", steplen)) {
-        for (cXMLElement *child = node->getFirstChild(); child; child = child->getNextSibling()) {
-            cXMLElement *res = matchSeparator(child, sep);
-            if (res)
-                return res;
-        }
-        return nullptr;
-    }
-    else if (stepexpr[0] == '*' && parseBracketedNum(n, stepexpr+1, steplen-1)) {
-        cXMLElement *nthnode = getNthSibling(node->getFirstChild(), nullptr, n);
-        if (!nthnode)
+        case Step::ANY:
+            for (cXMLElement *child = node->getFirstChild(); child; child = child->getNextSibling()) {
+                cXMLElement *res = matchNext(child, stepIndex);
+                if (res)
+                    return res;
+            }
             return nullptr;
-        return matchSeparator(nthnode, sep);
-    }
-    else if (stepexpr[0] == '*' && parseBracketedAttrEquals(attr, value, stepexpr+1, steplen-1)) {
-        for (cXMLElement *child = getFirstSiblingWithAttribute(node->getFirstChild(), nullptr, attr.c_str(), value.c_str());
-             child;
-             child = getFirstSiblingWithAttribute(child->getNextSibling(), nullptr, attr.c_str(), value.c_str()))
-        {
-            cXMLElement *res = matchSeparator(child, sep);
-            if (res)
-                return res;
-        }
-        return nullptr;
-    }
-    else if (parseTagNameFromStepExpr(tagname, stepexpr, steplen) && steplen == (int)tagname.length()) {
-        tagname = opp_trim(tagname);
-        for (cXMLElement *child = getNthSibling(node->getFirstChild(), tagname.c_str(), 0);
-             child;
-             child = getNthSibling(child->getNextSibling(), tagname.c_str(), 0))
-        {
-            cXMLElement *res = matchSeparator(child, sep);
-            if (res)
-                return res;
+
+        case Step::ANY_NTH:
+        case Step::TAG_NTH: {
+            cXMLElement *nthnode = getNthSibling(node->getFirstChild(), step.kind == Step::TAG_NTH ? step.tagName.c_str() : nullptr, step.n);
+            if (!nthnode)
+                return nullptr;
+            return matchNext(nthnode, stepIndex);
         }
-        return nullptr;
-    }
-    else if (parseTagNameFromStepExpr(tagname, stepexpr, steplen) && parseBracketedNum(n, stepexpr+tagname.length(), steplen-tagname.length())) {
-        tagname = opp_trim(tagname);
-        cXMLElement *nthnode = getNthSibling(node->getFirstChild(), tagname.c_str(), n);
-        if (!nthnode)
+
+        case Step::TAG:
+            for (cXMLElement *child = getNthSibling(node->getFirstChild(), step.tagName.c_str(), 0);
+                 child;
+                 child = getNthSibling(child->getNextSibling(), step.tagName.c_str(), 0))
+            {
+                cXMLElement *res = matchNext(child, stepIndex);
+                if (res)
+                    return res;
+            }
             return nullptr;
-        return matchSeparator(nthnode, sep);
+
+        case Step::ANY_ATTR:
+        case Step::TAG_ATTR:
+            return matchAttrStep(node, stepIndex, false);
+
+        default:
+            throw cRuntimeError("cXMLElement::getElementByPath(): Invalid path expression '%s'", step.expr.c_str());
     }
-    else if (parseTagNameFromStepExpr(tagname, stepexpr, steplen) && parseBracketedAttrEquals(attr, value, stepexpr+tagname.length(), steplen-tagname.length())) {
-        tagname = opp_trim(tagname);
-        for (cXMLElement *child = getFirstSiblingWithAttribute(node->getFirstChild(), tagname.c_str(), attr.c_str(), value.c_str());
-             child;
-             child = getFirstSiblingWithAttribute(child->getNextSibling(), tagname.c_str(), attr.c_str(), value.c_str()))
-        {
-            cXMLElement *res = matchSeparator(child, sep);
-            if (res)
-                return res;
-        }
-        return nullptr;
+}
+
+// Matches "tag[@attr='value']" or "*[@attr='value']" on the children of node
+// (or if descendants==true, on all elements below it, in the same order as
+// recursiveMatch() would visit them), using the element index.
+cXMLElement *MiniXPath::matchAttrStep(cXMLElement *node, int stepIndex, bool descendants)
+{
+    const Step& step = expr->steps[stepIndex];
+    const char *value = getValue(stepIndex);
+    const char *tagName = step.kind == Step::TAG_ATTR ? step.tagName.c_str() : nullptr;
+
+    if (!index)
+        index = node->getIndex();
+    std::vector<cXMLElement *> candidates = index->getDescendantsWithAttribute(node, tagName, step.attr.c_str(), value);
+    if (!descendants) {
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                [node](cXMLElement *e) {return e->getParentNode() != node;}), candidates.end());
     }
-    else {
-        throw cRuntimeError("cXMLElement::getElementByPath(): Invalid path expression '%s'", pathexpr);
+    else if (candidates.size() > 1) {
+        // recursiveMatch() visits parents in document order, and the matching children of each in order
+        std::stable_sort(candidates.begin(), candidates.end(), [this](cXMLElement *a, cXMLElement *b) {
+            return index->getPosition(a->getParentNode()) < index->getPosition(b->getParentNode());
+        });
     }
+
+    for (cXMLElement *child : candidates) {
+        cXMLElement *res = matchNext(child, stepIndex);
+        if (res)
+            return res;
+    }
+    return nullptr;
 }
 
 /* this function is currently unused
@@ -291,33 +397,25 @@ bool MiniXPath::nodeMatchesStepExpr(cXMLElement *node, const char *stepexpr, int
 
 cXMLElement *MiniXPath::matchPathExpression(cXMLElement *contextNode, const char *pathexpr, cXMLElement *documentNode)
 {
+    std::shared_ptr<const Expression> compiled = compile(pathexpr);
+    this->expr = compiled.get();
     this->docNode = documentNode;
-    if (pathexpr[0] == '/') {
-        // we need the document node if path starts with "/"
-        if (documentNode == nullptr)
-            throw cRuntimeError("Mini XPath engine: Cannot evaluate a path starting with '/' "
-                                "if the documentNode optional parameter is not supplied");
-
-        // plain "/" or "/." or "/./." doesn't match anything (try with any XPath interpreter)
-        while (pathexpr[0] == '/' && pathexpr[1] == '.' && pathexpr[2] == '/')
-            pathexpr += 2;
-        if (!pathexpr[0] || (pathexpr[0] == '/' && !pathexpr[1]) || (pathexpr[0] == '/' && pathexpr[1] == '.' && !pathexpr[2]))
-            return nullptr;
+    this->index = nullptr;
+    resolvedValues.assign(expr->steps.size(), std::string());
+    isResolved.assign(expr->steps.size(), false);
 
-        // match
-        return matchSeparator(docNode, pathexpr);
-    }
-    else {
-        // plain ".", "./." or "././." matches the context node itself
-        while (pathexpr[0] == '.' && pathexpr[1] == '/' && pathexpr[2] != '/')
-            pathexpr += 2;
-        if (!pathexpr[0])
-            return nullptr;  // plain "./" is nothing
-        if (pathexpr[0] == '.' && !pathexpr[1])
-            return contextNode;
+    // we need the document node if path starts with "/"
+    if (expr->absolute && documentNode == nullptr)
+        throw cRuntimeError("Mini XPath engine: Cannot evaluate a path starting with '/' "
+                            "if the documentNode optional parameter is not supplied");
 
-        // match
-        return matchStep(contextNode, pathexpr);
+    switch (expr->start) {
+        case Expression::NOTHING: return nullptr;
+        case Expression::CONTEXT: return contextNode;
+        case Expression::STEP: return matchStep(contextNode, 0);
+        case Expression::CHILD: return matchStep(docNode, 0);
+        case Expression::DESCENDANT: return recursiveMatch(docNode, 0);
+        default: return nullptr;
     }
 }
 
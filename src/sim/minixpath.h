@@ -20,30 +20,66 @@
 #ifndef __OMNETPP_MINIXPATH_H
 #define __OMNETPP_MINIXPATH_H
 
+#include <string>
+#include <vector>
+#include <memory>
 #include "omnetpp/cxmlelement.h"
 
 namespace omnetpp {
 namespace internal {
 
+class XMLElementIndex;
+
 /**
  * @brief A minimalistic XPath interpreter.
+ *
+ * Path expressions are compiled into a list of steps on first use, and the
+ * compiled form is cached (per thread). Steps of the form "tag[@attr='value']"
+ * and "*[@attr='value']" are evaluated using the element index of the tree
+ * (see XMLElementIndex), so they do not need to scan child lists.
  */
 class MiniXPath
 {
+  public:
+    struct Step {
+        // ".", "..", "*", "*[n]", "*[@attr='value']", "tag", "tag[n]", "tag[@attr='value']"
+        enum Kind { SELF, PARENT, ANY, ANY_NTH, ANY_ATTR, TAG, TAG_NTH, TAG_ATTR, INVALID } kind = INVALID;
+        enum Next { END, CHILD, DESCENDANT } next = END;  // the separator after the step: none, "/" or "//"
+        std::string tagName;
+        int n = 0;
+        std::string attr, value;
+        std::string paramName;  // if nonempty, value is "$paramName", to be resolved at match time
+        std::string expr;  // the rest of the path expression from this step, for error messages
+    };
+
+    struct Expression {
+        bool absolute = false;  // starts with '/'
+        enum Start { NOTHING, CONTEXT, STEP, CHILD, DESCENDANT } start = NOTHING;
+        std::vector<Step> steps;
+    };
+
   private:
     cXMLElement *docNode; // document node (parent of root element) of the ongoing match
     cXMLElement::ParamResolver *resolver;
+    const Expression *expr; // expression of the ongoing match
+    std::vector<std::string> resolvedValues; // of steps with paramName
+    std::vector<bool> isResolved;
+    XMLElementIndex *index;
 
   private:
-    bool parseTagNameFromStepExpr(std::string& tagname, const char *stepexpr, int len);
-    bool parseBracketedNum(int& n, const char *s, int len);
-    bool parseConstant(std::string& value, const char *s, int len);
-    bool parseBracketedAttrEquals(std::string& attr, std::string& value, const char *s, int len);
-    cXMLElement *getFirstSiblingWithAttribute(cXMLElement *firstsibling, const char *tagname, const char *attr, const char *attrvalue);
+    static bool parseTagNameFromStepExpr(std::string& tagname, const char *stepexpr, int len);
+    static bool parseBracketedNum(int& n, const char *s, int len);
+    static bool parseConstant(std::string& value, std::string& paramName, const char *s, int len);
+    static bool parseBracketedAttrEquals(std::string& attr, std::string& value, std::string& paramName, const char *s, int len);
+    static void compileSteps(Expression *expr, const char *pathexpr);
+    static void compileStep(Step& step, const char *pathexpr, int steplen);
+    static std::shared_ptr<const Expression> compile(const char *pathexpr);
+    const char *getValue(int stepIndex);
     cXMLElement *getNthSibling(cXMLElement *firstsibling, const char *tagname, int n);
-    cXMLElement *recursiveMatch(cXMLElement *node, const char *pathexpr);
-    cXMLElement *matchSeparator(cXMLElement *node, const char *seppathexpr);
-    cXMLElement *matchStep(cXMLElement *node, const char *pathexpr);
+    cXMLElement *recursiveMatch(cXMLElement *node, int stepIndex);
+    cXMLElement *matchNext(cXMLElement *node, int stepIndex);
+    cXMLElement *matchStep(cXMLElement *node, int stepIndex);
+    cXMLElement *matchAttrStep(cXMLElement *node, int stepIndex, bool descendants);
 
   public:
     /**
@@ -65,4 +101,3 @@ class MiniXPath
 
 #endif
 
-
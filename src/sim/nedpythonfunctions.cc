@@ -19,12 +19,17 @@
 #include "omnetpp/cnedfunction.h"
 #include "omnetpp/cexception.h"
 #include "omnetpp/ccomponent.h"
+#include "omnetpp/cconfiguration.h"
+#include "omnetpp/cconfigoption.h"
+#include "omnetpp/regmacros.h"
 
 #ifdef WITH_PYTHON
 
 #include <cstddef>
 #include <string>
 #include <regex>
+#include <chrono>
+#include <unordered_map>
 
 #include "common/stringutil.h"
 #include "omnetpp/cvalue.h"
@@ -41,10 +46,14 @@ using namespace common;
 
 class cComponent;
 
+Register_PerRunConfigOption(CFGID_PYTHON_MEMOIZE_NED_FUNCTIONS, "python-memoize-ned-functions", CFG_BOOL, "false", "Whether to cache the results of the `pyeval()` and `pycode()` NED functions, keyed by the code and the argument values. Only enable it if the Python code in the model is pure, i.e. its result only depends on its arguments (not on the parameters of the context module, random numbers, or any other state). Results that are objects (lists, dictionaries) and calls with object arguments are not cached.");
+
 void nedpythonfunctions_dummy() {} //see util.cc
 
 #ifdef WITH_PYTHON
 
+static const size_t MAX_MEMOIZED_RESULTS = 100000;
+
 static const char *CPP_CONTAINER_UNWRAP_CODE = R"(
 import cppyy
 
@@ -157,17 +166,21 @@ class Accessor:
 // necessary, but see: https://github.com/wlav/cppyy/issues/88
 static PyObject *unwrapCppObject(PyObject *obj)
 {
-    PyObject *globals = PyDict_New();
-    PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins());
-    PyDict_SetItemString(globals, "obj", obj);
-
-    PyRun_String(CPP_CONTAINER_UNWRAP_CODE, Py_file_input, globals, globals);
-    checkPythonException();
-
-    PyObject *compiled = Py_CompileString("unwrap(obj)", "<string>", Py_eval_input);
-    checkPythonException();
+    // the helper code is only run once; the function is kept alive for the lifetime of the process
+    static PyObject *unwrapFunction = nullptr;
+    if (!unwrapFunction) {
+        PyObject *globals = PyDict_New();
+        PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins());
+        Py_XDECREF(PyRun_String(CPP_CONTAINER_UNWRAP_CODE, Py_file_input, globals, globals));
+        checkPythonException();
+        unwrapFunction = PyDict_GetItemString(globals, "unwrap");
+        Py_XINCREF(unwrapFunction);
+        Py_DECREF(globals);
+        if (!unwrapFunction)
+            throw cRuntimeError("Internal error: Helper function unwrap() not found");
+    }
 
-    PyObject *result = PyEval_EvalCode(compiled, globals, globals);
+    PyObject *result = PyObject_CallFunctionObjArgs(unwrapFunction, obj, nullptr);
     checkPythonException();
 
     return result; // may be `None`!
@@ -255,7 +268,7 @@ static PyObject *valueToPyObject(const cValue& val)
 {
     PythonGilLock gilLock;
     switch (val.getType()) {
-        case cValue::UNDEF:   return Py_None;
+        case cValue::UNDEF:   Py_INCREF(Py_None); return Py_None;
         case cValue::BOOL:    return PyBool_FromLong(val.boolValue());
         case cValue::INT:     return PyLong_FromLong(val.intValue());
         case cValue::DOUBLE:  return PyFloat_FromDouble(val.doubleValue());
@@ -263,8 +276,10 @@ static PyObject *valueToPyObject(const cValue& val)
         case cValue::POINTER: {
             cObject *obj = val.objectValue();
 
-            if (!obj)
+            if (!obj) {
+                Py_INCREF(Py_None);
                 return Py_None;
+            }
 
             if (cValueArray *arr = dynamic_cast<cValueArray *>(obj)) {
                 PyObject *list = PyList_New(arr->size());
@@ -310,19 +325,27 @@ static PyObject *makeGlobalsWithAccessor(cComponent *contextComponent)
     PyObject *accessor = sim->getComponentAccessor(cid);
 
     if (accessor == nullptr) {
-        PyRun_String(CPP_CONTAINER_UNWRAP_CODE, Py_file_input, globals, globals);
-        PyRun_String(COMPONENT_WRAPPER_CODE, Py_file_input, globals, globals);
-        checkPythonException();
+        // the helper code is only run once; the class is kept alive for the lifetime of the process
+        static PyObject *accessorClass = nullptr;
+        if (!accessorClass) {
+            PyObject *helperGlobals = PyDict_New();
+            PyDict_SetItemString(helperGlobals, "__builtins__", PyEval_GetBuiltins());
+            Py_XDECREF(PyRun_String(CPP_CONTAINER_UNWRAP_CODE, Py_file_input, helperGlobals, helperGlobals));
+            Py_XDECREF(PyRun_String(COMPONENT_WRAPPER_CODE, Py_file_input, helperGlobals, helperGlobals));
+            checkPythonException();
 
-        PyObject *accessorClass = PyDict_GetItemString(globals, "Accessor");
-        ASSERT(!Py_IsNone(accessorClass));
-        checkPythonException();
+            accessorClass = PyDict_GetItemString(helperGlobals, "Accessor");
+            ASSERT(accessorClass != nullptr && !Py_IsNone(accessorClass));
+            Py_INCREF(accessorClass);
+            Py_DECREF(helperGlobals);
+        }
 
         PyObject *args = PyTuple_New(1);
         PyTuple_SetItem(args, 0, PyLong_FromVoidPtr(reinterpret_cast<void*>(contextComponent)));
         checkPythonException();
 
         accessor = PyObject_Call(accessorClass, args, nullptr);
+        Py_DECREF(args);
         checkPythonException();
 
         sim->putComponentAccessor(cid, accessor);
@@ -337,6 +360,129 @@ static PyObject *makeGlobalsWithAccessor(cComponent *contextComponent)
     return globals;
 }
 
+// Internal helper. Compiles the given code, or returns it from the cache.
+// Compiled code is kept for the lifetime of the process. Must be called
+// with the GIL held, which also protects the cache.
+static PyObject *getCompiledCode(const std::string& code, int start)
+{
+    static std::unordered_map<std::string, PyObject *> cache;
+    std::string key = (start == Py_eval_input ? "e:" : "f:") + code;
+    auto it = cache.find(key);
+    if (it != cache.end())
+        return it->second;
+
+    PyObject *compiled = Py_CompileString(code.c_str(), "<string>", start);
+    checkPythonException();
+    getPythonCallStats().numCompilations++;
+    cache[key] = compiled;
+    return compiled;
+}
+
+// Internal helper. Converts the arguments of a NED function call into a
+// tuple, for calling the corresponding Python function.
+static PyObject *makeArgsTuple(cValue argv[], int argc)
+{
+    PyObject *args = PyTuple_New(argc-1);
+    for (int i = 1; i < argc; ++i)
+        PyTuple_SetItem(args, i-1, valueToPyObject(argv[i]));
+    return args;
+}
+
+// Internal helper. Memoizes the results of pyeval() and pycode() calls,
+// if enabled in the configuration. The results are stored process-wide,
+// and the cache is protected by the GIL.
+class PythonResultCache
+{
+  private:
+    static std::unordered_map<std::string, cValue> results;
+    std::string key; // empty if not enabled
+
+  public:
+    PythonResultCache(cComponent *contextComponent, const char *functionName, cValue argv[], int argc) {
+        if (!getPythonNedFunctionSettings().memoizeResults)
+            return;
+        for (int i = 0; i < argc; i++)
+            if (argv[i].getType() == cValue::POINTER)
+                return;  // objects with the same string form may differ, and their addresses may be reused
+        key = functionName;
+        for (int i = 0; i < argc; i++) {
+            key += '\0';
+            key += (char)argv[i].getType();
+            switch (argv[i].getType()) {
+                case cValue::STRING: key += argv[i].stdstringValue(); break;
+                case cValue::DOUBLE: {
+                    double d = argv[i].doubleValueRaw();  // exact value, as str() rounds
+                    key.append((const char *)&d, sizeof(d));
+                    key += opp_nulltoempty(argv[i].getUnit());
+                    break;
+                }
+                default: key += argv[i].str(); break;
+            }
+        }
+    }
+
+    bool lookup(cValue& result) {
+        if (key.empty())
+            return false;
+        auto it = results.find(key);
+        if (it == results.end())
+            return false;
+        result = it->second;
+        getPythonCallStats().numCacheHits++;
+        return true;
+    }
+
+    void store(const cValue& result) {
+        if (key.empty() || result.getType() == cValue::POINTER)
+            return;  // objects are not shared, as they are owned by the caller
+        if (results.size() >= MAX_MEMOIZED_RESULTS)
+            results.clear();
+        results[key] = result;
+    }
+};
+
+std::unordered_map<std::string, cValue> PythonResultCache::results;
+
+// Internal helper for pycode(): turns the function body into a Python
+// function definition named "fun".
+static std::string translatePycode(std::string code)
+{
+    std::smatch match;
+
+    std::string ident = "([a-zA-Z_][a-zA-Z0-9_]*)";
+    std::string identList = "(" + ident + "(\\s*,\\s*" + ident + ")*)?";
+    std::regex_match(code, match, std::regex("(^\\s*" + identList + "\\s*:\\s*).*"));
+
+    if (match.size() >= 2) {
+        std::string header = match[1];
+        std::string arglist = match[2];
+        if (!std::regex_search(header, std::regex("\\btry\\b"))) {
+            code = code.substr(header.length());
+            code = "def fun(" + arglist + "):\n" + opp_indentlines(code, "    ");
+        }
+    }
+    else {
+        // Using *args, so we don't have to also create a list
+        // inside the argument pack tuple when calling.
+        code = "def fun(*args):\n" + opp_indentlines(code, "    ");
+    }
+    return code;
+}
+
+// Internal helper. Updates the call counters on destruction.
+class PythonCallTimer
+{
+  private:
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  public:
+    ~PythonCallTimer() {
+        PythonCallStats& stats = getPythonCallStats();
+        stats.numCalls++;
+        stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
 #endif // WITH_PYTHON
 
 
@@ -344,34 +490,43 @@ cValue nedf_pyeval(cComponent *contextComponent, cValue argv[], int argc)
 {
 #ifdef WITH_PYTHON
     try {
+        PythonCallTimer timer;
         ensurePythonInterpreter();
+        PythonGilBatch::hold();
         PythonGilLock gilLock;
 
+        PythonResultCache resultCache(contextComponent, "pyeval", argv, argc);
+        cValue value;
+        if (resultCache.lookup(value))
+            return value;
+
         std::string code = argv[0].stringValue();
 
         if (argc > 1)
             code = "lambda " + code;
 
-        PyObject *compiled = Py_CompileString(code.c_str(), "<string>", Py_eval_input);
-        checkPythonException();
+        PyObject *compiled = getCompiledCode(code, Py_eval_input);
 
         PyObject *globals = makeGlobalsWithAccessor(contextComponent);
 
         PyObject *result = PyEval_EvalCode(compiled, globals, globals);
+        Py_DECREF(globals);
         checkPythonException();
 
         if (argc > 1) {
             // in this case, the result is a lambda we should call
-            PyObject *args = PyTuple_New(argc-1);
-
-            for (int i = 1; i < argc; ++i)
-                PyTuple_SetItem(args, i-1, valueToPyObject(argv[i]));
-
-            result = PyObject_Call(result, args, NULL);
+            PyObject *args = makeArgsTuple(argv, argc);
+            PyObject *lambda = result;
+            result = PyObject_Call(lambda, args, NULL);
+            Py_DECREF(args);
+            Py_DECREF(lambda);
             checkPythonException();
         }
 
-        return pyObjectToValue(result);
+        value = pyObjectToValue(result);
+        Py_DECREF(result);
+        resultCache.store(value);
+        return value;
     }
     catch (std::exception& e) {
         throw cRuntimeError("Error evaluating Python expression: %s", e.what());
@@ -385,35 +540,28 @@ cValue nedf_pycode(cComponent *contextComponent, cValue argv[], int argc)
 {
 #ifdef WITH_PYTHON
     try {
+        PythonCallTimer timer;
         ensurePythonInterpreter();
+        PythonGilBatch::hold();
         PythonGilLock gilLock;
 
-        std::string code = argv[0].stringValue();
+        PythonResultCache resultCache(contextComponent, "pycode", argv, argc);
+        cValue value;
+        if (resultCache.lookup(value))
+            return value;
 
-        std::smatch match;
+        // the function definition is compiled once per code string
+        static std::unordered_map<std::string, std::string> functionDefinitions;  // protected by the GIL
+        std::string& code = functionDefinitions[argv[0].stdstringValue()];
+        if (code.empty())
+            code = translatePycode(argv[0].stringValue());
 
-        std::string ident = "([a-zA-Z_][a-zA-Z0-9_]*)";
-        std::string identList = "(" + ident + "(\\s*,\\s*" + ident + ")*)?";
-        std::regex_match(code, match, std::regex("(^\\s*" + identList + "\\s*:\\s*).*"));
-
-        if (match.size() >= 2) {
-            std::string header = match[1];
-            std::string arglist = match[2];
-            if (!std::regex_search(header, std::regex("\\btry\\b"))) {
-                code = code.substr(header.length());
-                code = "def fun(" + arglist + "):\n" + opp_indentlines(code, "    ");
-            }
-        }
-        else {
-            // Using *args, so we don't have to also create a list
-            // inside the argument pack tuple when calling.
-            code = "def fun(*args):\n" + opp_indentlines(code, "    ");
-        }
+        PyObject *compiled = getCompiledCode(code, Py_file_input);
 
         PyObject *globals = makeGlobalsWithAccessor(contextComponent);
 
-        // always returns `None`
-        PyRun_String(code.c_str(), Py_file_input, globals, globals);
+        // defines the function; always returns `None`
+        Py_XDECREF(PyEval_EvalCode(compiled, globals, globals));
         checkPythonException();
 
         PyObject *fun = PyDict_GetItemString(globals, "fun");
@@ -421,15 +569,16 @@ cValue nedf_pycode(cComponent *contextComponent, cValue argv[], int argc)
         if (!fun)
             throw cRuntimeError("Internal error: Defined internal function not found in locals");
 
-        PyObject *args = PyTuple_New(argc-1);
-
-        for (int i = 1; i < argc; ++i)
-            PyTuple_SetItem(args, i-1, valueToPyObject(argv[i]));
-
+        PyObject *args = makeArgsTuple(argv, argc);
         PyObject *result = PyObject_CallObject(fun, args);
+        Py_DECREF(args);
+        Py_DECREF(globals);
         checkPythonException();
 
-        return pyObjectToValue(result);
+        value = pyObjectToValue(result);
+        Py_DECREF(result);
+        resultCache.store(value);
+        return value;
     }
     catch (std::exception& e) {
         throw cRuntimeError("Error executing Python code: %s", e.what());
@@ -439,7 +588,6 @@ cValue nedf_pycode(cComponent *contextComponent, cValue argv[], int argc)
 #endif
 }
 
-
 Define_NED_Function2(nedf_pyeval, "any pyeval(string s, ...)", "python", "evaluates the string as a Python expression; or as if it was a Python lambda, then calls it");
 Define_NED_Function2(nedf_pycode, "any pycode(string s, ...)", "python", "evaluates the string as if it was a Python function body");
 
@@ -0,0 +1,840 @@
+//=========================================================================
+//  COPTIMISTICPROTOCOL.CC - part of
+//
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <algorithm>
+#include <thread>
+#include "omnetpp/cmessage.h"
+#include "omnetpp/cmodule.h"
+#include "omnetpp/csimplemodule.h" // SendOptions
+#include "omnetpp/cenvir.h"
+#include "omnetpp/cconfiguration.h"
+#include "omnetpp/cconfigoption.h"
+#include "omnetpp/ccontextswitcher.h"
+#include "omnetpp/cparsimcomm.h"
+#include "omnetpp/ccommbuffer.h"
+#include "omnetpp/cexception.h"
+#include "omnetpp/cfutureeventset.h"
+#include "omnetpp/cmodelchange.h"
+#include "omnetpp/crng.h"
+#include "omnetpp/crngmanager.h"
+#include "omnetpp/checkandcast.h"
+#include "omnetpp/globals.h"
+#include "omnetpp/regmacros.h"
+#include "coptimisticprotocol.h"
+#include "cparsimpartition.h"
+#include "messagetags.h"
+
+namespace omnetpp {
+
+Register_Class(cOptimisticProtocol);
+
+Register_GlobalConfigOptionU(CFGID_PARSIM_OPTIMISTICPROTOCOL_GVT_INTERVAL, "parsim-optimisticprotocol-gvt-interval", "s", "0.1s", "When `cOptimisticProtocol` is selected as parsim synchronization class: specifies how often (in wall clock time) partition 0 initiates the computation of global virtual time (GVT). GVT computation allows state saved for rolling back events to be discarded, and events that cannot be rolled back (e.g. the end of the simulation) to be executed. When partition 0 is idle, it computes GVT at most this often.");
+extern cConfigOption *CFGID_PARSIM_DEBUG;  // registered in cparsimpartition.cc
+
+cOptimisticProtocol::cOptimisticProtocol() : cParsimProtocolBase()
+{
+}
+
+cOptimisticProtocol::~cOptimisticProtocol()
+{
+    clear();
+}
+
+void cOptimisticProtocol::configure(cSimulation *simulation, cConfiguration *cfg, cParsimPartition *partition)
+{
+    cParsimProtocolBase::configure(simulation, cfg, partition);
+
+    debug = cfg->getAsBool(CFGID_PARSIM_DEBUG);
+
+    double interval = cfg->getAsDouble(CFGID_PARSIM_OPTIMISTICPROTOCOL_GVT_INTERVAL);
+    if (interval <= 0)
+        throw cRuntimeError("cOptimisticProtocol: %s must be positive", CFGID_PARSIM_OPTIMISTICPROTOCOL_GVT_INTERVAL->getName());
+    gvtInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval));
+}
+
+void cOptimisticProtocol::startRun()
+{
+    EV << "starting Optimistic Protocol...\n";
+
+    clear();
+
+    // coroutines cannot be rolled back
+    for (int id = 0; id <= sim->getLastComponentId(); id++) {
+        cSimpleModule *mod = dynamic_cast<cSimpleModule *>(sim->getComponent(id));
+        if (mod && mod->usesActivity())
+            throw cRuntimeError("cOptimisticProtocol: Module %s uses activity(), which is not supported "
+                                "with optimistic synchronization", mod->getFullPath().c_str());
+    }
+
+    // RNGs are rolled back by restoring saved copies
+    cRngManager *rngManager = dynamic_cast<cRngManager *>(sim->getRngManager());
+    if (!rngManager)
+        throw cRuntimeError("cOptimisticProtocol: The RNG manager must be a cRngManager");
+    for (int i = 0; i < rngManager->getNumRNGs(); i++) {
+        RngHistory history;
+        history.rng = rngManager->getRNG(i);
+        rngHistories.push_back(history);
+    }
+
+    gvt = SIMTIME_ZERO;
+    epoch = 0;
+    minSentTime = SIMTIME_MAX;
+    lastGvtTime = Clock::now();
+
+    // track deletion of delivered messages, and record module state changes
+    chainedObserver = cOwnedObject::setObserver(this);
+    cStateSaving::setUndoLog(&undoLog);
+
+    // modules must not be created or deleted while events may be rolled back
+    sim->getSystemModule()->subscribe(PRE_MODEL_CHANGE, this);
+
+    EV << "  setup done.\n";
+}
+
+void cOptimisticProtocol::endRun()
+{
+    EV << "Optimistic Protocol: " << numRollbacks << " rollbacks, " << numRolledBackEvents
+       << " events rolled back, " << numAntiMessages << " anti-messages sent\n";
+    clear();
+}
+
+void cOptimisticProtocol::clear()
+{
+    if (cStateSaving::getUndoLog() == &undoLog)
+        cStateSaving::setUndoLog(nullptr);
+    if (cOwnedObject::getObserver() == this)
+        cOwnedObject::setObserver(chainedObserver);
+    chainedObserver = nullptr;
+    unsubscribeAll();
+
+    for (ProcessedEvent& event : processed) {
+        delete event.copy;
+        for (SentMessage& sent : event.sentMessages)
+            dropAndDelete(sent.msg);
+        for (CancelledMessage& cancelled : event.cancelledMessages)
+            delete cancelled.copy;
+    }
+    processed.clear();
+    inRecordedEvent = false;
+    undoLog.clear();
+    undoLogBase = 0;
+    for (RngHistory& history : rngHistories)
+        for (auto& state : history.states)
+            delete state.second;
+    rngHistories.clear();
+    deliveredMessages.clear();
+    cancellingEvents.clear();
+
+    remoteMessages.clear();
+    remoteMessageKeys.clear();
+    processedRemoteMessages.clear();
+    pendingAntiMessages.clear();
+
+    sentCounts.clear();
+    receivedCounts.clear();
+    gvtRoundInProgress = false;
+
+    numRollbacks = numRolledBackEvents = numAntiMessages = 0;
+}
+
+void cOptimisticProtocol::processOutgoingMessage(cMessage *msg, const SendOptions& options, int destProcId, int destModuleId, int destGateId, void *)
+{
+    simtime_t t = msg->getArrivalTime();
+    if (t < minSentTime)
+        minSentTime = t;
+    sentCounts[epoch]++;
+
+    int64_t serial = nextMessageSerial++;
+    if (inRecordedEvent) {
+        take(msg);  // tells cProxyGate not to delete it
+        processed.back().sentMessages.push_back(SentMessage {destProcId, serial, t, msg});
+    }
+
+    {if (debug) EV << "sending '" << msg->getName() << "' to " << destProcId << ", serial=" << serial << "\n";}
+
+    cCommBuffer *buffer = comm->createCommBuffer();
+    buffer->pack(epoch);
+    buffer->pack(serial);
+    buffer->pack(destModuleId);
+    buffer->pack(destGateId);
+    packOptions(buffer, options);
+    buffer->packObject(msg);
+    comm->send(buffer, TAG_OPTIMISTIC_CMESSAGE, destProcId);
+    comm->recycleCommBuffer(buffer);
+}
+
+void cOptimisticProtocol::processReceivedBuffer(cCommBuffer *buffer, int tag, int sourceProcId)
+{
+    switch (tag) {
+        case TAG_OPTIMISTIC_CMESSAGE: {
+            int msgEpoch;
+            int64_t serial;
+            int destModuleId;
+            int destGateId;
+            buffer->unpack(msgEpoch);
+            buffer->unpack(serial);
+            buffer->unpack(destModuleId);
+            buffer->unpack(destGateId);
+            SendOptions options = unpackOptions(buffer);
+            cMessage *msg = (cMessage *)buffer->unpackObject();
+            receivedCounts[msgEpoch]++;
+            processReceivedRemoteMessage(msg, options, destModuleId, destGateId, sourceProcId, serial);
+            break;
+        }
+
+        case TAG_ANTIMESSAGE: {
+            int msgEpoch;
+            int64_t serial;
+            buffer->unpack(msgEpoch);
+            buffer->unpack(serial);
+            receivedCounts[msgEpoch]++;
+            processAntiMessage(RemoteMessageKey(sourceProcId, serial));
+            break;
+        }
+
+        case TAG_GVT_START: {
+            int e;
+            buffer->unpack(e);
+            enterEpoch(e);
+            sendGvtReport();
+            break;
+        }
+
+        case TAG_GVT_CONTINUE: {
+            int e;
+            buffer->unpack(e);
+            ASSERT(e == epoch);
+            sendGvtReport();
+            break;
+        }
+
+        case TAG_GVT_REPORT: {
+            int64_t sent, received;
+            simtime_t localMin;
+            buffer->unpack(sent);
+            buffer->unpack(received);
+            buffer->unpack(localMin);
+            processGvtReport(sent, received, localMin);
+            break;
+        }
+
+        case TAG_GVT_VALUE: {
+            simtime_t newGvt;
+            buffer->unpack(newGvt);
+            gvtComputed(newGvt);
+            break;
+        }
+
+        default: {
+            partition->processReceivedBuffer(buffer, tag, sourceProcId);
+            break;
+        }
+    }
+    buffer->assertBufferEmpty();
+}
+
+void cOptimisticProtocol::processReceivedRemoteMessage(cMessage *msg, const SendOptions& options, int destModuleId, int destGateId, int sourceProcId, int64_t serial)
+{
+    RemoteMessageKey key(sourceProcId, serial);
+    if (pendingAntiMessages.erase(key)) {
+        {if (debug) EV << "message '" << msg->getName() << "' from " << sourceProcId << " annihilated by its anti-message\n";}
+        delete msg;
+        return;
+    }
+
+    simtime_t t = msg->getArrivalTime();
+    if (t < gvt)
+        throw cRuntimeError("cOptimisticProtocol: Message \"%s\" from partition %d has timestamp %s, earlier than GVT=%s",
+                msg->getName(), sourceProcId, SIMTIME_STR(t), SIMTIME_STR(gvt));
+
+    if (t < sim->getSimTime()) {
+        {if (debug) EV << "straggler message '" << msg->getName() << "' from " << sourceProcId << " at t=" << t << "\n";}
+        rollbackToTime(t);
+    }
+
+    remoteMessages[key] = msg;
+    remoteMessageKeys[msg] = key;
+    cParsimProtocolBase::processReceivedMessage(msg, options, destModuleId, destGateId, sourceProcId);
+}
+
+void cOptimisticProtocol::processAntiMessage(const RemoteMessageKey& key)
+{
+    auto it = remoteMessages.find(key);
+    if (it == remoteMessages.end()) {
+        auto processedIt = processedRemoteMessages.find(key);
+        if (processedIt == processedRemoteMessages.end()) {
+            // the anti-message overtook its message
+            pendingAntiMessages.insert(key);
+            return;
+        }
+        {if (debug) EV << "anti-message from " << key.first << " for an already processed message\n";}
+        size_t index = processedIt->second - processed.front().seq;
+        rollbackTo(index, processed[index].time);
+        it = remoteMessages.find(key);
+        ASSERT(it != remoteMessages.end());
+    }
+
+    cMessage *msg = it->second;
+    {if (debug) EV << "annihilating message '" << msg->getName() << "' from " << key.first << "\n";}
+    forgetRemoteMessage(msg);
+    sim->getFES()->remove(msg);
+    delete msg;
+}
+
+void cOptimisticProtocol::sendAntiMessage(const SentMessage& sent)
+{
+    if (sent.arrivalTime < minSentTime)
+        minSentTime = sent.arrivalTime;
+    sentCounts[epoch]++;
+    numAntiMessages++;
+
+    cCommBuffer *buffer = comm->createCommBuffer();
+    buffer->pack(epoch);
+    buffer->pack(sent.serial);
+    comm->send(buffer, TAG_ANTIMESSAGE, sent.destProcId);
+    comm->recycleCommBuffer(buffer);
+}
+
+void cOptimisticProtocol::forgetCancellation(cOwnedObject *msg, uint64_t seq)
+{
+    auto it = cancellingEvents.find(msg);
+    if (it != cancellingEvents.end()) {
+        std::vector<uint64_t>& seqs = it->second;
+        seqs.erase(std::find(seqs.begin(), seqs.end(), seq));
+        if (seqs.empty())
+            cancellingEvents.erase(it);
+    }
+}
+
+void cOptimisticProtocol::forgetRemoteMessage(cOwnedObject *msg)
+{
+    auto it = remoteMessageKeys.find(msg);
+    if (it != remoteMessageKeys.end()) {
+        remoteMessages.erase(it->second);
+        remoteMessageKeys.erase(it);
+    }
+}
+
+cEvent *cOptimisticProtocol::takeNextEvent()
+{
+    // the previous event has completed
+    inRecordedEvent = false;
+
+    // look into the mailbox: messages from other partitions may cause rollbacks
+    receiveNonblocking();
+
+    if (comm->getProcId() == 0 && !gvtRoundInProgress && Clock::now() - lastGvtTime >= gvtInterval)
+        startGvtRound();
+
+    cFutureEventSet *fes = sim->getFES();
+    while (true) {
+        cEvent *event = fes->peekFirst();
+        if (!event) {
+            // GVT at infinity means all partitions are out of events, and nothing is in transit
+            if (gvt == SIMTIME_MAX && comm->getProcId() == 0)
+                throw cTerminationException(E_ENDEDOK);
+        }
+        else if (event->isMessage() || event->getArrivalTime() <= gvt) {
+            // messages are executed optimistically; other events cannot be rolled
+            // back (e.g. end of simulation), so they have to wait for GVT
+            break;
+        }
+        if (!waitForProgress())
+            return nullptr;
+    }
+
+    cEvent *event = fes->removeFirst();
+    if (event->isMessage())
+        beginEvent(static_cast<cMessage *>(event));
+    return event;
+}
+
+void cOptimisticProtocol::putBackEvent(cEvent *event)
+{
+    throw cRuntimeError("cOptimisticProtocol: \"Run Until Event/Module\" functionality "
+                        "cannot be used with this scheduler (putBackEvent() not implemented)");
+}
+
+bool cOptimisticProtocol::waitForProgress()
+{
+    if (comm->getProcId() != 0 || gvtRoundInProgress)
+        return receiveBlocking();
+
+    // partition 0 has nothing to do: advance GVT, but do not flood the others with GVT rounds
+    Clock::time_point nextGvtTime = lastGvtTime + gvtInterval;
+    if (Clock::now() < nextGvtTime) {
+        std::this_thread::sleep_until(nextGvtTime);
+        receiveNonblocking();
+    }
+    else {
+        startGvtRound();
+    }
+    return true;
+}
+
+void cOptimisticProtocol::beginEvent(cMessage *msg)
+{
+    ProcessedEvent event;
+    event.seq = nextSeq++;
+    event.eventNumber = sim->getEventNumber() + 1;
+    event.time = msg->getArrivalTime();
+    event.msg = msg;
+    event.previousEventNumber = msg->getPreviousEventNumber();  // must precede privateDup(), which overwrites it
+    event.copy = msg->privateDup();
+    event.firstMessageId = cMessage::getNextMessageId();
+    event.undoPos = undoLogBase + undoLog.size();
+
+    auto remoteIt = remoteMessageKeys.find(msg);
+    if (remoteIt != remoteMessageKeys.end()) {
+        event.isRemote = true;
+        event.remoteKey = remoteIt->second;
+        processedRemoteMessages[remoteIt->second] = event.seq;
+        remoteMessages.erase(remoteIt->second);
+        remoteMessageKeys.erase(remoteIt);
+    }
+
+    // link to the earlier delivery of the same message object, e.g. a reused timer
+    auto deliveredIt = deliveredMessages.find(msg);
+    event.prevDeliverySeq = NO_SEQ;
+    if (deliveredIt != deliveredMessages.end())
+        event.prevDeliverySeq = deliveredIt->second;
+    deliveredMessages[msg] = event.seq;
+
+    saveRngStates(event.seq);
+
+    processed.push_back(std::move(event));
+    inRecordedEvent = true;
+}
+
+void cOptimisticProtocol::rollbackToTime(simtime_t t, bool sendAntiMessages)
+{
+    size_t index = processed.size();
+    while (index > 0 && processed[index-1].time > t)
+        index--;
+    if (index < processed.size())
+        rollbackTo(index, t, sendAntiMessages);
+    else
+        setSimTimeBack(t);  // an earlier rollback left no event to undo after t
+}
+
+void cOptimisticProtocol::rollbackTo(size_t index, simtime_t t, bool sendAntiMessages)
+{
+    ASSERT(index < processed.size() && t <= processed[index].time && t >= gvt);
+    const ProcessedEvent& first = processed[index];
+    uint64_t firstSeq = processed.front().seq;
+    eventnumber_t firstEventNumber = first.eventNumber;
+    msgid_t firstMessageId = first.firstMessageId;
+
+    numRollbacks++;
+    numRolledBackEvents += processed.size() - index;
+    {if (debug) EV << "rolling back " << processed.size() - index << " event(s) to t=" << t << "\n";}
+
+    // remove the events scheduled by the rolled back events from the FES. Messages
+    // created in those events are deleted, older ones are given back to the module that
+    // sent them, so that the modules' undo actions can take them back. (Messages from
+    // other partitions are exempt: those are cancelled by anti-messages.)
+    cFutureEventSet *fes = sim->getFES();
+    std::vector<cEvent *> scheduledEvents;
+    for (int i = 0; i < fes->getLength(); i++) {
+        cEvent *event = fes->get(i);
+        if (event->getPreviousEventNumber() >= firstEventNumber && remoteMessageKeys.find(event) == remoteMessageKeys.end())
+            scheduledEvents.push_back(event);
+    }
+    for (cEvent *event : scheduledEvents) {
+        cMessage *msg = event->isMessage() ? static_cast<cMessage *>(event) : nullptr;
+        cModule *sender = msg ? sim->getModule(msg->getSenderModuleId()) : nullptr;
+        if (sender) {
+            cContextSwitcher tmp(sender);
+            fes->remove(event);
+        }
+        else {
+            fes->remove(event);
+        }
+        if (msg && isCreatedSince(msg, firstMessageId))
+            delete msg;
+    }
+
+    // cancel the messages sent to other partitions, and treat them the same way
+    for (size_t i = index; i < processed.size(); i++) {
+        for (const SentMessage& sent : processed[i].sentMessages) {
+            if (sendAntiMessages)
+                sendAntiMessage(sent);
+            cModule *sender = sim->getModule(sent.msg->getSenderModuleId());
+            if (sender) {
+                cContextSwitcher tmp(sender);
+                drop(sent.msg);
+            }
+            else {
+                drop(sent.msg);
+            }
+            if (isCreatedSince(sent.msg, firstMessageId))
+                delete sent.msg;
+        }
+    }
+
+    setSimTimeBack(t);
+
+    // undo the events in reverse order: run the undo actions of the module, then
+    // put back the message delivered in the event (except if it was sent by a rolled
+    // back event: then it goes back to the sender) and the self-messages cancelled
+    // in the event (except those scheduled by rolled back events)
+    cStateSaving::UndoLog *log = cStateSaving::setUndoLog(nullptr);
+    for (size_t i = processed.size(); i-- > index; ) {
+        ProcessedEvent& event = processed[i];
+        cModule *module = sim->getModule(event.copy->getArrivalModuleId());
+        ASSERT(module);
+
+        // undo actions are module code; e.g. objects they remove from containers must go back to the module
+        {
+            cContextSwitcher tmp(module);
+            while (undoLogBase + undoLog.size() > event.undoPos) {
+                cStateSaving::UndoAction action = std::move(undoLog.back());
+                undoLog.pop_back();
+                action();
+            }
+        }
+
+        if (!event.msgDeleted) {
+            if (event.prevDeliverySeq != NO_SEQ && event.prevDeliverySeq >= firstSeq)
+                deliveredMessages[event.msg] = event.prevDeliverySeq;
+            else
+                deliveredMessages.erase(event.msg);
+        }
+
+        bool sentByRolledBackEvent = event.previousEventNumber >= firstEventNumber && !event.isRemote;
+        if (sentByRolledBackEvent) {
+            cModule *sender = sim->getModule(event.copy->getSenderModuleId());
+            if (!event.msgDeleted && sender && sender != module && event.msg->getOwner() == module) {
+                take(event.msg);
+                cContextSwitcher tmp(sender);
+                drop(event.msg);
+            }
+            delete event.copy;
+        }
+        else {
+            cMessage *msg = reinstateMessage(event.msgDeleted ? nullptr : event.msg, event.copy, module);
+            msg->setPreviousEventNumber(event.previousEventNumber);
+            fes->insert(msg);
+
+            if (event.isRemote) {
+                processedRemoteMessages.erase(event.remoteKey);
+                remoteMessages[event.remoteKey] = msg;
+                remoteMessageKeys[msg] = event.remoteKey;
+            }
+        }
+
+        for (auto it = event.cancelledMessages.rbegin(); it != event.cancelledMessages.rend(); ++it) {
+            CancelledMessage& cancelled = *it;
+            if (!cancelled.msgDeleted)
+                forgetCancellation(cancelled.msg, event.seq);
+            if (cancelled.previousEventNumber >= firstEventNumber) {
+                delete cancelled.copy;
+                continue;
+            }
+            cMessage *msg = reinstateMessage(cancelled.msgDeleted ? nullptr : cancelled.msg, cancelled.copy, module);
+            msg->setPreviousEventNumber(cancelled.previousEventNumber);
+            fes->insert(msg);
+        }
+    }
+    cStateSaving::setUndoLog(log);
+
+    restoreRngStates(first.seq);
+
+    nextSeq = first.seq;  // keep seqs contiguous, they are used as indices into processed[]
+    processed.erase(processed.begin() + index, processed.end());
+    inRecordedEvent = false;
+}
+
+void cOptimisticProtocol::setSimTimeBack(simtime_t t)
+{
+    // the FES may keep the events at the current simulation time apart, assuming
+    // that time does not go backwards: take them out while the time is changed
+    cFutureEventSet *fes = sim->getFES();
+    simtime_t now = sim->getSimTime();
+    std::vector<cEvent *> currentEvents;
+    for (int i = 0; i < fes->getLength(); i++)
+        if (fes->get(i)->getArrivalTime() == now)
+            currentEvents.push_back(fes->get(i));
+    for (cEvent *event : currentEvents)
+        fes->remove(event);
+    sim->setSimTime(t);
+    for (cEvent *event : currentEvents)
+        fes->insert(event);
+}
+
+cMessage *cOptimisticProtocol::reinstateMessage(cMessage *msg, cMessage *copy, cModule *holder)
+{
+    if (msg && msg->isScheduled()) {
+        cContextSwitcher tmp(holder);
+        sim->getFES()->remove(msg);
+    }
+
+    if (msg && msg->getOwner() == holder) {
+        msg->setArrival(copy->getArrivalModuleId(), copy->getArrivalGateId(), copy->getArrivalTime());
+        msg->setSentFrom(sim->getModule(copy->getSenderModuleId()), copy->getSenderGateId(), copy->getSendingTime());
+        msg->setSchedulingPriority(copy->getSchedulingPriority());
+        delete copy;
+        return msg;
+    }
+    else {
+        // the message was deleted, or the module does not hold it any more (it was
+        // stored or passed on without an undo action): use the copy, which is a private
+        // copy, i.e. not part of the ownership tree, so it needs to be turned into a
+        // regular message first
+        cMessage *ret = copy->dup();
+        delete copy;
+        return ret;
+    }
+}
+
+void cOptimisticProtocol::saveRngStates(uint64_t seq)
+{
+    for (RngHistory& history : rngHistories) {
+        if (history.states.empty() || history.rng->getNumbersDrawn() != history.savedNumDrawn) {
+            history.states.push_back(std::make_pair(seq, history.rng->dup()));
+            history.savedNumDrawn = history.rng->getNumbersDrawn();
+        }
+    }
+}
+
+void cOptimisticProtocol::restoreRngStates(uint64_t seq)
+{
+    // the last state saved at or before the given event is the state at the start of that event
+    for (RngHistory& history : rngHistories) {
+        while (!history.states.empty() && history.states.back().first > seq) {
+            delete history.states.back().second;
+            history.states.pop_back();
+        }
+        ASSERT(!history.states.empty());
+        history.rng->restoreState(history.states.back().second);
+        history.savedNumDrawn = history.rng->getNumbersDrawn();
+    }
+}
+
+void cOptimisticProtocol::messageCancelled(cMessage *msg)
+{
+    // outside recorded events (e.g. in initialize()) there is nothing to roll back
+    if (!inRecordedEvent)
+        return;
+    ProcessedEvent& event = processed.back();
+    eventnumber_t previousEventNumber = msg->getPreviousEventNumber();  // privateDup() overwrites it
+    event.cancelledMessages.push_back(CancelledMessage {msg, msg->privateDup(), previousEventNumber});
+    cancellingEvents[msg].push_back(event.seq);
+}
+
+void cOptimisticProtocol::lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details)
+{
+    if (eventType == LF_ON_SIMULATION_SUCCESS) {
+        // the termination time is the simulation time of the partition that
+        // terminated (see cReceivedTerminationException); the other partitions
+        // are terminating as well, so they need no anti-messages. Events before
+        // GVT are committed (e.g. when the simulation ran out of events).
+        cTerminationException *e = check_and_cast<cTerminationException *>(details);
+        simtime_t t = std::max(e->getSimtime(), gvt);
+        inRecordedEvent = false;
+        if (!processed.empty() && processed.back().time > t) {
+            {if (debug) EV << "terminating at t=" << t << ", rolling back the events after it\n";}
+            rollbackToTime(t, false);
+        }
+    }
+    cParsimProtocolBase::lifecycleEvent(eventType, details);
+}
+
+void cOptimisticProtocol::enterEpoch(int e)
+{
+    ASSERT(e == epoch + 1);
+    epoch = e;
+    minSentTime = SIMTIME_MAX;
+}
+
+simtime_t cOptimisticProtocol::getLocalMinimum()
+{
+    cEvent *event = sim->getFES()->peekFirst();
+    simtime_t t = event ? event->getArrivalTime() : SIMTIME_MAX;
+    return t < minSentTime ? t : minSentTime;
+}
+
+void cOptimisticProtocol::sendGvtReport()
+{
+    // report the messages of the previous epoch, and the earliest time we may still affect
+    int64_t sent = sentCounts[epoch-1];
+    int64_t received = receivedCounts[epoch-1];
+    simtime_t localMin = getLocalMinimum();
+
+    if (comm->getProcId() == 0) {
+        processGvtReport(sent, received, localMin);
+        return;
+    }
+
+    cCommBuffer *buffer = comm->createCommBuffer();
+    buffer->pack(sent);
+    buffer->pack(received);
+    buffer->pack(localMin);
+    comm->send(buffer, TAG_GVT_REPORT, 0);
+    comm->recycleCommBuffer(buffer);
+}
+
+void cOptimisticProtocol::startGvtRound()
+{
+    ASSERT(comm->getProcId() == 0 && !gvtRoundInProgress);
+    enterEpoch(epoch + 1);
+    gvtRoundInProgress = true;
+    numReportsPending = comm->getNumPartitions();
+    reportedSent = reportedReceived = 0;
+    reportedMin = SIMTIME_MAX;
+    broadcastGvtControl(TAG_GVT_START, epoch);
+    sendGvtReport();
+}
+
+void cOptimisticProtocol::processGvtReport(int64_t sent, int64_t received, simtime_t localMin)
+{
+    ASSERT(comm->getProcId() == 0 && gvtRoundInProgress);
+    reportedSent += sent;
+    reportedReceived += received;
+    if (localMin < reportedMin)
+        reportedMin = localMin;
+    if (--numReportsPending > 0)
+        return;
+
+    if (reportedSent != reportedReceived) {
+        // some messages of the previous epoch are still in transit: ask for new reports
+        numReportsPending = comm->getNumPartitions();
+        reportedSent = reportedReceived = 0;
+        reportedMin = SIMTIME_MAX;
+        broadcastGvtControl(TAG_GVT_CONTINUE, epoch);
+        sendGvtReport();
+        return;
+    }
+
+    gvtRoundInProgress = false;
+    lastGvtTime = Clock::now();
+
+    cCommBuffer *buffer = comm->createCommBuffer();
+    buffer->pack(reportedMin);
+    comm->broadcast(buffer, TAG_GVT_VALUE);
+    comm->recycleCommBuffer(buffer);
+
+    gvtComputed(reportedMin);
+}
+
+void cOptimisticProtocol::broadcastGvtControl(int tag, int e)
+{
+    cCommBuffer *buffer = comm->createCommBuffer();
+    buffer->pack(e);
+    comm->broadcast(buffer, tag);
+    comm->recycleCommBuffer(buffer);
+}
+
+void cOptimisticProtocol::gvtComputed(simtime_t newGvt)
+{
+    ASSERT(newGvt >= gvt);
+    gvt = newGvt;
+    {if (debug) EV << "GVT=" << gvt << "\n";}
+
+    // all messages of earlier epochs have been received
+    sentCounts.erase(sentCounts.begin(), sentCounts.lower_bound(epoch));
+    receivedCounts.erase(receivedCounts.begin(), receivedCounts.lower_bound(epoch));
+
+    fossilCollect();
+}
+
+void cOptimisticProtocol::fossilCollect()
+{
+    // events before GVT can no longer be rolled back (those at GVT still can, by an anti-message)
+    size_t n = 0;
+    while (n < processed.size() && processed[n].time < gvt) {
+        ProcessedEvent& event = processed[n];
+        delete event.copy;
+        for (SentMessage& sent : event.sentMessages)
+            dropAndDelete(sent.msg);
+        for (CancelledMessage& cancelled : event.cancelledMessages) {
+            if (!cancelled.msgDeleted)
+                forgetCancellation(cancelled.msg, event.seq);
+            delete cancelled.copy;
+        }
+        if (!event.msgDeleted) {
+            auto it = deliveredMessages.find(event.msg);
+            if (it != deliveredMessages.end() && it->second == event.seq)
+                deliveredMessages.erase(it);
+        }
+        if (event.isRemote)
+            processedRemoteMessages.erase(event.remoteKey);
+        n++;
+    }
+    processed.erase(processed.begin(), processed.begin() + n);
+
+    size_t undoPos = processed.empty() ? undoLogBase + undoLog.size() : processed.front().undoPos;
+    while (undoLogBase < undoPos) {
+        undoLog.pop_front();
+        undoLogBase++;
+    }
+
+    uint64_t firstSeq = processed.empty() ? nextSeq : processed.front().seq;
+    for (RngHistory& history : rngHistories) {
+        while (history.states.size() >= 2 && history.states[1].first <= firstSeq) {
+            delete history.states.front().second;
+            history.states.pop_front();
+        }
+    }
+}
+
+void cOptimisticProtocol::objectCreated(cOwnedObject *obj)
+{
+    if (chainedObserver)
+        chainedObserver->objectCreated(obj);
+}
+
+void cOptimisticProtocol::objectDeleted(cOwnedObject *obj)
+{
+    auto it = deliveredMessages.find(obj);
+    if (it != deliveredMessages.end()) {
+        // mark all records of the message, so that rollback puts back the saved copy
+        uint64_t firstSeq = processed.empty() ? nextSeq : processed.front().seq;
+        for (uint64_t seq = it->second; seq != NO_SEQ && seq >= firstSeq; seq = processed[seq - firstSeq].prevDeliverySeq)
+            processed[seq - firstSeq].msgDeleted = true;
+        deliveredMessages.erase(it);
+    }
+    if (!cancellingEvents.empty()) {
+        auto cancelledIt = cancellingEvents.find(obj);
+        if (cancelledIt != cancellingEvents.end()) {
+            uint64_t firstSeq = processed.empty() ? nextSeq : processed.front().seq;
+            for (uint64_t seq : cancelledIt->second)
+                for (CancelledMessage& cancelled : processed[seq - firstSeq].cancelledMessages)
+                    if (cancelled.msg == obj)
+                        cancelled.msgDeleted = true;
+            cancellingEvents.erase(cancelledIt);
+        }
+    }
+    if (!remoteMessageKeys.empty())
+        forgetRemoteMessage(obj);
+
+    if (chainedObserver)
+        chainedObserver->objectDeleted(obj);
+}
+
+void cOptimisticProtocol::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details)
+{
+    // creation and deletion of modules cannot be rolled back (the network is
+    // also expected to stay the same in other partitions)
+    if (sim->getStage() != cSimulation::STAGE_EVENT)
+        return;
+    if (dynamic_cast<cPreModuleAddNotification *>(obj) || dynamic_cast<cPreModuleDeleteNotification *>(obj) || dynamic_cast<cPreModuleReparentNotification *>(obj))
+        throw cRuntimeError("cOptimisticProtocol: Creating, deleting or moving modules during the simulation "
+                            "is not supported with optimistic synchronization");
+}
+
+}  // namespace omnetpp
+
@@ -0,0 +1,281 @@
+//=========================================================================
+//  COPTIMISTICPROTOCOL.H - part of
+//
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COPTIMISTICPROTOCOL_H
+#define __OMNETPP_COPTIMISTICPROTOCOL_H
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "omnetpp/clistener.h"
+#include "omnetpp/cownedobject.h"
+#include "omnetpp/cstatesaving.h"
+#include "cparsimprotocolbase.h"
+
+namespace omnetpp {
+
+class cCommBuffer;
+class cRNG;
+
+/**
+ * @brief Implements optimistic synchronization ("Time Warp").
+ *
+ * Partitions execute their events without waiting for each other. When a
+ * message arrives from another partition with a timestamp that is smaller
+ * than the time of the events already executed (a "straggler"), the partition
+ * rolls back these events: module state is restored via the undo actions
+ * recorded with cStateSaving, the random number generators are restored, the
+ * events they scheduled are removed from the FES, the messages they consumed
+ * and the self-messages they cancelled are put back, and the messages they
+ * sent to other partitions are cancelled by sending anti-messages.
+ *
+ * Global virtual time (GVT) is computed periodically by partition 0, using
+ * Mattern's algorithm (message counting with epochs). Saved state older than
+ * GVT is discarded (fossil collection). Events that are not messages (such as
+ * the end-of-simulation event) are only executed once GVT has reached them,
+ * as they cannot be rolled back. When the simulation terminates, events
+ * executed beyond the termination time are rolled back before finish().
+ *
+ * Requirements on the model: modules must record their state changes with
+ * cStateSaving; activity()-based modules and creating, deleting or moving
+ * modules during the simulation are not supported (the latter is checked);
+ * messages held by modules must be restored by their undo actions (a message
+ * that is not back in the possession of the module when its delivery is
+ * undone is put back into the FES as a copy, taken at the time of delivery).
+ * Results recorded during event processing are not rolled back.
+ *
+ * @ingroup Parsim
+ */
+class SIM_API cOptimisticProtocol : public cParsimProtocolBase, public cIOwnedObjectObserver, public cListener
+{
+  protected:
+    typedef std::chrono::steady_clock Clock;
+
+    // identifies a message sent across partitions: (source procId, message serial)
+    typedef std::pair<int,int64_t> RemoteMessageKey;
+
+    // a message sent to another partition; the message object is kept until
+    // GVT passes the event, as rolling back the sender module may need it
+    struct SentMessage
+    {
+        int destProcId;
+        int64_t serial;
+        simtime_t arrivalTime;
+        cMessage *msg;
+    };
+
+    // a self-message cancelled during a processed event; it is put back into the
+    // FES on rollback, unless it was scheduled by a rolled back event as well
+    struct CancelledMessage
+    {
+        cMessage *msg;                   // the message (unless msgDeleted)
+        cMessage *copy;                  // private copy of msg as it was scheduled
+        eventnumber_t previousEventNumber; // previous event number of msg when it was scheduled
+        bool msgDeleted = false;         // whether msg has been deleted since
+    };
+
+    // processed event, with the data needed to roll it back
+    struct ProcessedEvent
+    {
+        uint64_t seq;                    // sequence number of the record
+        eventnumber_t eventNumber;       // number of the event
+        simtime_t time;                  // simulation time of the event
+        cMessage *msg;                   // the message delivered in the event (unless msgDeleted)
+        cMessage *copy;                  // private copy of msg as it was at delivery
+        eventnumber_t previousEventNumber; // previous event number of msg at delivery (the event that sent it)
+        msgid_t firstMessageId;          // messages created in this event or later have ids at least this large
+        size_t undoPos;                  // absolute position in the undo log at the start of the event
+        uint64_t prevDeliverySeq;        // earlier record that delivered the same message object, or NO_SEQ
+        bool msgDeleted = false;         // whether msg has been deleted since
+        bool isRemote = false;           // whether msg came from another partition
+        RemoteMessageKey remoteKey;      // if isRemote
+        std::vector<SentMessage> sentMessages; // messages sent to other partitions
+        std::vector<CancelledMessage> cancelledMessages; // self-messages cancelled in the event
+    };
+
+    // saved states of an RNG, each tagged with the seq of the event it precedes
+    struct RngHistory
+    {
+        cRNG *rng;
+        uint64_t savedNumDrawn = 0;
+        std::deque<std::pair<uint64_t,cRNG*>> states;
+    };
+
+    static const uint64_t NO_SEQ = UINT64_MAX;
+
+    bool debug = false;
+    Clock::duration gvtInterval;
+
+    // rollback support
+    std::deque<ProcessedEvent> processed;  // events executed since GVT, in execution order
+    uint64_t nextSeq = 0;
+    bool inRecordedEvent = false;          // whether the event being executed is the last one in processed[]
+    cStateSaving::UndoLog undoLog;
+    size_t undoLogBase = 0;                // absolute position of undoLog.front()
+    std::vector<RngHistory> rngHistories;
+    std::unordered_map<cOwnedObject *, uint64_t> deliveredMessages; // message -> seq of the last record that delivered it
+    std::unordered_map<cOwnedObject *, std::vector<uint64_t>> cancellingEvents; // message -> seqs of the records that cancelled it
+    cIOwnedObjectObserver *chainedObserver = nullptr;
+
+    // messages from other partitions
+    std::map<RemoteMessageKey, cMessage *> remoteMessages;  // not yet processed, i.e. in the FES
+    std::unordered_map<cOwnedObject *, RemoteMessageKey> remoteMessageKeys; // reverse of remoteMessages
+    std::map<RemoteMessageKey, uint64_t> processedRemoteMessages;  // -> seq of the record that delivered it
+    std::set<RemoteMessageKey> pendingAntiMessages;  // anti-messages that overtook their messages
+    int64_t nextMessageSerial = 0;
+
+    // GVT computation (Mattern's algorithm); partition 0 is the coordinator
+    simtime_t gvt;
+    int epoch = 0;
+    std::map<int,int64_t> sentCounts;       // per epoch
+    std::map<int,int64_t> receivedCounts;   // per epoch
+    simtime_t minSentTime;                  // smallest timestamp sent in the current epoch
+    bool gvtRoundInProgress = false;
+    int numReportsPending = 0;
+    int64_t reportedSent = 0;
+    int64_t reportedReceived = 0;
+    simtime_t reportedMin;
+    Clock::time_point lastGvtTime;
+
+    // statistics
+    int64_t numRollbacks = 0;
+    int64_t numRolledBackEvents = 0;
+    int64_t numAntiMessages = 0;
+
+  protected:
+    // process buffers coming from other partitions
+    virtual void processReceivedBuffer(cCommBuffer *buffer, int tag, int sourceProcId) override;
+
+    // handle a message or anti-message from another partition
+    virtual void processReceivedRemoteMessage(cMessage *msg, const SendOptions& options, int destModuleId, int destGateId, int sourceProcId, int64_t serial);
+    virtual void processAntiMessage(const RemoteMessageKey& key);
+    virtual void sendAntiMessage(const SentMessage& sent);
+
+    // record the message event about to be executed
+    virtual void beginEvent(cMessage *msg);
+
+    // roll back processed[index] and all later events, and set the simulation time back to t
+    virtual void rollbackTo(size_t index, simtime_t t, bool sendAntiMessages=true);
+    virtual void rollbackToTime(simtime_t t, bool sendAntiMessages=true);
+    virtual void setSimTimeBack(simtime_t t);
+
+    // returns the message to put back into the FES: msg restored from copy, or the copy itself
+    virtual cMessage *reinstateMessage(cMessage *msg, cMessage *copy, cModule *holder);
+
+    // RNG state saving
+    virtual void saveRngStates(uint64_t seq);
+    virtual void restoreRngStates(uint64_t seq);
+
+    // wait until a message arrives or GVT advances; false if interrupted by the user
+    virtual bool waitForProgress();
+
+    // GVT computation
+    virtual void enterEpoch(int e);
+    virtual simtime_t getLocalMinimum();
+    virtual void sendGvtReport();
+    virtual void startGvtRound();
+    virtual void processGvtReport(int64_t sent, int64_t received, simtime_t localMin);
+    virtual void broadcastGvtControl(int tag, int e);
+    virtual void gvtComputed(simtime_t newGvt);
+
+    // discard data needed for rolling back events before GVT
+    virtual void fossilCollect();
+
+    // utility
+    void forgetRemoteMessage(cOwnedObject *msg);
+    void forgetCancellation(cOwnedObject *msg, uint64_t seq);
+    bool isCreatedSince(cMessage *msg, msgid_t firstMessageId) {return msg->getSrcProcId() == -1 && msg->getId() >= firstMessageId;}
+    void clear();
+
+  public:
+    /**
+     * Constructor.
+     */
+    cOptimisticProtocol();
+
+    /**
+     * Destructor.
+     */
+    virtual ~cOptimisticProtocol();
+
+    /**
+     * Reads the configuration.
+     */
+    virtual void configure(cSimulation *simulation, cConfiguration *cfg, cParsimPartition *partition) override;
+
+    /**
+     * Called at the beginning of a simulation run.
+     */
+    virtual void startRun() override;
+
+    /**
+     * Called at the end of a simulation run.
+     */
+    virtual void endRun() override;
+
+    /**
+     * Scheduler function. Rollbacks and GVT computation are driven from here.
+     */
+    virtual cEvent *takeNextEvent() override;
+
+    /**
+     * Undo takeNextEvent() -- it comes from the cScheduler interface.
+     */
+    virtual void putBackEvent(cEvent *event) override;
+
+    /**
+     * Sends out the cMessage to the given partition, and takes ownership of it
+     * so that it can be cancelled and given back to the sender module if the
+     * current event gets rolled back.
+     */
+    virtual void processOutgoingMessage(cMessage *msg, const SendOptions& options, int procId, int moduleId, int gateId, void *data) override;
+
+    /**
+     * Records the self-message cancelled by the current event, so that it can
+     * be put back into the FES if the event gets rolled back.
+     */
+    virtual void messageCancelled(cMessage *msg) override;
+
+    /**
+     * Rolls back the events executed beyond the termination time before
+     * the modules' finish() methods are called.
+     */
+    virtual void lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details) override;
+
+    /**
+     * Returns the current GVT, the time before which events are committed.
+     */
+    simtime_t getGVT() const {return gvt;}
+
+    /** @name cIOwnedObjectObserver methods, used for tracking the deletion of delivered messages. */
+    //@{
+    virtual void objectCreated(cOwnedObject *obj) override;
+    virtual void objectDeleted(cOwnedObject *obj) override;
+    //@}
+
+    /**
+     * Listens to PRE_MODEL_CHANGE, to reject changes of the module structure.
+     */
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details) override;
+};
+
+}  // namespace omnetpp
+
+
+#endif
@@ -300,9 +300,12 @@ void cParsimPartition::processReceivedBuffer(cCommBuffer *buffer, int tag, int s
 {
     opp_string errmsg;
     switch (tag) {
-        case TAG_TERMINATIONEXCEPTION:
+        case TAG_TERMINATIONEXCEPTION: {
+            simtime_t t;
             buffer->unpack(errmsg);
-            throw cReceivedTerminationException(sourceProcId, errmsg.c_str());
+            buffer->unpack(t);
+            throw cReceivedTerminationException(sourceProcId, errmsg.c_str(), t);
+        }
 
         case TAG_EXCEPTION:
             buffer->unpack(errmsg);
@@ -350,6 +353,7 @@ void cParsimPartition::broadcastTerminationException(cTerminationException& e)
     // send TAG_TERMINATIONEXCEPTION to all partitions
     cCommBuffer *buffer = comm->createCommBuffer();
     buffer->pack(e.what());
+    buffer->pack(e.getSimtime());
     try {
         comm->broadcast(buffer, TAG_TERMINATIONEXCEPTION);
     }
@@ -102,6 +102,16 @@ class SIM_API cParsimSynchronizer : public cScheduler
      * (see null message algorithm) on outgoing messages.
      */
     virtual void processOutgoingMessage(cMessage *msg, const SendOptions& options, int procId, int moduleId, int gateId, void *data) = 0;
+
+    /**
+     * Hook, called from cSimpleModule::cancelEvent() when a self-message
+     * has been removed from the FES. The message still has the arrival time,
+     * priority and previous event number it was scheduled with. It is
+     * provided here so that synchronizers which roll back events can
+     * restore the cancelled message. This default implementation does
+     * nothing.
+     */
+    virtual void messageCancelled(cMessage *msg) {}
 };
 
 }  // namespace omnetpp
@@ -22,6 +22,7 @@
 #include "omnetpp/cmessage.h"
 #include "cproxygate.h"
 #include "cparsimpartition.h"
+#include "cparsimsynchr.h"
 
 namespace omnetpp {
 
@@ -46,7 +47,9 @@ bool cProxyGate::deliver(cMessage *msg, const SendOptions& options, simtime_t t)
 
     msg->setArrivalTime(t);  // merge arrival time into message
     partition->processOutgoingMessage(msg, options, remoteProcId, remoteModuleId, remoteGateId, data);
-    return false;  // meaning message should be deleted
+
+    // the message should be deleted, unless the synchronizer took it over (e.g. for rollback)
+    return msg->getOwner() == partition->getSynchronizer();
 }
 
 void cProxyGate::setRemoteGate(short procId, int moduleId, int gateId)
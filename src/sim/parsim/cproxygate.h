@@ -75,7 +75,8 @@ class SIM_API cProxyGate : public cGate // noncopyable
      * cParsimPartition.
      *
      * Invokes the cParsimPartition::processOutgoingMessage() method
-     * to transmit the message, then deletes the message object.
+     * to transmit the message, then deletes the message object unless
+     * the synchronizer has taken ownership of it.
      */
     virtual bool deliver(cMessage *msg, const SendOptions& options, simtime_t at) override;
     //@}
@@ -23,9 +23,10 @@ cReceivedException::cReceivedException(int sourceProcId, const char *msg)
 {
 }
 
-cReceivedTerminationException::cReceivedTerminationException(int sourceProcId, const char *msg)
+cReceivedTerminationException::cReceivedTerminationException(int sourceProcId, const char *msg, simtime_t t)
     : cTerminationException("Terminating simulation on request from procId=%d: %s", sourceProcId, msg)
 {
+    simtime = t;
 }
 
 }  // namespace omnetpp
@@ -45,9 +45,10 @@ class cReceivedTerminationException : public cTerminationException
 {
   public:
     /**
-     * Constructor.
+     * Constructor. The simulation time is that of the source partition
+     * at the time of termination.
      */
-    cReceivedTerminationException(int sourceProcId, const char *msg);
+    cReceivedTerminationException(int sourceProcId, const char *msg, simtime_t t);
 };
 
 }  // namespace omnetpp
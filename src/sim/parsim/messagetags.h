@@ -27,7 +27,13 @@ enum {
      TAG_NULLMESSAGE,
      TAG_CMESSAGE_WITH_NULLMESSAGE,
      TAG_TERMINATIONEXCEPTION,
-     TAG_EXCEPTION
+     TAG_EXCEPTION,
+     TAG_OPTIMISTIC_CMESSAGE,
+     TAG_ANTIMESSAGE,
+     TAG_GVT_START,
+     TAG_GVT_REPORT,
+     TAG_GVT_CONTINUE,
+     TAG_GVT_VALUE
 };
 
 #endif
@@ -227,6 +227,45 @@ static std::string extractExceptionLocation(PyObject *traceback)
 }
 
 
+static OPP_THREAD_LOCAL PythonGilBatch *currentGilBatch = nullptr;
+
+PythonGilBatch::PythonGilBatch() : outer(currentGilBatch)
+{
+    if (!outer)
+        currentGilBatch = this;
+}
+
+PythonGilBatch::~PythonGilBatch()
+{
+    if (!outer) {
+        currentGilBatch = nullptr;
+        if (held)
+            PyGILState_Release(state);
+    }
+}
+
+void PythonGilBatch::hold()
+{
+    PythonGilBatch *batch = currentGilBatch;
+    if (batch && !batch->held) {
+        batch->state = PyGILState_Ensure();
+        batch->held = true;
+    }
+}
+
+PythonCallStats& getPythonCallStats()
+{
+    static OPP_THREAD_LOCAL PythonCallStats stats;
+    return stats;
+}
+
+PythonNedFunctionSettings& getPythonNedFunctionSettings()
+{
+    static OPP_THREAD_LOCAL PythonNedFunctionSettings settings;
+    return settings;
+}
+
+
 void checkPythonException()
 {
     PythonGilLock gilLock;
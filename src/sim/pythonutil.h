@@ -76,6 +76,64 @@ public:
 };
 
 
+/**
+ * Internal helper. While an object of this class exists, the GIL, once
+ * acquired by hold() on this thread, is not released between Python calls,
+ * only when the batch ends. This spares a GIL handoff per call when many
+ * Python NED function calls are made in a row, e.g. while the parameters
+ * of a module are evaluated.
+ * Batches may be nested; only the outermost one has an effect.
+ */
+class SIM_API PythonGilBatch {
+    PythonGilBatch *outer;
+    bool held = false;
+    PyGILState_STATE state;
+
+public:
+    PythonGilBatch();
+    PythonGilBatch(const PythonGilBatch&) = delete;
+    PythonGilBatch& operator=(const PythonGilBatch&) = delete;
+    ~PythonGilBatch();
+
+    /**
+     * Acquires the GIL for the rest of the ongoing batch, if there is one
+     * on this thread. Python must be initialized.
+     */
+    static void hold();
+};
+
+/**
+ * Internal helper. Counters of Python NED function (pyeval(), pycode())
+ * calls made on the current thread, see getPythonCallStats().
+ */
+struct PythonCallStats {
+    int64_t numCalls = 0;
+    int64_t numCacheHits = 0;    // calls answered from the memoization cache
+    int64_t numCompilations = 0; // code strings compiled (the compiled code is cached)
+    double seconds = 0;          // total time spent in calls, including conversions
+};
+
+/**
+ * Returns the Python NED function call counters of the current thread.
+ * They are reset at network setup.
+ */
+SIM_API PythonCallStats& getPythonCallStats();
+
+/**
+ * Internal helper. Settings of the Python NED functions (pyeval(), pycode())
+ * for the simulation on the current thread, see getPythonNedFunctionSettings().
+ */
+struct PythonNedFunctionSettings {
+    bool memoizeResults = false;  // python-memoize-ned-functions
+};
+
+/**
+ * Returns the Python NED function settings of the current thread. They are
+ * read from the configuration at network setup.
+ */
+SIM_API PythonNedFunctionSettings& getPythonNedFunctionSettings();
+
+
 }  // namespace omnetpp
 
 #endif  // WITH_PYTHON
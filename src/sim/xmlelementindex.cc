@@ -0,0 +1,95 @@
+//==========================================================================
+//  XMLELEMENTINDEX.CC - part of
+//                 OMNeT++/OMNEST
+//              Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstring>
+#include <algorithm>
+#include "common/stringutil.h"
+#include "omnetpp/platdep/platmisc.h"  // strcasecmp
+#include "xmlelementindex.h"
+
+using namespace omnetpp::common;
+
+namespace omnetpp {
+namespace internal {
+
+XMLElementIndex::XMLElementIndex(cXMLElement *top)
+{
+    add(top);
+}
+
+void XMLElementIndex::add(cXMLElement *element)
+{
+    int pos = elements.size();
+    elements.push_back(element);
+    if (const char *id = element->getAttribute("id"))
+        idTable[id].push_back(pos);
+    for (cXMLElement *child = element->getFirstChild(); child; child = child->getNextSibling())
+        add(child);
+    ranges[element] = Range { pos, (int)elements.size() };
+}
+
+int XMLElementIndex::getPosition(const cXMLElement *element) const
+{
+    auto it = ranges.find(element);
+    return it == ranges.end() ? -1 : it->second.begin;
+}
+
+cXMLElement *XMLElementIndex::getElementById(const cXMLElement *context, const char *id) const
+{
+    auto it = idTable.find(id);
+    if (it == idTable.end())
+        return nullptr;
+    const Range& range = ranges.at(context);
+    const std::vector<int>& positions = it->second;
+    auto pos = std::lower_bound(positions.begin(), positions.end(), range.begin);
+    return (pos != positions.end() && *pos < range.end) ? elements[*pos] : nullptr;
+}
+
+const XMLElementIndex::ValueMap& XMLElementIndex::getAttrTable(const char *tagName, const char *attr)
+{
+    std::string key = tagName ? opp_strlower(tagName) : "*";
+    key += "/";
+    key += attr;
+    auto it = attrTables.find(key);
+    if (it != attrTables.end())
+        return it->second;
+
+    ValueMap& table = attrTables[key];
+    for (int pos = 0; pos < (int)elements.size(); pos++) {
+        cXMLElement *element = elements[pos];
+        if (!tagName || !strcasecmp(element->getTagName(), tagName))
+            if (const char *value = element->getAttribute(attr))
+                table[value].push_back(pos);
+    }
+    return table;
+}
+
+std::vector<cXMLElement *> XMLElementIndex::getDescendantsWithAttribute(const cXMLElement *context, const char *tagName, const char *attr, const char *value)
+{
+    std::vector<cXMLElement *> result;
+    const ValueMap& table = getAttrTable(tagName, attr);
+    auto it = table.find(value);
+    if (it == table.end())
+        return result;
+    const Range& range = ranges.at(context);
+    const std::vector<int>& positions = it->second;
+    for (auto pos = std::upper_bound(positions.begin(), positions.end(), range.begin); pos != positions.end() && *pos < range.end; ++pos)
+        result.push_back(elements[*pos]);
+    return result;
+}
+
+}  // namespace internal
+}  // namespace omnetpp
+
@@ -0,0 +1,81 @@
+//==========================================================================
+//  XMLELEMENTINDEX.H - part of
+//                 OMNeT++/OMNEST
+//              Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_XMLELEMENTINDEX_H
+#define __OMNETPP_XMLELEMENTINDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "omnetpp/cxmlelement.h"
+
+namespace omnetpp {
+namespace internal {
+
+/**
+ * Lookup tables for a cXMLElement tree, used by cXMLElement::getElementById()
+ * and by MiniXPath. Elements are numbered in document order, so the subtree
+ * of an element occupies a contiguous range of positions, and lookups within
+ * a subtree are binary searches. The ID table is built together with the
+ * index; tables for (tag name, attribute) pairs are built on first use.
+ *
+ * The index belongs to the top element of the tree (see cXMLElement::getIndex()),
+ * and it is discarded on any modification of the tree.
+ */
+class XMLElementIndex
+{
+  private:
+    struct Range {
+        int begin;  // position of the element
+        int end;    // position after the last element in its subtree
+    };
+    typedef std::unordered_map<std::string, std::vector<int>> ValueMap;  // attribute value -> positions, ascending
+
+    std::vector<cXMLElement *> elements;  // in document order
+    std::unordered_map<const cXMLElement *, Range> ranges;
+    ValueMap idTable;
+    std::unordered_map<std::string, ValueMap> attrTables;  // key: lowercase tag name (or "*"), '/', attribute name
+
+  private:
+    void add(cXMLElement *element);
+    const ValueMap& getAttrTable(const char *tagName, const char *attr);
+
+  public:
+    XMLElementIndex(cXMLElement *top);
+
+    /**
+     * Position of the element in document order, or -1 if it is not in the tree.
+     */
+    int getPosition(const cXMLElement *element) const;
+
+    /**
+     * The first element in document order in the subtree of context (context
+     * included) whose "id" attribute has the given value, or nullptr.
+     */
+    cXMLElement *getElementById(const cXMLElement *context, const char *id) const;
+
+    /**
+     * The elements in the subtree of context (context excluded) with the
+     * given tag name (case insensitive; nullptr means any) and attribute value,
+     * in document order.
+     */
+    std::vector<cXMLElement *> getDescendantsWithAttribute(const cXMLElement *context, const char *tagName, const char *attr, const char *value);
+};
+
+}  // namespace internal
+}  // namespace omnetpp
+
+#endif
+
@@ -0,0 +1,410 @@
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <omnetpp.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace omnetpp;
+
+typedef std::chrono::steady_clock Clock;
+
+static double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static std::string jsonQuote(const std::string& s)
+{
+    std::string result = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            result += '\\';
+        result += c;
+    }
+    return result + "\"";
+}
+
+// Resident set size of the process in kilobytes, or -1 if not available
+static long getResidentSetSizeKB()
+{
+#ifdef __linux__
+    std::ifstream in("/proc/self/statm");
+    long size, resident;
+    if (in >> size >> resident)
+        return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+    return -1;
+}
+
+// Prints one result as a JSON object on a line of its own, prefixed with
+// "BENCHMARK"; the runtest script collects these lines. extraFields, if
+// given, is inserted into the object as is.
+static void report(const char *name, int64_t numOps, double seconds, const std::string& extraFields="")
+{
+    cConfiguration *cfg = getSimulation()->getConfig();
+    std::cout << "BENCHMARK {"
+              << "\"name\": " << jsonQuote(name) << ", "
+              << "\"config\": " << jsonQuote(cfg->getVariable(CFGVAR_CONFIGNAME)) << ", "
+              << "\"iterationvars\": " << jsonQuote(cfg->getVariable(CFGVAR_ITERATIONVARS)) << ", "
+              << "\"ops\": " << numOps << ", "
+              << "\"seconds\": " << seconds << ", "
+              << "\"ns_per_op\": " << 1e9 * seconds / numOps
+              << (extraFields.empty() ? "" : ", ") << extraFields
+              << "}" << std::endl;
+}
+
+// ---------------
+
+class FesHold : public cSimpleModule
+{
+  protected:
+    int64_t numEvents;
+    int64_t count = 0;
+    Clock::time_point start;
+
+  public:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+};
+
+Define_Module(FesHold);
+
+void FesHold::initialize()
+{
+    numEvents = par("numEvents");
+    int holdSize = par("holdSize");
+    for (int i = 0; i < holdSize; i++)
+        scheduleAt(exponential(1.0), new cMessage("hold"));
+    start = Clock::now();
+}
+
+void FesHold::handleMessage(cMessage *msg)
+{
+    if (++count == numEvents) {
+        report("fes-hold", numEvents, secondsSince(start));
+        delete msg;
+        endSimulation();
+    }
+    scheduleAt(simTime() + exponential(1.0), msg);
+}
+
+// ---------------
+
+class Echo : public cSimpleModule
+{
+  protected:
+    cGate *outGate;
+
+  public:
+    virtual void initialize() override {outGate = gate("out");}
+    virtual void handleMessage(cMessage *msg) override {send(msg, outGate);}
+};
+
+Define_Module(Echo);
+
+class Pinger : public cSimpleModule
+{
+  protected:
+    int64_t numRoundTrips;
+    int64_t count = 0;
+    cGate *outGate;
+    Clock::time_point start;
+
+  public:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+};
+
+Define_Module(Pinger);
+
+void Pinger::initialize()
+{
+    numRoundTrips = par("numRoundTrips");
+    outGate = gate("out");
+    send(new cMessage("ping"), outGate);
+    start = Clock::now();
+}
+
+void Pinger::handleMessage(cMessage *msg)
+{
+    if (++count == numRoundTrips) {
+        report("send-nested", numRoundTrips, secondsSince(start));
+        delete msg;
+        endSimulation();
+    }
+    send(msg, outGate);
+}
+
+// ---------------
+
+class CountingListener : public cListener
+{
+  public:
+    double sum = 0;
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, double d, cObject *details) override {sum += d;}
+};
+
+class SignalEmit : public cSimpleModule
+{
+  protected:
+    std::vector<CountingListener> listeners;
+
+  public:
+    virtual void initialize() override;
+    virtual void finish() override;
+};
+
+Define_Module(SignalEmit);
+
+void SignalEmit::initialize()
+{
+    simsignal_t signal = registerSignal("value");
+    listeners.resize((int)par("numListeners"));
+    for (auto& listener : listeners)
+        subscribe(signal, &listener);
+
+    int64_t numEmits = par("numEmits");
+    Clock::time_point start = Clock::now();
+    for (int64_t i = 0; i < numEmits; i++)
+        emit(signal, (double)i);
+    report("signal-emit", numEmits, secondsSince(start));
+}
+
+void SignalEmit::finish()
+{
+    simsignal_t signal = registerSignal("value");
+    for (auto& listener : listeners)
+        unsubscribe(signal, &listener);
+}
+
+// ---------------
+
+class DupDelete : public cSimpleModule
+{
+  public:
+    virtual void initialize() override;
+};
+
+Define_Module(DupDelete);
+
+void DupDelete::initialize()
+{
+    int repeatCount = par("repeatCount");
+
+    cMessage *msg = new cMessage("msg", 42);
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < repeatCount; i++)
+        delete msg->dup();
+    report("message-dup-delete", repeatCount, secondsSince(start));
+    delete msg;
+
+    cPacket *pk = new cPacket("pk", 0, 64);
+    for (int i = 0; i < (int)par("encapsulationDepth"); i++) {
+        cPacket *outer = new cPacket("outer", 0, 20);
+        outer->encapsulate(pk);
+        pk = outer;
+    }
+    start = Clock::now();
+    for (int i = 0; i < repeatCount; i++)
+        delete pk->dup();
+    report("packet-dup-delete", repeatCount, secondsSince(start));
+    delete pk;
+}
+
+// ---------------
+
+class PacketQueue : public cSimpleModule
+{
+  public:
+    virtual void initialize() override;
+};
+
+Define_Module(PacketQueue);
+
+static int compareByKind(cObject *a, cObject *b)
+{
+    return static_cast<cMessage *>(a)->getKind() - static_cast<cMessage *>(b)->getKind();
+}
+
+void PacketQueue::initialize()
+{
+    int queueLength = par("queueLength");
+    int64_t numOps = par("numOps");
+
+    // FIFO: the queue is kept at queueLength packets, each op is an insert and a pop
+    cPacketQueue queue("queue");
+    for (int i = 0; i < queueLength; i++)
+        queue.insert(new cPacket("pk", intuniform(0, 7), 8 * intuniform(64, 1500)));
+    Clock::time_point start = Clock::now();
+    for (int64_t i = 0; i < numOps; i++)
+        queue.insert(queue.pop());
+    report("packetqueue-fifo", numOps, secondsSince(start));
+
+    // priority queue by message kind, with many packets of equal priority
+    cPacketQueue priorityQueue("priorityQueue", compareByKind);
+    start = Clock::now();
+    for (int64_t i = 0; i < numOps; i++)
+        priorityQueue.insert(i < queueLength ? queue.pop() : priorityQueue.pop());
+    report("packetqueue-priority", numOps, secondsSince(start));
+
+    // removal of a packet from the middle of the queue (e.g. on timeout)
+    start = Clock::now();
+    for (int64_t i = 0; i < numOps / 100; i++)
+        priorityQueue.insert(priorityQueue.remove(priorityQueue.get(priorityQueue.getLength() / 2)));
+    report("packetqueue-remove-middle", numOps / 100, secondsSince(start));
+    EV << "bytes=" << queue.getByteLength() + priorityQueue.getByteLength() << "\n";
+}
+
+// ---------------
+
+class ParamEval : public cSimpleModule
+{
+  public:
+    virtual void initialize() override;
+};
+
+Define_Module(ParamEval);
+
+void ParamEval::initialize()
+{
+    int repeatCount = par("repeatCount");
+
+    cPar& expr = par("expr");
+    double sum = 0;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < repeatCount; i++)
+        sum += expr.doubleValue();
+    report("param-eval-volatile", repeatCount, secondsSince(start));
+
+    start = Clock::now();
+    for (int i = 0; i < repeatCount; i++)
+        sum += par("plain").doubleValue();
+    report("param-lookup-by-name", repeatCount, secondsSince(start));
+
+    // volatile quantity converted to the declared unit, and to the one used by the model
+    cPar& delay = par("delay");
+    start = Clock::now();
+    for (int i = 0; i < repeatCount; i++)
+        sum += delay.doubleValueInUnit("ms");
+    report("param-eval-unit-conversion", repeatCount, secondsSince(start));
+
+    // JSON-style object parameter: evaluating it builds a fresh cValueMap
+    cPar& json = par("json");
+    int64_t length = 0;
+    start = Clock::now();
+    for (int i = 0; i < repeatCount; i++) {
+        cValueMap *map = check_and_cast<cValueMap *>(json.objectValue());
+        length += map->get("name").stdstringValue().size();
+    }
+    report("param-eval-object", repeatCount, secondsSince(start));
+
+    // copying nested cValueMaps/cValueArrays copies all contained cValues
+    cValueMap *table = check_and_cast<cValueMap *>(par("table").objectValue());
+    start = Clock::now();
+    for (int i = 0; i < repeatCount; i++) {
+        cValueMap *copy = table->dup();
+        length += copy->size();
+        delete copy;
+    }
+    report("valuemap-dup", repeatCount, secondsSince(start));
+
+    EV << "sum=" << sum << " length=" << length << "\n"; // keep the compiler from optimizing the loops away
+}
+
+// ---------------
+
+class Node : public cSimpleModule
+{
+  public:
+    virtual void handleMessage(cMessage *msg) override {delete msg;}
+};
+
+Define_Module(Node);
+
+class NetworkSetupTimer : public cModule
+{
+  protected:
+    virtual void doBuildInside() override;
+};
+
+Define_Module(NetworkSetupTimer);
+
+void NetworkSetupTimer::doBuildInside()
+{
+    Clock::time_point start = Clock::now();
+    cModule::doBuildInside();
+    report("network-setup", (int)par("numNodes"), secondsSince(start));
+}
+
+// ---------------
+
+class XmlLoad : public cSimpleModule
+{
+  protected:
+    int visit(cXMLElement *element);
+
+  public:
+    virtual void initialize() override;
+};
+
+Define_Module(XmlLoad);
+
+void XmlLoad::initialize()
+{
+    // generate a routing table-like document
+    int numElements = par("numElements");
+    std::string fileName = "xmlload-" + std::to_string(numElements) + ".xml";
+    if (!std::ifstream(fileName).good()) {
+        std::ofstream out(fileName);
+        out << "<routingTable>\n";
+        for (int i = 0; i < numElements / 2; i++)
+            out << "  <route id=\"r" << i << "\" dest=\"10." << i/65536 << "." << i/256%256 << "." << i%256 << "\" "
+                << "netmask=\"255.255.255.255\" interface=\"eth" << i%4 << "\" metric=\"" << i%16 << "\">"
+                << "<nextHop>10.255." << i%256 << ".1</nextHop></route>\n";
+        out << "</routingTable>\n";
+    }
+
+    // the first run in the process parses the file, further runs reuse the shared document
+    std::string runNumber = getSimulation()->getConfig()->getVariable(CFGVAR_RUNNUMBER);
+    long rssBefore = getResidentSetSizeKB();
+    Clock::time_point start = Clock::now();
+    cXMLElement *root = getEnvir()->getXMLDocument(fileName.c_str());
+    report("xml-load", numElements, secondsSince(start), "\"run\": " + runNumber);
+
+    start = Clock::now();
+    int count = visit(root);
+    report("xml-traverse", count, secondsSince(start),
+            "\"run\": " + runNumber + ", \"rss_delta_kb\": " + std::to_string(getResidentSetSizeKB() - rssBefore));
+
+    // per-node configuration lookup, as done by models during initialization
+    int numLookups = std::min(numElements / 2, 10000);
+    int found = 0;
+    start = Clock::now();
+    for (int i = 0; i < numLookups; i++) {
+        std::string path = "route[@id='r" + std::to_string(i * (numElements / 2 / numLookups)) + "']/nextHop";
+        if (root->getElementByPath(path.c_str()))
+            found++;
+    }
+    report("xml-lookup-path", numLookups, secondsSince(start), "\"run\": " + runNumber);
+
+    start = Clock::now();
+    for (int i = 0; i < numLookups; i++) {
+        std::string id = "r" + std::to_string(numElements / 2 - 1 - i * (numElements / 2 / numLookups));
+        if (root->getElementById(id.c_str()))
+            found++;
+    }
+    report("xml-lookup-id", numLookups, secondsSince(start), "\"run\": " + runNumber);
+    EV << "found=" << found << "\n";
+}
+
+int XmlLoad::visit(cXMLElement *element)
+{
+    int count = 1;
+    if (element->getAttribute("dest"))
+        element->getNodeValue();
+    for (cXMLElement *child = element->getFirstChild(); child; child = child->getNextSibling())
+        count += visit(child);
+    return count;
+}
@@ -0,0 +1,53 @@
+#include <chrono>
+#include <omnetpp.h>
+#include "sim/parsim/cmemcommbuffer.h"
+#include "packets_m.h"
+
+using namespace omnetpp;
+
+class Packer : public cSimpleModule
+{
+  protected:
+    template<typename T> void measure(const char *label);
+    virtual void initialize() override;
+};
+
+Define_Module(Packer);
+
+template<typename T>
+void Packer::measure(const char *label)
+{
+    T pkt("pkt");
+    pkt.setSrcAddress(1);
+    pkt.setDestAddress(2);
+    pkt.setSeqNum(3);
+    pkt.setAckRequired(true);
+    pkt.setTxPower(0.1);
+    pkt.setCreationTime(1.0);
+    pkt.setLabel("data");
+    for (int i = 0; i < 64; i++)
+        pkt.setPayload(i, i);
+    int numSamples = par("numSamples");
+    pkt.setSamplesArraySize(numSamples);
+    for (int i = 0; i < numSamples; i++)
+        pkt.setSamples(i, i * 0.5);
+
+    int repeatCount = par("repeatCount");
+    cMemCommBuffer buffer;
+    T copy("copy");
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeatCount; i++) {
+        buffer.reset();
+        pkt.parsimPack(&buffer);
+        copy.parsimUnpack(&buffer);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / repeatCount;
+    EV_INFO << label << ": " << ns << " ns per pack+unpack cycle, " << buffer.getMessageSize() << " bytes\n";
+}
+
+void Packer::initialize()
+{
+    measure<GenericPacket>("generic");
+    measure<BinaryPacket>("binary ");
+}
@@ -0,0 +1,30 @@
+#include <chrono>
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class Recorder : public cSimpleModule
+{
+  public:
+    Recorder() : cSimpleModule(32768) {}
+    virtual void activity() override;
+};
+
+Define_Module(Recorder);
+
+void Recorder::activity()
+{
+    simsignal_t valueSignal = registerSignal("value");
+    int numBatches = par("numBatches");
+    double elapsed = 0;
+    for (int i = 0; i < numBatches; i++) {
+        // emit a batch of values at the same simulation time, and time only the emit() calls
+        auto start = std::chrono::steady_clock::now();
+        for (int j = 0; j < 1000; j++)
+            emit(valueSignal, (double)j);
+        auto end = std::chrono::steady_clock::now();
+        elapsed += std::chrono::duration<double, std::nano>(end - start).count();
+        wait(0.001);
+    }
+    EV_INFO << "emit+record: " << elapsed / numBatches / 1000 << " ns per emit()\n";
+}
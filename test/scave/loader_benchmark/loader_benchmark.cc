@@ -0,0 +1,76 @@
+//
+// Standalone C++ version of loader_benchmark.py: times loading a .sca file,
+// indexing a .vec file, loading the .vci file, and reading the vector data,
+// without the overhead of the Python bindings. The input files are those
+// generated by loader_benchmark.py into its work directory.
+//
+// Build (from this directory, with the OMNeT++ environment set up):
+//   g++ -O2 -std=c++17 -I../../../src -I../../../include loader_benchmark.cc \
+//       -L../../../lib -loppscave -loppcommon -o loader_benchmark
+//
+// Usage:
+//   ./loader_benchmark work/loader-20000.sca work/loader-100-2000000.vec
+//
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include "scave/resultfilemanager.h"
+#include "scave/vectorutils.h"
+#include "scave/xyarray.h"
+
+using namespace omnetpp::scave;
+
+static double timed(const std::function<void()>& function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char *name, double seconds)
+{
+    printf("%-12s %.3fs\n", name, seconds);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <file.sca> <file.vec>\n", argv[0]);
+        return 1;
+    }
+    std::string scaFile = argv[1];
+    std::string vecFile = argv[2];
+    std::string vciFile = vecFile.substr(0, vecFile.size() - 4) + ".vci";
+
+    report("sca-load", timed([&]() {
+        ResultFileManager manager;
+        manager.loadFile(scaFile.c_str(), scaFile.c_str(), ResultFileManager::LOADFLAGS_DEFAULTS, nullptr);
+    }));
+
+    remove(vciFile.c_str());
+    report("vec-index", timed([&]() {
+        ResultFileManager manager;
+        manager.loadFile(vecFile.c_str(), vecFile.c_str(), ResultFileManager::LOADFLAGS_DEFAULTS, nullptr);
+    }));
+
+    ResultFileManager manager;
+    report("vci-load", timed([&]() {
+        manager.loadFile(vecFile.c_str(), vecFile.c_str(), ResultFileManager::LOADFLAGS_DEFAULTS, nullptr);
+    }));
+
+    IDList vectors = manager.getAllVectors();
+    size_t numSamples = 0;
+    report("vec-read", timed([&]() {
+        std::vector<XYArray *> arrays = readVectorsIntoArrays(&manager, vectors, true, true);
+        for (XYArray *array : arrays) {
+            numSamples += array->length();
+            delete array;
+        }
+    }));
+    printf("%zu vectors, %zu samples\n", (size_t)vectors.size(), numSamples);
+    return 0;
+}
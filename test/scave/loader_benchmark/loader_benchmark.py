@@ -0,0 +1,156 @@
+#
+# Benchmark for loading result files with the scave library: parsing a scalar
+# file, indexing a vector file, loading the index, and reading the vector data.
+# The input files are generated on the first run, and are reproducible, so that
+# results of different commits can be compared.
+#
+
+import argparse
+import json
+import os
+import random
+import time
+
+from omnetpp.scave.utils import _import_scave_bindings
+
+sb = _import_scave_bindings()
+
+RUN_HEADER = """version 3
+run General-0-20240101-12:00:00-1000
+attr configname General
+attr datetime 20240101-12:00:00
+attr experiment General
+attr inifile omnetpp.ini
+attr iterationvars ""
+attr measurement ""
+attr network Net
+attr processid 1000
+attr repetition 0
+attr replication #0
+attr resultdir results
+attr runnumber 0
+attr seedset 0
+config network Net
+config sim-time-limit 1000s
+
+"""
+
+def write_scalar_file(filename, num_modules, rng):
+    with open(filename, "w") as f:
+        f.write(RUN_HEADER)
+        for i in range(num_modules):
+            module = "Net.host[%d].app" % i
+            for name in ["sentPk", "rcvdPk", "droppedPk", "txBytes", "rxBytes"]:
+                f.write("scalar %s %s:count %.14g\n" % (module, name, rng.randint(0, 100000)))
+                f.write("attr recordingmode count\n")
+            f.write("scalar %s throughput:mean %.14g\n" % (module, rng.uniform(0, 1e6)))
+            f.write("attr unit bps\n")
+            values = [rng.expovariate(1000) for _ in range(100)]
+            f.write("statistic %s delay:histogram\n" % module)
+            f.write("field count %d\n" % len(values))
+            f.write("field mean %.14g\n" % (sum(values) / len(values)))
+            f.write("field min %.14g\n" % min(values))
+            f.write("field max %.14g\n" % max(values))
+            f.write("field sum %.14g\n" % sum(values))
+            f.write("field sqrsum %.14g\n" % sum(v * v for v in values))
+            f.write("attr recordingmode histogram\n")
+            f.write("attr unit s\n")
+            f.write("bin\t-inf\t0\n")
+            for k in range(20):
+                f.write("bin\t%.14g\t%d\n" % (k * 0.0005, rng.randint(0, 10)))
+
+def write_vector_file(filename, num_vectors, num_samples, rng):
+    with open(filename, "w") as f:
+        f.write(RUN_HEADER)
+        for id in range(num_vectors):
+            f.write("vector %d Net.host[%d].app endToEndDelay:vector ETV\n" % (id, id))
+            f.write("attr recordingmode vector\n")
+            f.write("attr unit s\n")
+        # data lines come in blocks, like in files written by the simulation
+        t = 0.0
+        eventNumber = 0
+        values = [0.0] * num_vectors
+        lines = []
+        for i in range(num_samples):
+            id = i // 64 % num_vectors
+            t += rng.expovariate(1000)
+            eventNumber += rng.randint(1, 20)
+            values[id] += rng.gauss(0, 1)
+            lines.append("%d\t%d\t%.9f\t%.14g\n" % (id, eventNumber, t, values[id]))
+            if len(lines) == 10000:
+                f.writelines(lines)
+                lines = []
+        f.writelines(lines)
+
+def count_lines(filename):
+    with open(filename, "rb") as f:
+        return sum(1 for _ in f)
+
+def load(filename, flags):
+    rfm = sb.ResultFileManager()
+    rfm.loadFile(filename, filename, flags)
+    return rfm
+
+def report(results, name, num_ops, seconds, extra=None):
+    result = {"name": name, "ops": num_ops, "seconds": seconds, "ns_per_op": 1e9 * seconds / num_ops}
+    if extra:
+        result.update(extra)
+    print("BENCHMARK " + json.dumps(result), flush=True)
+    results.append(result)
+
+def timed(function):
+    start = time.perf_counter()
+    result = function()
+    return result, time.perf_counter() - start
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark loading of .sca/.vec/.vci files")
+    parser.add_argument("--modules", type=int, default=20000, help="number of modules in the scalar file")
+    parser.add_argument("--vectors", type=int, default=100, help="number of vectors in the vector file")
+    parser.add_argument("--samples", type=int, default=2000000, help="total number of samples in the vector file")
+    parser.add_argument("--workdir", default="work", help="directory for the generated result files")
+    parser.add_argument("outfile", nargs="?", default="results/loader_benchmark.json")
+    args = parser.parse_args()
+
+    os.makedirs(args.workdir, exist_ok=True)
+    scafile = os.path.join(args.workdir, "loader-%d.sca" % args.modules)
+    vecfile = os.path.join(args.workdir, "loader-%d-%d.vec" % (args.vectors, args.samples))
+    vcifile = vecfile[:-4] + ".vci"
+    if not os.path.exists(scafile):
+        write_scalar_file(scafile, args.modules, random.Random(1))
+    if not os.path.exists(vecfile):
+        write_vector_file(vecfile, args.vectors, args.samples, random.Random(2))
+
+    results = []
+    sizes = lambda filename: {"file_mb": round(os.path.getsize(filename) / 1e6, 1)}
+
+    rfm, seconds = timed(lambda: load(scafile, sb.LoadFlags.LOADFLAGS_DEFAULTS))
+    report(results, "sca-load", count_lines(scafile), seconds, sizes(scafile))
+
+    if os.path.exists(vcifile):
+        os.remove(vcifile)
+    rfm, seconds = timed(lambda: load(vecfile, sb.LoadFlags.LOADFLAGS_DEFAULTS))
+    report(results, "vec-index", count_lines(vecfile), seconds, sizes(vecfile))
+
+    rfm, seconds = timed(lambda: load(vecfile, sb.LoadFlags.LOADFLAGS_DEFAULTS))
+    report(results, "vci-load", count_lines(vcifile), seconds, sizes(vcifile))
+
+    vectors = rfm.getAllVectors()
+    arrays, seconds = timed(lambda: sb.readVectorsIntoArrays(rfm, vectors, True, True))
+    report(results, "vec-read", sum(a.length() for a in arrays), seconds)
+
+    # with LAZY_VECTOR_METADATA, a name-based filter is answered without reading the attributes and statistics
+    flags = sb.LoadFlags.LOADFLAGS_DEFAULTS | sb.LoadFlags.LAZY_VECTOR_METADATA
+    rfm, seconds = timed(lambda: load(vecfile, flags))
+    report(results, "vci-load-lazy", count_lines(vcifile), seconds, sizes(vcifile))
+
+    vectors = rfm.getAllVectors()
+    _, seconds = timed(lambda: rfm.filterIDList(vectors, "module =~ Net.host*.app AND name =~ endToEndDelay:*", 0, None))
+    report(results, "vci-lazy-name-filter", vectors.size(), seconds)
+
+    os.makedirs(os.path.dirname(args.outfile) or ".", exist_ok=True)
+    with open(args.outfile, "w") as f:
+        json.dump({"date": time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime()), "benchmarks": results}, f, indent=2)
+
+if __name__ == "__main__":
+    main()
@@ -77,6 +77,7 @@ std::string opp_formatdouble(double value, int numSignificantDigits);
 //int getPEVersion(const char *fileName);
 
 %ignore UnitConversion::parseQuantity(const char *, std::string&);
+%ignore UnitConversion::tryConvertLinear;
 
 typedef int64_t intpar_t;
 
@@ -42,6 +42,7 @@ public class ResultFileManagerEx extends ResultFileManager {
     public static int SKIP_IF_LOCKED = ResultFileManager.LoadFlags.SKIP_IF_LOCKED.swigValue(); // don't load (this is the default)
     public static int IGNORE_LOCK_FILE = ResultFileManager.LoadFlags.IGNORE_LOCK_FILE.swigValue(); // pretend lock file doesn't exist
     public static int VERBOSE = ResultFileManager.LoadFlags.VERBOSE.swigValue(); // print on stdout what it's doing
+    public static int LAZY_VECTOR_METADATA = ResultFileManager.LoadFlags.LAZY_VECTOR_METADATA.swigValue(); // read vector attributes and statistics from the index file on first access only
 
     /*-------------------------------------------
      *               Writer methods
@@ -260,6 +260,28 @@ public class ConfigRegistry {
         "is called (possibly multiple times, see " +
         "`cmdenv-fake-gui-on-simtime-numsteps`) when simulation time advances from " +
         "one simulation event to the next.");
+    public static final ConfigOption CFGID_CMDENV_FORK_POINT = addGlobalOption(
+        "cmdenv-fork-point", CFG_STRING, "initialize",
+        "When `cmdenv-fork-repetitions=true`: the point at which worker processes " +
+        "are forked. Accepted values are `setup` (after setting up the network), " +
+        "`initialize` (after initializing it), or a simulation time such as `100s`, " +
+        "meaning that events before that time are also executed only once. No " +
+        "results may be recorded before the fork point; consider setting " +
+        "`warmup-period` accordingly.");
+    public static final ConfigOption CFGID_CMDENV_FORK_REPETITIONS = addGlobalOption(
+        "cmdenv-fork-repetitions", CFG_BOOL, "false",
+        "When enabled, runs that only differ in the repetition share the network " +
+        "setup: the network is set up (and possibly initialized and run for a while, " +
+        "see `cmdenv-fork-point`) only once, and the repetitions continue in worker " +
+        "processes forked from that state, each with the seeds and result files of " +
+        "its own run. Repetitions whose configuration also differs in other settings " +
+        "(e.g. because a parameter refers to `${repetition}` or `${runnumber}`) do " +
+        "not share the network setup. The number of concurrently running worker " +
+        "processes is limited " +
+        "by `cmdenv-num-threads`. Note that random numbers drawn before the fork " +
+        "point are shared among the repetitions. Not supported on Windows, and " +
+        "together with parallel simulation, eventlog recording and fingerprint " +
+        "checking.");
     public static final ConfigOption CFGID_CMDENV_INTERACTIVE = addPerRunOption(
         "cmdenv-interactive", CFG_BOOL, "false",
         "Defines what Cmdenv should do when the model contains unassigned " +
@@ -700,6 +722,14 @@ public class ConfigRegistry {
         "use. This value must be in agreement with the number of simulator instances " +
         "launched, e.g. with the `-n` or `-np` command-line option specified to the " +
         "`mpirun` program.");
+    public static final ConfigOption CFGID_PARSIM_OPTIMISTICPROTOCOL_GVT_INTERVAL = addGlobalOptionU(
+        "parsim-optimisticprotocol-gvt-interval", "s", "0.1s",
+        "When `cOptimisticProtocol` is selected as parsim synchronization class: " +
+        "specifies how often (in wall clock time) partition 0 initiates the " +
+        "computation of global virtual time (GVT). GVT computation allows state " +
+        "saved for rolling back events to be discarded, and events that cannot be " +
+        "rolled back (e.g. the end of the simulation) to be executed. When " +
+        "partition 0 is idle, it computes GVT at most this often.");
     public static final ConfigOption CFGID_PARSIM_SYNCHRONIZATION_CLASS = addGlobalOption(
         "parsim-synchronization-class", CFG_STRING, "omnetpp::cNullMessageProtocol",
         "If `parallel-simulation=true`, it selects the parallel simulation " +
@@ -727,6 +757,12 @@ public class ConfigRegistry {
         "qtenv-extra-stack", "B", "80KiB",
         "Specifies the extra amount of stack that is reserved for each `activity()` " +
         "simple module when the simulation is run under Qtenv.");
+    public static final ConfigOption CFGID_QTENV_OBJECT_INDEX = addGlobalOption(
+        "qtenv-object-index", CFG_BOOL, "true",
+        "Enables an index of live objects that speeds up the Find/Inspect Objects " +
+        "dialog on large models. The index is built on the first search, and " +
+        "afterwards it is updated on every object creation and deletion, which " +
+        "slightly slows down the simulation.");
     public static final ConfigOption CFGID_REAL_TIME_LIMIT = addPerRunOptionU(
         "real-time-limit", "s", null,
         "Stops the simulation after the specified amount of time has elapsed. The " +